@@ -4,6 +4,7 @@
 #include "CommonTools/PileupAlgos/interface/PuppiAlgo.h"
 #include "CommonTools/PileupAlgos/interface/RecoObj.h"
 #include "CommonTools/PileupAlgos/interface/PuppiCandidate.h"
+#include "CommonTools/PileupAlgos/interface/PuppiNeighbourGrid.h"
 
 class PuppiContainer{
 public:
@@ -25,12 +26,12 @@ public:
     std::vector<PuppiCandidate> const & puppiParticles() const { return fPupParticles;}
 
 protected:
-    double  goodVar      (PuppiCandidate const &iPart,std::vector<PuppiCandidate> const &iParts, int iOpt,const double iRCone);
-    void    getRMSAvg    (int iOpt,std::vector<PuppiCandidate> const &iConstits,std::vector<PuppiCandidate> const &iParticles,std::vector<PuppiCandidate> const &iChargeParticles);
-    void    getRawAlphas    (int iOpt,std::vector<PuppiCandidate> const &iConstits,std::vector<PuppiCandidate> const &iParticles,std::vector<PuppiCandidate> const &iChargeParticles);
+    double  goodVar      (PuppiCandidate const &iPart,PuppiNeighbourGrid const &iParts, int iOpt,const double iRCone);
+    void    getRMSAvg    (int iOpt,std::vector<PuppiCandidate> const &iConstits,PuppiNeighbourGrid const &iParticles,PuppiNeighbourGrid const &iChargeParticles);
+    void    getRawAlphas    (int iOpt,std::vector<PuppiCandidate> const &iConstits,PuppiNeighbourGrid const &iParticles,PuppiNeighbourGrid const &iChargeParticles);
     double  getChi2FromdZ(double iDZ);
     int     getPuppiId   ( float iPt, float iEta);
-    double  var_within_R (int iId, const std::vector<PuppiCandidate> & particles, const PuppiCandidate& centre, const double R);
+    double  var_within_R (int iId, const PuppiNeighbourGrid & particles, const PuppiCandidate& centre, const double R);
     
     bool      fPuppiDiagnostics;
     std::vector<RecoObj>   fRecoParticles;
@@ -42,6 +43,12 @@ protected:
     std::vector<double>    fRawAlphas;
     std::vector<double>    fAlphaMed;
     std::vector<double>    fAlphaRMS;
+    // fPFParticles and fChargedPV binned in (rapidity,phi) for the cone sums
+    PuppiNeighbourGrid     fPFGrid;
+    PuppiNeighbourGrid     fChargedPVGrid;
+    double                 fMaxCone;
+    std::vector<unsigned int> fNear;
+    std::vector<double>    fNearDR2;
 
     bool   fApplyCHS;
     bool   fInvert;
@@ -0,0 +1,51 @@
+#ifndef CommonTools_PileupAlgos_PuppiNeighbourGrid
+#define CommonTools_PileupAlgos_PuppiNeighbourGrid
+
+#include "CommonTools/PileupAlgos/interface/PuppiCandidate.h"
+#include <vector>
+
+// The particles of an event binned in cells of (rapidity,phi) of size >= cellSize,
+// so that the particles within a cone of radius R <= cellSize around a direction
+// are searched in the 3x3 cells around it instead of in the whole event.
+// The rapidity range of the cells is the one of the particles, cut at |y| = 10:
+// the particles beyond go to the first and last cells.
+//
+// The distance is the one of fastjet::PseudoJet::squared_distance, and the
+// particles are returned in the order of the input collection, so that sums over
+// them are the same as the ones over the full collection.
+class PuppiNeighbourGrid {
+  public:
+    void reset(std::vector<PuppiCandidate> const &iParticles, double iCellSize);
+
+    // indices, in increasing order, of the particles with squared_distance(iCentre) < iR2
+    void near(PuppiCandidate const &iCentre, double iR2, std::vector<unsigned int> &oIndices) const;
+
+    unsigned int size() const { return fPt.size(); }
+    double eta(unsigned int i) const { return fEta[i]; }
+    double phi(unsigned int i) const { return fPhi[i]; }
+    double pt (unsigned int i) const { return fPt[i]; }
+
+  private:
+    int rapCell(double iRap) const;
+    int phiCell(double iPhi) const;
+
+    // by particle, in the order of the input collection
+    std::vector<double> fEta;
+    std::vector<double> fPhi;
+    std::vector<double> fPt;
+
+    // by particle, in the order of the cells: the particles of cell c are
+    // [fCellStart[c], fCellStart[c+1]), in the order of the input collection
+    std::vector<unsigned int> fCellStart;
+    std::vector<unsigned int> fCellIndex;
+    std::vector<double> fCellRap;
+    std::vector<double> fCellPhi;
+
+    double fRapMin = 0;
+    double fRapWidth = 1;
+    double fPhiWidth = 1;
+    int    fNRap = 1;
+    int    fNPhi = 1;
+};
+
+#endif
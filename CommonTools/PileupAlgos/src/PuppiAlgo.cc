@@ -5,6 +5,7 @@
 #include "Math/SpecFuncMathCore.h"
 #include "Math/ProbFunc.h"
 #include "TMath.h"
+#include <algorithm>
 
 
 PuppiAlgo::PuppiAlgo(edm::ParameterSet &iConfig) {
@@ -126,19 +127,29 @@ void PuppiAlgo::computeMedRMS(const unsigned int &iAlgo,const double &iPVFrac) {
     if(iAlgo >= fNAlgos   ) return;
     if(fNCount[iAlgo] == 0) return;
 
-    // sort alphas
     int lNBefore = 0;
     for(unsigned int i0 = 0; i0 < iAlgo; i0++) lNBefore += fNCount[i0];
-    std::sort(fPups.begin()+lNBefore,fPups.begin()+lNBefore+fNCount[iAlgo]);
-    
-    // in case you have alphas == 0
+    auto lBegin = fPups.begin()+lNBefore;
+    auto lEnd   = lBegin+fNCount[iAlgo];
+
+    // in case you have alphas == 0: lNum0 is the position of the last 0 in the sorted alphas
     int lNum0 = 0;
-    for(int i0 = lNBefore; i0 < lNBefore+fNCount[iAlgo]; i0++) {
-        if(fPups[i0] == 0) lNum0 = i0-lNBefore;
+    int lNNeg = 0;
+    int lNZero = 0;
+    for(auto it = lBegin; it != lEnd; ++it) {
+        if(*it < 0) lNNeg++;
+        else if(*it == 0) lNZero++;
     }
+    if(lNZero > 0) lNum0 = lNNeg+lNZero-1;
 
     // comput median, removed lCorr for now
+    // only the alphas below the median are sorted, the ones above are only needed in order without fAdjust:
+    // the sums below are then done in the same order as over the fully sorted alphas
     int lNHalfway = lNBefore + lNum0 + int( double( fNCount[iAlgo]-lNum0 )*0.50);
+    auto lHalfway = fPups.begin()+lNHalfway;
+    std::nth_element(lBegin,lHalfway,lEnd);
+    std::sort(lBegin,lHalfway);
+    if(!fAdjust[iAlgo]) std::sort(lHalfway+1,lEnd);
     fMedian[iAlgo] = fPups[lNHalfway];
     double lMed = fMedian[iAlgo];  //Just to make the readability easier
     
@@ -162,7 +173,6 @@ void PuppiAlgo::computeMedRMS(const unsigned int &iAlgo,const double &iPVFrac) {
 
     if(fAdjust[iAlgo]){ 
         //Adjust the p-value to correspond to the median
-        std::sort(fPupsPV.begin(),fPupsPV.end());
         int lNPV = 0; 
         for(unsigned int i0 = 0; i0 < fPupsPV.size(); i0++) if(fPupsPV[i0] <= lMed ) lNPV++;
         double lAdjust = double(lNPV)/double(lNPV+0.5*fNCount[iAlgo]);
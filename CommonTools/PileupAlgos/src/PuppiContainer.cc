@@ -4,6 +4,7 @@
 #include "TMath.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/isFinite.h"
 
@@ -22,6 +23,11 @@ PuppiContainer::PuppiContainer(const edm::ParameterSet &iConfig) {
         PuppiAlgo pPuppiConfig(lAlgos[i0]);
         fPuppiAlgo.push_back(pPuppiConfig);
     }
+    // the cells of the grids must be as large as the largest cone
+    fMaxCone = 0.1;
+    for(int i0 = 0; i0 < fNAlgos; i0++) {
+        for(int i1 = 0; i1 < fPuppiAlgo[i0].numAlgos(); i1++) fMaxCone = std::max(fMaxCone,fPuppiAlgo[i0].coneSize(i1));
+    }
 }
 
 void PuppiContainer::initialize(const std::vector<RecoObj> &iRecoObjects) {
@@ -72,11 +78,11 @@ void PuppiContainer::initialize(const std::vector<RecoObj> &iRecoObjects) {
 }
 PuppiContainer::~PuppiContainer(){}
 
-double PuppiContainer::goodVar(PuppiCandidate const &iPart,std::vector<PuppiCandidate> const &iParts, int iOpt,const double iRCone) {
+double PuppiContainer::goodVar(PuppiCandidate const &iPart,PuppiNeighbourGrid const &iParts, int iOpt,const double iRCone) {
     return var_within_R(iOpt,iParts,iPart,iRCone);
 }
 
-double PuppiContainer::var_within_R(int iId, const vector<PuppiCandidate> & particles, const PuppiCandidate& centre, const double R){
+double PuppiContainer::var_within_R(int iId, const PuppiNeighbourGrid & particles, const PuppiCandidate& centre, const double R){
     if(iId == -1) return 1;
 
     //this is a circle in rapidity-phi
@@ -84,24 +90,23 @@ double PuppiContainer::var_within_R(int iId, const vector<PuppiCandidate> & part
     //fastjet::Selector sel = fastjet::SelectorCircle(R);
     //sel.set_reference(centre);
     //the original code used Selector infrastructure: it is too heavy here
-    //logic of SelectorCircle is preserved below
-
-    vector<double > near_dR2s;     near_dR2s.reserve(std::min(50UL, particles.size()));
-    vector<double > near_pts;      near_pts.reserve(std::min(50UL, particles.size()));
+    //logic of SelectorCircle is preserved in PuppiNeighbourGrid::near,
+    //which only looks at the cells around the centre and keeps the order of the particles
     const double r2 = R*R;
-    for (auto const& part : particles){
-      if ( part.squared_distance(centre) < r2 ){
-        near_dR2s.push_back(reco::deltaR2(part, centre));
-        near_pts.push_back(part.pt());
-      }
+    particles.near(centre, r2, fNear);
+    auto nParts = fNear.size();
+    fNearDR2.resize(nParts);
+    const double eta = centre.eta();
+    const double phi = centre.phi();
+    for(auto i = 0UL; i < nParts; ++i){
+        fNearDR2[i] = reco::deltaR2(particles.eta(fNear[i]), particles.phi(fNear[i]), eta, phi);
     }
     double var = 0;
     //double lSumPt = 0;
     //if(iId == 1) for(auto  pt : near_pts) lSumPt += pt;
-    auto nParts = near_dR2s.size();
     for(auto i = 0UL; i < nParts; ++i){
-        auto dr2 = near_dR2s[i];
-        auto pt  = near_pts[i];
+        auto dr2 = fNearDR2[i];
+        auto pt  = particles.pt(fNear[i]);
         if(dr2  <  0.0001) continue;
         if(iId == 0) var += (pt/dr2);
         else if(iId == 1) var += pt;
@@ -117,7 +122,7 @@ double PuppiContainer::var_within_R(int iId, const vector<PuppiCandidate> & part
     return var;
 }
 //In fact takes the median not the average
-void PuppiContainer::getRMSAvg(int iOpt,std::vector<PuppiCandidate> const &iConstits,std::vector<PuppiCandidate> const &iParticles,std::vector<PuppiCandidate> const &iChargedParticles) {
+void PuppiContainer::getRMSAvg(int iOpt,std::vector<PuppiCandidate> const &iConstits,PuppiNeighbourGrid const &iParticles,PuppiNeighbourGrid const &iChargedParticles) {
     for(unsigned int i0 = 0; i0 < iConstits.size(); i0++ ) {
         double pVal = -1;
         //Calculate the Puppi Algo to use
@@ -147,8 +152,10 @@ void PuppiContainer::getRMSAvg(int iOpt,std::vector<PuppiCandidate> const &iCons
             pCharged = fPuppiAlgo[i1].isCharged(iOpt);
             pCone    = fPuppiAlgo[i1].coneSize (iOpt);
             double curVal = -1; 
-            if(!pCharged) curVal = goodVar(iConstits[i0],iParticles       ,pAlgo,pCone);
-            if( pCharged) curVal = goodVar(iConstits[i0],iChargedParticles,pAlgo,pCone);
+            //the metric of the algo of the particle is already known
+            if(i1 == pPupId) curVal = pVal;
+            else if(!pCharged) curVal = goodVar(iConstits[i0],iParticles       ,pAlgo,pCone);
+            else if( pCharged) curVal = goodVar(iConstits[i0],iChargedParticles,pAlgo,pCone);
             //std::cout << "i1 = " << i1 << ", curVal = " << curVal << ", eta = " << iConstits[i0].eta() << ", pupID = " << pPupId << std::endl;
             fPuppiAlgo[i1].add(iConstits[i0],curVal,iOpt);
         }
@@ -157,7 +164,7 @@ void PuppiContainer::getRMSAvg(int iOpt,std::vector<PuppiCandidate> const &iCons
     for(int i0 = 0; i0 < fNAlgos; i0++) fPuppiAlgo[i0].computeMedRMS(iOpt,fPVFrac);
 }
 //In fact takes the median not the average
-void PuppiContainer::getRawAlphas(int iOpt,std::vector<PuppiCandidate> const &iConstits,std::vector<PuppiCandidate> const &iParticles,std::vector<PuppiCandidate> const &iChargedParticles) {
+void PuppiContainer::getRawAlphas(int iOpt,std::vector<PuppiCandidate> const &iConstits,PuppiNeighbourGrid const &iParticles,PuppiNeighbourGrid const &iChargedParticles) {
     for(int j0 = 0; j0 < fNAlgos; j0++){
         for(unsigned int i0 = 0; i0 < iConstits.size(); i0++ ) {
             double pVal = -1;
@@ -216,10 +223,12 @@ std::vector<double> const & PuppiContainer::puppiWeights() {
     for(int i0 = 0; i0 < fNAlgos; i0++) lNMaxAlgo = std::max(fPuppiAlgo[i0].numAlgos(),lNMaxAlgo);
     //Run through all compute mean and RMS
     int lNParticles    = fRecoParticles.size();
+    fPFGrid       .reset(fPFParticles,fMaxCone);
+    fChargedPVGrid.reset(fChargedPV  ,fMaxCone);
     for(int i0 = 0; i0 < lNMaxAlgo; i0++) {
-        getRMSAvg(i0,fPFParticles,fPFParticles,fChargedPV);
+        getRMSAvg(i0,fPFParticles,fPFGrid,fChargedPVGrid);
     }
-    if (fPuppiDiagnostics) getRawAlphas(0,fPFParticles,fPFParticles,fChargedPV);
+    if (fPuppiDiagnostics) getRawAlphas(0,fPFParticles,fPFGrid,fChargedPVGrid);
 
     std::vector<double> pVals;
     for(int i0 = 0; i0 < lNParticles; i0++) {
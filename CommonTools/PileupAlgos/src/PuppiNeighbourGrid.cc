@@ -0,0 +1,95 @@
+#include "CommonTools/PileupAlgos/interface/PuppiNeighbourGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // rapidity beyond which the particles go to the first and last cells
+  const double kRapMax = 10.;
+}
+
+void PuppiNeighbourGrid::reset(std::vector<PuppiCandidate> const &iParticles, double iCellSize) {
+    const unsigned int lNParticles = iParticles.size();
+    fEta.resize(lNParticles);
+    fPhi.resize(lNParticles);
+    fPt .resize(lNParticles);
+    double lRapMin =  kRapMax;
+    double lRapMax = -kRapMax;
+    for(unsigned int i0 = 0; i0 < lNParticles; i0++) {
+        fEta[i0] = iParticles[i0].eta();
+        fPhi[i0] = iParticles[i0].phi();
+        fPt [i0] = iParticles[i0].pt();
+        const double lRap = iParticles[i0].rap();
+        if(lRap < lRapMin) lRapMin = lRap;
+        if(lRap > lRapMax) lRapMax = lRap;
+    }
+    lRapMin = std::max(lRapMin,-kRapMax);
+    lRapMax = std::min(lRapMax, kRapMax);
+
+    // cells at least as large as iCellSize, so that a cone of that radius is within the 3x3 cells around its axis
+    fRapMin = lRapMin;
+    fNRap = lRapMax > lRapMin ? std::max(1,int((lRapMax-lRapMin)/iCellSize)) : 1;
+    fRapWidth = fNRap > 1 ? (lRapMax-lRapMin)/fNRap : 1.;
+    fNPhi = std::max(1,int(fastjet::twopi/iCellSize));
+    fPhiWidth = fastjet::twopi/fNPhi;
+
+    // counting sort of the particles by cell, keeping the order of the input collection within a cell
+    std::vector<int> lCells(lNParticles);
+    fCellStart.assign(fNRap*fNPhi+1,0);
+    for(unsigned int i0 = 0; i0 < lNParticles; i0++) {
+        lCells[i0] = phiCell(fPhi[i0])*fNRap + rapCell(iParticles[i0].rap());
+        fCellStart[lCells[i0]+1]++;
+    }
+    for(unsigned int i0 = 1; i0 < fCellStart.size(); i0++) fCellStart[i0] += fCellStart[i0-1];
+    fCellIndex.resize(lNParticles);
+    fCellRap  .resize(lNParticles);
+    fCellPhi  .resize(lNParticles);
+    std::vector<unsigned int> lFill(fCellStart.begin(),fCellStart.end()-1);
+    for(unsigned int i0 = 0; i0 < lNParticles; i0++) {
+        const unsigned int k = lFill[lCells[i0]]++;
+        fCellIndex[k] = i0;
+        fCellRap  [k] = iParticles[i0].rap();
+        fCellPhi  [k] = fPhi[i0];
+    }
+}
+
+int PuppiNeighbourGrid::rapCell(double iRap) const {
+    if(fNRap == 1) return 0;
+    const double x = (iRap-fRapMin)/fRapWidth;
+    if(!(x > 0)) return 0; // also for NaN
+    if(x >= fNRap) return fNRap-1;
+    return int(x);
+}
+
+int PuppiNeighbourGrid::phiCell(double iPhi) const {
+    const double x = iPhi/fPhiWidth;
+    if(!(x > 0)) return 0;
+    if(x >= fNPhi) return fNPhi-1;
+    return int(x);
+}
+
+void PuppiNeighbourGrid::near(PuppiCandidate const &iCentre, double iR2, std::vector<unsigned int> &oIndices) const {
+    oIndices.clear();
+    const double lRap = iCentre.rap();
+    const double lPhi = iCentre.phi();
+    const int lRapCell = rapCell(lRap);
+    const int lPhiCell = phiCell(lPhi);
+    const int lRapFirst = std::max(lRapCell-1,0);
+    const int lRapLast  = std::min(lRapCell+1,fNRap-1);
+    // with less than 3 cells in phi, all of them are around the centre
+    const int lNPhiAround = std::min(fNPhi,3);
+    const int lPhiFirst = fNPhi < 3 ? 0 : lPhiCell-1+fNPhi;
+    for(int i0 = 0; i0 < lNPhiAround; i0++) {
+        const int lRow = ((lPhiFirst+i0)%fNPhi)*fNRap;
+        // the rapidity cells of a row are contiguous
+        const unsigned int lBegin = fCellStart[lRow+lRapFirst];
+        const unsigned int lEnd   = fCellStart[lRow+lRapLast+1];
+        for(unsigned int k = lBegin; k < lEnd; k++) {
+            // as in fastjet::PseudoJet::plain_distance
+            double dphi = std::abs(fCellPhi[k] - lPhi);
+            if (dphi > fastjet::pi) {dphi = fastjet::twopi - dphi;}
+            const double drap = fCellRap[k] - lRap;
+            if(dphi*dphi + drap*drap < iR2) oIndices.push_back(fCellIndex[k]);
+        }
+    }
+    std::sort(oIndices.begin(),oIndices.end());
+}
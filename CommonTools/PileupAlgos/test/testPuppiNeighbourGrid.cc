@@ -0,0 +1,201 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "CommonTools/PileupAlgos/interface/PuppiAlgo.h"
+#include "CommonTools/PileupAlgos/interface/PuppiCandidate.h"
+#include "CommonTools/PileupAlgos/interface/PuppiNeighbourGrid.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "Math/QuantFuncMathCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class testPuppiNeighbourGrid : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testPuppiNeighbourGrid);
+  CPPUNIT_TEST(checkNear);
+  CPPUNIT_TEST(checkMedRMS);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkNear();
+  void checkMedRMS();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testPuppiNeighbourGrid);
+
+namespace {
+  PuppiCandidate candidate(double pt, double rap, double phi) {
+    PuppiCandidate c;
+    c.reset_PtYPhiM(pt, rap, phi, 0.13);
+    return c;
+  }
+
+  // the events: empty ones, a few particles, and up to some thousands of particles,
+  // spread or collimated, with particles at phi ~ 0 and 2pi and at |y| > 10
+  std::vector<PuppiCandidate> event(std::mt19937 &engine, unsigned int iEvent) {
+    std::vector<PuppiCandidate> particles;
+    if(iEvent % 6 == 0) {
+      for(unsigned int i0 = 0; i0 < iEvent % 5; i0++) particles.push_back(candidate(1. + i0, 0.1 * i0, 0.2 * i0));
+      return particles;
+    }
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    const unsigned int lN = 200 + engine() % 2500;
+    const double lSpread = iEvent % 3 == 0 ? 0.3 : 5.;
+    for(unsigned int i0 = 0; i0 < lN; i0++) {
+      const double lPt = 0.5 + 10. * uniform(engine) * uniform(engine);
+      const double lRap = lSpread * (2. * uniform(engine) - 1.);
+      switch(engine() % 20) {
+        case 0:  particles.push_back(candidate(lPt, lRap, 1e-7 * uniform(engine))); break;
+        case 1:  particles.push_back(candidate(lPt, lRap, 2. * M_PI - 1e-7 * uniform(engine))); break;
+        case 2:  particles.push_back(candidate(lPt, lRap, 0.1 * uniform(engine))); break;
+        case 3:  particles.push_back(candidate(lPt, lRap, 2. * M_PI - 0.1 * uniform(engine))); break;
+        case 4:  particles.push_back(candidate(lPt, (uniform(engine) < 0.5 ? -1. : 1.) * (10. + 5. * uniform(engine)),
+                                               2. * M_PI * uniform(engine))); break;
+        case 5:  particles.push_back(candidate(0., 99., 0.)); break;
+        default: particles.push_back(candidate(lPt, lRap, 2. * M_PI * uniform(engine)));
+      }
+    }
+    return particles;
+  }
+
+  // the previous computeMedRMS, with a full sort of the alphas, for one algo
+  void medRMS(std::vector<float> iPups, std::vector<float> const &iPupsPV, bool iAdjust, double iRMSScaleFactor,
+              double &oMedian, double &oRMS) {
+    std::sort(iPups.begin(), iPups.end());
+    const int lN = iPups.size();
+    int lNum0 = 0;
+    for(int i0 = 0; i0 < lN; i0++) if(iPups[i0] == 0) lNum0 = i0;
+    oMedian = iPups[lNum0 + int(double(lN - lNum0) * 0.50)];
+    const double lMed = oMedian;
+    oRMS = 0;
+    int lNRMS = 0;
+    for(int i0 = 0; i0 < lN; i0++) {
+      if(iPups[i0] == 0) continue;
+      if(iAdjust && iPups[i0] > lMed) continue;
+      lNRMS++;
+      oRMS += (iPups[i0] - lMed) * (iPups[i0] - lMed);
+    }
+    if(lNRMS > 0) oRMS /= lNRMS;
+    if(oRMS == 0) oRMS = 1e-5;
+    oRMS = sqrt(oRMS);
+    oRMS *= iRMSScaleFactor;
+    if(iAdjust) {
+      int lNPV = 0;
+      for(float lPup : iPupsPV) if(lPup <= lMed) lNPV++;
+      double lAdjust = double(lNPV) / double(lNPV + 0.5 * lN);
+      if(lAdjust > 0) {
+        oMedian -= sqrt(ROOT::Math::chisquared_quantile(lAdjust, 1.) * oRMS);
+        oRMS    -= sqrt(ROOT::Math::chisquared_quantile(lAdjust, 1.) * oRMS);
+      }
+    }
+  }
+
+  edm::ParameterSet algoConfig(bool iAdjust) {
+    edm::ParameterSet lAlgo;
+    lAlgo.addParameter<int>("algoId", 5);
+    lAlgo.addParameter<bool>("useCharged", true);
+    lAlgo.addParameter<bool>("applyLowPUCorr", iAdjust);
+    lAlgo.addParameter<int>("combOpt", 0);
+    lAlgo.addParameter<double>("cone", 0.4);
+    lAlgo.addParameter<double>("rmsPtMin", 0.1);
+    lAlgo.addParameter<double>("rmsScaleFactor", 1.3);
+
+    edm::ParameterSet lConfig;
+    lConfig.addParameter<std::vector<double> >("etaMin", {0.});
+    lConfig.addParameter<std::vector<double> >("etaMax", {2.5});
+    lConfig.addParameter<std::vector<double> >("ptMin", {0.});
+    lConfig.addParameter<std::vector<double> >("MinNeutralPt", {0.2});
+    lConfig.addParameter<std::vector<double> >("MinNeutralPtSlope", {0.015});
+    lConfig.addParameter<std::vector<double> >("RMSEtaSF", {1.});
+    lConfig.addParameter<std::vector<double> >("MedEtaSF", {1.});
+    lConfig.addParameter<double>("EtaMaxExtrap", 2.0);
+    // a second algo, so that the alphas of the first are not the whole collection
+    lConfig.addParameter<std::vector<edm::ParameterSet> >("puppiAlgos", {lAlgo, lAlgo});
+    return lConfig;
+  }
+}
+
+void testPuppiNeighbourGrid::checkNear() {
+  std::mt19937 engine(3);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  PuppiNeighbourGrid lGrid;
+  std::vector<unsigned int> lNear, lExpected;
+  unsigned long lNFound = 0;
+  for(unsigned int iEvent = 0; iEvent < 60; iEvent++) {
+    const std::vector<PuppiCandidate> lParticles = event(engine, iEvent);
+    const double lCellSize = iEvent % 4 == 0 ? 3.5 : (iEvent % 4 == 1 ? 0.4 : 0.8);
+    lGrid.reset(lParticles, lCellSize);
+    CPPUNIT_ASSERT(lGrid.size() == lParticles.size());
+
+    // the centres are the particles, and directions at phi ~ 0 and 2pi and |y| > 10
+    std::vector<PuppiCandidate> lCentres(lParticles);
+    for(double lRap : {-12., -10.05, -9.9, 0., 9.9, 10.05, 12.}) {
+      for(double lPhi : {0., 1e-9, 0.05, 2. * M_PI - 0.05, 2. * M_PI - 1e-9}) lCentres.push_back(candidate(1., lRap, lPhi));
+    }
+    for(unsigned int i0 = 0; i0 < lParticles.size(); i0++) {
+      CPPUNIT_ASSERT(lGrid.eta(i0) == lParticles[i0].eta());
+      CPPUNIT_ASSERT(lGrid.phi(i0) == lParticles[i0].phi());
+      CPPUNIT_ASSERT(lGrid.pt(i0) == lParticles[i0].pt());
+    }
+
+    for(double lR : {0.3, 0.4, lCellSize}) {
+      if(lR > lCellSize) continue;
+      const double lR2 = lR * lR;
+      for(auto const &lCentre : lCentres) {
+        lExpected.clear();
+        for(unsigned int i0 = 0; i0 < lParticles.size(); i0++) {
+          if(lParticles[i0].squared_distance(lCentre) < lR2) lExpected.push_back(i0);
+        }
+        lGrid.near(lCentre, lR2, lNear);
+        CPPUNIT_ASSERT(lNear == lExpected);
+        lNFound += lNear.size();
+      }
+    }
+  }
+  CPPUNIT_ASSERT(lNFound > 0);
+}
+
+void testPuppiNeighbourGrid::checkMedRMS() {
+  std::mt19937 engine(5);
+  std::normal_distribution<float> alpha(2., 3.);
+  for(bool lAdjust : {false, true}) {
+    edm::ParameterSet lConfig = algoConfig(lAdjust);
+    PuppiAlgo lAlgo(lConfig);
+    for(unsigned int iTest = 0; iTest < 2000; iTest++) {
+      lAlgo.reset();
+      std::vector<float> lPups, lPupsPV;
+      // alphas with zeros, negative values and ties
+      const unsigned int lN = 1 + engine() % 600;
+      for(unsigned int i0 = 0; i0 < lN; i0++) {
+        float lAlpha = alpha(engine);
+        if(engine() % 7 == 0) lAlpha = 0;
+        if(engine() % 5 == 0) lAlpha = std::round(lAlpha);
+        PuppiCandidate lParticle = candidate(1., 0., 0.);
+        // pileup charged particles, and some of the PV
+        const bool lPV = engine() % 4 == 0;
+        lParticle.set_info(lPV ? 1 : 3);
+        lAlgo.add(lParticle, lAlpha, 0);
+        (lPV ? lPupsPV : lPups).push_back(lAlpha);
+      }
+      // the alphas of the second algo, after the ones of the first one
+      for(unsigned int i0 = 0; i0 < 10; i0++) {
+        PuppiCandidate lParticle = candidate(1., 0., 0.);
+        lParticle.set_info(3);
+        lAlgo.add(lParticle, -alpha(engine), 1);
+      }
+      if(lPups.empty()) continue;
+      lAlgo.computeMedRMS(0, 0.);
+      lAlgo.computeMedRMS(1, 0.);
+      lAlgo.fixAlgoEtaBin(0);
+
+      double lMedian, lRMS;
+      medRMS(lPups, lPupsPV, lAdjust, 1.3, lMedian, lRMS);
+      CPPUNIT_ASSERT(lAlgo.median() == lMedian);
+      CPPUNIT_ASSERT(lAlgo.rms() == lRMS);
+    }
+  }
+}
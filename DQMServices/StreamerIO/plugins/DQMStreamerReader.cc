@@ -129,8 +129,11 @@ void DQMStreamerReader::openFile_(const DQMFileIterator::LumiEntry& entry) {
   processedEventPerLs_ = 0;
 
   if (flagDeleteDatFiles_) {
-    // unlink the file
+    // unlink the file, and its index if any (both stay mapped/open until closed)
     unlink(path.c_str());
+    if (file_.streamFile_->index()) {
+      unlink(edm::StreamerFileIndex::indexFileName(path).c_str());
+    }
   }
 }
 
@@ -182,8 +185,24 @@ InitMsgView const* DQMStreamerReader::getHeaderMsg() {
   return header;
 }
 
-EventMsgView const* DQMStreamerReader::getEventMsg() {
-  if (!file_.streamFile_->next()) {
+EventMsgView const* DQMStreamerReader::getEventMsg(bool& endOfFile) {
+  // With a sidecar index, the rejected events are skipped without reading them.
+  // prepareNextFile() is not called between the rejected events any more, so
+  // its checks (shutdown, end of run, next lumi) are done here for each of
+  // them; if one of them fires, the event stops the skipping and nullptr is
+  // returned with the file still open.
+  endOfFile = false;
+  bool interrupted = false;
+  auto accept = [this, &interrupted](uint8 const* hltBits, uint32 hltCount) {
+    if (acceptEvent(hltBits, hltCount)) return true;
+    interrupted = mustLeaveFile();
+    return interrupted;
+  };
+  if (!file_.streamFile_->next(accept)) {
+    endOfFile = true;
+    return nullptr;
+  }
+  if (interrupted) {
     return nullptr;
   }
 
@@ -193,6 +212,23 @@ EventMsgView const* DQMStreamerReader::getEventMsg() {
   return msg;
 }
 
+/**
+ * True if prepareNextFile() would close the current file: shutdown, end of run,
+ * or enough events processed in this lumi and the next one (or the end of
+ * run) is there.
+ */
+bool DQMStreamerReader::mustLeaveFile() {
+  typedef DQMFileIterator::State State;
+
+  fiterator_.update_state();
+
+  if (edm::shutdown_flag.load()) return true;
+  if (flagEndOfRunKills_ && (fiterator_.state() != State::OPEN)) return true;
+
+  return (processedEventPerLs_ >= minEventsPerLs_) &&
+         (fiterator_.lumiReady() || (fiterator_.state() == State::EOR));
+}
+
 /**
  * Prepare (open) the next file for reading.
  * It is used by prepareNextEvent and in the constructor.
@@ -278,18 +314,16 @@ EventMsgView const* DQMStreamerReader::prepareNextEvent() {
       fiterator_.delay();
     } else {
       // our reader exists, try to read out an event
-      eview = getEventMsg();
+      bool endOfFile = false;
+      eview = getEventMsg(endOfFile);
 
       if (eview == nullptr) {
         // read unsuccessful
-        // this means end of file, so close the file
-        closeFile_("eof");
+        // at the end of file, close the file, otherwise the skipping of the
+        // rejected events was interrupted: prepareNextFile() will act
+        if (endOfFile) closeFile_("eof");
       } else {
-        if (!acceptEvent(eview)) {
-          continue;
-        } else {
-          return eview;
-        }
+        return eview;
       }
     }
   }
@@ -373,19 +407,12 @@ bool DQMStreamerReader::matchTriggerSel(Strings const& tnames) {
 /**
  * Check the trigger path to accept event
  */
-bool DQMStreamerReader::acceptEvent(const EventMsgView* evtmsg) {
+bool DQMStreamerReader::acceptEvent(uint8 const* hltBits, uint32 hltCount) {
   if (acceptAllEvt_) return true;
   if (!matchTriggerSel_) return false;
 
-  std::vector<unsigned char> hltTriggerBits_;
-  int hltTriggerCount_ = evtmsg->hltCount();
-  if (hltTriggerCount_ > 0) {
-    hltTriggerBits_.resize(1 + (hltTriggerCount_ - 1) / 4);
-  }
-  evtmsg->hltTriggerBits(&hltTriggerBits_[0]);
-
   if (eventSelector_->wantAll() ||
-      eventSelector_->acceptEvent(&hltTriggerBits_[0], evtmsg->hltCount())) {
+      eventSelector_->acceptEvent(hltBits, hltCount)) {
     return true;
   } else {
     return false;
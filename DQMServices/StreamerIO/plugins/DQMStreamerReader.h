@@ -47,11 +47,12 @@ class DQMStreamerReader : public edm::StreamerInputSource {
   bool openNextFile_();
 
   InitMsgView const* getHeaderMsg();
-  EventMsgView const* getEventMsg();
+  EventMsgView const* getEventMsg(bool& endOfFile);
+  bool mustLeaveFile();
 
   EventMsgView const* prepareNextEvent();
   bool prepareNextFile();
-  bool acceptEvent(const EventMsgView*);
+  bool acceptEvent(uint8 const* hltBits, uint32 hltCount);
 
   bool triggerSel();
   bool matchTriggerSel(Strings const& tnames);
@@ -56,6 +56,7 @@ class DQMStreamerOutputRepackerTest : public edm::StreamerOutputModuleBase {
  private:
   std::string streamLabel_;
   std::string outputPath_;
+  bool writeIndex_;
 
   std::unique_ptr<uint8_t[]> init_message_cache_;
   std::unique_ptr<StreamerOutputFile> streamFile_;
@@ -76,6 +77,7 @@ DQMStreamerOutputRepackerTest::DQMStreamerOutputRepackerTest(
       edm::StreamerOutputModuleBase(ps) {
   outputPath_ = ps.getUntrackedParameter<std::string>("outputPath");
   streamLabel_ = ps.getUntrackedParameter<std::string>("streamLabel");
+  writeIndex_ = ps.getUntrackedParameter<bool>("writeIndex");
 
   eventsProcessedTotal_ = 0;
   eventsProcessedFile_ = 0;
@@ -104,7 +106,7 @@ void DQMStreamerOutputRepackerTest::openFile(uint32_t run, uint32_t lumi) {
   edm::LogAbsolute("DQMStreamerOutputRepackerTest") << "Writing file: "
                                                     << currentFilePath_;
 
-  streamFile_.reset(new StreamerOutputFile(currentFilePath_));
+  streamFile_.reset(new StreamerOutputFile(currentFilePath_, writeIndex_));
   streamRun_ = run;
   streamLumi_ = lumi;
 
@@ -120,6 +122,7 @@ void DQMStreamerOutputRepackerTest::openFile(uint32_t run, uint32_t lumi) {
 void DQMStreamerOutputRepackerTest::closeFile() {
   edm::LogAbsolute("DQMStreamerOutputRepackerTest") << "Writing json: "
                                                     << currentJsonPath_;
+  streamFile_->writeIndex();
   size_t fsize = boost::filesystem::file_size(currentFilePath_);
 
   using namespace boost::property_tree;
@@ -193,6 +196,9 @@ void DQMStreamerOutputRepackerTest::fillDescriptions(
   desc.addUntracked<std::string>("streamLabel", "DQM")
       ->setComment("Stream label used in json discovery.");
 
+  desc.addUntracked<bool>("writeIndex", false)
+      ->setComment("Also write the sidecar index of each file.");
+
   descriptions.add("DQMStreamerOutputRepackerTest", desc);
 }
 
@@ -0,0 +1,108 @@
+// Checks that the events read are the expected ones, in the expected order,
+// that each of them was accepted by one of the selected paths of the process
+// which wrote them, and that no expected event is missing at the end of the job.
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/TriggerResults.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "FWCore/Common/interface/TriggerNames.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <string>
+#include <vector>
+
+namespace dqmservices {
+
+class DQMStreamerReaderEventChecker : public edm::one::EDAnalyzer<> {
+ public:
+  explicit DQMStreamerReaderEventChecker(edm::ParameterSet const& ps);
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+ private:
+  void analyze(edm::Event const& event, edm::EventSetup const&) override;
+  void endJob() override;
+
+  std::vector<edm::EventID> const expected_;
+  std::vector<std::string> const selectedPaths_;
+  edm::EDGetTokenT<edm::TriggerResults> const triggerResultsToken_;
+  unsigned int index_;
+};
+
+DQMStreamerReaderEventChecker::DQMStreamerReaderEventChecker(
+    edm::ParameterSet const& ps)
+    : expected_(ps.getUntrackedParameter<std::vector<edm::EventID> >(
+          "eventSequence")),
+      selectedPaths_(
+          ps.getUntrackedParameter<std::vector<std::string> >("selectedPaths")),
+      triggerResultsToken_(consumes<edm::TriggerResults>(
+          ps.getUntrackedParameter<edm::InputTag>("triggerResults"))),
+      index_(0) {}
+
+void DQMStreamerReaderEventChecker::analyze(edm::Event const& event,
+                                            edm::EventSetup const&) {
+  if (index_ >= expected_.size()) {
+    throw cms::Exception("TooManyEvents")
+        << "Expected " << expected_.size() << " events, got also "
+        << event.id() << "\n";
+  }
+  if (event.id() != expected_[index_]) {
+    throw cms::Exception("WrongEvent") << "Expected event "
+                                       << expected_[index_] << ", got "
+                                       << event.id() << "\n";
+  }
+  ++index_;
+
+  edm::Handle<edm::TriggerResults> results;
+  event.getByToken(triggerResultsToken_, results);
+  edm::TriggerNames const& names = event.triggerNames(*results);
+  bool accepted = false;
+  for (auto const& path : selectedPaths_) {
+    unsigned int const i = names.triggerIndex(path);
+    if (i == names.size()) {
+      throw cms::Exception("MissingPath") << "No path " << path
+                                          << " in the trigger results\n";
+    }
+    accepted = accepted || results->accept(i);
+  }
+  if (!accepted) {
+    throw cms::Exception("RejectedEvent")
+        << "Event " << event.id()
+        << " was not accepted by any of the selected paths\n";
+  }
+}
+
+void DQMStreamerReaderEventChecker::endJob() {
+  if (index_ != expected_.size()) {
+    throw cms::Exception("MissedEvents")
+        << "Got " << index_ << " events out of the " << expected_.size()
+        << " expected, the next one is " << expected_[index_] << "\n";
+  }
+  edm::LogSystem("DQMStreamerReaderEventChecker")
+      << "Got the " << index_ << " expected events";
+}
+
+void DQMStreamerReaderEventChecker::fillDescriptions(
+    edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<std::vector<edm::EventID> >("eventSequence")
+      ->setComment("Expected events, in order.");
+  desc.addUntracked<std::vector<std::string> >("selectedPaths")
+      ->setComment("Paths of which at least one accepted each event.");
+  desc.addUntracked<edm::InputTag>("triggerResults",
+                                   edm::InputTag("TriggerResults", "", "HLT"))
+      ->setComment("Trigger results of the process which wrote the events.");
+  descriptions.add("dqmStreamerReaderEventChecker", desc);
+}
+
+}  // end of namespace
+
+typedef dqmservices::DQMStreamerReaderEventChecker
+    DQMStreamerReaderEventChecker;
+DEFINE_FWK_MODULE(DQMStreamerReaderEventChecker);
@@ -0,0 +1,62 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Reads the lumi sections written by DQMStreamerWriteLumis_cfg.py with a
+# trigger selection, and checks that the events read are, in each lumi section,
+# the first minEventsPerLumi accepted ones (all of them if there are fewer).
+
+options = VarParsing.VarParsing()
+options.register('runNumber',
+                 100, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Run number.")
+options.register('minEventsPerLumi',
+                 1, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Minimum number of events to process per lumisection.")
+options.register('selectEvents',
+                 'HLT_Sparse', # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Selected paths, separated by commas.")
+options.parseArguments()
+selectEvents = options.selectEvents.split(',')
+
+process = cms.Process("READ")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.source = cms.Source("DQMStreamerReader",
+    SelectEvents = cms.untracked.vstring(selectEvents),
+    runNumber = cms.untracked.uint32(options.runNumber),
+    runInputDir = cms.untracked.string("."),
+    streamLabel = cms.untracked.string("streamDQM"),
+    scanOnce = cms.untracked.bool(False),
+    datafnPosition = cms.untracked.uint32(3),
+    minEventsPerLumi = cms.untracked.int32(options.minEventsPerLumi),
+    delayMillis = cms.untracked.uint32(100),
+    nextLumiTimeoutMillis = cms.untracked.int32(-1),
+    skipFirstLumis = cms.untracked.bool(False),
+    deleteDatFiles = cms.untracked.bool(False),
+    endOfRunKills = cms.untracked.bool(False)
+)
+
+# the paths of DQMStreamerWriteLumis_cfg.py, as (modulo, offset) of the event number
+paths = {"HLT_Sparse": (40, 7), "HLT_Third": (3, 0)}
+eventsPerLumi = 20
+nLumis = 5
+
+expected = []
+for lumi in range(1, nLumis + 1):
+    accepted = [e for e in range((lumi - 1) * eventsPerLumi + 1, lumi * eventsPerLumi + 1)
+                if any(e % paths[p][0] == paths[p][1] for p in selectEvents)]
+    expected += [cms.EventID(options.runNumber, lumi, e) for e in accepted[:options.minEventsPerLumi]]
+
+process.checker = cms.EDAnalyzer("DQMStreamerReaderEventChecker",
+    eventSequence = cms.untracked.VEventID(*expected),
+    selectedPaths = cms.untracked.vstring(selectEvents)
+)
+
+process.p = cms.Path(process.checker)
@@ -0,0 +1,53 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Writes one streamer file per lumi section, with its json, in the layout read
+# by DQMStreamerReader (see DQMStreamerReaderSelection_cfg.py). The paths accept
+# few events, HLT_Sparse none in some lumi sections.
+
+options = VarParsing.VarParsing()
+options.register('runNumber',
+                 100, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Run number.")
+options.register('writeIndex',
+                 False, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.bool,
+                 "Also write the sidecar index of each file.")
+options.parseArguments()
+
+process = cms.Process("HLT")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(100)
+)
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(options.runNumber),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(20)
+)
+
+# events 7, 47 and 87: nothing in lumi sections 2 and 4
+process.sparse = cms.EDFilter("ModuloEventIDFilter",
+    modulo = cms.uint32(40),
+    offset = cms.uint32(7)
+)
+
+process.third = cms.EDFilter("ModuloEventIDFilter",
+    modulo = cms.uint32(3),
+    offset = cms.uint32(0)
+)
+
+process.out = cms.OutputModule("DQMStreamerOutputRepackerTest",
+    outputPath = cms.untracked.string("."),
+    streamLabel = cms.untracked.string("DQM"),
+    writeIndex = cms.untracked.bool(options.writeIndex)
+)
+
+process.HLT_Sparse = cms.Path(process.sparse)
+process.HLT_Third = cms.Path(process.third)
+process.end = cms.EndPath(process.out)
@@ -0,0 +1,22 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+pushd ${LOCAL_TMP_DIR}
+
+# one run with the sidecar indexes, in which the rejected events are skipped
+# without being read, one without
+cmsRun ${LOCAL_TEST_DIR}/DQMStreamerWriteLumis_cfg.py runNumber=100 writeIndex=True || die 'Failure using DQMStreamerWriteLumis_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/DQMStreamerWriteLumis_cfg.py runNumber=101 writeIndex=False || die 'Failure using DQMStreamerWriteLumis_cfg.py' $?
+[ -f run000100/run000100_ls0001_streamDQM_local.dat.idx ] || die 'No index written for run 100' 1
+[ -f run000101/run000101_ls0001_streamDQM_local.dat.idx ] && die 'Index written for run 101' 1
+
+for run in 100 101; do
+  echo '{"data": ["100", "100", "5"]}' > run000${run}/run000${run}_ls0000_EoR.jsn
+  for min in 1 2 1000; do
+    cmsRun ${LOCAL_TEST_DIR}/DQMStreamerReaderSelection_cfg.py runNumber=${run} minEventsPerLumi=${min} || die "Failure using DQMStreamerReaderSelection_cfg.py on run ${run} with minEventsPerLumi=${min}" $?
+    cmsRun ${LOCAL_TEST_DIR}/DQMStreamerReaderSelection_cfg.py runNumber=${run} minEventsPerLumi=${min} selectEvents=HLT_Sparse,HLT_Third || die "Failure using DQMStreamerReaderSelection_cfg.py on run ${run} with minEventsPerLumi=${min} and two paths" $?
+  done
+done
+
+popd
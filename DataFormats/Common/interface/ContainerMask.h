@@ -53,6 +53,8 @@ namespace edm {
 
 
       size_t size() const { return m_mask.size();}
+      /// the mask itself, to be used in place of a copy while the ContainerMask is alive
+      const std::vector<bool>& maskVector() const { return m_mask; }
 
       const edm::RefProd<T>& refProd() const {return m_prod;}
       // ---------- static member functions --------------------
@@ -89,7 +91,8 @@ namespace edm {
    
    template<typename T>
    void ContainerMask<T>::copyMaskTo(std::vector<bool>& iTo) const {
-      iTo.assign(m_mask.begin(),m_mask.end());
+      // copy the whole words of the bitset, not bit by bit
+      iTo = m_mask;
    }
    
    template<typename T>
@@ -19,6 +19,8 @@
 class testPackedCandidate;
 
 namespace pat {
+  class PackedCandidateSoA;
+
   class PackedCandidate : public reco::Candidate {
   public:
     /// collection of daughter candidates                                                 
@@ -690,6 +692,7 @@ namespace pat {
 
   protected:
     friend class ::testPackedCandidate;
+    friend class PackedCandidateSoA;
     static constexpr float kMinDEtaToStore_=0.001;
     static constexpr float kMinDTrkPtToStore_=0.001;
     
@@ -700,6 +703,10 @@ namespace pat {
 
     void pack(bool unpackAfterwards=true) ;
     void unpack() const ;
+    /// the values unpack() and unpackVtx() set, without storing them
+    PolarLorentzVector unpackedP4() const ;
+    float unpackedDxy() const ;
+    float unpackedDz() const ;
     void packVtx(bool unpackAfterwards=true) ;
     void unpackVtx() const ;
     void packCovariance(const reco::TrackBase::CovarianceMatrix  & m,bool unpackAfterwards=true) ;
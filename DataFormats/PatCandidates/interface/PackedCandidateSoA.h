@@ -0,0 +1,48 @@
+#ifndef __DataFormats_PatCandidates_PackedCandidateSoA_h__
+#define __DataFormats_PatCandidates_PackedCandidateSoA_h__
+
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+
+#include <vector>
+
+namespace pat {
+
+  /** The kinematics and impact parameters of all the candidates of a
+   *  PackedCandidateCollection, decoded in one pass into plain arrays.
+   *
+   *  Decoding this way does not unpack the candidates themselves, so it
+   *  allocates no four-vector or vertex for each candidate and uses no
+   *  atomics. The values are the ones the accessors of the candidates
+   *  return: pt(), eta(), phi(), mass(), dxy() and dz(), where dz() is
+   *  taken with respect to PV[0]. A candidate that has already been
+   *  unpacked (for example, one modified after it was read) is taken as
+   *  it is. cartesianPt, cartesianEta and cartesianPhi are the ones of
+   *  the cartesian p4(), which can differ in the last bits from the polar
+   *  ones: they are what deltaR(x, candidate) and candidate.p4().pt()
+   *  give.
+   *
+   *  This is a transient helper: fill it once per event, then loop over
+   *  the arrays instead of calling the accessors of each candidate.
+   */
+  class PackedCandidateSoA {
+  public:
+    PackedCandidateSoA() {}
+    explicit PackedCandidateSoA(const PackedCandidateCollection & cands) { fill(cands); }
+
+    void fill(const PackedCandidateCollection & cands);
+
+    unsigned int size() const { return pt.size(); }
+    const PackedCandidate & candidate(unsigned int i) const { return (*cands_)[i]; }
+
+    std::vector<double> pt, eta, phi, mass;
+    std::vector<double> cartesianPt, cartesianEta, cartesianPhi;
+    std::vector<float> dxy, dz;
+    std::vector<int> pdgId;
+
+  private:
+    const PackedCandidateCollection * cands_ = nullptr;
+  };
+
+}
+
+#endif
@@ -45,15 +45,19 @@ void pat::PackedCandidate::packVtx(bool unpackAfterwards) {
     }
 }
 
-void pat::PackedCandidate::unpack() const {
+pat::PackedCandidate::PolarLorentzVector pat::PackedCandidate::unpackedP4() const {
     float pt = MiniFloatConverter::float16to32(packedPt_);
     double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
     double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
     double phi = int16_t(packedPhi_)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
-    auto p4 = std::make_unique<PolarLorentzVector>(pt,
+    return PolarLorentzVector(pt,
                              int16_t(packedEta_)*6.0f/std::numeric_limits<int16_t>::max(),
                              phi,
                              MiniFloatConverter::float16to32(packedM_));
+}
+
+void pat::PackedCandidate::unpack() const {
+    auto p4 = std::make_unique<PolarLorentzVector>(unpackedP4());
     auto p4c = std::make_unique<LorentzVector>( *p4 );
     PolarLorentzVector* expectp4= nullptr;
     if( p4_.compare_exchange_strong(expectp4,p4.get()) ) {
@@ -111,13 +115,21 @@ void pat::PackedCandidate::unpackCovariance() const {
     }
 }
 
+float pat::PackedCandidate::unpackedDxy() const {
+    return MiniFloatConverter::float16to32(packedDxy_)/100.;
+}
+
+float pat::PackedCandidate::unpackedDz() const {
+    return vertexRef().isNonnull() ? MiniFloatConverter::float16to32(packedDz_)/100. : int16_t(packedDz_)*40.f/std::numeric_limits<int16_t>::max();
+}
+
 void pat::PackedCandidate::unpackVtx() const {
     reco::VertexRef pvRef = vertexRef();
     dphi_ = int16_t(packedDPhi_)*3.2f/std::numeric_limits<int16_t>::max(),
     deta_ = MiniFloatConverter::float16to32(packedDEta_);
     dtrkpt_ = MiniFloatConverter::float16to32(packedDTrkPt_);
-    dxy_ = MiniFloatConverter::float16to32(packedDxy_)/100.;
-    dz_   = pvRef.isNonnull() ? MiniFloatConverter::float16to32(packedDz_)/100. : int16_t(packedDz_)*40.f/std::numeric_limits<int16_t>::max();
+    dxy_ = unpackedDxy();
+    dz_ = unpackedDz();
     Point pv = pvRef.isNonnull() ? pvRef->position() : Point();
     float phi = p4_.load()->Phi()+dphi_, s = std::sin(phi), c = std::cos(phi);
     auto vertex = std::make_unique<Point>(pv.X() - dxy_ * s,
@@ -0,0 +1,35 @@
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
+
+void pat::PackedCandidateSoA::fill(const PackedCandidateCollection & cands) {
+    cands_ = &cands;
+    const unsigned int n = cands.size();
+    pt.resize(n); eta.resize(n); phi.resize(n); mass.resize(n);
+    cartesianPt.resize(n); cartesianEta.resize(n); cartesianPhi.resize(n);
+    dxy.resize(n); dz.resize(n);
+    pdgId.resize(n);
+
+    for (unsigned int i=0; i<n; ++i) {
+      auto const & c = cands[i];
+      // p4c_ is the guard of the unpacking, as in the accessors
+      const PackedCandidate::PolarLorentzVector p4 = c.p4c_.load() ? *c.p4_.load() : c.unpackedP4();
+      pt[i] = p4.Pt();
+      eta[i] = p4.Eta();
+      phi[i] = p4.Phi();
+      mass[i] = p4.M();
+      // as p4(): converted from the polar one by unpack(), but set by hand for some candidates
+      const PackedCandidate::LorentzVector p4c = c.p4c_.load() ? *c.p4c_.load() : PackedCandidate::LorentzVector(p4);
+      cartesianPt[i] = p4c.Pt();
+      cartesianEta[i] = p4c.Eta();
+      cartesianPhi[i] = p4c.Phi();
+
+      float dxyi, dzi;
+      if (c.vertex_.load()) { dxyi = c.dxy_; dzi = c.dz_; }
+      else { dxyi = c.unpackedDxy(); dzi = c.unpackedDz(); }
+      dxy[i] = dxyi;
+      // as dz(0): dz is stored with respect to the associated PV
+      const reco::VertexRef pvRef = c.vertexRef();
+      dz[i] = pvRef.isNonnull() ? dzi + pvRef->position().z() - (*c.pvRefProd_)[0].position().z() : dzi;
+
+      pdgId[i] = c.pdgId();
+    }
+}
@@ -5,6 +5,7 @@
 #include <iomanip>
 
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
 
 class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testPackedCandidate);
@@ -15,6 +16,7 @@ class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST(testSimulateReadFromRoot);
   CPPUNIT_TEST(testPackUnpackTime);
   CPPUNIT_TEST(testQualityFlags);
+  CPPUNIT_TEST(testSoA);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -28,6 +30,7 @@ public:
 
   void testPackUnpackTime();
   void testQualityFlags();
+  void testSoA();
 
 private:
 };
@@ -318,3 +321,41 @@ void testPackedCandidate::testQualityFlags() {
 	      
 	      
 	    
+
+void testPackedCandidate::testSoA() {
+  pat::PackedCandidateCollection cands;
+  for (int i=0; i<50; ++i) {
+    double pt = 0.3+0.37*i, phi = -3.1+0.125*i, eta = -2.4+0.1*i;
+    pat::PackedCandidate::PolarLorentzVector plv(pt, eta, phi, 0.14);
+    pat::PackedCandidate::Point v(0.001*i,-0.002*i,0.1*(i%7));
+    cands.emplace_back(plv, v, pt+0.1, eta-0.01, phi, 211, reco::VertexRefProd(), reco::VertexRef().key());
+  }
+  //some from a cartesian p4, which is kept as it is by the unpacked ones
+  for (int i=0; i<10; ++i) {
+    pat::PackedCandidate::LorentzVector lv(0.7*i-3.1, 1.3-0.4*i, 2.1*i-9.7, 25.);
+    pat::PackedCandidate::Point v(0.,0.,0.2*i);
+    cands.emplace_back(lv, v, lv.pt(), lv.eta(), lv.phi(), 22, reco::VertexRefProd(), reco::VertexRef().key());
+  }
+  //one candidate out of two as read back from ROOT, the others already unpacked
+  for (unsigned int i=0; i<cands.size(); i+=2) {
+    delete cands[i].p4_.exchange(nullptr);
+    delete cands[i].p4c_.exchange(nullptr);
+    delete cands[i].vertex_.exchange(nullptr);
+  }
+
+  pat::PackedCandidateSoA soa(cands);
+  CPPUNIT_ASSERT(soa.size() == cands.size());
+  for (unsigned int i=0; i<cands.size(); ++i) {
+    CPPUNIT_ASSERT(&soa.candidate(i) == &cands[i]);
+    CPPUNIT_ASSERT(soa.pt[i] == cands[i].pt());
+    CPPUNIT_ASSERT(soa.eta[i] == cands[i].eta());
+    CPPUNIT_ASSERT(soa.phi[i] == cands[i].phi());
+    CPPUNIT_ASSERT(soa.mass[i] == cands[i].mass());
+    CPPUNIT_ASSERT(soa.cartesianPt[i] == cands[i].p4().pt());
+    CPPUNIT_ASSERT(soa.cartesianEta[i] == cands[i].p4().eta());
+    CPPUNIT_ASSERT(soa.cartesianPhi[i] == cands[i].p4().phi());
+    CPPUNIT_ASSERT(soa.dxy[i] == cands[i].dxy());
+    CPPUNIT_ASSERT(soa.dz[i] == cands[i].dzAssociatedPV());
+    CPPUNIT_ASSERT(soa.pdgId[i] == cands[i].pdgId());
+  }
+}
@@ -0,0 +1,58 @@
+#ifndef DataFormats_TauReco_PFTauDiscriminatorContainer_h
+#define DataFormats_TauReco_PFTauDiscriminatorContainer_h
+
+/* class PFTauDiscriminatorContainer
+ *
+ * The results of several discriminators for the taus of one PFTau
+ * collection, stored in one product: one column of values per
+ * discriminator, in the order of the taus, and the names of the
+ * discriminators.
+ *
+ * discriminator(i) gives the column i as a PFTauDiscriminator, for the
+ * code that expects one product per discriminator.
+ */
+
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+
+#include <string>
+#include <vector>
+
+namespace reco {
+
+  class PFTauDiscriminatorContainer {
+  public:
+    PFTauDiscriminatorContainer() : nTaus_(0) {}
+    // all the values are 0
+    PFTauDiscriminatorContainer(const PFTauRefProd& taus, unsigned int nTaus, const std::vector<std::string>& names);
+
+    const PFTauRefProd& keyProduct() const { return taus_; }
+    // number of taus
+    unsigned int size() const { return nTaus_; }
+    unsigned int nDiscriminators() const { return names_.size(); }
+    const std::vector<std::string>& names() const { return names_; }
+    const std::string& name(unsigned int iDisc) const { return names_[iDisc]; }
+    // index of the discriminator with this name, -1 if there is none
+    int index(const std::string& name) const;
+
+    float value(unsigned int iDisc, unsigned int iTau) const { return values_[iDisc*nTaus_+iTau]; }
+    // throws if the tau is not from the key collection
+    float value(unsigned int iDisc, const PFTauRef& tau) const;
+    void setValue(unsigned int iDisc, unsigned int iTau, float value) { values_[iDisc*nTaus_+iTau] = value; }
+    // the nTaus values of a discriminator
+    const float* column(unsigned int iDisc) const { return values_.data()+iDisc*nTaus_; }
+    float* column(unsigned int iDisc) { return values_.data()+iDisc*nTaus_; }
+
+    // copy of the values of a discriminator
+    PFTauDiscriminator discriminator(unsigned int iDisc) const;
+
+  private:
+    PFTauRefProd taus_;
+    unsigned int nTaus_;
+    std::vector<std::string> names_;
+    // by discriminator, then by tau
+    std::vector<float> values_;
+  };
+
+}
+#endif
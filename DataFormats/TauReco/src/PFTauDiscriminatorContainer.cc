@@ -0,0 +1,40 @@
+#include "DataFormats/TauReco/interface/PFTauDiscriminatorContainer.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <algorithm>
+
+using namespace reco;
+
+PFTauDiscriminatorContainer::PFTauDiscriminatorContainer(const PFTauRefProd& taus, unsigned int nTaus,
+                                                         const std::vector<std::string>& names)
+  : taus_(taus),
+    nTaus_(nTaus),
+    names_(names),
+    values_(names.size()*nTaus, 0.f)
+{}
+
+int PFTauDiscriminatorContainer::index(const std::string& name) const
+{
+  auto it = std::find(names_.begin(), names_.end(), name);
+  return it != names_.end() ? it-names_.begin() : -1;
+}
+
+float PFTauDiscriminatorContainer::value(unsigned int iDisc, const PFTauRef& tau) const
+{
+  if ( tau.id() != taus_.id() ) {
+    throw edm::Exception(edm::errors::InvalidReference)
+      << "PFTauDiscriminatorContainer: the tau of product ID " << tau.id()
+      << " is not from the collection of product ID " << taus_.id() << " of the discriminators.\n";
+  }
+  return value(iDisc, tau.key());
+}
+
+PFTauDiscriminator PFTauDiscriminatorContainer::discriminator(unsigned int iDisc) const
+{
+  PFTauDiscriminator result(taus_);
+  const float* values = column(iDisc);
+  for ( unsigned int iTau = 0; iTau < nTaus_; ++iTau ) {
+    result.setValue(iTau, values[iTau]);
+  }
+  return result;
+}
@@ -14,6 +14,7 @@
 #include "DataFormats/TauReco/interface/CaloTauDiscriminatorAgainstElectron.h"
 #include "DataFormats/TauReco/interface/PFTauDiscriminatorByIsolation.h"
 #include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminatorContainer.h"
 #include "DataFormats/Common/interface/AssociationMap.h"
 #include "DataFormats/Common/interface/Association.h"
 #include "DataFormats/Common/interface/Ptr.h"
@@ -72,6 +73,9 @@ namespace DataFormats_TauReco {
     std::pair<reco::PFTauRef, float>                              pftdiscr_p;
     std::vector<std::pair<reco::PFTauRef, float> >                pftdiscr_v;
 
+    reco::PFTauDiscriminatorContainer                pftdiscrc_o;
+    edm::Wrapper<reco::PFTauDiscriminatorContainer>  pftdiscrc_w;
+
     reco::JetPiZeroAssociationBase                     jetPiZeroAssoc_b;
     reco::JetPiZeroAssociation                         jetPiZeroAssoc_o;
     reco::JetPiZeroAssociationRef                      jetPiZeroAssoc_r;
@@ -59,6 +59,9 @@ namespace edm {
     unsigned int const& maxFileSize() const {return maxFileSize_;}
     int const& inputFileCount() const {return inputFileCount_;}
     int const& whyNotFastClonable() const {return whyNotFastClonable_;}
+    bool concurrentCompression() const {return concurrentCompression_;}
+    unsigned int numberOfStreamGroups() const {return numberOfStreamGroups_;}
+    unsigned int streamGroup() const {return streamGroup_;}
 
     std::string const& currentFileName() const;
 
@@ -86,7 +89,7 @@ namespace edm {
 
       OutputItem();
 
-      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize);
+      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compressionSettings);
 
       ~OutputItem() {}
 
@@ -102,6 +105,7 @@ namespace edm {
       mutable void const* product_;
       int splitLevel_;
       int basketSize_;
+      int compressionSettings_; // ROOT compression settings, or -1 to use those of the file
     };
 
     typedef std::vector<OutputItem> OutputItemList;
@@ -114,11 +118,22 @@ namespace edm {
       splitLevel_(iSplitLevel < 1? 1: iSplitLevel) //minimum is 1
       {}
       bool match(std::string const& iBranchName) const;
-      std::regex convert(std::string const& iGlobBranchExpression )const;
+      static std::regex convert(std::string const& iGlobBranchExpression);
       
       std::regex branch_;
       int splitLevel_;
     };
+
+    struct SpecialCompressionForBranch {
+      SpecialCompressionForBranch(std::string const& iBranchName, std::string const& iAlgorithm, int iLevel);
+      bool match(std::string const& iBranchName) const;
+
+      std::regex branch_;
+      int compressionSettings_;
+    };
+
+    /// Throws if the algorithm name is not one of ZLIB, LZMA or LZ4.
+    static int compressionSettings(std::string const& algorithm, int level);
     
     OutputItemListArray const& selectedOutputItemList() const {return selectedOutputItemList_;}
 
@@ -150,6 +165,7 @@ namespace edm {
     void updateBranchParentsForOneBranch(ProductProvenanceRetriever const* provRetriever,
                                          BranchID const& branchID);
     void updateBranchParents(EventForOutput const& e);
+    bool inStreamGroup(EventForOutput const& e) const;
     void fillDependencyGraph();
 
     void startEndFile();
@@ -173,6 +189,7 @@ namespace edm {
     AuxItemArray auxItems_;
     OutputItemListArray selectedOutputItemList_;
     std::vector<SpecialSplitLevelForBranch> specialSplitLevelForBranches_;
+    std::vector<SpecialCompressionForBranch> specialCompressionForBranches_;
     std::string const fileName_;
     std::string const logicalFileName_;
     std::string const catalog_;
@@ -196,6 +213,9 @@ namespace edm {
     BranchChildren branchChildren_;
     std::vector<BranchID> producedBranches_;
     bool overrideInputFileSplitLevels_;
+    bool const concurrentCompression_;
+    unsigned int const numberOfStreamGroups_;
+    unsigned int const streamGroup_;
     edm::propagate_const<std::unique_ptr<RootOutputFile>> rootOutputFile_;
     std::string statusFileName_;
     std::vector<std::string> processesWithSelectedMergeableRunProducts_;
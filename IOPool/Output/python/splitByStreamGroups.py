@@ -0,0 +1,49 @@
+import FWCore.ParameterSet.Config as cms
+
+def _fileNameForGroup(fileName, group):
+    suffix = ".root"
+    if fileName.endswith(suffix):
+        return "%s_streamGroup%d%s" % (fileName[:-len(suffix)], group, suffix)
+    return "%s_streamGroup%d" % (fileName, group)
+
+def splitOutputModuleByStreamGroups(process, label, numberOfGroups):
+    """Replaces the PoolOutputModule 'label' by 'numberOfGroups' clones.
+
+    Each clone writes the events of the streams whose index modulo
+    'numberOfGroups' equals its stream group into its own file, so the
+    files are written concurrently. Runs and lumis are written to every
+    file. Each file is reported in the job report, and the set can be
+    read back as one dataset by listing all files in a PoolSource (or
+    merged with a PoolSource -> PoolOutputModule job).
+
+    Returns the list of new module labels.
+    """
+    original = getattr(process, label)
+    if original.type_() != "PoolOutputModule":
+        raise ValueError("module '%s' is a %s, not a PoolOutputModule" % (label, original.type_()))
+    if numberOfGroups < 2:
+        return [label]
+
+    fileName = original.fileName.value()
+    logicalFileName = original.logicalFileName.value() if hasattr(original, "logicalFileName") else ""
+    labels = []
+    for group in range(numberOfGroups):
+        clone = original.clone(
+            fileName = cms.untracked.string(_fileNameForGroup(fileName, group)),
+            numberOfStreamGroups = cms.untracked.uint32(numberOfGroups),
+            streamGroup = cms.untracked.uint32(group)
+        )
+        if logicalFileName:
+            clone.logicalFileName = cms.untracked.string(_fileNameForGroup(logicalFileName, group))
+        cloneLabel = "%sStreamGroup%d" % (label, group)
+        setattr(process, cloneLabel, clone)
+        labels.append(cloneLabel)
+
+    # Put the clones wherever the original was scheduled.
+    for endPathLabel, endPath in process.endpaths_().items():
+        if endPath.contains(original):
+            for cloneLabel in labels:
+                endPath.insert(endPath.index(original), getattr(process, cloneLabel))
+            endPath.remove(original)
+    delattr(process, label)
+    return labels
@@ -26,6 +26,7 @@
 #include "TBranchElement.h"
 #include "TObjArray.h"
 #include "RVersion.h"
+#include "Compression.h"
 
 #include <fstream>
 #include <iomanip>
@@ -62,6 +63,9 @@ namespace edm {
     branchParents_(),
     branchChildren_(),
     overrideInputFileSplitLevels_(pset.getUntrackedParameter<bool>("overrideInputFileSplitLevels")),
+    concurrentCompression_(pset.getUntrackedParameter<bool>("concurrentCompression")),
+    numberOfStreamGroups_(pset.getUntrackedParameter<unsigned int>("numberOfStreamGroups")),
+    streamGroup_(pset.getUntrackedParameter<unsigned int>("streamGroup")),
     rootOutputFile_(),
     statusFileName_() {
 
@@ -83,7 +87,13 @@ namespace edm {
             << "Legal values are 'NONE', 'DROPPED', 'PRIOR', and 'ALL'.\n";
       }
 
-    if (!wantAllEvents()) {
+    if(numberOfStreamGroups_ == 0U || streamGroup_ >= numberOfStreamGroups_) {
+      throw edm::Exception(errors::Configuration, "Illegal streamGroup parameter value: ")
+          << streamGroup_ << ".\n"
+          << "It must be smaller than numberOfStreamGroups (" << numberOfStreamGroups_ << ").\n";
+    }
+
+    if (!wantAllEvents() || numberOfStreamGroups_ > 1U) {
       whyNotFastClonable_+= FileBlock::EventSelectionUsed;
     }
 
@@ -94,6 +104,15 @@ namespace edm {
       specialSplitLevelForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
                                                  s.getUntrackedParameter<int>("splitLevel"));
     }
+
+    auto const& specialCompression {pset.getUntrackedParameterSetVector("overrideBranchesCompression")};
+
+    specialCompressionForBranches_.reserve(specialCompression.size());
+    for(auto const& s: specialCompression) {
+      specialCompressionForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
+                                                  s.getUntrackedParameter<std::string>("compressionAlgorithm"),
+                                                  s.getUntrackedParameter<int>("compressionLevel"));
+    }
       
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
@@ -123,14 +142,16 @@ namespace edm {
         token_(),
         product_(nullptr),
         splitLevel_(BranchDescription::invalidSplitLevel),
-        basketSize_(BranchDescription::invalidBasketSize) {}
+        basketSize_(BranchDescription::invalidBasketSize),
+        compressionSettings_(-1) {}
 
-  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize) :
+  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compressionSettings) :
         branchDescription_(bd),
         token_(token),
         product_(nullptr),
         splitLevel_(splitLevel),
-        basketSize_(basketSize) {}
+        basketSize_(basketSize),
+        compressionSettings_(compressionSettings) {}
 
 
   PoolOutputModule::OutputItem::Sorter::Sorter(TTree* tree) : treeMap_(new std::map<std::string, int>) {
@@ -169,12 +190,34 @@ namespace edm {
     return std::regex_match(iBranchName,branch_);
   }
 
-  std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert( std::string const& iGlobBranchExpression) const {
+  std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert( std::string const& iGlobBranchExpression) {
     std::string tmp(iGlobBranchExpression);
     boost::replace_all(tmp, "*", ".*");
     boost::replace_all(tmp, "?", ".");
     return std::regex(tmp);
   }
+
+  PoolOutputModule::SpecialCompressionForBranch::SpecialCompressionForBranch(std::string const& iBranchName,
+                                                                             std::string const& iAlgorithm,
+                                                                             int iLevel) :
+      branch_(SpecialSplitLevelForBranch::convert(iBranchName)),
+      compressionSettings_(PoolOutputModule::compressionSettings(iAlgorithm, iLevel)) {}
+
+  inline bool PoolOutputModule::SpecialCompressionForBranch::match( std::string const& iBranchName) const {
+    return std::regex_match(iBranchName,branch_);
+  }
+
+  int PoolOutputModule::compressionSettings(std::string const& algorithm, int level) {
+    if(algorithm == std::string("ZLIB")) {
+      return ROOT::CompressionSettings(ROOT::kZLIB, level);
+    } else if(algorithm == std::string("LZMA")) {
+      return ROOT::CompressionSettings(ROOT::kLZMA, level);
+    } else if(algorithm == std::string("LZ4")) {
+      return ROOT::CompressionSettings(ROOT::kLZ4, level);
+    }
+    throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << algorithm << "'\n"
+                                           << "Allowed compression algorithms are ZLIB, LZMA and LZ4\n";
+  }
   
   void PoolOutputModule::fillSelectedItemList(BranchType branchType, TTree* theInputTree) {
 
@@ -214,7 +257,17 @@ namespace edm {
         }
         basketSize = (prod.basketSize() == BranchDescription::invalidBasketSize ? basketSize_ : prod.basketSize());
       }
-      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize);
+      int compressionSettings = -1;
+      for(auto const& b: specialCompressionForBranches_) {
+        if(b.match(prod.branchName())) {
+          compressionSettings = b.compressionSettings_;
+        }
+      }
+      // Fast cloning would copy the baskets with their input compression.
+      if(compressionSettings != -1 && !prod.produced()) {
+        whyNotFastClonable_ |= FileBlock::SplitLevelMismatch;
+      }
+      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize, compressionSettings);
     }
 
     // Sort outputItemList to allow fast copying.
@@ -269,7 +322,13 @@ namespace edm {
   PoolOutputModule::~PoolOutputModule() {
   }
 
+  bool PoolOutputModule::inStreamGroup(EventForOutput const& e) const {
+    return e.streamID().value() % numberOfStreamGroups_ == streamGroup_;
+  }
+
   void PoolOutputModule::write(EventForOutput const& e) {
+    // Events processed by streams of other groups are written by the sibling modules.
+    if(!inStreamGroup(e)) return;
     updateBranchParents(e);
     rootOutputFile_->writeOne(e);
       if (!statusFileName_.empty()) {
@@ -446,7 +505,7 @@ namespace edm {
     desc.addUntracked<int>("compressionLevel", 9)
         ->setComment("ROOT compression level of output file.");
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB, LZMA and LZ4");
     desc.addUntracked<int>("basketSize", 16384)
         ->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize",20*1024*1024)
@@ -464,6 +523,15 @@ namespace edm {
     desc.addUntracked<bool>("overrideInputFileSplitLevels", false)
         ->setComment("False: Use branch split levels and basket sizes from input file, if possible.\n"
                      "True:  Always use specified or default split levels and basket sizes.");
+    desc.addUntracked<bool>("concurrentCompression", true)
+        ->setComment("True:  Compress output baskets concurrently in the TBB thread pool (requires ROOT implicit multi-threading, see InitRootHandlers.EnableIMT).\n"
+                     "False: Compress baskets serially in the output module. The file contents are then independent of the number of threads.");
+    desc.addUntracked<unsigned int>("numberOfStreamGroups", 1U)
+        ->setComment("Number of output modules sharing the events of this job, each writing its own file.\n"
+                     "Stream i is written by the module with 'streamGroup' equal to i modulo this number.\n"
+                     "Use IOPool.Output.splitByStreamGroups to create the modules.");
+    desc.addUntracked<unsigned int>("streamGroup", 0U)
+        ->setComment("Index of the stream group written by this module. Must be smaller than 'numberOfStreamGroups'.");
     desc.addUntracked<bool>("writeStatusFile", false)
         ->setComment("Write a status file. Intended for use by workflow management.");
     desc.addUntracked<std::string>("dropMetaData", defaultString)
@@ -484,6 +552,15 @@ namespace edm {
       specialSplit.addUntracked<int>("splitLevel")->setComment("The special split level for the branch");
       desc.addVPSetUntracked("overrideBranchesSplitLevel",specialSplit, std::vector<ParameterSet>());
     }
+    {
+      ParameterSetDescription specialCompression;
+      specialCompression.addUntracked<std::string>("branch")->setComment("Name of branch needing a special compression. The name can contain wildcards '*' and '?'. If several entries match a branch, the last one is used.");
+      specialCompression.addUntracked<std::string>("compressionAlgorithm")->setComment("Compression algorithm for the branch, allowed values are ZLIB, LZMA and LZ4");
+      specialCompression.addUntracked<int>("compressionLevel")->setComment("Compression level for the branch");
+      desc.addVPSetUntracked("overrideBranchesCompression",specialCompression, std::vector<ParameterSet>())
+        ->setComment("Per branch compression. Branches read from the input file that match an entry are not fast cloned.\n"
+                     "The edmBranchCompression tool measures candidate settings on an existing file.");
+    }
     OutputModule::fillDescription(desc);
   }
 
@@ -119,9 +119,11 @@ namespace edm {
       filePtr_->SetCompressionAlgorithm(ROOT::kZLIB);
     } else if (om_->compressionAlgorithm() == std::string("LZMA")) {
       filePtr_->SetCompressionAlgorithm(ROOT::kLZMA);
+    } else if (om_->compressionAlgorithm() == std::string("LZ4")) {
+      filePtr_->SetCompressionAlgorithm(ROOT::kLZ4);
     } else {
       throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << om_->compressionAlgorithm() << "'\n"
-					     << "Allowed compression algorithms are ZLIB and LZMA\n";
+					     << "Allowed compression algorithms are ZLIB, LZMA and LZ4\n";
     }
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1*om->eventAutoFlushSize());
@@ -145,6 +147,10 @@ namespace edm {
     treePointers_[InLumi]  = &lumiTree_;
     treePointers_[InRun]   = &runTree_;
 
+    for(auto& theTree : treePointers_) {
+      theTree->setImplicitMT(om_->concurrentCompression());
+    }
+
     for(int i = InEvent; i < NumBranchTypes; ++i) {
       BranchType branchType = static_cast<BranchType>(i);
       RootOutputTree *theTree = treePointers_[branchType];
@@ -156,6 +162,7 @@ namespace edm {
                            item.product_,
                            item.splitLevel_,
                            item.basketSize_,
+                           item.compressionSettings_,
                            item.branchDescription_->produced());
         //make sure we always store product registry info for all branches we create
         branchesWithStoredHistory_.insert(item.branchID());
@@ -285,7 +292,7 @@ namespace edm {
         isWarning = false;
       }
       if((whyNotFastClonable & FileBlock::SplitLevelMismatch) != 0) {
-        message << "the split level or basket size of a branch or branches was modified.\n";
+        message << "the split level, basket size or compression of a branch or branches was modified.\n";
         whyNotFastClonable &= ~(FileBlock::SplitLevelMismatch);
       }
       if((whyNotFastClonable & FileBlock::BranchMismatch) != 0) {
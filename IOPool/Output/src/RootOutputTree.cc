@@ -333,6 +333,7 @@ namespace edm {
                             void const*& pProd,
                             int splitLevel,
                             int basketSize,
+                            int compressionSettings,
                             bool produced) {
       assert(splitLevel != BranchDescription::invalidSplitLevel);
       assert(basketSize != BranchDescription::invalidBasketSize);
@@ -342,6 +343,10 @@ namespace edm {
                  basketSize,
                  splitLevel);
       assert(branch != nullptr);
+      if(compressionSettings != -1) {
+        // Also applies to all sub-branches.
+        branch->SetCompressionSettings(compressionSettings);
+      }
 /*
       if(pProd != nullptr) {
         // Delete the product that ROOT has allocated.
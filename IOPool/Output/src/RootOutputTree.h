@@ -68,6 +68,7 @@ namespace edm {
                    void const*& pProd,
                    int splitLevel,
                    int basketSize,
+                   int compressionSettings,
                    bool produced);
 
     bool checkSplitLevelsAndBasketSizes(TTree* inputTree) const;
@@ -108,6 +109,12 @@ namespace edm {
     void setAutoFlush(Long64_t size) {
       tree_->SetAutoFlush(size);
     }
+
+    // When ROOT implicit multi-threading is enabled, TTree::Fill and
+    // TTree::FlushBaskets hand full baskets to the TBB pool for compression.
+    void setImplicitMT(bool enabled) {
+      tree_->SetImplicitMT(enabled);
+    }
   private:
     static void fillTTree(std::vector<TBranch*> const& branches);
 // We use bare pointers for pointers to some ROOT entities.
@@ -0,0 +1,41 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTBRANCHCOMPRESSION")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(20)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+# checkBranchCompression.py expects these settings: keep them in sync
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputBranchCompressionTest.root'),
+    compressionAlgorithm = cms.untracked.string('ZLIB'),
+    compressionLevel = cms.untracked.int32(7),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.untracked.PSet(
+            branch = cms.untracked.string('edmtestThings_Thing__*'),
+            compressionAlgorithm = cms.untracked.string('LZMA'),
+            compressionLevel = cms.untracked.int32(4)
+        ),
+        # the last matching entry wins
+        cms.untracked.PSet(
+            branch = cms.untracked.string('edmtestOtherThings_*'),
+            compressionAlgorithm = cms.untracked.string('LZMA'),
+            compressionLevel = cms.untracked.int32(9)
+        ),
+        cms.untracked.PSet(
+            branch = cms.untracked.string('edmtestOtherThings_OtherThing_testUserTag_*'),
+            compressionAlgorithm = cms.untracked.string('LZ4'),
+            compressionLevel = cms.untracked.int32(3)
+        )
+    )
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
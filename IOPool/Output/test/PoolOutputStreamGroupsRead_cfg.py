@@ -0,0 +1,20 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUTREAD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolOutputStreamGroupsTest_streamGroup0.root',
+                                      'file:PoolOutputStreamGroupsTest_streamGroup1.root')
+)
+
+# every one of the 40 events of PoolOutputStreamGroupsTest_cfg.py (10 per lumi)
+# must be in exactly one of the two files
+process.check = cms.EDAnalyzer("StreamGroupEventsChecker",
+    expectedEvents = cms.untracked.VEventID(*[cms.EventID(1, (i-1)//10+1, i) for i in range(1, 41)])
+)
+
+process.e = cms.EndPath(process.check)
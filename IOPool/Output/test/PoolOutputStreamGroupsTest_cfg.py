@@ -0,0 +1,30 @@
+import FWCore.ParameterSet.Config as cms
+from IOPool.Output.splitByStreamGroups import splitOutputModuleByStreamGroups
+
+process = cms.Process("TESTOUTPUT")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(4)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(40)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputStreamGroupsTest.root')
+)
+
+process.source = cms.Source("EmptySource",
+    numberEventsInLuminosityBlock = cms.untracked.uint32(10)
+)
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
+
+splitOutputModuleByStreamGroups(process, "output", 2)
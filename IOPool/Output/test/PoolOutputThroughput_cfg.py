@@ -0,0 +1,40 @@
+# Measures PoolOutputModule throughput.  Usage:
+#   cmsRun PoolOutputThroughput_cfg.py <nThreads> <compressionAlgorithm> <concurrentCompression>
+# See runPoolOutputThroughput.sh for a scan over the number of threads.
+import FWCore.ParameterSet.Config as cms
+import sys
+
+nThreads = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+algorithm = sys.argv[3] if len(sys.argv) > 3 else "LZMA"
+concurrent = (sys.argv[4] != "False") if len(sys.argv) > 4 else True
+
+process = cms.Process("THROUGHPUT")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nThreads),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(2000)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.ints = cms.EDProducer("IntVectorProducer",
+    ivalue = cms.int32(11),
+    count = cms.int32(20000),
+    delta = cms.int32(7)
+)
+process.moreInts = process.ints.clone(ivalue = 13, delta = 3)
+process.things = cms.EDProducer("ThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputThroughput.root'),
+    compressionAlgorithm = cms.untracked.string(algorithm),
+    compressionLevel = cms.untracked.int32(4),
+    concurrentCompression = cms.untracked.bool(concurrent)
+)
+
+process.p = cms.Path(process.ints + process.moreInts + process.things)
+process.ep = cms.EndPath(process.output)
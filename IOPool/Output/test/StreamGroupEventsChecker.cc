@@ -0,0 +1,77 @@
+// -*- C++ -*-
+//
+// Package:    IOPool/Output
+// Class:      StreamGroupEventsChecker
+//
+/**\class StreamGroupEventsChecker
+
+ Description: Checks that each of the configured events is read exactly once,
+ in any order. The events written to the files of the stream groups of an output
+ module depend on the scheduling of the streams, so only the set of events read
+ back from all the files can be compared with the events that were processed.
+*/
+
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <vector>
+
+class StreamGroupEventsChecker : public edm::one::EDAnalyzer<> {
+public:
+  explicit StreamGroupEventsChecker(edm::ParameterSet const&);
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void analyze(edm::Event const&, edm::EventSetup const&) override;
+  void endJob() override;
+
+  // run and event number, the luminosity block is not compared
+  static bool sameEvent(edm::EventID const& a, edm::EventID const& b) {
+    return a.run() == b.run() && a.event() == b.event();
+  }
+
+  std::vector<edm::EventID> expected_;
+  std::vector<unsigned int> seen_;
+};
+
+StreamGroupEventsChecker::StreamGroupEventsChecker(edm::ParameterSet const& iConfig) :
+  expected_(iConfig.getUntrackedParameter<std::vector<edm::EventID> >("expectedEvents")),
+  seen_(expected_.size(), 0)
+{}
+
+void
+StreamGroupEventsChecker::analyze(edm::Event const& iEvent, edm::EventSetup const&) {
+  auto it = std::find_if(expected_.begin(), expected_.end(),
+                         [&iEvent](edm::EventID const& id) { return sameEvent(id, iEvent.id()); });
+  if(it == expected_.end()) {
+    throw cms::Exception("UnexpectedEvent") << "The event " << iEvent.id() << " is not in the list of expected events.\n";
+  }
+  if(++seen_[it-expected_.begin()] > 1) {
+    throw cms::Exception("DuplicatedEvent") << "The event " << iEvent.id() << " was read more than once.\n";
+  }
+}
+
+void
+StreamGroupEventsChecker::endJob() {
+  for(unsigned int i = 0; i < expected_.size(); ++i) {
+    if(seen_[i] == 0) {
+      throw cms::Exception("MissedEvent") << "The event " << expected_[i] << " was not read.\n";
+    }
+  }
+}
+
+void
+StreamGroupEventsChecker::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<std::vector<edm::EventID> >("expectedEvents");
+  descriptions.add("streamGroupEventsChecker", desc);
+}
+
+DEFINE_FWK_MODULE(StreamGroupEventsChecker);
@@ -33,4 +33,19 @@ cmsRun ${LOCAL_TEST_DIR}/TestProvC_cfg.py || die 'Failure using TestProvC_cfg.py
 cmsRun ${LOCAL_TEST_DIR}/PoolOutputTestUnscheduled_cfg.py || die 'Failure using PoolOutputTestUnscheduled_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/PoolOutputTestUnscheduledRead_cfg.py || die 'Failure using PoolOutputTestUnscheduledRead_cfg.py' $?
 
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputStreamGroupsTest_cfg.py || die 'Failure using PoolOutputStreamGroupsTest_cfg.py' $?
+#reads the files from above
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputStreamGroupsRead_cfg.py || die 'Failure using PoolOutputStreamGroupsRead_cfg.py' $?
+
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputBranchCompressionTest_cfg.py || die 'Failure using PoolOutputBranchCompressionTest_cfg.py' $?
+#checks the file from above
+python ${LOCAL_TEST_DIR}/checkBranchCompression.py PoolOutputBranchCompressionTest.root || die 'Failure using checkBranchCompression.py' $?
+#measures the file from above with the edmBranchCompression tool
+edmBranchCompression -s ZLIB:1 -s LZMA:9 -s LZ4:4 -o branchCompression.txt -c branchCompression_cff.py PoolOutputBranchCompressionTest.root || die 'Failure using edmBranchCompression' $?
+python ${LOCAL_TEST_DIR}/checkEdmBranchCompressionReport.py PoolOutputBranchCompressionTest.root branchCompression.txt branchCompression_cff.py 0 ZLIB:1 LZMA:9 LZ4:4 || die 'Failure checking the report of edmBranchCompression' $?
+edmBranchCompression -s ZLIB:1 -s LZMA:9 -s LZ4:4 -m 2 -o branchCompressionSlowdown.txt -c branchCompressionSlowdown_cff.py PoolOutputBranchCompressionTest.root || die 'Failure using edmBranchCompression -m 2' $?
+python ${LOCAL_TEST_DIR}/checkEdmBranchCompressionReport.py PoolOutputBranchCompressionTest.root branchCompressionSlowdown.txt branchCompressionSlowdown_cff.py 2 ZLIB:1 LZMA:9 LZ4:4 || die 'Failure checking the report of edmBranchCompression -m 2' $?
+edmBranchCompression -s ZLIB:1 -s BZIP:5 PoolOutputBranchCompressionTest.root && die 'edmBranchCompression accepted an unknown algorithm' 1
+edmBranchCompression doesNotExist.root && die 'edmBranchCompression accepted a missing file' 1
+
 popd
@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# Checks the compression settings of the branches of the Events tree of the
+# file written by PoolOutputBranchCompressionTest_cfg.py: the branches that match
+# an entry of overrideBranchesCompression, and all their sub-branches, have the
+# settings of the last matching entry, the others those of the file.
+from __future__ import print_function
+import sys
+import ROOT
+
+fileName = sys.argv[1] if len(sys.argv) > 1 else "PoolOutputBranchCompressionTest.root"
+
+# ROOT compression settings are 100*algorithm + level, with ZLIB=1, LZMA=2, LZ4=4
+fileSettings = 107
+branchSettings = [("edmtestThings_Thing__", 204),
+                  ("edmtestOtherThings_OtherThing__", 209),
+                  ("edmtestOtherThings_OtherThing_testUserTag_", 403)]
+
+def expected(name):
+    for prefix, settings in branchSettings:
+        if name.startswith(prefix):
+            return settings
+    return fileSettings
+
+def check(branch, settings, errors):
+    if branch.GetCompressionSettings() != settings:
+        errors.append("%s: compression settings %d, expected %d" % (branch.GetName(), branch.GetCompressionSettings(), settings))
+    for sub in branch.GetListOfBranches():
+        check(sub, settings, errors)
+
+f = ROOT.TFile.Open(fileName)
+if not f or f.IsZombie():
+    print("cannot open", fileName)
+    sys.exit(1)
+if f.GetCompressionSettings() != fileSettings:
+    print("file compression settings %d, expected %d" % (f.GetCompressionSettings(), fileSettings))
+    sys.exit(1)
+
+events = f.Get("Events")
+errors = []
+found = set()
+for branch in events.GetListOfBranches():
+    name = branch.GetName()
+    for prefix, settings in branchSettings:
+        if name.startswith(prefix):
+            found.add(prefix)
+    check(branch, expected(name), errors)
+for prefix, settings in branchSettings:
+    if prefix not in found:
+        errors.append("no branch %s*" % prefix)
+
+for e in errors:
+    print(e)
+sys.exit(1 if errors else 0)
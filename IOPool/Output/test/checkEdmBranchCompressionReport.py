@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# Checks the report of edmBranchCompression on the file written by
+# PoolOutputBranchCompressionTest_cfg.py, run with the settings given here:
+# one row per branch of the Events tree, sorted by decreasing uncompressed size,
+# sizes and times consistent with each other, the suggestion within the allowed
+# slowdown, and the same suggestions in the configuration fragment.
+#
+# Usage: checkEdmBranchCompressionReport.py <root file> <report> <configuration> <max slowdown or 0> SETTING...
+from __future__ import print_function
+import sys
+import ROOT
+import FWCore.ParameterSet.Config as cms
+
+fileName, reportName, configName, maxSlowdown = sys.argv[1:5]
+maxSlowdown = float(maxSlowdown)
+settings = sys.argv[5:]
+nEvents = 20
+
+errors = []
+def check(condition, message):
+    if not condition:
+        errors.append(message)
+
+f = ROOT.TFile.Open(fileName)
+events = f.Get("Events")
+branchNames = set(b.GetName() for b in events.GetListOfBranches())
+
+lines = [l for l in open(reportName).read().splitlines() if l.strip()]
+check(lines[0].split()[-2:] == ["Events", str(nEvents)], "header: " + lines[0])
+for s in settings:
+    check(s.replace(":", "-") + " Size (Bytes/Event)" in lines[1], "no column for %s in: %s" % (s, lines[1]))
+
+rows = {}
+previous = None
+for line in lines[2:]:
+    fields = line.split()
+    if len(fields) != 3 + 2 * len(settings):
+        errors.append("wrong number of fields: " + line)
+        continue
+    name = fields[0]
+    uncompressed = float(fields[1])
+    sizes = [float(x) for x in fields[2:-1:2]]
+    times = [float(x) for x in fields[3:-1:2]]
+    suggested = fields[-1].replace("-", ":")
+    rows[name] = suggested
+    if previous is not None:
+        check(uncompressed <= previous, "%s: not sorted by uncompressed size" % name)
+    previous = uncompressed
+    # the chunks that do not shrink are counted uncompressed
+    check(all(0 <= s <= uncompressed for s in sizes), "%s: compressed sizes %s for %g uncompressed" % (name, sizes, uncompressed))
+    check(all(t >= 0 for t in times), "%s: negative unzip time" % name)
+    check(suggested in settings, "%s: suggested %s is not a candidate" % (name, suggested))
+    if suggested not in settings:
+        continue
+    # the report rounds to 6 digits, so the settings at the time limit are not checked
+    limit = maxSlowdown * min(times) if maxSlowdown > 0 else float("inf")
+    allowed = [j for j in range(len(settings)) if times[j] < limit * (1 - 1e-5)]
+    i = settings.index(suggested)
+    check(times[i] <= limit * (1 + 1e-5), "%s: suggested %s decompresses too slowly" % (name, suggested))
+    check(all(sizes[i] <= sizes[j] for j in allowed), "%s: suggested %s is not the smallest allowed" % (name, suggested))
+
+check(set(rows) == branchNames, "branches in the report %s, in the file %s" % (sorted(rows), sorted(branchNames)))
+for prefix in ("edmtestThings_Thing__", "edmtestOtherThings_OtherThing__"):
+    check(any(n.startswith(prefix) for n in rows), "no branch %s* in the report" % prefix)
+
+config = {"cms": cms}
+exec(open(configName).read(), config)
+overrides = config["overrideBranchesCompression"]
+check(len(overrides) == len(rows), "%d branches in the configuration, %d in the report" % (len(overrides), len(rows)))
+for pset in overrides:
+    name = pset.branch.value()
+    setting = "%s:%d" % (pset.compressionAlgorithm.value(), pset.compressionLevel.value())
+    check(rows.get(name) == setting, "%s: %s in the configuration, %s in the report" % (name, setting, rows.get(name)))
+
+if errors:
+    print("\n".join(errors))
+    sys.exit(1)
+print("%d branches checked in %s" % (len(rows), reportName))
@@ -0,0 +1,19 @@
+#!/bin/bash
+# Prints PoolOutputModule events/s versus number of threads.
+# Not part of the unit tests, run by hand:
+#   runPoolOutputThroughput.sh [compressionAlgorithm] [concurrentCompression]
+function die { echo $1: status $2 ;  exit $2; }
+
+ALGORITHM=${1:-LZMA}
+CONCURRENT=${2:-True}
+CFG=${LOCAL_TEST_DIR:-$(dirname $0)}/PoolOutputThroughput_cfg.py
+NEVENTS=2000
+
+echo "algorithm=${ALGORITHM} concurrentCompression=${CONCURRENT}"
+echo "threads events/s"
+for nThreads in 1 2 4 8 16; do
+  start=$(date +%s.%N)
+  cmsRun ${CFG} ${nThreads} ${ALGORITHM} ${CONCURRENT} > /dev/null 2>&1 || die "Failure using PoolOutputThroughput_cfg.py with ${nThreads} threads" $?
+  end=$(date +%s.%N)
+  echo "${nThreads} $(echo "${NEVENTS} / (${end} - ${start})" | bc -l | xargs printf '%.1f')"
+done
@@ -0,0 +1,106 @@
+#ifndef IOPool_Streamer_StreamerFileIndex_h
+#define IOPool_Streamer_StreamerFileIndex_h
+
+/** StreamerFileIndex: optional sidecar index of a streamer file.
+
+    The index file (named after the streamer file with ".idx" appended)
+    stores, for every event of the streamer file, its ID, its offset and
+    size in the streamer file and its HLT trigger bits. Each quantity is
+    stored as one contiguous column, so that a reader can scan e.g. the
+    trigger bits of all events without touching the event payloads.
+
+    Layout (host byte order, every column padded to 8 bytes):
+      StreamerFileIndexHeader
+      uint64 event[nEvents]
+      uint64 offset[nEvents]
+      uint32 run[nEvents]
+      uint32 lumi[nEvents]
+      uint32 size[nEvents]
+      uint8  hltBits[nEvents][hltStride]   (same packing as EventMsgView::hltTriggerBits)
+*/
+
+#include "IOPool/Streamer/interface/MsgTools.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class EventMsgView;
+
+namespace edm {
+
+  struct StreamerFileIndexHeader {
+    char   magic_[8];
+    uint32 version_;
+    uint32 hltCount_;
+    uint64 nEvents_;
+    uint64 streamerFileSize_;
+    uint32 hltStride_;
+    uint32 reserved_;
+  };
+
+  /** Accumulates the columns while the streamer file is written */
+  class StreamerFileIndexBuilder {
+  public:
+    StreamerFileIndexBuilder();
+
+    void add(EventMsgView const& eview, uint64 offset);
+
+    /** Writes the index, streamerFileSize is the size of the complete streamer file */
+    void write(std::string const& indexFileName, uint64 streamerFileSize) const;
+
+  private:
+    bool hltCountSet_;
+    uint32 hltCount_;
+    uint32 hltStride_;
+    std::vector<uint64> event_;
+    std::vector<uint64> offset_;
+    std::vector<uint32> run_;
+    std::vector<uint32> lumi_;
+    std::vector<uint32> size_;
+    std::vector<uint8> hltBits_;
+  };
+
+  /** Read only, memory mapped view of an index file */
+  class StreamerFileIndex {
+  public:
+    typedef uint64 size_type;
+
+    ~StreamerFileIndex();
+    StreamerFileIndex(StreamerFileIndex const&) = delete; // Disallow copying and moving
+    StreamerFileIndex& operator=(StreamerFileIndex const&) = delete; // Disallow copying and moving
+
+    /** Name of the index file belonging to a streamer file */
+    static std::string indexFileName(std::string const& streamerFileName);
+
+    /** Maps the index of a streamer file. Returns a null pointer if the file
+        has no index, or if the index does not describe a streamer file of
+        the given size (e.g. it is stale). Throws if the index is corrupted. */
+    static std::unique_ptr<StreamerFileIndex> open(std::string const& streamerFileName, uint64 streamerFileSize);
+
+    size_type size() const { return header_->nEvents_; }
+    uint32 hltCount() const { return header_->hltCount_; }
+
+    uint64 event(size_type i) const { return event_[i]; }
+    uint64 offset(size_type i) const { return offset_[i]; }
+    uint32 run(size_type i) const { return run_[i]; }
+    uint32 lumi(size_type i) const { return lumi_[i]; }
+    uint32 eventSize(size_type i) const { return size_[i]; }
+    uint8 const* hltBits(size_type i) const { return hltBits_ + i * header_->hltStride_; }
+
+  private:
+    StreamerFileIndex(std::string const& indexFileName, void* address, size_t length);
+
+    void* address_;
+    size_t length_;
+    StreamerFileIndexHeader const* header_;
+    uint64 const* event_;
+    uint64 const* offset_;
+    uint32 const* run_;
+    uint32 const* lumi_;
+    uint32 const* size_;
+    uint8 const* hltBits_;
+  };
+}
+
+#endif
@@ -4,10 +4,12 @@
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/EventMessage.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
 #include "Utilities/StorageFactory/interface/IOTypes.h"
 #include "Utilities/StorageFactory/interface/Storage.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
+#include <functional>
 #include <memory>
 
 #include<string>
@@ -30,6 +32,17 @@ namespace edm {
 
     bool next(); /** Moves the handler to next Event Record */
 
+    /** Packed HLT bits (as from EventMsgView::hltTriggerBits) and number of HLT paths */
+    typedef std::function<bool(uint8 const*, uint32)> HLTSelection;
+
+    bool next(HLTSelection const& accept);
+    /** Moves the handler to the next Event Record whose HLT bits pass 'accept'.
+        If the file has a sidecar index (see StreamerFileIndex), the bits are
+        taken from the index and rejected events are not read at all. */
+
+    StreamerFileIndex const* index() const { return index_.get(); }
+    /** Index of the current file, null if it has none */
+
     InitMsgView const* startMessage() const { return startMsg_.get(); }
     /** Points to File Start Header/Message */
 
@@ -49,6 +62,9 @@ namespace edm {
 
     void readStartMessage();
     int readEventMessage();
+    void checkRepeatedStartMessage(uint32 headerSize);
+    int readIndexedEventMessage(HLTSelection const& accept);
+    bool acceptCurrentRecord(HLTSelection const& accept) const;
 
     bool openNextFile();
     /** Compares current File header with the newly opened file header
@@ -78,6 +94,9 @@ namespace edm {
 
     edm::propagate_const<std::unique_ptr<Storage>> storage_;
 
+    std::unique_ptr<StreamerFileIndex const> index_;
+    StreamerFileIndex::size_type nextIndexEntry_; /** index entry of the next event in the file */
+
     bool endOfFile_;
   };
 }
@@ -14,6 +14,7 @@
 #include "IOPool/Streamer/interface/EventMessage.h"
 
 #include "IOPool/Streamer/interface/StreamerFileIO.h"
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
 #include <memory>
 
 #include <exception>
@@ -26,9 +27,11 @@ class StreamerOutputFile
   */
   {
   public:
-     explicit StreamerOutputFile(const std::string& name);
+     explicit StreamerOutputFile(const std::string& name, bool writeIndex = false);
      /**
-      CTOR, takes file path name as argument
+      CTOR, takes file path name as argument.
+      If writeIndex is true, the events are also recorded in a
+      sidecar index (see StreamerFileIndex), written by writeIndex().
      */
      ~StreamerOutputFile();
 
@@ -56,12 +59,21 @@ class StreamerOutputFile
 
      uint32 adler32() const { return streamerfile_->adler32(); }
 
+     void writeIndex();
+     /**
+      Writes the sidecar index, if requested, for all the events written so far,
+      replacing the one written by a previous call: the index written after the
+      last event covers the whole file, whatever the number of runs in it.
+      No index is written if events were written as fragments.
+     */
+
   private:
      void writeEventHeader(const EventMsgView& ineview);
      void writeStart(const InitMsgView& inview);
 
   private:
      edm::propagate_const<std::shared_ptr<OutputFile>> streamerfile_;
+     edm::propagate_const<std::unique_ptr<edm::StreamerFileIndexBuilder>> index_;
 };
 
 #endif
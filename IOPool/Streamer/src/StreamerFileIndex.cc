@@ -0,0 +1,151 @@
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
+#include "IOPool/Streamer/interface/EventMessage.h"
+
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace edm {
+
+  namespace {
+    char const kIndexMagic[8] = {'C','M','S','S','T','R','I','X'};
+    uint32 const kIndexVersion = 1;
+
+    size_t padded(size_t n) { return (n + 7) & ~size_t(7); }
+
+    void writeColumn(std::ofstream& os, void const* data, size_t n) {
+      static char const zeros[8] = {0,0,0,0,0,0,0,0};
+      os.write(static_cast<char const*>(data), n);
+      os.write(zeros, padded(n) - n);
+    }
+  }
+
+  StreamerFileIndexBuilder::StreamerFileIndexBuilder() :
+    hltCountSet_(false),
+    hltCount_(0),
+    hltStride_(0) {
+  }
+
+  void StreamerFileIndexBuilder::add(EventMsgView const& eview, uint64 offset) {
+    if(!hltCountSet_) {
+      hltCount_ = eview.hltCount();
+      hltStride_ = (hltCount_ == 0) ? 0 : 1 + (hltCount_ - 1) / 4;
+      hltCountSet_ = true;
+    } else if(eview.hltCount() != hltCount_) {
+      throw Exception(errors::LogicError, "StreamerFileIndexBuilder::add")
+        << "Event " << eview.event() << " has " << eview.hltCount() << " HLT bits, "
+        << "previous events of the same streamer file have " << hltCount_ << "\n";
+    }
+    event_.push_back(eview.event());
+    offset_.push_back(offset);
+    run_.push_back(eview.run());
+    lumi_.push_back(eview.lumi());
+    size_.push_back(eview.size());
+    size_t const start = hltBits_.size();
+    hltBits_.resize(start + hltStride_);
+    if(hltStride_ != 0) {
+      eview.hltTriggerBits(&hltBits_[start]);
+    }
+  }
+
+  void StreamerFileIndexBuilder::write(std::string const& indexFileName, uint64 streamerFileSize) const {
+    StreamerFileIndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic_, kIndexMagic, sizeof(kIndexMagic));
+    header.version_ = kIndexVersion;
+    header.hltCount_ = hltCount_;
+    header.nEvents_ = event_.size();
+    header.streamerFileSize_ = streamerFileSize;
+    header.hltStride_ = hltStride_;
+
+    std::ofstream os(indexFileName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    writeColumn(os, &header, sizeof(header));
+    writeColumn(os, event_.data(), event_.size() * sizeof(uint64));
+    writeColumn(os, offset_.data(), offset_.size() * sizeof(uint64));
+    writeColumn(os, run_.data(), run_.size() * sizeof(uint32));
+    writeColumn(os, lumi_.data(), lumi_.size() * sizeof(uint32));
+    writeColumn(os, size_.data(), size_.size() * sizeof(uint32));
+    writeColumn(os, hltBits_.data(), hltBits_.size());
+    os.close();
+    if(!os) {
+      throw Exception(errors::FileWriteError, "StreamerFileIndexBuilder::write")
+        << "Error writing streamer index file " << indexFileName << ".  Possibly the output disk "
+        << "is full?\n";
+    }
+  }
+
+  std::string StreamerFileIndex::indexFileName(std::string const& streamerFileName) {
+    std::string const filePrefix("file:");
+    if(streamerFileName.compare(0, filePrefix.size(), filePrefix) == 0) {
+      return streamerFileName.substr(filePrefix.size()) + ".idx";
+    }
+    return streamerFileName + ".idx";
+  }
+
+  std::unique_ptr<StreamerFileIndex> StreamerFileIndex::open(std::string const& streamerFileName, uint64 streamerFileSize) {
+    std::string const name = indexFileName(streamerFileName);
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0) {
+      return std::unique_ptr<StreamerFileIndex>();
+    }
+    struct stat st;
+    if(::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(StreamerFileIndexHeader))) {
+      ::close(fd);
+      throw Exception(errors::FileReadError, "StreamerFileIndex::open")
+        << "Streamer index file " << name << " is too short\n";
+    }
+    size_t const length = st.st_size;
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(address == MAP_FAILED) {
+      throw Exception(errors::FileReadError, "StreamerFileIndex::open")
+        << "Failed to map streamer index file " << name << "\n";
+    }
+    std::unique_ptr<StreamerFileIndex> index(new StreamerFileIndex(name, address, length));
+    if(index->header_->streamerFileSize_ != streamerFileSize) {
+      // Written for another (e.g. unfinished) version of the streamer file.
+      return std::unique_ptr<StreamerFileIndex>();
+    }
+    return index;
+  }
+
+  StreamerFileIndex::StreamerFileIndex(std::string const& indexFileName, void* address, size_t length) :
+    address_(address),
+    length_(length),
+    header_(static_cast<StreamerFileIndexHeader const*>(address)),
+    event_(nullptr),
+    offset_(nullptr),
+    run_(nullptr),
+    lumi_(nullptr),
+    size_(nullptr),
+    hltBits_(nullptr) {
+    if(std::memcmp(header_->magic_, kIndexMagic, sizeof(kIndexMagic)) != 0 || header_->version_ != kIndexVersion) {
+      ::munmap(address_, length_);
+      throw Exception(errors::FileReadError, "StreamerFileIndex")
+        << "File " << indexFileName << " is not a streamer index file of version " << kIndexVersion << "\n";
+    }
+    size_t const n = header_->nEvents_;
+    char const* p = static_cast<char const*>(address) + padded(sizeof(StreamerFileIndexHeader));
+    event_ = reinterpret_cast<uint64 const*>(p);  p += padded(n * sizeof(uint64));
+    offset_ = reinterpret_cast<uint64 const*>(p); p += padded(n * sizeof(uint64));
+    run_ = reinterpret_cast<uint32 const*>(p);    p += padded(n * sizeof(uint32));
+    lumi_ = reinterpret_cast<uint32 const*>(p);   p += padded(n * sizeof(uint32));
+    size_ = reinterpret_cast<uint32 const*>(p);   p += padded(n * sizeof(uint32));
+    hltBits_ = reinterpret_cast<uint8 const*>(p); p += padded(n * header_->hltStride_);
+    if(p > static_cast<char const*>(address) + length) {
+      ::munmap(address_, length_);
+      throw Exception(errors::FileReadError, "StreamerFileIndex")
+        << "Streamer index file " << indexFileName << " is truncated\n";
+    }
+  }
+
+  StreamerFileIndex::~StreamerFileIndex() {
+    ::munmap(address_, length_);
+  }
+}
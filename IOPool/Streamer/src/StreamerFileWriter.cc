@@ -4,7 +4,8 @@
 namespace edm {
   StreamerFileWriter::StreamerFileWriter(edm::ParameterSet const& ps) :
     stream_writer_(new StreamerOutputFile(
-                      ps.getUntrackedParameter<std::string>("fileName")))
+                      ps.getUntrackedParameter<std::string>("fileName"),
+                      ps.getUntrackedParameter<bool>("writeIndex")))
   {
   }
 
@@ -16,6 +17,12 @@ namespace edm {
   StreamerFileWriter::~StreamerFileWriter() {
   }
 
+  void StreamerFileWriter::stop() {
+    // Called at the end of each run and at the end of the job: the index
+    // is rewritten each time, so the last one includes all the runs.
+    stream_writer_->writeIndex();
+  }
+
   void StreamerFileWriter::doOutputHeader(InitMsgBuilder const& init_message) {
     //Let us turn it into a View
     InitMsgView view(init_message.startAddress());
@@ -40,5 +47,7 @@ namespace edm {
   void StreamerFileWriter::fillDescription(ParameterSetDescription& desc) {
     desc.setComment("Writes events into a streamer output file.");
     desc.addUntracked<std::string>("fileName", "teststreamfile.dat")->setComment("Name of output file.");
+    desc.addUntracked<bool>("writeIndex", false)->setComment("Also write an index of the events (IDs, offsets, sizes and HLT bits) into '<fileName>.idx', "
+                                                             "used by the streamer readers to seek to events and to apply trigger selections without reading the event data.");
   }
 } //namespace edm
@@ -10,6 +10,7 @@
 #include "Utilities/StorageFactory/interface/IOFlags.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
@@ -35,6 +36,8 @@ namespace edm {
     currProto_(0),
     newHeader_(false),
     storage_(),
+    index_(),
+    nextIndexEntry_(0),
     endOfFile_(false) {
     openStreamerFile(name);
     readStartMessage();
@@ -55,6 +58,8 @@ namespace edm {
     currRun_(0),
     currProto_(0),
     newHeader_(false),
+    index_(),
+    nextIndexEntry_(0),
     endOfFile_(false) {
     openStreamerFile(names.at(0));
     ++currentFile_;
@@ -91,6 +96,12 @@ namespace edm {
     }
     currentFileOpen_ = true;
     logFileAction("  Successfully opened file ");
+
+    index_ = StreamerFileIndex::open(name, size);
+    nextIndexEntry_ = 0;
+    if(index_) {
+      logFileAction("  Using sidecar index of file ");
+    }
   }
 
   void
@@ -181,6 +192,32 @@ namespace edm {
     return false;
   }
 
+  bool StreamerInputFile::next(HLTSelection const& accept) {
+    for(;;) {
+      if(index_) {
+        if(readIndexedEventMessage(accept)) {
+          return true;
+        }
+      } else if(readEventMessage()) {
+        if(acceptCurrentRecord(accept)) {
+          return true;
+        }
+        continue;
+      }
+      if(!multiStreams_ || !openNextFile()) {
+        return false;
+      }
+      endOfFile_ = false;
+    }
+  }
+
+  bool StreamerInputFile::acceptCurrentRecord(HLTSelection const& accept) const {
+    uint32 const hltCount = currentEvMsg_->hltCount();
+    std::vector<uint8> hltBits(hltCount == 0 ? 1 : 1 + (hltCount - 1) / 4);
+    currentEvMsg_->hltTriggerBits(&hltBits[0]);
+    return accept(&hltBits[0], hltCount);
+  }
+
   bool StreamerInputFile::openNextFile() {
 
      if(currentFile_ <= streamerNames_.size() - 1) {
@@ -242,6 +279,17 @@ namespace edm {
       HeaderView head(&eventBuf_[0]);
       uint32 code = head.code();
 
+      // The streamer output modules write the INIT message again at each new
+      // run, it must be the same as the one at the start of the file.
+      if(code == Header::INIT) {
+        if(head.size() <= nWant) {
+          throw edm::Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+            << "Failed reading streamer file, init header size from data too small\n";
+        }
+        checkRepeatedStartMessage(head.size());
+        continue;
+      }
+
       // If it is not an event then something is wrong.
       if(code != Header::EVENT) {
         throw Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
@@ -253,6 +301,7 @@ namespace edm {
         throw edm::Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
           << "Failed reading streamer file, event header size from data too small\n";
       }
+      ++nextIndexEntry_;
       eventRead = true;
       if(eventSkipperByID_) {
         EventHeader *evh = (EventHeader *)(&eventBuf_[0]);
@@ -282,6 +331,81 @@ namespace edm {
     return 1;
   }
 
+  void StreamerInputFile::checkRepeatedStartMessage(uint32 headerSize) {
+    // the header is already in eventBuf_
+    IOSize const nHead = sizeof(EventHeader);
+    if(eventBuf_.size() < headerSize) eventBuf_.resize(headerSize);
+    IOSize const nWant = headerSize - nHead;
+    IOSize const nGot = readBytes(&eventBuf_[nHead], nWant);
+    if(nGot != nWant) {
+      throw Exception(errors::FileReadError, "StreamerInputFile::checkRepeatedStartMessage")
+        << "Failed reading streamer file, read of init message in readEventMessage\n"
+        << "Requested " << nWant << " bytes, read function returned " << nGot << " bytes\n";
+    }
+
+    InitMsgView const repeated(&eventBuf_[0]);
+    uint8 psetId[sizeof(Version::pset_id_)];
+    uint8 repeatedPsetId[sizeof(Version::pset_id_)];
+    startMsg_->pset(psetId);
+    repeated.pset(repeatedPsetId);
+    if(repeated.size() != startMsg_->size() ||
+       repeated.protocolVersion() != startMsg_->protocolVersion() ||
+       !std::equal(psetId, psetId + sizeof(psetId), repeatedPsetId) ||
+       repeated.descLength() != startMsg_->descLength() ||
+       !std::equal(repeated.descData(), repeated.descData() + repeated.descLength(), startMsg_->descData())) {
+      throw Exception(errors::FileReadError, "StreamerInputFile::checkRepeatedStartMessage")
+        << "File " << currentFileName_
+        << "\nhas an init message for run " << repeated.run()
+        << " which differs from the one at the start of the file (size, protocol version,"
+        << " parameter set or product description)\n";
+    }
+  }
+
+  int StreamerInputFile::readIndexedEventMessage(HLTSelection const& accept) {
+    if(endOfFile_) return 0;
+
+    for(; nextIndexEntry_ < index_->size(); ++nextIndexEntry_) {
+      StreamerFileIndex::size_type const entry = nextIndexEntry_;
+      if(eventSkipperByID_ && eventSkipperByID_->skipIt(index_->run(entry), index_->lumi(entry), index_->event(entry))) {
+        continue;
+      }
+      if(!accept(index_->hltBits(entry), index_->hltCount())) {
+        continue;
+      }
+      ++nextIndexEntry_;
+
+      uint32 const eventSize = index_->eventSize(entry);
+      if(eventSize <= sizeof(EventHeader)) {
+        throw edm::Exception(errors::FileReadError, "StreamerInputFile::readIndexedEventMessage")
+          << "Failed reading streamer file, event size from index too small\n";
+      }
+      if(eventBuf_.size() < eventSize) eventBuf_.resize(eventSize);
+      try {
+        storage_->position(index_->offset(entry), Storage::SET);
+      }
+      catch(cms::Exception& ce) {
+        Exception ex(errors::FileReadError, "", ce);
+        ex.addContext("Calling StreamerInputFile::readIndexedEventMessage()");
+        throw ex;
+      }
+      IOSize nGot = readBytes(&eventBuf_[0], eventSize);
+      if(nGot != eventSize) {
+        throw Exception(errors::FileReadError, "StreamerInputFile::readIndexedEventMessage")
+          << "Failed reading streamer file, read of indexed event\n"
+          << "Requested " << eventSize << " bytes, read function returned " << nGot << " bytes\n";
+      }
+      HeaderView head(&eventBuf_[0]);
+      if(head.code() != Header::EVENT || head.size() != eventSize) {
+        throw Exception(errors::FileReadError, "StreamerInputFile::readIndexedEventMessage")
+          << "Failed reading streamer file, index does not point to an event of the expected size\n";
+      }
+      currentEvMsg_ = std::make_shared<EventMsgView>((void*)&eventBuf_[0]); // propagate_const<T> has no reset() function
+      return 1;
+    }
+    endOfFile_ = true;
+    return 0;
+  }
+
   void StreamerInputFile::logFileAction(char const* msg) {
     LogAbsolute("fileAction") << std::setprecision(0) << TimeOfDay() << msg << currentFileName_;
     FlushMessageLog();
@@ -4,8 +4,9 @@
   StreamerOutputFile::~StreamerOutputFile() {
   }
 
-  StreamerOutputFile::StreamerOutputFile(const std::string& name):
-  streamerfile_(new OutputFile(name))
+  StreamerOutputFile::StreamerOutputFile(const std::string& name, bool writeIndex):
+  streamerfile_(new OutputFile(name)),
+  index_(writeIndex ? new edm::StreamerFileIndexBuilder() : nullptr)
   {
     streamerfile_->set_do_adler(true);
   }
@@ -30,9 +31,21 @@
         << streamerfile_->fileName() << ".  Possibly the output disk "
         << "is full?" << std::endl;
     }
+    if (index_) {
+      // OutputFile offsets start at 1, the index stores byte positions
+      index_->add(ineview, offset_to_return - 1);
+    }
     return offset_to_return;
   }
 
+  void StreamerOutputFile::writeIndex()
+  {
+    if (index_) {
+      index_->write(edm::StreamerFileIndex::indexFileName(streamerfile_->fileName()),
+                    streamerfile_->current_offset() - 1);
+    }
+  }
+
   uint64 StreamerOutputFile::
   writeEventFragment(uint32 fragIndex, uint32 fragCount,
                      const char *dataPtr, uint32 dataSize)
@@ -40,6 +53,9 @@
     /** Offset where current event starts */
     uint64 offset_to_return = streamerfile_->current_offset();
 
+    // The event header is not available here, so the index cannot be kept.
+    index_ = nullptr; // propagate_const<T> has no reset() function
+
     bool ret = streamerfile_->write(dataPtr, dataSize);
     if (ret) {
       throw cms::Exception("OutputFile", "writeEventFragment()")
@@ -0,0 +1,47 @@
+import FWCore.ParameterSet.Config as cms
+
+# Writes a streamer file with its index over several runs, with HLT bits
+# that differ between the events, for ReadIndexedStreamerFile
+
+process = cms.Process("HLT")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(35)
+)
+
+process.source = cms.Source("EmptySource",
+    numberEventsInRun = cms.untracked.uint32(10)
+)
+
+process.m1 = cms.EDProducer("StreamThingProducer",
+    instance_count = cms.int32(5),
+    array_size = cms.int32(2)
+)
+
+process.pre2 = cms.EDFilter("Prescaler",
+    prescaleFactor = cms.int32(2),
+    prescaleOffset = cms.int32(0)
+)
+
+process.pre3 = cms.EDFilter("Prescaler",
+    prescaleFactor = cms.int32(3),
+    prescaleOffset = cms.int32(1)
+)
+
+process.out = cms.OutputModule("EventStreamFileWriter",
+    fileName = cms.untracked.string('teststreamfileruns.dat'),
+    compression_level = cms.untracked.int32(1),
+    use_compression = cms.untracked.bool(True),
+    max_event_size = cms.untracked.int32(7000000),
+    writeIndex = cms.untracked.bool(True)
+)
+
+process.p1 = cms.Path(process.m1)
+process.p2 = cms.Path(process.pre2)
+process.p3 = cms.Path(process.pre3)
+process.end = cms.EndPath(process.out)
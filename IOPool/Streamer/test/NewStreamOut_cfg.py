@@ -30,7 +30,8 @@ process.out = cms.OutputModule("EventStreamFileWriter",
     fileName = cms.untracked.string('teststreamfile.dat'),
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
-    max_event_size = cms.untracked.int32(7000000)
+    max_event_size = cms.untracked.int32(7000000),
+    writeIndex = cms.untracked.bool(True)
 )
 
 process.p1 = cms.Path(process.m1*process.a1*process.m2)
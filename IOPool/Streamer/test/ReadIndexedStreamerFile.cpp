@@ -0,0 +1,141 @@
+/** Compares the events selected by StreamerInputFile::next(HLTSelection), which
+    uses the sidecar index of the file, with the ones selected by reading all the
+    events sequentially and checking their HLT bits.
+
+    Then checks that the sequential read fails on a copy of the file in which
+    the init message repeated for the second run has another parameter set ID.
+
+    Usage: ReadIndexedStreamerFile <streamer file>
+
+    The file must have an index, at least two runs, and events both accepted
+    and rejected by the selection (see NewStreamOutRuns_cfg.py).
+*/
+
+#include "DataFormats/Common/interface/HLTenums.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "IOPool/Streamer/interface/EventMessage.h"
+#include "IOPool/Streamer/interface/StreamerInputFile.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+  typedef std::tuple<uint32, uint32, uint64> ID;
+
+  bool passed(uint8 const* bits, uint32 path) {
+    return ((bits[path / 4] >> ((path % 4) * 2)) & 0x3) == edm::hlt::Pass;
+  }
+
+  // second or third path of the file passed
+  bool accept(uint8 const* bits, uint32 count) {
+    return (count > 1 && passed(bits, 1)) || (count > 2 && passed(bits, 2));
+  }
+
+  ID id(EventMsgView const* eview) {
+    return ID(eview->run(), eview->lumi(), eview->event());
+  }
+
+  // copy of the file with the parameter set ID of the second init message changed,
+  // false if there is no such message
+  bool writeBadInitCopy(std::string const& fileName, std::string const& copyName) {
+    std::ifstream in(fileName, std::ios::binary);
+    std::vector<char> buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    unsigned int nInit = 0;
+    for(std::size_t pos = 0; pos + sizeof(Header) <= buf.size(); ) {
+      HeaderView head(&buf[pos]);
+      if(head.size() == 0) return false;
+      if(head.code() == Header::INIT && ++nInit == 2) {
+        // the ID follows the header and the protocol version
+        buf[pos + sizeof(Header) + sizeof(uint8)] ^= 0x1;
+        std::ofstream out(copyName, std::ios::binary);
+        out.write(&buf[0], buf.size());
+        return true;
+      }
+      pos += head.size();
+    }
+    return false;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <streamer file>" << std::endl;
+    return 1;
+  }
+  std::string const fileName(argv[1]);
+
+  try {
+    // all the events, selected afterwards
+    std::vector<ID> sequential;
+    std::set<uint32> runs;
+    unsigned int nEvents = 0;
+    {
+      edm::StreamerInputFile reader(fileName);
+      while(reader.next()) {
+        EventMsgView const* eview = reader.currentRecord();
+        std::vector<uint8> bits(eview->hltCount() == 0 ? 1 : 1 + (eview->hltCount() - 1) / 4);
+        eview->hltTriggerBits(&bits[0]);
+        runs.insert(eview->run());
+        ++nEvents;
+        if(accept(&bits[0], eview->hltCount())) sequential.push_back(id(eview));
+      }
+    }
+
+    // only the selected events, through the index
+    std::vector<ID> indexed;
+    {
+      edm::StreamerInputFile reader(fileName);
+      if(reader.index() == nullptr) {
+        std::cerr << "No valid index for " << fileName << std::endl;
+        return 1;
+      }
+      if(reader.index()->size() != nEvents) {
+        std::cerr << "The index has " << reader.index()->size() << " events, the file " << nEvents << std::endl;
+        return 1;
+      }
+      while(reader.next(accept)) {
+        indexed.push_back(id(reader.currentRecord()));
+      }
+    }
+
+    std::cout << nEvents << " events in " << runs.size() << " runs, "
+              << sequential.size() << " selected sequentially, "
+              << indexed.size() << " through the index" << std::endl;
+    if(runs.size() < 2) {
+      std::cerr << "The file must have at least two runs" << std::endl;
+      return 1;
+    }
+    if(sequential.empty() || sequential.size() == nEvents) {
+      std::cerr << "The selection must accept some events and reject others" << std::endl;
+      return 1;
+    }
+    if(indexed != sequential) {
+      std::cerr << "The events selected through the index differ from the ones read sequentially" << std::endl;
+      return 1;
+    }
+  } catch(cms::Exception& e) {
+    std::cerr << "Exception caught:  " << e.what() << std::endl;
+    return 1;
+  }
+
+  // the copy has no index, so it is read sequentially
+  std::string const copyName(fileName + ".badinit");
+  if(!writeBadInitCopy(fileName, copyName)) {
+    std::cerr << "No init message for a second run in " << fileName << std::endl;
+    return 1;
+  }
+  try {
+    edm::StreamerInputFile reader(copyName);
+    while(reader.next()) {}
+    std::cerr << "The changed init message in " << copyName << " was not detected" << std::endl;
+    return 1;
+  } catch(cms::Exception& e) {
+    std::cout << "Changed init message detected: " << e.what() << std::endl;
+  }
+  return 0;
+}
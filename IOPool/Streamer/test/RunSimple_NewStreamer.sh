@@ -17,10 +17,13 @@ cp *_cfg.py ${OUTDIR}
 cd ${OUTDIR}
 
 cmsRun --parameter-set NewStreamOut_cfg.py > out 2>&1 || die "cmsRun NewStreamOut_cfg.py" $?
+[ -f teststreamfile.dat.idx ] || die "NewStreamOut_cfg.py did not write teststreamfile.dat.idx" 1
 cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn_cfg.py" $?
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
+cmsRun --parameter-set NewStreamOutRuns_cfg.py > outruns 2>&1 || die "cmsRun NewStreamOutRuns_cfg.py" $?
+ReadIndexedStreamerFile teststreamfileruns.dat || die "ReadIndexedStreamerFile teststreamfileruns.dat" $?
 
 # echo "CHECKSUM = 1" > out
 # echo "CHECKSUM = 1" > in
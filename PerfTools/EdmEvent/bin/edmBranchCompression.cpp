@@ -0,0 +1,132 @@
+/** measure branch compression and suggest per branch settings
+ *
+ *
+ */
+
+#include "PerfTools/EdmEvent/interface/EdmBranchCompression.h"
+
+
+#include <boost/program_options.hpp>
+#include <string>
+#include <iostream>
+#include <fstream>
+
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TError.h>
+#include "FWCore/FWLite/interface/FWLiteEnabler.h"
+
+static const char * const kHelpOpt = "help";
+static const char * const kHelpCommandOpt = "help,h";
+static const char * const kDataFileOpt = "data-file";
+static const char * const kDataFileCommandOpt = "data-file,d";
+static const char * const kTreeNameOpt = "tree-name";
+static const char * const kTreeNameCommandOpt = "tree-name,n";
+static const char * const kOutputOpt = "output";
+static const char * const kOutputCommandOpt = "output,o";
+static const char * const kAutoLoadOpt ="auto-loader";
+static const char * const kAutoLoadCommandOpt ="auto-loader,a";
+static const char * const kSettingOpt ="setting";
+static const char * const kSettingCommandOpt ="setting,s";
+static const char * const kMaxSlowdownOpt ="max-slowdown";
+static const char * const kMaxSlowdownCommandOpt ="max-slowdown,m";
+static const char * const kConfigOpt ="config";
+static const char * const kConfigCommandOpt ="config,c";
+
+int main( int argc, char * argv[] ) {
+  using namespace boost::program_options;
+  using namespace std;
+
+  string programName( argv[ 0 ] );
+  string descString( programName );
+  descString += " [options] ";
+  descString += "data_file \nAllowed options";
+  options_description desc( descString );
+
+  desc.add_options()
+    ( kHelpCommandOpt, "produce help message" )
+    ( kAutoLoadCommandOpt, "automatic library loading (avoid root warnings)" )
+    ( kDataFileCommandOpt, value<string>(), "data file" )
+    ( kTreeNameCommandOpt, value<string>(), "tree name (default \"Events\")" )
+    ( kOutputCommandOpt, value<string>(), "output file for the table (default: standard output)" )
+    ( kSettingCommandOpt, value<vector<string> >(), "candidate setting ALGORITHM:LEVEL, e.g. LZMA:4 (may be repeated; default: ZLIB:1 ZLIB:6 LZMA:4 LZMA:9 LZ4:4)" )
+    ( kMaxSlowdownCommandOpt, value<double>(), "suggest the smallest setting decompressing at most <arg> times slower than the fastest one (default: no limit)" )
+    ( kConfigCommandOpt, value<string>(), "write the suggestions as a PoolOutputModule 'overrideBranchesCompression' parameter into file <arg>" );
+
+  positional_options_description p;
+
+  p.add( kDataFileOpt, -1 );
+
+  variables_map vm;
+  try {
+    store( command_line_parser(argc,argv).options(desc).positional(p).run(), vm );
+    notify( vm );
+  } catch( const error& ) {
+    return 7000;
+  }
+
+  if( vm.count( kHelpOpt ) ) {
+    cout << desc <<std::endl;
+    return 0;
+  }
+
+  if( ! vm.count( kDataFileOpt ) ) {
+    cerr << programName << ": no data file given" << endl;
+    return 7001;
+  }
+
+  gROOT->SetBatch();
+
+  if( vm.count( kAutoLoadOpt ) != 0 ) {
+    gSystem->Load( "libFWCoreFWLite" );
+    FWLiteEnabler::enable();
+  }
+  else 
+    gErrorIgnoreLevel = kError; 
+
+  std::string fileName = vm[kDataFileOpt].as<string>();
+
+  std::string treeName = "Events";
+  if ( vm.count( kTreeNameOpt) )
+    treeName=vm[kTreeNameOpt].as<string>();
+
+  try {
+    std::vector<perftools::EdmBranchCompression::Setting> settings;
+    if ( vm.count( kSettingOpt ) ) {
+      for ( auto const & s : vm[kSettingOpt].as<vector<string> >() ) {
+	std::string::size_type colon = s.find(':');
+	if ( colon == std::string::npos ) {
+	  cerr << programName << ": setting " << s << " is not of the form ALGORITHM:LEVEL" << endl;
+	  return 7012;
+	}
+	settings.emplace_back(s.substr(0, colon), std::stoi(s.substr(colon + 1)));
+      }
+    }
+    perftools::EdmBranchCompression me = settings.empty() ? perftools::EdmBranchCompression() : perftools::EdmBranchCompression(settings);
+
+    me.parseFile(fileName,treeName);
+
+    if ( vm.count( kMaxSlowdownOpt ) )
+      me.suggest( vm[kMaxSlowdownOpt].as<double>() );
+
+    if (vm.count( kOutputOpt )) {
+      std::ofstream of(vm[kOutputOpt].as<std::string>().c_str());
+      me.dump(of); of << std::endl;
+    } else {
+      me.dump(std::cout);
+    }
+
+    if (vm.count( kConfigOpt )) {
+      std::ofstream of(vm[kConfigOpt].as<std::string>().c_str());
+      me.dumpConfiguration(of);
+    }
+  } catch(perftools::EdmBranchCompression::Error const & error) {
+    std::cerr <<  programName << ":" << error.descr << std::endl;
+    return error.code;
+  } catch(std::exception const & e) {
+    std::cerr <<  programName << ": " << e.what() << std::endl;
+    return 7013;
+  }
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef PerfTools_EdmBranchCompression_H
+#define PerfTools_EdmBranchCompression_H
+
+#include<string>
+#include<vector>
+#include<iosfwd>
+
+class TBranch;
+
+namespace perftools {
+
+  /** \class EdmBranchCompression
+   *  Measure, for each top level branch of a tree, the compressed size
+   *  and the decompression time obtained with a set of candidate ROOT
+   *  compression settings, and suggest a setting per branch.
+   *
+   *  Algorithm:
+   *  Read every basket of the branch and of its sub-branches, recompress
+   *  the uncompressed buffer with each candidate setting and time the
+   *  decompression of the result.
+   *  The suggestion is the smallest candidate whose decompression time
+   *  is within a given factor of the fastest one.
+   */
+  class EdmBranchCompression {
+  public:
+
+    /// generic exception
+    struct Error {
+      Error(std::string const & idescr, int icode) :
+	descr(idescr), code(icode){}
+      std::string descr;
+      int code;
+    };
+
+    /// a candidate compression setting
+    struct Setting {
+      Setting(std::string const & ialgorithm, int ilevel);
+      std::string algorithm;
+      int level;
+      int rootAlgorithm;
+    };
+
+    /// the result of one setting for one branch
+    struct Measurement {
+      Measurement() : compr_size(0.), unzip_time(0.) {}
+      double compr_size;  // bytes per event
+      double unzip_time;  // microseconds per event
+    };
+
+    /// the information for each branch
+    struct BranchRecord {
+      explicit BranchRecord(std::string const & iname) :
+	name(iname), uncompr_size(0.), suggested(0) {}
+      std::string name;
+      double uncompr_size;
+      std::vector<Measurement> measurements; // one per setting
+      unsigned int suggested;                // index in the settings
+    };
+
+    typedef std::vector<BranchRecord> Branches;
+
+    /// Constructor, the candidates default to ZLIB, LZMA and LZ4 at a few levels
+    EdmBranchCompression();
+    explicit EdmBranchCompression(std::vector<Setting> const & settings);
+
+    /// read file, measure all settings for all branches, sort by uncompressed size
+    void parseFile(std::string const & fileName, std::string const & treeName="Events");
+
+    /// suggest the smallest setting decompressing at most maxSlowdown times slower than the fastest
+    void suggest(double maxSlowdown);
+
+    /// dump the ascii table on "co"
+    void dump(std::ostream & co, bool header=true) const;
+
+    /// dump the suggestions as a PoolOutputModule overrideBranchesCompression parameter
+    void dumpConfiguration(std::ostream & co) const;
+
+  private:
+    void measure(TBranch * branch, BranchRecord & record) const;
+
+    std::string m_fileName;
+    int m_nEvents;
+    std::vector<Setting> m_settings;
+    Branches m_branches;
+  };
+
+}
+
+#endif // PerfTools_EdmBranchCompression_H
@@ -0,0 +1,207 @@
+/** \file PerfTools/EdmEvent/src/EdmBranchCompression.cc
+ *
+ */
+#include "PerfTools/EdmEvent/interface/EdmBranchCompression.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <ostream>
+
+#include "Rtypes.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TObjArray.h"
+#include "TBranch.h"
+#include "TBasket.h"
+#include "TBuffer.h"
+#include "Compression.h"
+#include "RZip.h"
+
+namespace {
+
+  // ROOT compresses in chunks of at most this size (kMAXZIPBUF in TBasket)
+  const int kMaxZipChunk = 0xffffff;
+  // size of the header ROOT writes in front of each compressed chunk
+  const int kZipHeader = 9;
+
+  struct Totals {
+    explicit Totals(size_t n) : compressed(n, 0.), unzipTime(n, 0.), uncompressed(0.) {}
+    std::vector<double> compressed;
+    std::vector<double> unzipTime;
+    double uncompressed;
+    // work buffers for one chunk, kept for all the baskets of the branch:
+    // they only grow (and are only initialised) up to the largest chunk
+    std::vector<char> zipped;
+    std::vector<char> unzipped;
+  };
+
+  void measureBuffer(char * src, int len,
+		     std::vector<perftools::EdmBranchCompression::Setting> const & settings,
+		     Totals & totals) {
+    int const chunk = std::min(len, kMaxZipChunk);
+    if (totals.zipped.size() < size_t(chunk + kZipHeader + 256)) totals.zipped.resize(chunk + kZipHeader + 256);
+    if (totals.unzipped.size() < size_t(chunk)) totals.unzipped.resize(chunk);
+    std::vector<char> & zipped = totals.zipped;
+    std::vector<char> & unzipped = totals.unzipped;
+    totals.uncompressed += len;
+    for (size_t s = 0; s < settings.size(); ++s) {
+      double time = 0.;
+      for (int offset = 0; offset < len; offset += kMaxZipChunk) {
+	int srcsize = std::min(kMaxZipChunk, len - offset);
+	int tgtsize = zipped.size();
+	int nzip = 0;
+	R__zipMultipleAlgorithm(settings[s].level, &srcsize, src + offset, &tgtsize, &zipped[0], &nzip,
+				static_cast<ROOT::ECompressionAlgorithm>(settings[s].rootAlgorithm));
+	if (nzip <= 0 || nzip >= srcsize) {
+	  // ROOT stores such chunks uncompressed
+	  totals.compressed[s] += srcsize;
+	  continue;
+	}
+	totals.compressed[s] += nzip;
+	int nbuf = srcsize;
+	int nout = 0;
+	auto start = std::chrono::steady_clock::now();
+	R__unzip(&nzip, reinterpret_cast<unsigned char *>(&zipped[0]), &nbuf,
+		 reinterpret_cast<unsigned char *>(&unzipped[0]), &nout);
+	time += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+      }
+      totals.unzipTime[s] += time;
+    }
+  }
+
+  void measureBranch(TBranch * b,
+		     std::vector<perftools::EdmBranchCompression::Setting> const & settings,
+		     Totals & totals) {
+    Int_t const nBaskets = b->GetWriteBasket();
+    for (Int_t i = 0; i < nBaskets; ++i) {
+      TBasket * basket = b->GetBasket(i);
+      if (basket == nullptr || basket->GetObjlen() <= 0) continue;
+      measureBuffer(basket->GetBufferRef()->Buffer() + basket->GetKeylen(), basket->GetObjlen(), settings, totals);
+      // keep only one basket in memory at a time
+      b->DropBaskets("all");
+    }
+    TObjArray * branches = b->GetListOfBranches();
+    size_t n = branches->GetEntries();
+    for (size_t i = 0; i < n; ++i) {
+      TBranch * sub = dynamic_cast<TBranch*>(branches->At(i));
+      if (sub != nullptr) measureBranch(sub, settings, totals);
+    }
+  }
+
+  int algorithmFromName(std::string const & algorithm) {
+    if (algorithm == "ZLIB") return ROOT::kZLIB;
+    if (algorithm == "LZMA") return ROOT::kLZMA;
+    if (algorithm == "LZ4") return ROOT::kLZ4;
+    throw perftools::EdmBranchCompression::Error("unknown compression algorithm " + algorithm + ", allowed values are ZLIB, LZMA and LZ4", 7010);
+  }
+}
+
+namespace perftools {
+
+  EdmBranchCompression::Setting::Setting(std::string const & ialgorithm, int ilevel) :
+    algorithm(ialgorithm), level(ilevel), rootAlgorithm(algorithmFromName(ialgorithm)) {}
+
+  EdmBranchCompression::EdmBranchCompression() :
+    m_nEvents(0),
+    m_settings{ {"ZLIB", 1}, {"ZLIB", 6}, {"LZMA", 4}, {"LZMA", 9}, {"LZ4", 4} } {}
+
+  EdmBranchCompression::EdmBranchCompression(std::vector<Setting> const & settings) :
+    m_nEvents(0),
+    m_settings(settings) {
+    if (m_settings.empty())
+      throw Error("no compression setting to measure", 7011);
+  }
+
+  void EdmBranchCompression::measure(TBranch * branch, BranchRecord & record) const {
+    Totals totals(m_settings.size());
+    measureBranch(branch, m_settings, totals);
+    record.uncompr_size = totals.uncompressed/double(m_nEvents);
+    record.measurements.resize(m_settings.size());
+    for (size_t s = 0; s < m_settings.size(); ++s) {
+      record.measurements[s].compr_size = totals.compressed[s]/double(m_nEvents);
+      record.measurements[s].unzip_time = totals.unzipTime[s]/double(m_nEvents);
+    }
+  }
+
+  void EdmBranchCompression::parseFile(std::string const & fileName, std::string const & treeName) {
+    m_fileName = fileName;
+    m_branches.clear();
+
+    std::unique_ptr<TFile> file(TFile::Open( fileName.c_str() ));
+    if( file==nullptr  || ( !(*file).IsOpen() ) )
+      throw Error( "unable to open data file " + fileName, 7002);
+
+    TObject * o = file->Get(treeName.c_str() );
+    if ( o == nullptr )
+      throw Error("no object \"" + treeName + "\" found in file: " + fileName, 7003);
+
+    TTree * events = dynamic_cast<TTree*> (o);
+    if ( events == nullptr )
+      throw Error("object \"" + treeName + "\" is not a TTree in file: " + fileName, 7004);
+
+    m_nEvents = events->GetEntries();
+    if ( m_nEvents == 0 )
+      throw Error("tree \"" + treeName + "\" in file " + fileName + " contains no Events", 7005);
+
+    TObjArray * branches = events->GetListOfBranches();
+    if ( branches == nullptr )
+      throw Error("tree \"" + treeName+ "\" in file " + fileName + " contains no branches", 7006);
+
+    const size_t n =  branches->GetEntries();
+    m_branches.reserve(n);
+    for( size_t i = 0; i < n; ++i ) {
+      TBranch * b = dynamic_cast<TBranch*>( branches->At( i ) );
+      if (b==nullptr) continue;
+      m_branches.emplace_back(b->GetName());
+      measure(b, m_branches.back());
+    }
+    std::sort(m_branches.begin(), m_branches.end(),
+	      [](BranchRecord const & a, BranchRecord const & b) { return a.uncompr_size > b.uncompr_size; });
+    suggest(std::numeric_limits<double>::max());
+  }
+
+  void EdmBranchCompression::suggest(double maxSlowdown) {
+    for (auto & br : m_branches) {
+      double fastest = std::numeric_limits<double>::max();
+      for (auto const & m : br.measurements) fastest = std::min(fastest, m.unzip_time);
+      double smallest = std::numeric_limits<double>::max();
+      for (size_t s = 0; s < br.measurements.size(); ++s) {
+	Measurement const & m = br.measurements[s];
+	if (m.unzip_time <= maxSlowdown*fastest && m.compr_size < smallest) {
+	  smallest = m.compr_size;
+	  br.suggested = s;
+	}
+      }
+    }
+  }
+
+  void EdmBranchCompression::dump(std::ostream & co, bool header) const {
+    if (header) {
+      co << "File " << m_fileName << " Events " << m_nEvents << "\n";
+      co << "Branch Name | Average Uncompressed Size (Bytes/Event)";
+      for (auto const & s : m_settings)
+	co << " | " << s.algorithm << "-" << s.level << " Size (Bytes/Event) | " << s.algorithm << "-" << s.level << " Unzip Time (us/Event)";
+      co << " | Suggested\n";
+    }
+    for (auto const & br : m_branches) {
+      co << br.name << " " << br.uncompr_size;
+      for (auto const & m : br.measurements)
+	co << " " << m.compr_size << " " << m.unzip_time;
+      Setting const & s = m_settings[br.suggested];
+      co << " " << s.algorithm << "-" << s.level << "\n";
+    }
+  }
+
+  void EdmBranchCompression::dumpConfiguration(std::ostream & co) const {
+    co << "overrideBranchesCompression = cms.untracked.VPSet(\n";
+    for (auto const & br : m_branches) {
+      Setting const & s = m_settings[br.suggested];
+      co << "    cms.untracked.PSet(branch = cms.untracked.string('" << br.name << "'),"
+	 << " compressionAlgorithm = cms.untracked.string('" << s.algorithm << "'),"
+	 << " compressionLevel = cms.untracked.int32(" << s.level << ")),\n";
+    }
+    co << ")\n";
+  }
+
+}
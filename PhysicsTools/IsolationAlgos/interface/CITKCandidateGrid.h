@@ -0,0 +1,49 @@
+#ifndef IsolationAlgos_CITKCandidateGrid_H
+#define IsolationAlgos_CITKCandidateGrid_H
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Common/interface/View.h"
+
+#include <vector>
+
+namespace citk {
+  /** Index of the candidates used for isolation in eta-phi cells, one
+   *  index per candidate type. It is built once per event and then finds
+   *  the candidates of a given type around a direction without looping
+   *  over all the candidates.
+   *
+   *  Usage: fill() with the candidates and the type of each candidate,
+   *  then call near() for each object to isolate.
+   */
+  class CandidateGrid {
+  public:
+    /// cell size in eta and (approximately) in phi
+    static constexpr float kCellSize = 0.1f;
+    /// margin added to the cone size of near()
+    static constexpr float kMargin = 1.e-3f;
+
+    CandidateGrid() {}
+
+    /// types[i] is the type of candidate i, in [0, nTypes)
+    void fill(const edm::View<reco::Candidate>& cands, const std::vector<unsigned>& types, unsigned nTypes);
+
+    /// indices of the candidates of type t within deltaR < dr (plus a small margin) of (eta, phi),
+    /// in increasing order: any candidate closer than dr is returned
+    void near(unsigned t, double eta, double phi, float dr, std::vector<unsigned>& result) const;
+
+  private:
+    int etaBin(double eta) const;
+    int phiBin(double phi) const;
+
+    unsigned _nTypes = 0;
+    int _nEtaBins = 0;
+    int _nPhiBins = 0;
+    float _etaMin = 0;
+    // the candidates of type t in cell c are _indices[_cellStart[t*nCells+c], _cellStart[t*nCells+c+1])
+    std::vector<unsigned> _cellStart;
+    std::vector<unsigned> _indices;
+    std::vector<float> _eta, _phi;  // by candidate
+  };
+}
+
+#endif
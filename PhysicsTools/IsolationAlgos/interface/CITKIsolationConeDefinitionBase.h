@@ -29,9 +29,13 @@ namespace citk {
     virtual void getEventInfo(const edm::Event&) {}
     virtual void setConsumes(edm::ConsumesCollector) = 0;
 
+    //! never true beyond deltaR2 = coneSize2(): the producers only ask
+    //! for the candidates within the cone
     virtual bool isInIsolationCone(const reco::CandidatePtr& physob,
 				   const reco::CandidatePtr& other) const = 0;
 
+    float coneSize2() const { return _coneSize2; }
+
     const std::string& name() const { return _name; }
 
     const std::string& additionalCode() const { return _additionalCode; }
@@ -16,6 +16,7 @@
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "PhysicsTools/IsolationAlgos/interface/CITKIsolationConeDefinitionBase.h"
+#include "PhysicsTools/IsolationAlgos/interface/CITKCandidateGrid.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -24,6 +25,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <algorithm>
+#include <cmath>
 
 namespace edm { class Event; }
 namespace edm { class EventSetup; }
@@ -54,6 +57,9 @@ namespace citk {
     // indexed by pf candidate type
     std::array<IsoTypes,kNPFTypes> _isolation_types; 
     std::array<std::vector<std::string>,kNPFTypes> _product_names;
+    // largest cone of the isolations of each type
+    std::array<float,kNPFTypes> _max_cone_size;
+    CandidateGrid _grid;
   };
 }
 
@@ -102,6 +108,11 @@ namespace citk {
       _product_names[thetype->second].emplace_back(pname);
       produces<edm::ValueMap<float> >(pname);
     }
+    for( unsigned i = 0; i < kNPFTypes; ++i ) {
+      float coneSize2 = 0;
+      for( const auto& isolator : _isolation_types[i] ) coneSize2 = std::max(coneSize2,isolator->coneSize2());
+      _max_cone_size[i] = std::sqrt(coneSize2);
+    }
   }
 
   void  PFIsolationSumProducer::
@@ -133,6 +144,13 @@ namespace citk {
       }
     }
     reco::PFCandidate helper; // to translate pdg id to type    
+    // index the isolation candidates by type and position once for all the candidates to isolate
+    std::vector<unsigned> isotypes(isolate_with->size());
+    for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      isotypes[ic] = helper.translatePdgIdToType((*isolate_with)[ic].pdgId());
+    }
+    _grid.fill(*isolate_with,isotypes,kNPFTypes);
+    std::vector<unsigned> near;
     // loop over the candidates we are isolating and fill the values
     for( size_t c = 0; c < to_isolate->size(); ++c ) {
       auto cand_to_isolate = to_isolate->ptrAt(c);
@@ -143,13 +161,17 @@ namespace citk {
 	for( auto& value : cand_values[k] ) value = 0.0;
 	++k;
       }
-      for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
-        auto isocand = isolate_with->ptrAt(ic);
-	auto isotype = helper.translatePdgIdToType(isocand->pdgId());	
+      // only the candidates within the largest cone of each type, in the same order as in the collection
+      for( unsigned isotype = 0; isotype < kNPFTypes; ++isotype ) {
 	const auto& isolations = _isolation_types[isotype];	
-	for( unsigned i = 0; i < isolations.size(); ++ i  ) {
-	  if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
-	    cand_values[isotype][i] += isocand->pt();
+	if( isolations.empty() ) continue;
+	_grid.near(isotype,cand_to_isolate->eta(),cand_to_isolate->phi(),_max_cone_size[isotype],near);
+	for( auto ic : near ) {
+	  auto isocand = isolate_with->ptrAt(ic);
+	  for( unsigned i = 0; i < isolations.size(); ++ i  ) {
+	    if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
+	      cand_values[isotype][i] += isocand->pt();
+	    }
 	  }
 	}
       }
@@ -12,6 +12,7 @@
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "PhysicsTools/IsolationAlgos/interface/CITKIsolationConeDefinitionBase.h"
+#include "PhysicsTools/IsolationAlgos/interface/CITKCandidateGrid.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -20,6 +21,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <algorithm>
+#include <cmath>
 
 //module to compute isolation sum weighted with PUPPI weights
 namespace citk {
@@ -50,6 +53,9 @@ namespace citk {
     // indexed by pf candidate type
     std::array<IsoTypes,kNPFTypes> _isolation_types; 
     std::array<std::vector<std::string>,kNPFTypes> _product_names;
+    // largest cone of the isolations of each type
+    std::array<float,kNPFTypes> _max_cone_size;
+    CandidateGrid _grid;
     bool useValueMapForPUPPI = true;
     bool usePUPPINoLepton = false;// in case puppi weights are taken from packedCandidate can take weights for puppiNoLeptons
   };
@@ -108,6 +114,11 @@ namespace citk {
       _product_names[thetype->second].emplace_back(pname);
       produces<edm::ValueMap<float> >(pname);
     }
+    for( unsigned i = 0; i < kNPFTypes; ++i ) {
+      float coneSize2 = 0;
+      for( const auto& isolator : _isolation_types[i] ) coneSize2 = std::max(coneSize2,isolator->coneSize2());
+      _max_cone_size[i] = std::sqrt(coneSize2);
+    }
   }
 
   void  PFIsolationSumProducerForPUPPI::
@@ -141,6 +152,13 @@ namespace citk {
       }
     }
     reco::PFCandidate helper; // to translate pdg id to type    
+    // index the isolation candidates by type and position once for all the candidates to isolate
+    std::vector<unsigned> isotypes(isolate_with->size());
+    for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      isotypes[ic] = helper.translatePdgIdToType((*isolate_with)[ic].pdgId());
+    }
+    _grid.fill(*isolate_with,isotypes,kNPFTypes);
+    std::vector<unsigned> near;
     // loop over the candidates we are isolating and fill the values
     for( size_t c = 0; c < to_isolate->size(); ++c ) {
       auto cand_to_isolate = to_isolate->ptrAt(c);
@@ -151,21 +169,25 @@ namespace citk {
 	for( auto& value : cand_values[k] ) value = 0.0;
 	++k;
       }
-      for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
-        auto isocand = isolate_with->ptrAt(ic);
-        edm::Ptr<pat::PackedCandidate> aspackedCandidate(isocand);
-        auto isotype = helper.translatePdgIdToType(isocand->pdgId());	
-	      const auto& isolations = _isolation_types[isotype];	
-    	   for( unsigned i = 0; i < isolations.size(); ++ i  ) {
-    	  if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
-          double puppiWeight = 0.;
-    	    if (!useValueMapForPUPPI && !usePUPPINoLepton) puppiWeight = aspackedCandidate -> puppiWeight(); // if miniAOD, take puppiWeight directly from the object
-            else if (!useValueMapForPUPPI && usePUPPINoLepton) puppiWeight = aspackedCandidate -> puppiWeightNoLep(); // if miniAOD, take puppiWeightNoLep directly from the object
-            else  puppiWeight = (*puppiValueMap)[isocand]; // if AOD, take puppiWeight from the valueMap
-          if (puppiWeight > 0.)cand_values[isotype][i] += (isocand->pt())*puppiWeight; // this is basically the main change to Lindsey's code: scale pt with puppiWeight for candidates with puppiWeight > 0.
-    	  }
-    	}
-    }
+      // only the candidates within the largest cone of each type, in the same order as in the collection
+      for( unsigned isotype = 0; isotype < kNPFTypes; ++isotype ) {
+        const auto& isolations = _isolation_types[isotype];
+        if( isolations.empty() ) continue;
+        _grid.near(isotype,cand_to_isolate->eta(),cand_to_isolate->phi(),_max_cone_size[isotype],near);
+        for( auto ic : near ) {
+          auto isocand = isolate_with->ptrAt(ic);
+          edm::Ptr<pat::PackedCandidate> aspackedCandidate(isocand);
+          for( unsigned i = 0; i < isolations.size(); ++ i  ) {
+            if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
+              double puppiWeight = 0.;
+              if (!useValueMapForPUPPI && !usePUPPINoLepton) puppiWeight = aspackedCandidate -> puppiWeight(); // if miniAOD, take puppiWeight directly from the object
+              else if (!useValueMapForPUPPI && usePUPPINoLepton) puppiWeight = aspackedCandidate -> puppiWeightNoLep(); // if miniAOD, take puppiWeightNoLep directly from the object
+              else  puppiWeight = (*puppiValueMap)[isocand]; // if AOD, take puppiWeight from the valueMap
+              if (puppiWeight > 0.)cand_values[isotype][i] += (isocand->pt())*puppiWeight; // this is basically the main change to Lindsey's code: scale pt with puppiWeight for candidates with puppiWeight > 0.
+            }
+          }
+        }
+      }
       // add this candidate to isolation value list
       for( unsigned i = 0; i < kNPFTypes; ++i ) {
 	for( unsigned j = 0; j < cand_values[i].size(); ++j ) {
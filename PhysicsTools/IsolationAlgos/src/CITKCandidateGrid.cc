@@ -0,0 +1,80 @@
+#include "PhysicsTools/IsolationAlgos/interface/CITKCandidateGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // candidates beyond are kept in the first and last eta cells
+  constexpr float kEtaMax = 10.f;
+}
+
+namespace citk {
+  int CandidateGrid::etaBin(double eta) const {
+    const int b = std::floor((std::max(-kEtaMax,std::min(kEtaMax,float(eta))) - _etaMin)/kCellSize);
+    return std::max(0,std::min(_nEtaBins-1,b));
+  }
+
+  int CandidateGrid::phiBin(double phi) const {
+    const int b = std::floor((phi+M_PI)*_nPhiBins/(2*M_PI));
+    return std::max(0,std::min(_nPhiBins-1,b));
+  }
+
+  void CandidateGrid::fill(const edm::View<reco::Candidate>& cands,
+                           const std::vector<unsigned>& types, unsigned nTypes) {
+    const unsigned n = cands.size();
+    _nTypes = nTypes;
+    _eta.resize(n);
+    _phi.resize(n);
+    float etaMin = kEtaMax, etaMax = -kEtaMax;
+    for( unsigned i = 0; i < n; ++i ) {
+      _eta[i] = cands[i].eta();
+      _phi[i] = cands[i].phi();
+      etaMin = std::min(etaMin,_eta[i]);
+      etaMax = std::max(etaMax,_eta[i]);
+    }
+    _etaMin = std::max(-kEtaMax,etaMin);
+    _nEtaBins = n==0 ? 1 : 1+int((std::min(kEtaMax,etaMax)-_etaMin)/kCellSize);
+    _nPhiBins = int(2*M_PI/kCellSize);
+
+    // counting sort by (type, cell): the indices in a cell stay in increasing order
+    const unsigned nCells = _nEtaBins*_nPhiBins;
+    _cellStart.assign(_nTypes*nCells+1,0);
+    std::vector<unsigned> cell(n);
+    for( unsigned i = 0; i < n; ++i ) {
+      cell[i] = types[i]*nCells + etaBin(_eta[i])*_nPhiBins + phiBin(_phi[i]);
+      ++_cellStart[cell[i]+1];
+    }
+    for( unsigned c = 0; c < _nTypes*nCells; ++c ) _cellStart[c+1] += _cellStart[c];
+    _indices.resize(n);
+    std::vector<unsigned> next(_cellStart.begin(),_cellStart.end()-1);
+    for( unsigned i = 0; i < n; ++i ) _indices[next[cell[i]]++] = i;
+  }
+
+  void CandidateGrid::near(unsigned t, double eta, double phi, float dr,
+                           std::vector<unsigned>& result) const {
+    result.clear();
+    if( t >= _nTypes ) return;
+    const float r = dr + kMargin;
+    const float r2 = r*r;
+    const float feta = eta, fphi = phi;
+    const unsigned nCells = _nEtaBins*_nPhiBins;
+    const int etaLo = etaBin(eta-r), etaHi = etaBin(eta+r);
+    const double phiWidth = 2*M_PI/_nPhiBins;
+    int phiLo = std::floor((phi-r+M_PI)/phiWidth), phiHi = std::floor((phi+r+M_PI)/phiWidth);
+    if( phiHi-phiLo+1 >= _nPhiBins ) { phiLo = 0; phiHi = _nPhiBins-1; }
+    for( int ie = etaLo; ie <= etaHi; ++ie ) {
+      for( int k = phiLo; k <= phiHi; ++k ) {
+        const int ip = (k%_nPhiBins + _nPhiBins)%_nPhiBins;
+        const unsigned c = t*nCells + ie*_nPhiBins + ip;
+        for( unsigned j = _cellStart[c]; j < _cellStart[c+1]; ++j ) {
+          const unsigned i = _indices[j];
+          const float deta = _eta[i]-feta;
+          float dphi = std::abs(_phi[i]-fphi);
+          if( dphi > float(M_PI) ) dphi = float(2*M_PI) - dphi;
+          if( deta*deta + dphi*dphi < r2 ) result.push_back(i);
+        }
+      }
+    }
+    std::sort(result.begin(),result.end());
+  }
+}
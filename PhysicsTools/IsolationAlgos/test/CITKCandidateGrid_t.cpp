@@ -0,0 +1,129 @@
+// Checks the candidates that citk::CandidateGrid::near returns against a brute
+// force loop over all the candidates: every candidate of the type closer than the
+// cone size must be there, none farther than the cone size plus the margin, and in
+// increasing order. The directions cover phi = +-pi and the wrap around it, and
+// candidates beyond the first and last eta cells.
+
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "DataFormats/Common/interface/FillViewHelperVector.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Math/interface/deltaR.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "PhysicsTools/IsolationAlgos/interface/CITKCandidateGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  const unsigned nTypes = 4;  // the last one is never used
+
+  struct Direction { double eta, phi; };
+
+  std::vector<Direction> makeDirections(std::mt19937& engine, unsigned n) {
+    std::uniform_real_distribution<double> eta(-3., 3.), phi(-M_PI, M_PI);
+    std::vector<Direction> directions;
+    for( unsigned i = 0; i < n; ++i ) directions.push_back({eta(engine),phi(engine)});
+    // around phi = +-pi, on the boundaries of the cells and beyond the eta of the grid
+    for( double e : {-12., -10., -3.1, 0., 0.05, 2.95, 10., 15.} ) {
+      for( double p : {-M_PI, -M_PI+0.01, -0.1, 0., 0.1, M_PI-0.01, M_PI} ) directions.push_back({e,p});
+    }
+    return directions;
+  }
+
+  std::vector<reco::LeafCandidate> makeCandidates(std::mt19937& engine, const std::vector<Direction>& directions,
+                                                  unsigned nRandom) {
+    std::uniform_real_distribution<double> eta(-3., 3.), phi(-M_PI, M_PI), dR(0., 0.5), angle(-M_PI, M_PI);
+    std::vector<reco::LeafCandidate> cands;
+    auto add = [&](double e, double p) {
+      cands.emplace_back(0, reco::LeafCandidate::PolarLorentzVector(1., e, reco::reduceRange(p), 0.));
+    };
+    for( unsigned i = 0; i < nRandom; ++i ) add(eta(engine),phi(engine));
+    // clustered around the directions, so across the wrap in phi
+    for( const auto& d : directions ) {
+      for( unsigned i = 0; i < 20; ++i ) {
+        const double r = dR(engine), a = angle(engine);
+        add(d.eta+r*std::cos(a),d.phi+r*std::sin(a));
+      }
+    }
+    // exactly at phi = +-pi, and beyond the eta cells
+    for( double e : {-20., -11., -10.05, 9.97, 10.3, 13.} ) {
+      add(e,M_PI);
+      add(e,-M_PI);
+      add(e,0.);
+    }
+    return cands;
+  }
+
+  edm::View<reco::Candidate> makeView(const std::vector<reco::LeafCandidate>& cands) {
+    std::vector<void const*> pointers;
+    edm::FillViewHelperVector helpers;
+    for( unsigned i = 0; i < cands.size(); ++i ) {
+      pointers.push_back(static_cast<const reco::Candidate*>(&cands[i]));
+      helpers.emplace_back(edm::ProductID(1,1),i);
+    }
+    return edm::View<reco::Candidate>(pointers,helpers,nullptr);
+  }
+}
+
+int main() {
+  std::mt19937 engine(7);
+  std::uniform_int_distribution<unsigned> type(0, nTypes-2);
+  const auto directions = makeDirections(engine,200);
+
+  int failures = 0;
+  unsigned nFound = 0;
+  for( unsigned nRandom : {0u, 50u, 2000u} ) {
+    for( bool withCandidates : {true, false} ) {
+      const auto cands = withCandidates ? makeCandidates(engine,directions,nRandom) : std::vector<reco::LeafCandidate>();
+      const auto view = makeView(cands);
+      std::vector<unsigned> types(cands.size());
+      for( auto& t : types ) t = type(engine);
+
+      citk::CandidateGrid grid;
+      grid.fill(view,types,nTypes);
+      std::vector<unsigned> near;
+      for( const auto& d : directions ) {
+        for( float dr : {0.01f, 0.1f, 0.3f, 0.4f, 1.2f} ) {
+          for( unsigned t = 0; t < nTypes+1; ++t ) {
+            grid.near(t,d.eta,d.phi,dr,near);
+            if( !std::is_sorted(near.begin(),near.end()) ||
+                std::adjacent_find(near.begin(),near.end()) != near.end() ) {
+              std::cout << "unsorted or repeated candidates at eta " << d.eta << " phi " << d.phi << std::endl;
+              ++failures;
+            }
+            // the float arithmetic of the grid can be off by a few ulps at the boundaries
+            const double tolerance = 1.e-5;
+            for( unsigned i = 0; i < cands.size(); ++i ) {
+              const double dR = reco::deltaR(d.eta,d.phi,cands[i].eta(),cands[i].phi());
+              const bool found = std::binary_search(near.begin(),near.end(),i);
+              if( types[i] == t && dR < dr-tolerance && !found ) {
+                std::cout << "missing candidate " << i << " at eta " << cands[i].eta() << " phi " << cands[i].phi()
+                          << ", dR " << dR << " < " << dr << " from eta " << d.eta << " phi " << d.phi << std::endl;
+                ++failures;
+              }
+              if( found && (types[i] != t || dR > dr+citk::CandidateGrid::kMargin+tolerance) ) {
+                std::cout << "extra candidate " << i << " of type " << types[i] << " (not " << t << "), dR " << dR
+                          << " from eta " << d.eta << " phi " << d.phi << ", cone " << dr << std::endl;
+                ++failures;
+              }
+            }
+            nFound += near.size();
+          }
+        }
+      }
+    }
+  }
+  if( nFound == 0 ) {
+    std::cout << "no candidate found" << std::endl;
+    ++failures;
+  }
+  if( failures ) {
+    std::cout << failures << " failures" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -57,6 +57,9 @@ private:
   void openFile(edm::FileBlock const&) override;
   void reallyCloseFile() override;
 
+  void flushAutoFlushBaskets();
+  void flushBatch();
+
   std::string m_fileName;
   std::string m_logicalFileName;
   int m_compressionLevel;
@@ -65,6 +68,8 @@ private:
   bool m_writeProvenance;
   bool m_fakeName; //crab workaround, remove after crab is fixed
   int m_autoFlush;
+  unsigned int m_batchSize;
+  unsigned int m_eventsInBatch{0};
   edm::ProcessHistoryRegistry m_processHistoryRegistry;
   edm::JobReport::Token m_jrToken;
   std::unique_ptr<TFile> m_file;
@@ -75,15 +80,26 @@ private:
   class CommonEventBranches {
      public:
          void branch(TTree &tree) {
-            tree.Branch("run", & m_run, "run/i");
-            tree.Branch("luminosityBlock", & m_luminosityBlock, "luminosityBlock/i");
-            tree.Branch("event", & m_event, "event/l");
+            m_runBranch = tree.Branch("run", & m_run, "run/i");
+            m_luminosityBlockBranch = tree.Branch("luminosityBlock", & m_luminosityBlock, "luminosityBlock/i");
+            m_eventBranch = tree.Branch("event", & m_event, "event/l");
          }
          void fill(const edm::EventID & id) { 
             m_run = id.run(); m_luminosityBlock = id.luminosityBlock(); m_event = id.event(); 
          }
+         void addToBatch(const edm::EventID & id) { 
+            m_batch.push_back(id);
+         }
+         void flushBatch() {
+            for (const auto & id : m_batch) { m_run = id.run(); m_runBranch->Fill(); }
+            for (const auto & id : m_batch) { m_luminosityBlock = id.luminosityBlock(); m_luminosityBlockBranch->Fill(); }
+            for (const auto & id : m_batch) { m_event = id.event(); m_eventBranch->Fill(); }
+            m_batch.clear();
+         }
      private:
          UInt_t m_run; UInt_t m_luminosityBlock; ULong64_t m_event;
+         TBranch *m_runBranch, *m_luminosityBlockBranch, *m_eventBranch;
+         std::vector<edm::EventID> m_batch;
   } m_commonBranches;
 
   class CommonLumiBranches {
@@ -144,6 +160,7 @@ NanoAODOutputModule::NanoAODOutputModule(edm::ParameterSet const& pset):
   m_writeProvenance(pset.getUntrackedParameter<bool>("saveProvenance", true)),
   m_fakeName(pset.getUntrackedParameter<bool>("fakeNameForCrab", false)),
   m_autoFlush(pset.getUntrackedParameter<int>("autoFlush", -10000000)),
+  m_batchSize(pset.getUntrackedParameter<unsigned int>("batchSize", 0)),
   m_processHistoryRegistry()
 {
 }
@@ -158,39 +175,20 @@ NanoAODOutputModule::write(edm::EventForOutput const& iEvent) {
   edm::Service<edm::JobReport> jr;
   jr->eventWrittenToFile(m_jrToken, iEvent.id().run(), iEvent.id().event());
 
-  if (m_autoFlush) {
-    int64_t events = m_tree->GetEntriesFast();
-    if (events == m_firstFlush) {
-      m_tree->FlushBaskets();
-      float maxMemory;
-      if (m_autoFlush > 0) {
-        // Estimate the memory we'll be using at the first full flush by
-        // linearly scaling the number of events.
-        float percentClusterDone = m_firstFlush / static_cast<float>(m_autoFlush);
-        maxMemory = static_cast<float>(m_tree->GetTotBytes()) / percentClusterDone;
-      } else if (m_tree->GetZipBytes() == 0) {
-        maxMemory = 100*1024*1024; // Degenerate case of no information in the tree; arbitrary value
-      } else {
-        // Estimate the memory we'll be using by scaling the current compression ratio.
-        float cxnRatio = m_tree->GetTotBytes() / static_cast<float>(m_tree->GetZipBytes());
-        maxMemory = -m_autoFlush * cxnRatio;
-        float percentBytesDone = -m_tree->GetZipBytes() / static_cast<float>(m_autoFlush);
-        m_autoFlush = m_firstFlush / percentBytesDone;
-      }
-      //std::cout << "OptimizeBaskets: total bytes " << m_tree->GetTotBytes() << std::endl;
-      //std::cout << "OptimizeBaskets: zip bytes " << m_tree->GetZipBytes() << std::endl;
-      //std::cout << "OptimizeBaskets: autoFlush " << m_autoFlush << std::endl;
-      //std::cout << "OptimizeBaskets: maxMemory " << static_cast<uint32_t>(maxMemory) << std::endl;
-      //m_tree->OptimizeBaskets(static_cast<uint32_t>(maxMemory), 1, "d");
-      m_tree->OptimizeBaskets(static_cast<uint32_t>(maxMemory), 1, "");
-    }
-    if (m_eventsSinceFlush == m_autoFlush) {
-      m_tree->FlushBaskets();
-      m_eventsSinceFlush = 0;
+  if (m_batchSize) {
+    m_commonBranches.addToBatch(iEvent.id());
+    for (unsigned int extensions = 0; extensions <= 1; ++extensions) {
+        for (auto & t : m_tables) t.addToBatch(iEvent,*m_tree,extensions);
     }
-    m_eventsSinceFlush++;
+    for (auto & t : m_triggers) t.addToBatch(iEvent,*m_tree);
+    if (++m_eventsInBatch == m_batchSize) flushBatch();
+
+    m_processHistoryRegistry.registerProcessHistory(iEvent.processHistory());
+    return;
   }
 
+  if (m_autoFlush) flushAutoFlushBaskets();
+
   m_commonBranches.fill(iEvent.id());
   // fill all tables, starting from main tables and then doing extension tables
   for (unsigned int extensions = 0; extensions <= 1; ++extensions) {
@@ -203,6 +201,61 @@ NanoAODOutputModule::write(edm::EventForOutput const& iEvent) {
   m_processHistoryRegistry.registerProcessHistory(iEvent.processHistory());
 }
 
+void 
+NanoAODOutputModule::flushAutoFlushBaskets() {
+  int64_t events = m_tree->GetEntriesFast();
+  if (events == m_firstFlush) {
+    m_tree->FlushBaskets();
+    float maxMemory;
+    if (m_autoFlush > 0) {
+      // Estimate the memory we'll be using at the first full flush by
+      // linearly scaling the number of events.
+      float percentClusterDone = m_firstFlush / static_cast<float>(m_autoFlush);
+      maxMemory = static_cast<float>(m_tree->GetTotBytes()) / percentClusterDone;
+    } else if (m_tree->GetZipBytes() == 0) {
+      maxMemory = 100*1024*1024; // Degenerate case of no information in the tree; arbitrary value
+    } else {
+      // Estimate the memory we'll be using by scaling the current compression ratio.
+      float cxnRatio = m_tree->GetTotBytes() / static_cast<float>(m_tree->GetZipBytes());
+      maxMemory = -m_autoFlush * cxnRatio;
+      float percentBytesDone = -m_tree->GetZipBytes() / static_cast<float>(m_autoFlush);
+      m_autoFlush = m_firstFlush / percentBytesDone;
+    }
+    //std::cout << "OptimizeBaskets: total bytes " << m_tree->GetTotBytes() << std::endl;
+    //std::cout << "OptimizeBaskets: zip bytes " << m_tree->GetZipBytes() << std::endl;
+    //std::cout << "OptimizeBaskets: autoFlush " << m_autoFlush << std::endl;
+    //std::cout << "OptimizeBaskets: maxMemory " << static_cast<uint32_t>(maxMemory) << std::endl;
+    //m_tree->OptimizeBaskets(static_cast<uint32_t>(maxMemory), 1, "d");
+    m_tree->OptimizeBaskets(static_cast<uint32_t>(maxMemory), 1, "");
+  }
+  if (m_eventsSinceFlush == m_autoFlush) {
+    m_tree->FlushBaskets();
+    m_eventsSinceFlush = 0;
+  }
+  m_eventsSinceFlush++;
+}
+
+void 
+NanoAODOutputModule::flushBatch() {
+  if (m_eventsInBatch == 0) return;
+  // Fill the batch branch by branch: each branch receives all the events of the
+  // batch in a row from a contiguous buffer, without going through TTree::Fill.
+  m_commonBranches.flushBatch();
+  for (auto & t : m_tables) t.flushBatch();
+  for (auto & t : m_triggers) t.flushBatch();
+  m_tree->SetEntries(m_tree->GetEntries() + m_eventsInBatch);
+  bool firstBatch = (m_tree->GetEntries() == m_eventsInBatch);
+  m_eventsInBatch = 0;
+
+  // Each batch is a cluster. With ROOT implicit multi-threading enabled the
+  // baskets of the different branches are compressed in parallel.
+  m_tree->FlushBaskets();
+  if (firstBatch) {
+    // Size the baskets so that a whole batch fits in a single basket per branch.
+    m_tree->OptimizeBaskets(static_cast<ULong64_t>(m_tree->GetTotBytes()), 1, "");
+  }
+}
+
 void 
 NanoAODOutputModule::writeLuminosityBlock(edm::LuminosityBlockForOutput const& iLumi) {
   edm::Service<edm::JobReport> jr;
@@ -316,6 +369,7 @@ NanoAODOutputModule::openFile(edm::FileBlock const&) {
 }
 void 
 NanoAODOutputModule::reallyCloseFile() {
+  flushBatch();
   if (m_writeProvenance) {
       int basketSize = 16384; // fixme configurable?
       edm::fillParameterSetBranch(m_parameterSetsTree.get(), basketSize);
@@ -356,6 +410,9 @@ NanoAODOutputModule::fillDescriptions(edm::ConfigurationDescriptions& descriptio
         ->setComment("Change the OutputModule name in the fwk job report to fake PoolOutputModule. This is needed to run on cran (and publish) till crab is fixed");
   desc.addUntracked<int>("autoFlush", -10000000)
         ->setComment("Autoflush parameter for ROOT file");
+  desc.addUntracked<unsigned int>("batchSize", 0)
+        ->setComment("If not 0, accumulate the columns of this many events in contiguous buffers and fill the event tree "
+                     "one branch at a time, flushing the baskets after each batch. The batch size replaces autoFlush.");
 
   //replace with whatever you want to get from the EDM by default
   const std::vector<std::string> keep = {"drop *", "keep nanoaodFlatTable_*Table_*_*", "keep edmTriggerResults_*_*_*", "keep nanoaodMergeableCounterTable_*Table_*_*", "keep nanoaodUniqueString_nanoMetadata_*_*"};
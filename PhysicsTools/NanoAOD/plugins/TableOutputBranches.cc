@@ -61,10 +61,11 @@ TableOutputBranches::branch(TTree &tree)
     }
 }
 
-void TableOutputBranches::fill(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) 
+const nanoaod::FlatTable * 
+TableOutputBranches::prepareFill(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) 
 {
     if (m_extension != DontKnowYetIfMainOrExtension) {
-        if (extensions != m_extension) return; // do nothing, wait to be called with the proper flag
+        if (extensions != m_extension) return nullptr; // do nothing, wait to be called with the proper flag
     }
 
     edm::Handle<nanoaod::FlatTable> handle;
@@ -74,7 +75,7 @@ void TableOutputBranches::fill(const edm::EventForOutput &iEvent, TTree & tree,
     m_singleton = tab.singleton();
     if(!m_branchesBooked) {
         m_extension = tab.extension() ? IsExtension : IsMain;
-        if (extensions != m_extension) return; // do nothing, wait to be called with the proper flag
+        if (extensions != m_extension) return nullptr; // do nothing, wait to be called with the proper flag
         defineBranchesFromFirstEvent(tab);	
         m_doc = tab.doc();
         m_branchesBooked=true;
@@ -85,9 +86,42 @@ void TableOutputBranches::fill(const edm::EventForOutput &iEvent, TTree & tree,
             throw cms::Exception("LogicError", "Mismatch in number of entries between extension and main table for " + tab.name());
         }
     }
-    for (auto & pair : m_floatBranches) fillColumn<float>(pair, tab);
-    for (auto & pair : m_intBranches) fillColumn<int>(pair, tab);
-    for (auto & pair : m_uint8Branches) fillColumn<uint8_t>(pair, tab);
+    return &tab;
+}
+
+void TableOutputBranches::fill(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) 
+{
+    const nanoaod::FlatTable * tab = prepareFill(iEvent, tree, extensions);
+    if (!tab) return;
+    for (auto & pair : m_floatBranches) fillColumn<float>(pair, *tab);
+    for (auto & pair : m_intBranches) fillColumn<int>(pair, *tab);
+    for (auto & pair : m_uint8Branches) fillColumn<uint8_t>(pair, *tab);
+}
+
+void TableOutputBranches::addToBatch(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) 
+{
+    const nanoaod::FlatTable * tab = prepareFill(iEvent, tree, extensions);
+    if (!tab) return;
+    m_counterBatch.push_back(m_counter);
+    for (auto & pair : m_floatBranches) appendColumn<float>(pair, *tab);
+    for (auto & pair : m_intBranches) appendColumn<int>(pair, *tab);
+    for (auto & pair : m_uint8Branches) appendColumn<uint8_t>(pair, *tab);
 }
 
+void TableOutputBranches::flushBatch() 
+{
+    if (m_counterBatch.empty()) return;
+    // for extensions this is the counter of the main table, which has already been filled
+    UInt_t * counter = m_singleton ? nullptr : reinterpret_cast<UInt_t *>(m_counterBranch->GetAddress());
+    if (!m_singleton && m_extension == IsMain) {
+        for (UInt_t n : m_counterBatch) {
+            m_counter = n;
+            m_counterBranch->Fill();
+        }
+    }
+    for (auto & pair : m_floatBranches) flushColumn<float>(pair, counter);
+    for (auto & pair : m_intBranches) flushColumn<int>(pair, counter);
+    for (auto & pair : m_uint8Branches) flushColumn<uint8_t>(pair, counter);
+    m_counterBatch.clear();
+}
 
@@ -24,7 +24,17 @@ class TableOutputBranches {
     /// This parameter is used so that the fill is called first for non-extensions and then for extensions
     void fill(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) ;
 
+    /// Same as fill, but the columns are copied at the end of contiguous per-branch buffers
+    /// instead of being exposed to the tree; flushBatch then fills the branches one after the other
+    void addToBatch(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) ;
+    /// Fill the branches with all the events accumulated by addToBatch, and empty the buffers.
+    /// The caller has to update the number of entries of the tree afterwards.
+    void flushBatch() ;
+
  private:
+    /// Read the table and book the branches if needed; returns nullptr if the table must not be filled in this pass
+    const nanoaod::FlatTable * prepareFill(const edm::EventForOutput &iEvent, TTree & tree, bool extensions) ;
+
     edm::EDGetToken m_token;
     std::string  m_baseName;
     bool         m_singleton;
@@ -34,6 +44,7 @@ class TableOutputBranches {
     struct NamedBranchPtr {
         std::string name, title, rootTypeCode;
         TBranch * branch;
+        std::vector<char> batch;
         NamedBranchPtr(const std::string & aname, const std::string & atitle, const std::string & rootType, TBranch *branchptr = nullptr) : 
             name(aname), title(atitle), rootTypeCode(rootType), branch(branchptr) {}
     };
@@ -42,6 +53,7 @@ class TableOutputBranches {
     std::vector<NamedBranchPtr>   m_intBranches;
     std::vector<NamedBranchPtr> m_uint8Branches;
     bool m_branchesBooked;
+    std::vector<UInt_t> m_counterBatch;
 
     template<typename T>
     void fillColumn(NamedBranchPtr & pair, const nanoaod::FlatTable & tab) {
@@ -50,6 +62,28 @@ class TableOutputBranches {
         pair.branch->SetAddress( const_cast<T *>(& tab.columnData<T>(idx).front() ) ); // SetAddress should take a const * !
     }
 
+    template<typename T>
+    void appendColumn(NamedBranchPtr & pair, const nanoaod::FlatTable & tab) {
+        int idx = tab.columnIndex(pair.name);
+        if (idx == -1) throw cms::Exception("LogicError", "Missing column in input for "+m_baseName+"_"+pair.name);
+        const auto & data = tab.columnData<T>(idx);
+        if (data.empty()) return;
+        const char * begin = reinterpret_cast<const char *>(& data.front());
+        pair.batch.insert(pair.batch.end(), begin, begin + data.size()*sizeof(T));
+    }
+
+    template<typename T>
+    void flushColumn(NamedBranchPtr & pair, UInt_t * counter) {
+        size_t offset = 0;
+        for (UInt_t n : m_counterBatch) {
+            if (counter) *counter = n; // the leaf count is read at each fill of a variable-size branch
+            pair.branch->SetAddress(pair.batch.data() + offset);
+            pair.branch->Fill();
+            offset += n*sizeof(T);
+        }
+        pair.batch.clear();
+    }
+
 };
 
 #endif
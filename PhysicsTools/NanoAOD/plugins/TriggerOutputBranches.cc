@@ -72,7 +72,7 @@ edm::TriggerNames TriggerOutputBranches::triggerNames(const edm::TriggerResults
     return edm::TriggerNames();
 }
 
-void TriggerOutputBranches::fill(const edm::EventForOutput &iEvent,TTree & tree) 
+const edm::TriggerResults & TriggerOutputBranches::prepareFill(const edm::EventForOutput &iEvent,TTree & tree) 
 {
     edm::Handle<edm::TriggerResults> handle;
     iEvent.getByToken(m_token, handle);
@@ -83,9 +83,36 @@ void TriggerOutputBranches::fill(const edm::EventForOutput &iEvent,TTree & tree)
         m_lastRun=iEvent.id().run();
         updateTriggerNames(tree,names,triggers);
     }
+    return triggers;
+}
+
+void TriggerOutputBranches::fill(const edm::EventForOutput &iEvent,TTree & tree) 
+{
+    const edm::TriggerResults & triggers = prepareFill(iEvent,tree);
     for (auto & pair : m_triggerBranches) fillColumn<uint8_t>(pair, triggers);
     m_fills++; 
 }
 
+void TriggerOutputBranches::addToBatch(const edm::EventForOutput &iEvent,TTree & tree) 
+{
+    // New branches are back filled up to m_fills, which also counts the events still in the batch,
+    // so the entries stay aligned once the batch is flushed
+    const edm::TriggerResults & triggers = prepareFill(iEvent,tree);
+    for (auto & nb : m_triggerBranches) {
+        if(nb.idx>=0) nb.buffer=triggers.accept(nb.idx);
+        nb.batch.push_back(nb.buffer);
+    }
+    m_fills++; 
+}
 
-
+void TriggerOutputBranches::flushBatch() 
+{
+    for (auto & nb : m_triggerBranches) {
+        nb.branch->SetAddress(&(nb.buffer));
+        for (uint8_t bit : nb.batch) {
+            nb.buffer=bit;
+            nb.branch->Fill();
+        }
+        nb.batch.clear();
+    }
+}
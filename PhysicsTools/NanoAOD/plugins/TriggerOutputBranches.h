@@ -20,9 +20,13 @@ class TriggerOutputBranches {
 
     void updateTriggerNames(TTree &tree,const edm::TriggerNames & names, const edm::TriggerResults & ta);
     void fill(const edm::EventForOutput &iEvent,TTree & tree) ;
+    /// Same as fill, but the bits are accumulated in per-branch buffers until flushBatch is called
+    void addToBatch(const edm::EventForOutput &iEvent,TTree & tree) ;
+    void flushBatch() ;
 
  private:
     edm::TriggerNames triggerNames(const edm::TriggerResults triggerResults); //FIXME: if we have to keep it local we may use PsetID check per event instead of run boundary
+    const edm::TriggerResults & prepareFill(const edm::EventForOutput &iEvent,TTree & tree) ;
 
     edm::EDGetToken m_token;
     std::string  m_baseName;
@@ -33,6 +37,7 @@ class TriggerOutputBranches {
 	int idx;
         TBranch * branch;
 	uint8_t buffer;
+	std::vector<uint8_t> batch;
         NamedBranchPtr(const std::string & aname, const std::string & atitle, TBranch *branchptr = nullptr) : 
             name(aname), title(atitle), branch(branchptr), buffer(-1) {}
     };
@@ -0,0 +1,75 @@
+// Produces flat tables that depend only on the event ID, for the tests of
+// NanoAODOutputModule: a table with a number of rows that changes from event to
+// event (including empty ones), an extension of it, and a singleton table,
+// with columns of all the types.
+
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/NanoAOD/interface/FlatTable.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class NanoAODTestTableProducer : public edm::global::EDProducer<> {
+    public:
+        NanoAODTestTableProducer( edm::ParameterSet const & params ) :
+            name_(params.getParameter<std::string>("name")),
+            maxRows_(params.getParameter<unsigned int>("maxRows"))
+        {
+            produces<nanoaod::FlatTable>();
+            produces<nanoaod::FlatTable>("extension");
+            produces<nanoaod::FlatTable>("event");
+        }
+
+        void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override {
+            const unsigned long long event = iEvent.id().event();
+            const unsigned int nRows = event % (maxRows_+1);
+
+            std::vector<float> x(nRows), y(nRows);
+            std::vector<int> i(nRows);
+            std::vector<uint8_t> u(nRows), b(nRows);
+            for (unsigned int row = 0; row < nRows; ++row) {
+                x[row] = 0.25f*event + row;
+                y[row] = -1.5f*row;
+                i[row] = int(event*10 + row) * (row % 2 ? -1 : 1);
+                u[row] = (event + row) % 256;
+                b[row] = (event + row) % 3 == 0;
+            }
+
+            auto table = std::make_unique<nanoaod::FlatTable>(nRows, name_, false);
+            table->addColumn<float>("x", x, "float column", nanoaod::FlatTable::FloatColumn);
+            table->addColumn<float>("xReduced", x, "float column with reduced mantissa", nanoaod::FlatTable::FloatColumn, 10);
+            table->addColumn<int>("i", i, "int column", nanoaod::FlatTable::IntColumn);
+            table->addColumn<uint8_t>("u", u, "uint8 column", nanoaod::FlatTable::UInt8Column);
+            table->addColumn<uint8_t>("b", b, "bool column", nanoaod::FlatTable::BoolColumn);
+
+            auto extension = std::make_unique<nanoaod::FlatTable>(nRows, name_, false, true);
+            extension->addColumn<float>("y", y, "float column of the extension", nanoaod::FlatTable::FloatColumn);
+
+            auto singleton = std::make_unique<nanoaod::FlatTable>(1, name_+"Event", true);
+            singleton->addColumnValue<int>("nRows", nRows, "number of rows", nanoaod::FlatTable::IntColumn);
+            singleton->addColumnValue<float>("sumX", 0.25f*event*nRows, "float value", nanoaod::FlatTable::FloatColumn);
+
+            iEvent.put(std::move(table));
+            iEvent.put(std::move(extension), "extension");
+            iEvent.put(std::move(singleton), "event");
+        }
+
+        static void fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+            edm::ParameterSetDescription desc;
+            desc.add<std::string>("name", "Test")->setComment("name of the tables");
+            desc.add<unsigned int>("maxRows", 4)->setComment("the tables have event%(maxRows+1) rows");
+            descriptions.add("nanoAODTestTableProducer", desc);
+        }
+
+    private:
+        const std::string name_;
+        const unsigned int maxRows_;
+};
+
+DEFINE_FWK_MODULE(NanoAODTestTableProducer);
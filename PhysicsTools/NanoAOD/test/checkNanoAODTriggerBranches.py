@@ -0,0 +1,37 @@
+#!/usr/bin/env python
+# Checks the trigger branches written by testNanoAODBatch_cfg.py: one per path
+# of testNanoAODBatchHLT_cfg.py, without the version, HLT_Pre2 and HLT_NotPre2
+# complementary and both changing, and HLT_New back filled with false for the
+# runs before the one in which its path appears.
+# Usage: checkNanoAODTriggerBranches.py <file>
+from __future__ import print_function
+import sys
+import ROOT
+
+firstRunWithNewPath = 3
+
+f = ROOT.TFile.Open(sys.argv[1])
+events = f.Get("Events")
+errors = []
+branches = set(b.GetName() for b in events.GetListOfBranches())
+for name in ["HLT_Pre2", "HLT_NotPre2", "Flag_Pre3", "HLT_New"]:
+    if name not in branches:
+        errors.append("no branch %s" % name)
+if not errors:
+    pre2 = set()
+    for entry in range(events.GetEntries()):
+        events.GetEntry(entry)
+        pre2.add(bool(events.HLT_Pre2))
+        if bool(events.HLT_Pre2) == bool(events.HLT_NotPre2):
+            errors.append("entry %d: HLT_Pre2 and HLT_NotPre2 both %s" % (entry, bool(events.HLT_Pre2)))
+        if events.run < firstRunWithNewPath:
+            expected = False
+        else:
+            expected = events.event % 2 == 1
+        if bool(events.HLT_New) != expected:
+            errors.append("entry %d, run %d, event %d: HLT_New %s" % (entry, events.run, events.event, bool(events.HLT_New)))
+    if pre2 != set([True, False]):
+        errors.append("HLT_Pre2 does not change")
+for e in errors:
+    print(e)
+sys.exit(1 if errors else 0)
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# Compares the Events, LuminosityBlocks and Runs trees of two NanoAOD files
+# entry by entry: same branches, same number of entries, and for each entry
+# the same values of all the leaves.
+# Usage: compareNanoAODTrees.py <reference file> <file>
+from __future__ import print_function
+import sys
+import ROOT
+
+def leafValues(tree, leaves):
+    return [tuple(leaf.GetValue(i) for i in range(leaf.GetLen())) for leaf in leaves]
+
+def compareTree(name, ref, new):
+    tref = ref.Get(name)
+    tnew = new.Get(name)
+    if not tref or not tnew:
+        return ["%s: missing tree" % name]
+    refBranches = sorted(b.GetName() for b in tref.GetListOfBranches())
+    newBranches = sorted(b.GetName() for b in tnew.GetListOfBranches())
+    if refBranches != newBranches:
+        return ["%s: different branches %s and %s" % (name, refBranches, newBranches)]
+    if tref.GetEntries() != tnew.GetEntries():
+        return ["%s: %d and %d entries" % (name, tref.GetEntries(), tnew.GetEntries())]
+    refLeaves = [tref.GetBranch(b).GetLeaf(b) for b in refBranches]
+    newLeaves = [tnew.GetBranch(b).GetLeaf(b) for b in refBranches]
+    errors = []
+    for entry in range(tref.GetEntries()):
+        tref.GetEntry(entry)
+        tnew.GetEntry(entry)
+        for branch, vref, vnew in zip(refBranches, leafValues(tref, refLeaves), leafValues(tnew, newLeaves)):
+            if vref != vnew:
+                errors.append("%s: entry %d, branch %s: %s and %s" % (name, entry, branch, vref, vnew))
+    return errors
+
+ref = ROOT.TFile.Open(sys.argv[1])
+new = ROOT.TFile.Open(sys.argv[2])
+errors = []
+for name in ["Events", "LuminosityBlocks", "Runs"]:
+    errors += compareTree(name, ref, new)
+if ref.Get("Events").GetEntries() == 0:
+    errors.append("no events in %s" % sys.argv[1])
+for e in errors:
+    print(e)
+sys.exit(1 if errors else 0)
@@ -38,6 +38,7 @@ process.out = cms.OutputModule("NanoAODOutputModule",
     outputCommands = process.NanoAODEDMEventContent.outputCommands,
    #compressionLevel = cms.untracked.int32(9),
     #compressionAlgorithm = cms.untracked.string("LZMA"),
+    #batchSize = cms.untracked.uint32(1000),
 
 )
 process.out1 = cms.OutputModule("NanoAODOutputModule",
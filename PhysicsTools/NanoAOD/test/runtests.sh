@@ -2,6 +2,14 @@
 
 function die { echo $1: status $2 ;  exit $2; }
 
+cmsRun ${LOCAL_TEST_DIR}/testNanoAODBatchHLT_cfg.py firstRun=1 events=17 fileName=testNanoAODBatchHLT_1.root || die 'Failure using testNanoAODBatchHLT_cfg.py for runs 1 and 2' $?
+cmsRun ${LOCAL_TEST_DIR}/testNanoAODBatchHLT_cfg.py firstRun=3 events=13 newPath=True fileName=testNanoAODBatchHLT_3.root || die 'Failure using testNanoAODBatchHLT_cfg.py for run 3' $?
+cmsRun ${LOCAL_TEST_DIR}/testNanoAODBatch_cfg.py || die 'Failure using testNanoAODBatch_cfg.py' $?
+#checks the trigger branches and compares the files from above
+python ${LOCAL_TEST_DIR}/checkNanoAODTriggerBranches.py testNanoAODBatch_0.root || die 'Failure checking the trigger branches of batchSize 0' $?
+python ${LOCAL_TEST_DIR}/compareNanoAODTrees.py testNanoAODBatch_0.root testNanoAODBatch_7.root || die 'Failure comparing batchSize 7 to batchSize 0' $?
+python ${LOCAL_TEST_DIR}/compareNanoAODTrees.py testNanoAODBatch_0.root testNanoAODBatch_64.root || die 'Failure comparing batchSize 64 to batchSize 0' $?
+
 #to be enabled with the right files
 #cmsDriver.py test80X -s NANO --mc --eventcontent NANOAODSIM --datatier NANO --filein /store/relval/CMSSW_8_0_0/RelValTTbar_13/MINIAODSIM/PU25ns_80X_mcRun2_asymptotic_v4-v1/10000/A65CD249-BFDA-E511-813A-0025905A6066.root    --conditions auto:run2_mc -n 100 --era Run2_2016,run2_miniAOD_80XLegacy || die 'Failure using cmsdriver 80X' $?
 #cmsDriver.py test92X -s NANO --mc --eventcontent NANOAODSIM --datatier NANOAODSIM --filein /store/relval/CMSSW_9_2_12/RelValTTbar_13/MINIAODSIM/PU25ns_92X_upgrade2017_realistic_v11-v1/00000/080E2624-F59D-E711-ACEE-0CC47A7C35A4.root  --conditions auto:phase1_2017_realistic -n 100 --era Run2_2017,run2_nanoAOD_92X || die 'Failure using cmsdriver 92X' $?
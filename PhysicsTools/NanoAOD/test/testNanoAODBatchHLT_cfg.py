@@ -0,0 +1,67 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Writes events with trigger results of HLT_* and Flag_* paths, for
+# testNanoAODBatch_cfg.py. With newPath=True, the menu has one more path, so
+# that NanoAODOutputModule books its branch when it reaches these events.
+
+options = VarParsing.VarParsing()
+options.register('firstRun',
+                 1, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "First run number.")
+options.register('events',
+                 17, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of events.")
+options.register('newPath',
+                 False, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.bool,
+                 "Add the path HLT_New_v3.")
+options.register('fileName',
+                 'testNanoAODBatchHLT.root', # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Output file.")
+options.parseArguments()
+
+process = cms.Process("HLT")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.events))
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(options.firstRun),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(4),
+    numberEventsInRun = cms.untracked.uint32(12)
+)
+
+process.pre2 = cms.EDFilter("Prescaler",
+    prescaleFactor = cms.int32(2),
+    prescaleOffset = cms.int32(0)
+)
+process.pre3 = cms.EDFilter("Prescaler",
+    prescaleFactor = cms.int32(3),
+    prescaleOffset = cms.int32(1)
+)
+
+process.HLT_Pre2_v1 = cms.Path(process.pre2)
+process.Flag_Pre3 = cms.Path(process.pre3)
+process.HLT_NotPre2_v1 = cms.Path(~process.pre2)
+
+if options.newPath:
+    process.odd = cms.EDFilter("ModuloEventIDFilter",
+        modulo = cms.uint32(2),
+        offset = cms.uint32(1)
+    )
+    process.HLT_New_v3 = cms.Path(process.odd)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string(options.fileName)
+)
+
+process.end = cms.EndPath(process.out)
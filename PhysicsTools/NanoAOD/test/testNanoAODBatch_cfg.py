@@ -0,0 +1,48 @@
+import FWCore.ParameterSet.Config as cms
+
+# Writes the same events with the event-by-event filling of NanoAODOutputModule
+# and with batches that do not divide the number of events, to be compared by
+# compareNanoAODTrees.py.
+#
+# The events come from the files of testNanoAODBatchHLT_cfg.py: runs 1 and 2
+# with the paths HLT_Pre2, HLT_NotPre2 and Flag_Pre3, then run 3 with HLT_New
+# in addition. Its branch is booked, and back filled, at the first event of run
+# 3, the 18th, in the middle of the third batch of 7 events.
+
+process = cms.Process("NANOTEST")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:testNanoAODBatchHLT_1.root",
+                                      "file:testNanoAODBatchHLT_3.root")
+)
+
+process.testTable = cms.EDProducer("NanoAODTestTableProducer",
+    name = cms.string("Test"),
+    maxRows = cms.uint32(4)
+)
+
+process.tables = cms.Path(process.testTable)
+
+outputCommands = cms.untracked.vstring("drop *",
+                                       "keep nanoaodFlatTable_*Table_*_*",
+                                       "keep edmTriggerResults_*_*_HLT")
+
+process.outEvent = cms.OutputModule("NanoAODOutputModule",
+    fileName = cms.untracked.string('testNanoAODBatch_0.root'),
+    outputCommands = outputCommands,
+    batchSize = cms.untracked.uint32(0)
+)
+# 4 full batches and a partial one of 2 events, flushed when the file is closed
+process.outBatch = process.outEvent.clone(
+    fileName = cms.untracked.string('testNanoAODBatch_7.root'),
+    batchSize = cms.untracked.uint32(7)
+)
+# a single partial batch
+process.outLargeBatch = process.outEvent.clone(
+    fileName = cms.untracked.string('testNanoAODBatch_64.root'),
+    batchSize = cms.untracked.uint32(64)
+)
+
+process.end = cms.EndPath(process.outEvent+process.outBatch+process.outLargeBatch)
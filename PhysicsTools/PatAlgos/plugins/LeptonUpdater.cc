@@ -10,6 +10,7 @@
 #include "DataFormats/PatCandidates/interface/Muon.h"
 #include "DataFormats/PatCandidates/interface/Electron.h"
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
 #include "DataFormats/MuonReco/interface/MuonSelectors.h"
 
 namespace pat {
@@ -122,7 +123,12 @@ void pat::LeptonUpdater<T>::produce(edm::StreamID, edm::Event& iEvent, edm::Even
     const reco::Vertex & pv = vertices->front();
 
     edm::Handle<pat::PackedCandidateCollection> pc;
-    if(computeMiniIso_) iEvent.getByToken(pcToken_, pc);
+    // decoded once, for all the leptons
+    pat::PackedCandidateSoA pcs;
+    if(computeMiniIso_) {
+        iEvent.getByToken(pcToken_, pc);
+        pcs.fill(*pc);
+    }
 
     std::unique_ptr<std::vector<T>> out(new std::vector<T>(*src));
 
@@ -133,7 +139,7 @@ void pat::LeptonUpdater<T>::produce(edm::StreamID, edm::Event& iEvent, edm::Even
         setDZ(lep, pv);
         if (computeMiniIso_) {
             const auto & params = miniIsoParams(lep);
-            pat::PFIsolation miniiso = pat::getMiniPFIsolation(pc.product(), lep.p4(),
+            pat::PFIsolation miniiso = pat::getMiniPFIsolation(pcs, lep.p4(),
                                                                params[0], params[1], params[2],
                                                                params[3], params[4], params[5],
                                                                params[6], params[7], params[8]);
@@ -10,6 +10,7 @@
 
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
 #include "DataFormats/PatCandidates/interface/PFIsolation.h"
 #include "DataFormats/Math/interface/LorentzVector.h"
 
@@ -25,6 +26,13 @@ namespace pat{
                                    float deadcone_pu=0.01, float deadcone_ph=0.01, float deadcone_nh=0.01,
                                    float dZ_cut=0.0);
 
+  // the same, from the candidates decoded once per event
+  PFIsolation getMiniPFIsolation(const pat::PackedCandidateSoA &pfcands, const math::XYZTLorentzVector& p4,
+                                   float mindr=0.05, float maxdr=0.2, float kt_scale=10.0,
+                                   float ptthresh=0.5, float deadcone_ch=0.0001,
+                                   float deadcone_pu=0.01, float deadcone_ph=0.01, float deadcone_nh=0.01,
+                                   float dZ_cut=0.0);
+
   float muonRelMiniIsoPUCorrected(const PFIsolation& iso,
 				  const math::XYZTLorentzVector& p4,
 				  float dr,
@@ -55,6 +55,42 @@ PFIsolation getMiniPFIsolation(const pat::PackedCandidateCollection *pfcands,
 
 }
 
+// The same, reading pt, eta, phi and dz from the decoded arrays: the candidates
+// are not unpacked, apart from the charged hadrons in the cone for fromPV().
+// The values are the ones of the cartesian p4 of the candidates, as above, so
+// that the result is the same.
+PFIsolation getMiniPFIsolation(const pat::PackedCandidateSoA &pfcands,
+                                 const math::XYZTLorentzVector &p4, float mindr, float maxdr,
+                                 float kt_scale, float ptthresh, float deadcone_ch,
+                                 float deadcone_pu, float deadcone_ph, float deadcone_nh,
+                                 float dZ_cut)
+{
+    float chiso=0, nhiso=0, phiso=0, puiso=0;
+    float drcut = miniIsoDr(p4,mindr,maxdr,kt_scale);
+    const double eta = p4.eta(), phi = p4.phi();
+    for(unsigned int i=0, n=pfcands.size(); i<n; ++i){
+        float dr = reco::deltaR(eta, phi, pfcands.cartesianEta[i], pfcands.cartesianPhi[i]);
+        if(dr>drcut)
+            continue;
+        float pt = pfcands.cartesianPt[i];
+        int id = std::abs(pfcands.pdgId[i]);
+        if(id==211){
+            bool fromPV = (std::abs(pfcands.dz[i]) < dZ_cut || pfcands.candidate(i).fromPV()>1);
+            if(fromPV && dr > deadcone_ch){
+                chiso += pt;
+            }else if(!fromPV && pt > ptthresh && dr > deadcone_pu){
+                puiso += pt;
+            }
+        }
+        if(id==130 && pt>ptthresh && dr>deadcone_nh)
+            nhiso += pt;
+        if(id==22 && pt>ptthresh && dr>deadcone_ph)
+            phiso += pt;
+    }
+
+    return pat::PFIsolation(chiso, nhiso, phiso, puiso);
+}
+
   float muonRelMiniIsoPUCorrected(const PFIsolation& iso,
 				  const math::XYZTLorentzVector& p4,
 				  float dr,
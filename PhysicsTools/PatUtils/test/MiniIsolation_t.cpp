@@ -0,0 +1,115 @@
+// Checks that getMiniPFIsolation gives the same isolation from the decoded
+// PackedCandidateSoA as from the collection of packed candidates, for leptons of
+// several pt (so several cone sizes) and directions, including across phi = +-pi,
+// and candidates of all the kinds (charged from the PV or not, neutral hadrons,
+// photons, leptons) around them, some of them in the dead cones.
+
+#include "DataFormats/Common/interface/TestHandle.h"
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "PhysicsTools/PatUtils/interface/MiniIsolation.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace {
+
+  reco::VertexCollection makeVertices() {
+    reco::VertexCollection vertices;
+    reco::Vertex::Error error;
+    error(0,0) = error(1,1) = error(2,2) = 0.01;
+    vertices.emplace_back(reco::Vertex::Point(0.01, -0.02, 0.5), error, 20., 30., 17);
+    vertices.emplace_back(reco::Vertex::Point(0.02, 0.01, -3.2), error, 5., 3., 3);
+    vertices.emplace_back(reco::Vertex::Point(-0.01, 0.02, 7.1), error, 8., 10., 7);
+    return vertices;
+  }
+
+  pat::PackedCandidateCollection makeCandidates(const math::XYZTLorentzVector& lepton, const reco::VertexRefProd& pvs,
+                                                std::mt19937& engine) {
+    const int pdgIds[] = {211, -211, 130, 22, 11, -13};
+    const pat::PackedCandidate::PVAssociationQuality qualities[] = {
+      pat::PackedCandidate::NotReconstructedPrimary, pat::PackedCandidate::OtherDeltaZ,
+      pat::PackedCandidate::CompatibilityBTag, pat::PackedCandidate::CompatibilityDz,
+      pat::PackedCandidate::UsedInFitLoose, pat::PackedCandidate::UsedInFitTight};
+    std::uniform_int_distribution<int> kind(0, 5), vertex(0, 2);
+    std::uniform_real_distribution<double> logPt(std::log(0.2), std::log(50.)), dR(0., 0.3), angle(-M_PI, M_PI),
+      deadCone(0., 0.02), dz(-1., 1.);
+    pat::PackedCandidateCollection cands;
+    for (int i = 0; i < 400; ++i) {
+      // a few in and around the dead cones
+      const double r = (i % 5 == 0) ? deadCone(engine) : dR(engine), a = angle(engine);
+      const double eta = lepton.eta() + r * std::cos(a), phi = reco::reduceRange(lepton.phi() + r * std::sin(a));
+      const double pt = std::exp(logPt(engine));
+      const int pdgId = pdgIds[kind(engine)];
+      const int key = std::abs(pdgId) == 211 || std::abs(pdgId) == 11 || std::abs(pdgId) == 13 ? vertex(engine) : 0;
+      const pat::PackedCandidate::Point v(0., 0., (*pvs)[key].z() + 0.1 * dz(engine));
+      if (i % 2) {
+        pat::PackedCandidate::PolarLorentzVector p4(pt, eta, phi, std::abs(pdgId) == 211 ? 0.14 : 0.);
+        cands.emplace_back(p4, v, pt, eta, phi, pdgId, pvs, key);
+      } else {
+        // the cartesian p4 of these ones is kept as it is given
+        pat::PackedCandidate::LorentzVector p4(pat::PackedCandidate::PolarLorentzVector(pt, eta, phi, 0.));
+        cands.emplace_back(p4, v, pt, eta, phi, pdgId, pvs, key);
+      }
+      cands.back().setAssociationQuality(qualities[kind(engine)]);
+    }
+    return cands;
+  }
+
+  bool same(const pat::PFIsolation& a, const pat::PFIsolation& b) {
+    return a.chargedHadronIso() == b.chargedHadronIso() && a.neutralHadronIso() == b.neutralHadronIso() &&
+      a.photonIso() == b.photonIso() && a.puChargedHadronIso() == b.puChargedHadronIso();
+  }
+}
+
+int main() {
+  std::mt19937 engine(2018);
+  const auto vertices = makeVertices();
+  const reco::VertexRefProd pvs(edm::TestHandle<reco::VertexCollection>(&vertices, edm::ProductID(1, 1)));
+
+  int failures = 0;
+  unsigned int nonZero = 0;
+  for (double pt : {3., 20., 55., 300.}) {
+    for (double phi : {-M_PI + 0.01, -1.2, 0., 2.3, M_PI - 0.02}) {
+      for (double eta : {-2.3, 0.1, 1.7}) {
+        const math::XYZTLorentzVector lepton(math::PtEtaPhiMLorentzVector(pt, eta, phi, 0.106));
+        const auto cands = makeCandidates(lepton, pvs, engine);
+        const pat::PackedCandidateSoA soa(cands);
+        // the electron and muon parameters of the PAT updaters, and the default ones
+        for (float dZ_cut : {0.f, 0.1f}) {
+          const auto soaIso = pat::getMiniPFIsolation(soa, lepton, 0.05, 0.2, 10., 0.5, 0.0001, 0.01, 0.01, 0.01, dZ_cut);
+          const auto iso = pat::getMiniPFIsolation(&cands, lepton, 0.05, 0.2, 10., 0.5, 0.0001, 0.01, 0.01, 0.01, dZ_cut);
+          if (!same(iso, soaIso)) {
+            std::cout << "lepton pt " << pt << " eta " << eta << " phi " << phi << " dZ cut " << dZ_cut
+                      << ": charged " << iso.chargedHadronIso() << " " << soaIso.chargedHadronIso()
+                      << ", neutral " << iso.neutralHadronIso() << " " << soaIso.neutralHadronIso()
+                      << ", photon " << iso.photonIso() << " " << soaIso.photonIso()
+                      << ", pileup " << iso.puChargedHadronIso() << " " << soaIso.puChargedHadronIso() << std::endl;
+            ++failures;
+          }
+          if (iso.chargedHadronIso() > 0 && iso.puChargedHadronIso() > 0 && iso.neutralHadronIso() > 0 && iso.photonIso() > 0)
+            ++nonZero;
+        }
+        const auto soaIso = pat::getMiniPFIsolation(soa, lepton);
+        const auto iso = pat::getMiniPFIsolation(&cands, lepton);
+        if (!same(iso, soaIso)) {
+          std::cout << "lepton pt " << pt << " eta " << eta << " phi " << phi << ": different default isolations" << std::endl;
+          ++failures;
+        }
+      }
+    }
+  }
+  // the candidates must fill all the sums
+  if (nonZero == 0) {
+    std::cout << "no isolation with all the sums" << std::endl;
+    ++failures;
+  }
+  if (failures) {
+    std::cout << failures << " failures" << std::endl;
+    return 1;
+  }
+  return 0;
+}
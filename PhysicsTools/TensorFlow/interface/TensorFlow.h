@@ -19,6 +19,9 @@
 
 #include "FWCore/Utilities/interface/Exception.h"
 
+#include <atomic>
+#include <memory>
+
 namespace tensorflow
 {
 
@@ -80,30 +83,70 @@ Session* createSession(GraphDef* graphDef, int nThreads = 1);
 // closes a session, calls its destructor, resets the pointer, and returns true on success
 bool closeSession(Session*& session);
 
+// Session::Run is thread-safe, so the run functions take a const session which can be shared by
+// several streams
+
 // run the session with inputs, outputNames and targetNodes, and store output tensors
 // throws a cms exception when not successful
-void run(Session* session, const NamedTensorList& inputs,
+void run(const Session* session, const NamedTensorList& inputs,
     const std::vector<std::string>& outputNames, const std::vector<std::string>& targetNodes,
     std::vector<Tensor>* outputs);
 
 // run the session with inputNames, inputTensors, outputNames and targetNodes, and store output
 // tensors
 // throws a cms exception when not successful
-void run(Session* session, const std::vector<std::string>& inputNames,
+void run(const Session* session, const std::vector<std::string>& inputNames,
     const std::vector<Tensor>& inputTensors, const std::vector<std::string>& outputNames,
     const std::vector<std::string>& targetNodes, std::vector<Tensor>* outputs);
 
 // run the session with inputs and outputNames, and store output tensors
 // throws a cms exception when not successful
-void run(Session* session, const NamedTensorList& inputs,
+void run(const Session* session, const NamedTensorList& inputs,
     const std::vector<std::string>& outputNames, std::vector<Tensor>* outputs);
 
 // run the session with inputNames, inputTensors and outputNames, and store output tensors
 // throws a cms exception when not successful
-void run(Session* session, const std::vector<std::string>& inputNames,
+void run(const Session* session, const std::vector<std::string>& inputNames,
     const std::vector<Tensor>& inputTensors, const std::vector<std::string>& outputNames,
     std::vector<Tensor>* outputs);
 
+// a graph def loaded from a protobuf file and a session running it, to be shared by all the
+// streams and modules using the same graph, so that its weights are in memory only once per
+// process; the number of runs and their total time are counted
+class SessionCache
+{
+public:
+    SessionCache(const std::string& pbFile, SessionOptions& sessionOptions);
+    ~SessionCache();
+
+    SessionCache(const SessionCache&) = delete;
+    SessionCache& operator=(const SessionCache&) = delete;
+
+    const std::string& pbFile() const { return pbFile_; }
+    const Session* getSession() const { return session_; }
+
+    // run the session with inputs and outputNames, and store output tensors
+    // throws a cms exception when not successful
+    void run(const NamedTensorList& inputs, const std::vector<std::string>& outputNames,
+        std::vector<Tensor>* outputs) const;
+
+    // number of runs, and their total time in seconds
+    unsigned long long nRuns() const { return nRuns_; }
+    double runTime() const { return 1e-9 * runNanoseconds_; }
+
+private:
+    std::string pbFile_;
+    GraphDef* graphDef_;
+    Session* session_;
+    mutable std::atomic<unsigned long long> nRuns_;
+    mutable std::atomic<unsigned long long> runNanoseconds_;
+};
+
+// returns the cache of the graph at pbFile for the threading options of sessionOptions, which is
+// created by the first caller and shared with all the others until the last one releases it
+std::shared_ptr<SessionCache> getSessionCache(const std::string& pbFile,
+    SessionOptions& sessionOptions);
+
 } // namespace tensorflow
 
 #endif // PHYSICSTOOLS_TENSORFLOW_TENSORFLOW_H
@@ -8,6 +8,12 @@
 
 #include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
 
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
 namespace tensorflow
 {
 
@@ -207,7 +213,7 @@ bool closeSession(Session*& session)
     return status.ok();
 }
 
-void run(Session* session, const NamedTensorList& inputs,
+void run(const Session* session, const NamedTensorList& inputs,
     const std::vector<std::string>& outputNames, const std::vector<std::string>& targetNodes,
     std::vector<Tensor>* outputs)
 {
@@ -217,7 +223,8 @@ void run(Session* session, const NamedTensorList& inputs,
     }
 
     // run and check the status
-    Status status = session->Run(inputs, outputNames, targetNodes, outputs);
+    // Session::Run is thread-safe but not declared const
+    Status status = const_cast<Session*>(session)->Run(inputs, outputNames, targetNodes, outputs);
     if (!status.ok())
     {
         throw cms::Exception("InvalidRun")
@@ -225,7 +232,7 @@ void run(Session* session, const NamedTensorList& inputs,
     }
 }
 
-void run(Session* session, const std::vector<std::string>& inputNames,
+void run(const Session* session, const std::vector<std::string>& inputNames,
     const std::vector<Tensor>& inputTensors, const std::vector<std::string>& outputNames,
     const std::vector<std::string>& targetNodes, std::vector<Tensor>* outputs)
 {
@@ -243,17 +250,65 @@ void run(Session* session, const std::vector<std::string>& inputNames,
     run(session, inputs, outputNames, targetNodes, outputs);
 }
 
-void run(Session* session, const NamedTensorList& inputs,
+void run(const Session* session, const NamedTensorList& inputs,
     const std::vector<std::string>& outputNames, std::vector<Tensor>* outputs)
 {
     run(session, inputs, outputNames, {}, outputs);
 }
 
-void run(Session* session, const std::vector<std::string>& inputNames,
+void run(const Session* session, const std::vector<std::string>& inputNames,
     const std::vector<Tensor>& inputTensors, const std::vector<std::string>& outputNames,
     std::vector<Tensor>* outputs)
 {
     run(session, inputNames, inputTensors, outputNames, {}, outputs);
 }
 
+SessionCache::SessionCache(const std::string& pbFile, SessionOptions& sessionOptions)
+    : pbFile_(pbFile)
+    , graphDef_(loadGraphDef(pbFile))
+    , session_(createSession(graphDef_, sessionOptions))
+    , nRuns_(0)
+    , runNanoseconds_(0)
+{
+}
+
+SessionCache::~SessionCache()
+{
+    closeSession(session_);
+    delete graphDef_;
+}
+
+void SessionCache::run(const NamedTensorList& inputs, const std::vector<std::string>& outputNames,
+    std::vector<Tensor>* outputs) const
+{
+    auto start = std::chrono::steady_clock::now();
+    tensorflow::run(session_, inputs, outputNames, outputs);
+    auto stop = std::chrono::steady_clock::now();
+
+    nRuns_ += 1;
+    runNanoseconds_ += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+}
+
+std::shared_ptr<SessionCache> getSessionCache(const std::string& pbFile,
+    SessionOptions& sessionOptions)
+{
+    // the caches in use, by graph file and threading options
+    CMS_THREAD_SAFE static std::mutex mutex;
+    CMS_THREAD_SAFE static std::map<std::string, std::weak_ptr<SessionCache>> caches;
+
+    const auto& config = sessionOptions.config;
+    std::string key = pbFile + "|" + sessionOptions.target + "|"
+        + std::to_string(config.intra_op_parallelism_threads()) + "|"
+        + std::to_string(config.inter_op_parallelism_threads());
+
+    std::lock_guard<std::mutex> guard(mutex);
+    std::shared_ptr<SessionCache> cache = caches[key].lock();
+    if (!cache)
+    {
+        cache = std::make_shared<SessionCache>(pbFile, sessionOptions);
+        caches[key] = cache;
+    }
+    return cache;
+}
+
 } // namespace tensorflow
@@ -0,0 +1,140 @@
+/*
+ * Tests for the session cache shared by several users of the same graph.
+ * Based on TensorFlow C++ API 1.3.
+ * For more info, see https://gitlab.cern.ch/mrieger/CMSSW-DNN.
+ */
+
+#include <boost/filesystem.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+#include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
+
+std::string cmsswPath(std::string path)
+{
+    if (path.size() > 0 && path.substr(0, 1) != "/")
+    {
+        path = "/" + path;
+    }
+
+    std::string base = std::string(std::getenv("CMSSW_BASE"));
+    std::string releaseBase = std::string(std::getenv("CMSSW_RELEASE_BASE"));
+
+    return (boost::filesystem::exists(base.c_str()) ? base : releaseBase) + path;
+}
+
+class testSessionCache : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testSessionCache);
+    CPPUNIT_TEST(checkAll);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    std::string dataPath;
+
+    void setUp();
+    void tearDown();
+    void checkAll();
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testSessionCache);
+
+void testSessionCache::setUp()
+{
+    dataPath = cmsswPath("/test/" + std::string(getenv("SCRAM_ARCH"))
+        + "/" + boost::filesystem::unique_path().string());
+
+    // create the graph
+    std::string testPath = cmsswPath("/src/PhysicsTools/TensorFlow/test");
+    std::string cmd = "python " + testPath + "/createconstantgraph.py " + dataPath;
+    std::array<char, 128> buffer;
+    std::string result;
+    std::shared_ptr<FILE> pipe(popen(cmd.c_str(), "r"), pclose);
+    if (!pipe)
+    {
+        throw std::runtime_error("popen() failed!");
+    }
+    while (!feof(pipe.get()))
+    {
+        if (fgets(buffer.data(), 128, pipe.get()) != NULL)
+        {
+            result += buffer.data();
+        }
+    }
+    std::cout << std::endl
+              << result << std::endl;
+}
+
+void testSessionCache::tearDown()
+{
+    if (boost::filesystem::exists(dataPath))
+    {
+        boost::filesystem::remove_all(dataPath);
+    }
+}
+
+void testSessionCache::checkAll()
+{
+    std::string pbFile = dataPath + "/constantgraph.pb";
+    tensorflow::setLogging();
+
+    tensorflow::SessionOptions sessionOptions;
+    tensorflow::setThreading(sessionOptions, 1, "no_threads");
+
+    // the same graph with the same options gives the same cache
+    std::shared_ptr<tensorflow::SessionCache> cache1 = tensorflow::getSessionCache(pbFile, sessionOptions);
+    std::shared_ptr<tensorflow::SessionCache> cache2 = tensorflow::getSessionCache(pbFile, sessionOptions);
+    CPPUNIT_ASSERT(cache1 != nullptr);
+    CPPUNIT_ASSERT(cache1 == cache2);
+    CPPUNIT_ASSERT(cache1->getSession() != nullptr);
+    CPPUNIT_ASSERT(cache1->nRuns() == 0);
+
+    // other threading options give another cache
+    tensorflow::SessionOptions otherOptions;
+    tensorflow::setThreading(otherOptions, 2, "no_threads");
+    std::shared_ptr<tensorflow::SessionCache> cache3 = tensorflow::getSessionCache(pbFile, otherOptions);
+    CPPUNIT_ASSERT(cache3 != cache1);
+    cache3.reset();
+
+    // example evaluation from both users
+    tensorflow::Tensor input(tensorflow::DT_FLOAT, { 1, 10 });
+    float* d = input.flat<float>().data();
+    for (size_t i = 0; i < 10; i++, d++)
+    {
+        *d = float(i);
+    }
+    tensorflow::Tensor scale(tensorflow::DT_FLOAT, {});
+    scale.scalar<float>()() = 1.0;
+
+    std::vector<tensorflow::Tensor> outputs;
+    cache1->run({ { "input", input }, { "scale", scale } }, { "output" }, &outputs);
+    CPPUNIT_ASSERT(outputs.size() == 1);
+    CPPUNIT_ASSERT(outputs[0].matrix<float>()(0, 0) == 46.);
+
+    outputs.clear();
+    cache2->run({ { "input", input }, { "scale", scale } }, { "output" }, &outputs);
+    CPPUNIT_ASSERT(outputs.size() == 1);
+    CPPUNIT_ASSERT(outputs[0].matrix<float>()(0, 0) == 46.);
+
+    // the plain helper works on the shared session as well
+    outputs.clear();
+    tensorflow::run(cache1->getSession(), { { "input", input }, { "scale", scale } }, { "output" },
+        &outputs);
+    CPPUNIT_ASSERT(outputs[0].matrix<float>()(0, 0) == 46.);
+
+    // only the runs through the cache are counted
+    CPPUNIT_ASSERT(cache2->nRuns() == 2);
+    CPPUNIT_ASSERT(cache2->runTime() > 0.);
+
+    // check for exception
+    CPPUNIT_ASSERT_THROW(cache1->run({ { "foo", input } }, { "output" }, &outputs), cms::Exception);
+
+    // once released by all its users, the cache is created again
+    tensorflow::SessionCache* oldCache = cache1.get();
+    cache1.reset();
+    CPPUNIT_ASSERT(oldCache == cache2.get());
+    cache2.reset();
+    std::shared_ptr<tensorflow::SessionCache> cache4 = tensorflow::getSessionCache(pbFile, sessionOptions);
+    CPPUNIT_ASSERT(cache4->nRuns() == 0);
+}
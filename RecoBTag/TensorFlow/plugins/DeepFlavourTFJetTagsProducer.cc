@@ -8,6 +8,7 @@
 #include "FWCore/Framework/interface/makeRefToBaseProdFrom.h"
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 
 #include "DataFormats/BTauReco/interface/JetTag.h"
@@ -19,18 +20,14 @@
 #include "RecoBTag/TensorFlow/interface/tensor_fillers.h"
 
 // Declaration of the data structure that is hold by the edm::GlobalCache.
-// In TensorFlow, the computational graph is stored in a stateless graph object which can be shared
-// by multiple session instances which handle the initialization of variables related to the graph.
-// Following this approach in CMSSW, a graph should be stored in a GlobalCache which can be accessed
-// by sessions owned by multiple stream module copies. Instead of using only the plain graph, we
-// make use of a cache struct that can be extended in the future if nedded. In addition, the graph
-// is protected via std::atomic, which should not affect the performance as it is only accessed in
-// the module constructor and not in the actual produce loop.
+// In TensorFlow, the computational graph and its weights are stored in a graph object, and
+// Session::Run is thread-safe. The graph and a session running it are therefore held by a
+// tensorflow::SessionCache which is shared by all the stream module copies, and by all the modules
+// of the process using the same graph file and threading options, so that the weights are in
+// memory only once. Instead of using only the plain session cache, we make use of a cache struct
+// that can be extended in the future if nedded.
 struct DeepFlavourTFCache {
-  DeepFlavourTFCache() : graphDef(nullptr) {
-  }
-
-  std::atomic<tensorflow::GraphDef*> graphDef;
+  std::shared_ptr<tensorflow::SessionCache> sessionCache;
 };
 
 class DeepFlavourTFJetTagsProducer : public edm::stream::EDProducer<edm::GlobalCache<DeepFlavourTFCache>> {
@@ -71,12 +68,16 @@ class DeepFlavourTFJetTagsProducer : public edm::stream::EDProducer<edm::GlobalC
     std::vector<std::string> output_names_;
     std::vector<std::string> lp_names_;
 
-    // session for TF evaluation
-    tensorflow::Session* session_;
     // vector of learning phase tensors, i.e., boolean scalar tensors pointing to false
     std::vector<tensorflow::Tensor> lp_tensors_;
     // flag to evaluate model batch or jet by jet
     bool batch_eval_;
+    // maximum number of jets of a batch, 0 for all the jets of the event
+    unsigned int max_batch_size_;
+    // input tensors, kept between events and allocated for the largest batch so far:
+    // a batch of n jets uses their first n jets
+    std::vector<tensorflow::Tensor> input_buffers_;
+    int64_t buffer_batch_size_;
 };
 
 DeepFlavourTFJetTagsProducer::DeepFlavourTFJetTagsProducer(const edm::ParameterSet& iConfig,
@@ -85,18 +86,10 @@ DeepFlavourTFJetTagsProducer::DeepFlavourTFJetTagsProducer(const edm::ParameterS
   input_names_(iConfig.getParameter<std::vector<std::string>>("input_names")),
   output_names_(iConfig.getParameter<std::vector<std::string>>("output_names")),
   lp_names_(iConfig.getParameter<std::vector<std::string>>("lp_names")),
-  session_(nullptr),
-  batch_eval_(iConfig.getParameter<bool>("batch_eval"))
+  batch_eval_(iConfig.getParameter<bool>("batch_eval")),
+  max_batch_size_(iConfig.getParameter<unsigned int>("max_batch_size")),
+  buffer_batch_size_(0)
 {
-  // get threading config and build session options
-  size_t nThreads = iConfig.getParameter<unsigned int>("nThreads");
-  std::string singleThreadPool = iConfig.getParameter<std::string>("singleThreadPool");
-  tensorflow::SessionOptions sessionOptions;
-  tensorflow::setThreading(sessionOptions, nThreads, singleThreadPool);
-
-  // create the session using the meta graph from the cache
-  session_ = tensorflow::createSession(cache->graphDef, sessionOptions);
-
   // get output names from flav_table
   const auto & flav_pset = iConfig.getParameter<edm::ParameterSet>("flav_table");
   for (const auto flav_pair : flav_pset.tbl()) {
@@ -121,10 +114,6 @@ DeepFlavourTFJetTagsProducer::DeepFlavourTFJetTagsProducer(const edm::ParameterS
 
 DeepFlavourTFJetTagsProducer::~DeepFlavourTFJetTagsProducer()
 {
-  // close and delete the session
-  if (session_ != nullptr) {
-    tensorflow::closeSession(session_);
-  }
 }
 
 void DeepFlavourTFJetTagsProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
@@ -153,6 +142,7 @@ void DeepFlavourTFJetTagsProducer::fillDescriptions(edm::ConfigurationDescriptio
   }
 
   desc.add<bool>("batch_eval", false);
+  desc.add<unsigned int>("max_batch_size", 0);
 
   desc.add<unsigned int>("nThreads", 1);
   desc.add<std::string>("singleThreadPool", "no_threads");
@@ -169,18 +159,25 @@ std::unique_ptr<DeepFlavourTFCache> DeepFlavourTFJetTagsProducer::initializeGlob
   // get the pb file
   std::string pbFile = iConfig.getParameter<edm::FileInPath>("graph_path").fullPath();
 
-  // load the graph def and save it in the cache
+  // get threading config and build session options
+  size_t nThreads = iConfig.getParameter<unsigned int>("nThreads");
+  std::string singleThreadPool = iConfig.getParameter<std::string>("singleThreadPool");
+  tensorflow::SessionOptions sessionOptions;
+  tensorflow::setThreading(sessionOptions, nThreads, singleThreadPool);
+
+  // get the graph and its session, shared with the other modules using the same graph
   DeepFlavourTFCache* cache = new DeepFlavourTFCache();
-  cache->graphDef = tensorflow::loadGraphDef(pbFile);
+  cache->sessionCache = tensorflow::getSessionCache(pbFile, sessionOptions);
 
   return std::unique_ptr<DeepFlavourTFCache>(cache);
 }
 
 void DeepFlavourTFJetTagsProducer::globalEndJob(const DeepFlavourTFCache* cache)
 {
-  if (cache->graphDef != nullptr) {
-    delete cache->graphDef;
-  }
+  // the counts include the other modules sharing the session
+  const auto& sessionCache = *cache->sessionCache;
+  edm::LogInfo("DeepFlavourTFJetTagsProducer") << "graph " << sessionCache.pbFile() << ": " << sessionCache.nRuns()
+    << " runs in " << sessionCache.runTime() << " s";
 }
 
 void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
@@ -202,39 +199,47 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
   }
 
   const int64_t n_jets = tag_infos->size();
-  // either all jets or one per batch for the time being
-  const int64_t n_batch_jets = batch_eval_ ?  n_jets : 1;
+  // either one jet per batch, all jets, or batches of at most max_batch_size_ jets
+  int64_t batch_size = 1;
+  if (batch_eval_) {
+    batch_size = max_batch_size_ > 0 ? std::min(n_jets, (int64_t) max_batch_size_) : n_jets;
+  }
 
-  std::vector<tensorflow::TensorShape> input_sizes {
-    {n_batch_jets, 15},         // input_1 - global jet features
-    {n_batch_jets, 25, 16},     // input_2 - charged pf
-    {n_batch_jets, 25, 6},      // input_3 - neutral pf
-    {n_batch_jets, 4, 12},      // input_4 - vertices 
-    {n_batch_jets, 1}           // input_5 - jet pt for reg 
-  };
+  // the input buffers are only allocated when a batch is larger than all the previous ones
+  if (batch_size > buffer_batch_size_) {
+    std::vector<tensorflow::TensorShape> input_sizes {
+      {batch_size, 15},         // input_1 - global jet features
+      {batch_size, 25, 16},     // input_2 - charged pf
+      {batch_size, 25, 6},      // input_3 - neutral pf
+      {batch_size, 4, 12},      // input_4 - vertices 
+      {batch_size, 1}           // input_5 - jet pt for reg 
+    };
+    input_buffers_.clear();
+    for (const auto & input_size : input_sizes) {
+      input_buffers_.emplace_back(tensorflow::DT_FLOAT, input_size);
+    }
+    buffer_batch_size_ = batch_size;
+  }
 
   // create a list of named tensors, i.e. a vector of (string, Tensor) pairs, with proper size to
   // prevent element copying that would occur via push_back's
   // the default Tensor constructor creates a scalar so this should be fine w.r.t. to memory
   tensorflow::NamedTensorList input_tensors;
-  input_tensors.resize(input_sizes.size() + lp_tensors_.size());
+  input_tensors.resize(input_buffers_.size() + lp_tensors_.size());
 
-  // add actual input tensors that hold physics information
-  for (std::size_t i=0; i < input_sizes.size(); i++) {
-    input_tensors[i] = tensorflow::NamedTensor(
-      input_names_[i], tensorflow::Tensor(tensorflow::DT_FLOAT, input_sizes.at(i)));
-  }
-
-  // add learning-phase tensors behind them
+  // add learning-phase tensors behind the ones that hold physics information
   for (std::size_t i=0; i < lp_tensors_.size(); i++) {
-    input_tensors[input_sizes.size() + i] = tensorflow::NamedTensor(lp_names_[i], lp_tensors_[i]);
+    input_tensors[input_buffers_.size() + i] = tensorflow::NamedTensor(lp_names_[i], lp_tensors_[i]);
   }
 
-  std::size_t n_batches = n_jets/n_batch_jets; // either 1 or n_jets
-  for (std::size_t batch_n=0; batch_n < n_batches; batch_n++) {
+  for (int64_t batch_start=0; batch_start < n_jets; batch_start += batch_size) {
+
+    const int64_t n_batch_jets = std::min(batch_size, n_jets - batch_start);
 
-    // tensors have to be zeroed before filling per batch
-    for (std::size_t i=0; i < input_sizes.size(); i++) {
+    // the input tensors are the first n_batch_jets jets of the buffers (sharing their memory),
+    // and have to be zeroed before filling per batch
+    for (std::size_t i=0; i < input_buffers_.size(); i++) {
+      input_tensors[i] = tensorflow::NamedTensor(input_names_[i], input_buffers_[i].Slice(0, n_batch_jets));
       input_tensors[i].second.flat<float>().setZero();
     }
 
@@ -242,7 +247,7 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
     for (std::size_t jet_bn=0; jet_bn < (std::size_t) n_batch_jets; jet_bn++) {
 
       // global jet index (jet_bn is the jet batch index)
-      std::size_t jet_n = batch_n*n_batch_jets + jet_bn;
+      std::size_t jet_n = batch_start + jet_bn;
 
       // jet and other global features
       const auto & features = tag_infos->at(jet_n).features();
@@ -250,7 +255,7 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
 
       // c_pf candidates
       auto max_c_pf_n = std::min(features.c_pf_features.size(),
-        (std::size_t) input_sizes.at(kChargedCandidates).dim_size(1));
+        (std::size_t) input_buffers_.at(kChargedCandidates).dim_size(1));
       for (std::size_t c_pf_n=0; c_pf_n < max_c_pf_n; c_pf_n++) {
         const auto & c_pf_features = features.c_pf_features.at(c_pf_n);
         c_pf_tensor_filler(input_tensors.at(kChargedCandidates).second,
@@ -259,7 +264,7 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
 
       // n_pf candidates
       auto max_n_pf_n = std::min(features.n_pf_features.size(),
-        (std::size_t) input_sizes.at(kNeutralCandidates).dim_size(1));
+        (std::size_t) input_buffers_.at(kNeutralCandidates).dim_size(1));
       for (std::size_t n_pf_n=0; n_pf_n < max_n_pf_n; n_pf_n++) {
         const auto & n_pf_features = features.n_pf_features.at(n_pf_n);
         n_pf_tensor_filler(input_tensors.at(kNeutralCandidates).second,
@@ -268,7 +273,7 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
 
       // sv candidates
       auto max_sv_n = std::min(features.sv_features.size(),
-        (std::size_t) input_sizes.at(kVertices).dim_size(1));
+        (std::size_t) input_buffers_.at(kVertices).dim_size(1));
       for (std::size_t sv_n=0; sv_n < max_sv_n; sv_n++) {
         const auto & sv_features = features.sv_features.at(sv_n);
         sv_tensor_filler(input_tensors.at(kVertices).second,
@@ -281,13 +286,13 @@ void DeepFlavourTFJetTagsProducer::produce(edm::Event& iEvent, const edm::EventS
 
     // run the session
     std::vector<tensorflow::Tensor> outputs;
-    tensorflow::run(session_, input_tensors, output_names_, &outputs);
+    globalCache()->sessionCache->run(input_tensors, output_names_, &outputs);
 
     // set output values for flavour probs
     for (std::size_t jet_bn=0; jet_bn < (std::size_t) n_batch_jets; jet_bn++) {
 
       // global jet index (jet_bn is the jet batch index)
-      std::size_t jet_n = batch_n*n_batch_jets + jet_bn;
+      std::size_t jet_n = batch_start + jet_bn;
 
       const auto & jet_ref = tag_infos->at(jet_n).jet();
       for (std::size_t flav_n=0; flav_n < flav_pairs_.size(); flav_n++) {
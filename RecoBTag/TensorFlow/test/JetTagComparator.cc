@@ -0,0 +1,85 @@
+// Compares two JetTagCollections of the same jets, for instance the discriminators
+// of a tagger evaluated jet by jet and in batches: same jets, in the same order,
+// with the same discriminator within the tolerance.
+
+#include "DataFormats/BTauReco/interface/JetTag.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <algorithm>
+#include <cmath>
+
+class JetTagComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit JetTagComparator(edm::ParameterSet const& params) :
+    referenceToken_(consumes<reco::JetTagCollection>(params.getParameter<edm::InputTag>("reference"))),
+    testToken_(consumes<reco::JetTagCollection>(params.getParameter<edm::InputTag>("test"))),
+    tolerance_(params.getParameter<double>("tolerance"))
+  {}
+
+  void analyze(edm::Event const& iEvent, edm::EventSetup const&) override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  const edm::EDGetTokenT<reco::JetTagCollection> referenceToken_;
+  const edm::EDGetTokenT<reco::JetTagCollection> testToken_;
+  const double tolerance_;
+
+  unsigned long nJets_ = 0;
+  double maxDifference_ = 0;
+};
+
+void JetTagComparator::analyze(edm::Event const& iEvent, edm::EventSetup const&)
+{
+  edm::Handle<reco::JetTagCollection> hReference, hTest;
+  iEvent.getByToken(referenceToken_, hReference);
+  iEvent.getByToken(testToken_, hTest);
+  auto const& reference = *hReference;
+  auto const& test = *hTest;
+
+  if (test.size() != reference.size()) {
+    throw cms::Exception("JetTagComparator") << "event " << iEvent.id() << ": " << test.size() << " jets instead of "
+                                             << reference.size();
+  }
+  for (unsigned int i = 0; i < reference.size(); ++i) {
+    if (test[i].first != reference[i].first) {
+      throw cms::Exception("JetTagComparator") << "event " << iEvent.id() << ", jet " << i << ": not the same jet";
+    }
+    const double difference = std::abs(test[i].second - reference[i].second);
+    maxDifference_ = std::max(maxDifference_, difference);
+    if (!(difference <= tolerance_)) {
+      throw cms::Exception("JetTagComparator") << "event " << iEvent.id() << ", jet " << i << ": discriminator "
+                                               << test[i].second << " instead of " << reference[i].second;
+    }
+  }
+  nJets_ += reference.size();
+}
+
+void JetTagComparator::endJob()
+{
+  edm::LogSystem("JetTagComparator") << nJets_ << " jets compared, largest difference " << maxDifference_;
+  if (nJets_ == 0) {
+    throw cms::Exception("JetTagComparator") << "The comparison needs jets";
+  }
+}
+
+void JetTagComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
+{
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("reference", edm::InputTag(""));
+  desc.add<edm::InputTag>("test", edm::InputTag(""));
+  desc.add<double>("tolerance", 0.)->setComment("absolute");
+  descriptions.add("jetTagComparator", desc);
+}
+
+DEFINE_FWK_MODULE(JetTagComparator);
@@ -0,0 +1,56 @@
+# Timing of the DeepFlavour evaluation on CPU versus the batch size,
+# on the jets of a MINIAODSIM file:
+#   cmsRun benchmark_deep_flavour_cfg.py inputFiles=file:miniaod.root batchSizes=1,4,16,64,0
+# batch size 1 is the jet by jet evaluation, 0 evaluates all the jets of an event at once.
+# The time per module is in the summary of the Timing service.
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing('analysis')
+options.register('globalTag', 'auto:run2_mc', VarParsing.multiplicity.singleton, VarParsing.varType.string, "global tag")
+options.register('batchSizes', '1,4,16,64,0', VarParsing.multiplicity.singleton, VarParsing.varType.string, "batch sizes to time")
+options.register('repeat', 5, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of copies of each producer")
+options.parseArguments()
+
+process = cms.Process("BENCH")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+process.load("Configuration.Geometry.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring(options.inputFiles))
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+process.Timing = cms.Service("Timing", summaryOnly = cms.untracked.bool(True))
+
+# the DeepFlavour tag infos of the slimmed jets
+from PhysicsTools.PatAlgos.tools.helpers import getPatAlgosToolsTask
+from PhysicsTools.PatAlgos.tools.jetTools import updateJetCollection
+updateJetCollection(
+   process,
+   labelName = 'Bench',
+   jetSource = cms.InputTag('slimmedJets'),
+   pvSource = cms.InputTag('offlineSlimmedPrimaryVertices'),
+   svSource = cms.InputTag('slimmedSecondaryVertices'),
+   jetCorrections = ('AK4PFchs', cms.vstring(['L1FastJet', 'L2Relative', 'L3Absolute']), 'None'),
+   btagDiscriminators = ['pfDeepFlavourJetTags:probb']
+   )
+
+from RecoBTag.TensorFlow.pfDeepFlavourJetTags_cfi import pfDeepFlavourJetTags
+
+process.benchmark = cms.Sequence()
+for size in [int(s) for s in options.batchSizes.split(',')]:
+    for i in range(options.repeat):
+        tags = pfDeepFlavourJetTags.clone(
+            src = 'pfDeepFlavourTagInfosBench',
+            batch_eval = size != 1,
+            max_batch_size = size
+            )
+        setattr(process, "pfDeepFlavourJetTagsBatch%d_%d" % (size, i), tags)
+        process.benchmark += tags
+
+process.p = cms.Path(process.benchmark, getPatAlgosToolsTask(process))
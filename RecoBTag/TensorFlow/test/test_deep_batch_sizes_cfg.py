@@ -0,0 +1,80 @@
+# Checks that DeepFlavourTFJetTagsProducer and DeepDoubleBTFJetTagsProducer give
+# the same discriminators, jet by jet, in batches of all the jets of the event
+# (max_batch_size 0), of one jet, and of at most 3 jets (so with a smaller last
+# batch), on the AK4 and AK8 jets of a MINIAODSIM file:
+#   cmsRun test_deep_batch_sizes_cfg.py [inputFiles=file:miniaod.root] [maxEvents=20]
+# A batched matrix product can round differently from the single jet one, so the
+# discriminators are compared within a tolerance of 1e-6.
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+from PhysicsTools.PatAlgos.tools.helpers import getPatAlgosToolsTask
+
+options = VarParsing('analysis')
+options.maxEvents = 20
+options.parseArguments()
+
+process = cms.Process("BATCHTEST")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 10
+process.load("Configuration.Geometry.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:run2_mc', '')
+
+from PhysicsTools.PatAlgos.patInputFiles_cff import filesRelValTTbarPileUpMINIAODSIM
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles) if options.inputFiles else filesRelValTTbarPileUpMINIAODSIM
+)
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+# the tag infos of the AK4 and AK8 jets
+from PhysicsTools.PatAlgos.tools.jetTools import updateJetCollection
+updateJetCollection(
+   process,
+   labelName = 'Batch',
+   jetSource = cms.InputTag('slimmedJets'),
+   pvSource = cms.InputTag('offlineSlimmedPrimaryVertices'),
+   svSource = cms.InputTag('slimmedSecondaryVertices'),
+   jetCorrections = ('AK4PFchs', cms.vstring(['L1FastJet', 'L2Relative', 'L3Absolute']), 'None'),
+   btagDiscriminators = ['pfDeepFlavourJetTags:probb']
+   )
+updateJetCollection(
+   process,
+   labelName = 'BatchAK8',
+   jetSource = cms.InputTag('slimmedJetsAK8'),
+   pvSource = cms.InputTag('offlineSlimmedPrimaryVertices'),
+   svSource = cms.InputTag('slimmedSecondaryVertices'),
+   rParam = 0.8,
+   jetCorrections = ('AK8PFchs', cms.vstring(['L1FastJet', 'L2Relative', 'L3Absolute']), 'None'),
+   btagDiscriminators = ['pfDeepDoubleBJetTags:probH']
+   )
+
+from RecoBTag.TensorFlow.pfDeepFlavourJetTags_cfi import pfDeepFlavourJetTags
+from RecoBTag.TensorFlow.pfDeepDoubleBJetTags_cfi import pfDeepDoubleBJetTags
+
+process.tasks = getPatAlgosToolsTask(process)
+process.comparisons = cms.Sequence()
+for tagger, tagInfos, discriminators in (
+        (pfDeepFlavourJetTags, 'pfDeepFlavourTagInfosBatch', ('probb', 'probbb', 'problepb', 'probc', 'probuds', 'probg')),
+        (pfDeepDoubleBJetTags, 'pfDeepDoubleBTagInfosBatchAK8', ('probQ', 'probH'))):
+    name = tagger.type_()
+    reference = tagger.clone(src = tagInfos, batch_eval = False)
+    setattr(process, name + 'JetByJet', reference)
+    process.tasks.add(reference)
+    for size in (0, 1, 3):
+        batched = tagger.clone(src = tagInfos, batch_eval = True, max_batch_size = size)
+        label = '%sBatch%d' % (name, size)
+        setattr(process, label, batched)
+        process.tasks.add(batched)
+        for discriminator in discriminators:
+            comparator = cms.EDAnalyzer("JetTagComparator",
+                reference = cms.InputTag(name + 'JetByJet', discriminator),
+                test = cms.InputTag(label, discriminator),
+                tolerance = cms.double(1e-6)
+            )
+            setattr(process, 'compare%s%s' % (label, discriminator), comparator)
+            process.comparisons += comparator
+
+process.p = cms.Path(process.comparisons, process.tasks)
@@ -0,0 +1,106 @@
+#ifndef RecoJets_JetAlgorithms_TiledAntiKtAlgorithm_h
+#define RecoJets_JetAlgorithms_TiledAntiKtAlgorithm_h
+
+/** \class TiledAntiKtAlgorithm
+ *
+ * Anti-kT clustering (E-scheme recombination) of a set of particles,
+ * without FastJet.
+ *
+ * The particles and the pseudojets are kept in plain arrays, the
+ * nearest-neighbour search is restricted to the 3x3 tiles of size >= R
+ * around each pseudojet, as in the tiled strategies of FastJet, and the
+ * smallest distance is kept in a binary tree updated in log(N). The
+ * rapidity, phi and distance definitions are the ones of FastJet, so the
+ * jets are the same as the ones of fastjet::ClusterSequence with
+ * antikt_algorithm, up to the order in which exactly equal distances
+ * are resolved.
+ *
+ * The clustering is run once; the inclusive jets above any pt threshold
+ * and their constituents can then be read as many times as needed.
+ *
+ * Usage:
+ *   TiledAntiKtAlgorithm algo(0.4);
+ *   algo.addParticle(px, py, pz, e);  // for each particle
+ *   algo.run();
+ *   for (auto j : algo.inclusiveJets(ptMin)) { algo.px(j) ... algo.constituents(j, indices); }
+ */
+
+#include <vector>
+
+class TiledAntiKtAlgorithm {
+
+ public:
+  explicit TiledAntiKtAlgorithm(double rParam);
+
+  double rParam() const { return rParam_; }
+
+  /// remove the particles and the result of the previous clustering
+  void clear();
+  void reserve(unsigned int n);
+  /// particles are numbered in the order they are added
+  void addParticle(double px, double py, double pz, double e);
+  unsigned int nParticles() const { return nParticles_; }
+
+  /// cluster all the particles added since clear(); to be called once, since
+  /// the momenta of the merged pseudojets replace the ones of the particles
+  void run();
+
+  /// the jets with pt >= ptMin, in order of decreasing pt
+  std::vector<unsigned int> inclusiveJets(double ptMin) const;
+
+  double px(unsigned int jet) const { return px_[jet]; }
+  double py(unsigned int jet) const { return py_[jet]; }
+  double pz(unsigned int jet) const { return pz_[jet]; }
+  double e(unsigned int jet) const { return e_[jet]; }
+  /// the indices of the particles of the jet, in no particular order
+  void constituents(unsigned int jet, std::vector<unsigned int>& indices) const;
+
+ private:
+  void setKinematics(unsigned int i);
+  void initTiles();
+  int tileIndex(double rap, double phi) const;
+  void addToTile(unsigned int i, int tile);
+  void removeFromTile(unsigned int i);
+  void setDiJ(unsigned int i, double dij);
+  double distance(unsigned int i, unsigned int j) const;
+  void setNearestNeighbour(unsigned int i);
+  double diJ(unsigned int i) const;
+  void markNeighbourTiles(int tile);
+
+  double rParam_;
+  double r2_;
+  unsigned int nParticles_ = 0;
+
+  // by pseudojet: a merged pseudojet takes the slot of one of its parents,
+  // so there are never more slots than particles
+  std::vector<double> px_, py_, pz_, e_;
+  std::vector<double> rap_, phi_, kt2_, momentumFactor_;
+  std::vector<double> nnDist_;
+  std::vector<int> nn_;
+  std::vector<int> tile_, tileNext_, tilePrev_;
+  // the particles of pseudojet i are constHead_[i], constNext_[constHead_[i]], ... (-1 terminated)
+  std::vector<int> constHead_, constTail_, constNext_;
+
+  // diJ by pseudojet (infinite once clustered), and the binary tree of the minima:
+  // minTree_[k] is the pseudojet of smallest diJ below node k, the leaves are at minTreeSize_+i
+  std::vector<double> diJ_;
+  std::vector<unsigned int> minTree_;
+  unsigned int minTreeSize_ = 0;
+
+  std::vector<unsigned int> finalJets_;
+
+  // tiles: the neighbours of tile t (t included) are tileNeighbours_[tileNeighbourStart_[t] .. tileNeighbourStart_[t+1])
+  double tileSize_ = 0;
+  double tileRapMin_ = 0;
+  double tilePhiWidth_ = 0;
+  int nTileRap_ = 0;
+  int nTilePhi_ = 0;
+  std::vector<int> tileHead_;
+  std::vector<unsigned int> tileNeighbourStart_;
+  std::vector<int> tileNeighbours_;
+  std::vector<unsigned int> tileMark_;
+  unsigned int tileMarkValue_ = 0;
+  std::vector<int> markedTiles_;
+};
+
+#endif
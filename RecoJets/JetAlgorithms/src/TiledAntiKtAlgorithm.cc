@@ -0,0 +1,292 @@
+#include "RecoJets/JetAlgorithms/interface/TiledAntiKtAlgorithm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+  // as fastjet::MaxRap, for the particles along the beam
+  constexpr double kMaxRap = 1e5;
+  // the tiles cover this rapidity range at most, the first and last ones
+  // also take the particles beyond
+  constexpr double kTileRapMax = 10.;
+  constexpr double kTwoPi = 2*M_PI;
+}
+
+TiledAntiKtAlgorithm::TiledAntiKtAlgorithm(double rParam) :
+  rParam_(rParam), r2_(rParam*rParam)
+{
+}
+
+void
+TiledAntiKtAlgorithm::clear()
+{
+  nParticles_ = 0;
+  px_.clear(); py_.clear(); pz_.clear(); e_.clear();
+  finalJets_.clear();
+}
+
+void
+TiledAntiKtAlgorithm::reserve(unsigned int n)
+{
+  px_.reserve(n); py_.reserve(n); pz_.reserve(n); e_.reserve(n);
+}
+
+void
+TiledAntiKtAlgorithm::addParticle(double px, double py, double pz, double e)
+{
+  px_.push_back(px); py_.push_back(py); pz_.push_back(pz); e_.push_back(e);
+  ++nParticles_;
+}
+
+// the same rapidity, phi and momentum factor as fastjet::PseudoJet and ClusterSequence
+void
+TiledAntiKtAlgorithm::setKinematics(unsigned int i)
+{
+  const double px = px_[i], py = py_[i], pz = pz_[i], e = e_[i];
+  const double kt2 = px*px + py*py;
+  kt2_[i] = kt2;
+
+  double phi = (kt2 == 0.0) ? 0.0 : std::atan2(py,px);
+  if (phi < 0.0) phi += kTwoPi;
+  if (phi >= kTwoPi) phi -= kTwoPi;
+  phi_[i] = phi;
+
+  if (e == std::abs(pz) && kt2 == 0) {
+    const double maxRapHere = kMaxRap + std::abs(pz);
+    rap_[i] = (pz >= 0.0) ? maxRapHere : -maxRapHere;
+  } else {
+    const double effectiveM2 = std::max(0.0, (e+pz)*(e-pz) - kt2);
+    const double ePlusPz = e + std::abs(pz);
+    double rap = 0.5*std::log((kt2 + effectiveM2)/(ePlusPz*ePlusPz));
+    if (pz > 0) rap = -rap;
+    rap_[i] = rap;
+  }
+
+  momentumFactor_[i] = kt2 > 1e-300 ? 1.0/kt2 : 1e300;
+}
+
+void
+TiledAntiKtAlgorithm::initTiles()
+{
+  // tiles at least as large as R: the neighbours closer than R are in the 3x3 tiles around
+  tileSize_ = std::max(0.1, rParam_);
+  nTilePhi_ = std::max(1, int(kTwoPi/tileSize_));
+  tilePhiWidth_ = kTwoPi/nTilePhi_;
+
+  double rapMin = kTileRapMax, rapMax = -kTileRapMax;
+  for (unsigned int i = 0; i < nParticles_; ++i) {
+    rapMin = std::min(rapMin, rap_[i]);
+    rapMax = std::max(rapMax, rap_[i]);
+  }
+  tileRapMin_ = std::max(-kTileRapMax, rapMin);
+  rapMax = std::min(kTileRapMax, rapMax);
+  nTileRap_ = nParticles_ == 0 ? 1 : 1 + int((rapMax - tileRapMin_)/tileSize_);
+
+  const int nTiles = nTileRap_*nTilePhi_;
+  tileHead_.assign(nTiles, -1);
+  tileMark_.assign(nTiles, 0);
+  tileMarkValue_ = 0;
+
+  tileNeighbourStart_.resize(nTiles + 1);
+  tileNeighbours_.clear();
+  for (int iy = 0; iy < nTileRap_; ++iy) {
+    for (int ip = 0; ip < nTilePhi_; ++ip) {
+      tileNeighbourStart_[iy*nTilePhi_ + ip] = tileNeighbours_.size();
+      for (int jy = std::max(0, iy-1); jy <= std::min(nTileRap_-1, iy+1); ++jy) {
+        // with less than 3 tiles in phi, the neighbours in phi are all the tiles
+        const int phiLo = nTilePhi_ < 3 ? 0 : ip-1;
+        const int phiHi = nTilePhi_ < 3 ? nTilePhi_-1 : ip+1;
+        for (int k = phiLo; k <= phiHi; ++k) {
+          const int jp = (k + nTilePhi_) % nTilePhi_;
+          tileNeighbours_.push_back(jy*nTilePhi_ + jp);
+        }
+      }
+    }
+  }
+  tileNeighbourStart_[nTiles] = tileNeighbours_.size();
+}
+
+int
+TiledAntiKtAlgorithm::tileIndex(double rap, double phi) const
+{
+  const int iy = std::max(0, std::min(nTileRap_-1, int(std::floor((rap - tileRapMin_)/tileSize_))));
+  const int ip = std::max(0, std::min(nTilePhi_-1, int(phi/tilePhiWidth_)));
+  return iy*nTilePhi_ + ip;
+}
+
+void
+TiledAntiKtAlgorithm::addToTile(unsigned int i, int tile)
+{
+  tile_[i] = tile;
+  tilePrev_[i] = -1;
+  tileNext_[i] = tileHead_[tile];
+  if (tileHead_[tile] >= 0) tilePrev_[tileHead_[tile]] = i;
+  tileHead_[tile] = i;
+}
+
+void
+TiledAntiKtAlgorithm::removeFromTile(unsigned int i)
+{
+  if (tilePrev_[i] >= 0) tileNext_[tilePrev_[i]] = tileNext_[i];
+  else tileHead_[tile_[i]] = tileNext_[i];
+  if (tileNext_[i] >= 0) tilePrev_[tileNext_[i]] = tilePrev_[i];
+}
+
+void
+TiledAntiKtAlgorithm::setDiJ(unsigned int i, double dij)
+{
+  diJ_[i] = dij;
+  for (unsigned int k = (minTreeSize_ + i)/2; k > 0; k /= 2) {
+    const unsigned int l = minTree_[2*k], r = minTree_[2*k+1];
+    minTree_[k] = diJ_[r] < diJ_[l] ? r : l;
+  }
+}
+
+double
+TiledAntiKtAlgorithm::distance(unsigned int i, unsigned int j) const
+{
+  double dphi = std::abs(phi_[i] - phi_[j]);
+  if (dphi > M_PI) dphi = kTwoPi - dphi;
+  const double drap = rap_[i] - rap_[j];
+  return dphi*dphi + drap*drap;
+}
+
+void
+TiledAntiKtAlgorithm::setNearestNeighbour(unsigned int i)
+{
+  double nnDist = r2_;
+  int nn = -1;
+  const int tile = tile_[i];
+  for (unsigned int n = tileNeighbourStart_[tile]; n < tileNeighbourStart_[tile+1]; ++n) {
+    for (int j = tileHead_[tileNeighbours_[n]]; j >= 0; j = tileNext_[j]) {
+      if (j == int(i)) continue;
+      const double d = distance(i, j);
+      if (d < nnDist) { nnDist = d; nn = j; }
+    }
+  }
+  nnDist_[i] = nnDist;
+  nn_[i] = nn;
+}
+
+double
+TiledAntiKtAlgorithm::diJ(unsigned int i) const
+{
+  const int nn = nn_[i];
+  return nnDist_[i] * (nn >= 0 ? std::min(momentumFactor_[i], momentumFactor_[nn]) : momentumFactor_[i]);
+}
+
+void
+TiledAntiKtAlgorithm::markNeighbourTiles(int tile)
+{
+  for (unsigned int n = tileNeighbourStart_[tile]; n < tileNeighbourStart_[tile+1]; ++n) {
+    const int t = tileNeighbours_[n];
+    if (tileMark_[t] != tileMarkValue_) {
+      tileMark_[t] = tileMarkValue_;
+      markedTiles_.push_back(t);
+    }
+  }
+}
+
+void
+TiledAntiKtAlgorithm::run()
+{
+  const unsigned int n = nParticles_;
+  rap_.resize(n); phi_.resize(n); kt2_.resize(n); momentumFactor_.resize(n);
+  nnDist_.resize(n); nn_.resize(n);
+  tile_.resize(n); tileNext_.resize(n); tilePrev_.resize(n);
+  constHead_.resize(n); constTail_.resize(n); constNext_.assign(n, -1);
+  finalJets_.clear();
+
+  for (unsigned int i = 0; i < n; ++i) {
+    setKinematics(i);
+    constHead_[i] = constTail_[i] = i;
+  }
+  initTiles();
+  for (unsigned int i = 0; i < n; ++i) addToTile(i, tileIndex(rap_[i], phi_[i]));
+  for (unsigned int i = 0; i < n; ++i) setNearestNeighbour(i);
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  minTreeSize_ = 1;
+  while (minTreeSize_ < n) minTreeSize_ *= 2;
+  diJ_.assign(minTreeSize_, infinity);
+  for (unsigned int i = 0; i < n; ++i) diJ_[i] = diJ(i);
+  minTree_.resize(2*minTreeSize_);
+  for (unsigned int i = 0; i < minTreeSize_; ++i) minTree_[minTreeSize_ + i] = i;
+  for (unsigned int k = minTreeSize_ - 1; k > 0; --k) {
+    const unsigned int l = minTree_[2*k], r = minTree_[2*k+1];
+    minTree_[k] = diJ_[r] < diJ_[l] ? r : l;
+  }
+
+  for (unsigned int step = 0; step < n; ++step) {
+    const unsigned int a = minTree_[1];
+    const int b = nn_[a];
+    ++tileMarkValue_;
+    markedTiles_.clear();
+    markNeighbourTiles(tile_[a]);
+
+    if (b >= 0) {
+      // recombine b into a (E-scheme): a keeps its slot
+      markNeighbourTiles(tile_[b]);
+      removeFromTile(b);
+      setDiJ(b, infinity);
+      px_[a] += px_[b]; py_[a] += py_[b]; pz_[a] += pz_[b]; e_[a] += e_[b];
+      setKinematics(a);
+      constNext_[constTail_[a]] = constHead_[b];
+      constTail_[a] = constTail_[b];
+
+      const int tile = tileIndex(rap_[a], phi_[a]);
+      if (tile != tile_[a]) {
+        removeFromTile(a);
+        addToTile(a, tile);
+        markNeighbourTiles(tile);
+      }
+      nnDist_[a] = r2_;
+      nn_[a] = -1;
+    } else {
+      // a is a final jet
+      removeFromTile(a);
+      setDiJ(a, infinity);
+      finalJets_.push_back(a);
+    }
+
+    // the pseudojets which had a or b as nearest neighbour, or which may have the new a,
+    // are all in the tiles around a and b
+    for (int t : markedTiles_) {
+      for (int j = tileHead_[t]; j >= 0; j = tileNext_[j]) {
+        if (j == int(a)) continue;
+        bool update = false;
+        if (nn_[j] == int(a) || (b >= 0 && nn_[j] == b)) {
+          setNearestNeighbour(j);
+          update = true;
+        }
+        if (b >= 0) {
+          const double d = distance(a, j);
+          if (d < nnDist_[a]) { nnDist_[a] = d; nn_[a] = j; }
+          if (d < nnDist_[j]) { nnDist_[j] = d; nn_[j] = a; update = true; }
+        }
+        if (update) setDiJ(j, diJ(j));
+      }
+    }
+    if (b >= 0) setDiJ(a, diJ(a));
+  }
+}
+
+std::vector<unsigned int>
+TiledAntiKtAlgorithm::inclusiveJets(double ptMin) const
+{
+  const double pt2Min = ptMin*ptMin;
+  std::vector<unsigned int> jets;
+  for (auto j : finalJets_) {
+    if (kt2_[j] >= pt2Min) jets.push_back(j);
+  }
+  std::sort(jets.begin(), jets.end(), [this](unsigned int i, unsigned int j) { return kt2_[i] > kt2_[j]; });
+  return jets;
+}
+
+void
+TiledAntiKtAlgorithm::constituents(unsigned int jet, std::vector<unsigned int>& indices) const
+{
+  indices.clear();
+  for (int i = constHead_[jet]; i >= 0; i = constNext_[i]) indices.push_back(i);
+}
@@ -0,0 +1,86 @@
+#include "RecoJets/JetAlgorithms/interface/TiledAntiKtAlgorithm.h"
+
+#include "fastjet/ClusterSequence.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// compare the jets of TiledAntiKtAlgorithm with the ones of fastjet::ClusterSequence
+// on random events: a few collimated sprays over a uniform background
+
+namespace {
+  std::mt19937 rng(4321);
+
+  std::vector<fastjet::PseudoJet> makeEvent(unsigned int n) {
+    std::uniform_real_distribution<double> u(0.,1.);
+    std::vector<std::pair<double,double> > axes;
+    for (int k=0; k<6; ++k) axes.emplace_back(-4.+8.*u(rng), 2*M_PI*u(rng));
+
+    std::vector<fastjet::PseudoJet> particles;
+    for (unsigned int i=0; i<n; ++i) {
+      double pt = 0.01-2.*std::log(u(rng)), eta, phi;
+      if (i%3==0) {
+        auto const & axis = axes[i%axes.size()];
+        eta = axis.first + 0.3*(u(rng)-0.5);
+        phi = axis.second + 0.3*(u(rng)-0.5);
+        pt *= 10.;
+      } else {
+        eta = -5.5+11.*u(rng);
+        phi = 2*M_PI*u(rng);
+      }
+      const double m = (i%2) ? 0.14 : 0.;
+      const double px = pt*std::cos(phi), py = pt*std::sin(phi), pz = pt*std::sinh(eta);
+      particles.emplace_back(px, py, pz, std::sqrt(px*px+py*py+pz*pz+m*m));
+      particles.back().set_user_index(i);
+    }
+    // along the beam
+    particles.emplace_back(0., 0., 7., 7.);
+    particles.back().set_user_index(n);
+    return particles;
+  }
+}
+
+int main() {
+  int nbad = 0;
+  for (int ev=0; ev<50; ++ev) {
+    const double rParam = (ev%3==0) ? 0.4 : ((ev%3==1) ? 0.8 : 2.5);
+    const double ptMin = (ev%2) ? 0. : 5.;
+    std::vector<fastjet::PseudoJet> particles = makeEvent(50+(ev*97)%2000);
+
+    fastjet::ClusterSequence cs(particles, fastjet::JetDefinition(fastjet::antikt_algorithm, rParam));
+    std::vector<fastjet::PseudoJet> fjJets = fastjet::sorted_by_pt(cs.inclusive_jets(ptMin));
+
+    TiledAntiKtAlgorithm algo(rParam);
+    for (auto const & p : particles) algo.addParticle(p.px(), p.py(), p.pz(), p.E());
+    algo.run();
+    std::vector<unsigned int> jets = algo.inclusiveJets(ptMin);
+
+    if (jets.size() != fjJets.size()) {
+      std::cout << "event " << ev << ": " << jets.size() << " jets instead of " << fjJets.size() << std::endl;
+      ++nbad;
+      continue;
+    }
+    std::vector<unsigned int> indices;
+    for (unsigned int j=0; j<jets.size(); ++j) {
+      algo.constituents(jets[j], indices);
+      std::sort(indices.begin(), indices.end());
+      std::vector<unsigned int> fjIndices;
+      for (auto const & c : fjJets[j].constituents()) fjIndices.push_back(c.user_index());
+      std::sort(fjIndices.begin(), fjIndices.end());
+      const fastjet::PseudoJet & fjJet = fjJets[j];
+      if (indices != fjIndices ||
+          std::abs(algo.px(jets[j])-fjJet.px()) > 1e-9*fjJet.E() ||
+          std::abs(algo.py(jets[j])-fjJet.py()) > 1e-9*fjJet.E() ||
+          std::abs(algo.pz(jets[j])-fjJet.pz()) > 1e-9*fjJet.E() ||
+          std::abs(algo.e(jets[j])-fjJet.E()) > 1e-9*fjJet.E()) {
+        std::cout << "event " << ev << ": jet " << j << " differs, pt " << fjJet.pt() << std::endl;
+        ++nbad;
+      }
+    }
+  }
+  std::cout << nbad << " differences" << std::endl;
+  return nbad==0 ? 0 : 1;
+}
@@ -18,7 +18,7 @@ class ECFAdder : public edm::stream::EDProducer<> {
     explicit ECFAdder(const edm::ParameterSet& iConfig);
     
     void produce(edm::Event & iEvent, const edm::EventSetup & iSetup) override;
-    float getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const;
+    void getConstituents(const edm::Ptr<reco::Jet> & object, std::vector<fastjet::PseudoJet> & FJparticles) const;
 
     static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
     
@@ -10,6 +10,7 @@
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "fastjet/contrib/Njettiness.hh"
+#include "fastjet/JetDefinition.hh"
 
 
 class NjettinessAdder : public edm::stream::EDProducer<> { 
@@ -48,7 +49,8 @@ class NjettinessAdder : public edm::stream::EDProducer<> {
     ~NjettinessAdder() override {}
     
     void produce(edm::Event & iEvent, const edm::EventSetup & iSetup) override ;
-    float getTau(unsigned num, const edm::Ptr<reco::Jet> & object) const;
+    /// the taus of all the Njets_ values, in the same order
+    void getTaus(const edm::Ptr<reco::Jet> & object, std::vector<float> & taus);
     
  private:	
     edm::InputTag                          src_;
@@ -70,6 +72,11 @@ class NjettinessAdder : public edm::stream::EDProducer<> {
 
     std::auto_ptr<fastjet::contrib::Njettiness>   routine_; 
 
+    // for the exclusive kT or C/A axes: the clustering of the seed axes, shared by all the
+    // N values of a jet, and the Njettiness computed from these axes
+    std::unique_ptr<fastjet::JetDefinition>       seedDefinition_;
+    std::unique_ptr<fastjet::contrib::Njettiness> manualRoutine_;
+
 };
 
 #endif
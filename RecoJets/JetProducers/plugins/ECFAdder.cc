@@ -66,39 +66,51 @@ void ECFAdder::produce(edm::Event & iEvent, const edm::EventSetup & iSetup) {
   // read input collection
   edm::Handle<edm::View<reco::Jet> > jets;
   iEvent.getByToken(src_token_, jets);
-  
-  unsigned i=0;
-  for ( std::vector<unsigned>::const_iterator n = Njets_.begin(); n != Njets_.end(); ++n )
-    {
-      // prepare room for output
-      std::vector<float> ecfN;
-      ecfN.reserve(jets->size());
 
-      for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
+  // prepare room for output
+  std::vector<std::vector<float> > ecfN(Njets_.size());
+  for ( auto & ecfs : ecfN ) ecfs.reserve(jets->size());
 
-	edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
+  // the constituents of a jet are collected once, for all the N values
+  std::vector<bool> selected(Njets_.size());
+  std::vector<fastjet::PseudoJet> FJparticles;
+  for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
 
-	
-	float t= -1.0;
-	if ( selectors_[n - Njets_.begin()] (*jetIt) )
-	  t = getECF( i, jetPtr );	
+    bool anySelected = false;
+    for ( unsigned i = 0; i < Njets_.size(); ++i ) {
+      selected[i] = selectors_[i] (*jetIt);
+      anySelected |= selected[i];
+    }
 
-	ecfN.push_back(t);
-      }
+    fastjet::PseudoJet FJjet;
+    if ( anySelected ) {
+      edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
+      getConstituents( jetPtr, FJparticles );
+      if ( !FJparticles.empty() ) FJjet = join(FJparticles);
+    }
 
+    for ( unsigned i = 0; i < Njets_.size(); ++i ) {
+      float t= -1.0;
+      if ( selected[i] && FJparticles.size() > Njets_[i] )
+	t = routine_[i]->result(FJjet);
+      ecfN[i].push_back(t);
+    }
+  }
+
+  for ( unsigned i = 0; i < Njets_.size(); ++i )
+    {
       auto outT = std::make_unique<edm::ValueMap<float>>();
       edm::ValueMap<float>::Filler fillerT(*outT);
-      fillerT.insert(jets, ecfN.begin(), ecfN.end());
+      fillerT.insert(jets, ecfN[i].begin(), ecfN[i].end());
       fillerT.fill();
 
       iEvent.put(std::move(outT),variables_[i]);
-      ++i;
     }
 }
 
-float ECFAdder::getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const
+void ECFAdder::getConstituents(const edm::Ptr<reco::Jet> & object, std::vector<fastjet::PseudoJet> & FJparticles) const
 {
-  std::vector<fastjet::PseudoJet> FJparticles;
+  FJparticles.clear();
   for (unsigned k = 0; k < object->numberOfDaughters(); ++k)
     {
       const reco::CandidatePtr & dp = object->daughterPtr(k);
@@ -122,14 +134,6 @@ float ECFAdder::getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const
       else
 	edm::LogWarning("MissingJetConstituent") << "Jet constituent required for ECF computation is missing!";
     }
-  if ( FJparticles.size() > Njets_[index] )
-    {
-      return routine_[index]->result(join(FJparticles));
-    }
-  else
-    {
-      return -1.0;
-    }
 }
 
 
@@ -40,6 +40,7 @@
 #include "fastjet/tools/GridMedianBackgroundEstimator.hh"
 #include "fastjet/tools/Subtractor.hh"
 #include "fastjet/contrib/ConstituentSubtractor.hh"
+#include "fastjet/CompositeJetStructure.hh"
 #include "RecoJets/JetAlgorithms/interface/CMSBoostedTauSeedingAlgorithm.h"
 
 #include <iostream>
@@ -113,6 +114,8 @@ FastjetJetProducer::FastjetJetProducer(const edm::ParameterSet& iConfig):
 	gridMaxRapidity_ = iConfig.getParameter<double>("gridMaxRapidity");
 	gridSpacing_ = iConfig.getParameter<double>("gridSpacing");
 
+	useTiledAntiKt_ = iConfig.getParameter<bool>("useTiledAntiKt");
+
 	input_chrefcand_token_ = consumes<edm::View<reco::RecoChargedRefCandidate> >(iConfig.getParameter<edm::InputTag>("src"));
 
 	if ( useFiltering_ ||
@@ -138,6 +141,16 @@ FastjetJetProducer::FastjetJetProducer(const edm::ParameterSet& iConfig):
 
 	if ( ( useTrimming_ ) && ( ( rFilt_ == -1 ) || ( trimPtFracMin_ == -1 ) ) ) 
 		throw cms::Exception("useTrimming") << "Parameters rFilt and/or trimPtFracMin for Trimming are not defined." << std::endl;
+
+	// the tiled anti-kT clustering gives the jets and their constituents only:
+	// no fastjet area (the disk approximation can be used), rho, ghosts or grooming
+	if ( useTiledAntiKt_ ) {
+		if ( jetAlgorithm_ != "AntiKt" || doAreaFastjet_ || doRhoFastjet_ || useExplicitGhosts_ || doPUOffsetCorr_ ||
+		     useFiltering_ || useDynamicFiltering_ || useTrimming_ || usePruning_ || useKtPruning_ || useSoftDrop_ ||
+		     useMassDropTagger_ || useCMSBoostedTauSeedingAlgorithm_ || useConstituentSubtraction_ )
+			throw cms::Exception("useTiledAntiKt") << "useTiledAntiKt needs jetAlgorithm AntiKt, without doAreaFastjet, doRhoFastjet, explicit ghosts, jet grooming or doPUOffsetCorr." << std::endl;
+		tiledAntiKt_ = std::make_unique<TiledAntiKtAlgorithm>(rParam_);
+	}
 	
 	if ( ( usePruning_ ) && ( ( zCut_ == -1 ) || ( RcutFactor_ == -1 )  || ( nFilt_ == -1 )) ) 
 		throw cms::Exception("usePruning") << "Parameters zCut and/or RcutFactor and/or nFilt for Pruning are not defined." << std::endl;
@@ -297,7 +310,7 @@ void FastjetJetProducer::produceTrackJets( edm::Event & iEvent, const edm::Event
       // convert our jets and add to the overall jet vector
       for (unsigned int ijet=0;ijet<fjJets_.size();++ijet) {
         // get the constituents from fastjet
-        std::vector<fastjet::PseudoJet> fjConstituents = sorted_by_pt(fjClusterSeq_->constituents(fjJets_[ijet]));
+        std::vector<fastjet::PseudoJet> fjConstituents = sorted_by_pt(fjJets_[ijet].constituents());
         // convert them to CandidatePtr vector
         std::vector<reco::CandidatePtr> constituents = getConstituents(fjConstituents);
         // fill the trackjet
@@ -352,6 +365,12 @@ void FastjetJetProducer::runAlgorithm( edm::Event & iEvent, edm::EventSetup cons
   fin.close();
   */
 
+  // no grooming with useTiledAntiKt, see the constructor
+  if ( useTiledAntiKt_ ) {
+    runTiledAntiKt();
+    return;
+  }
+
   if ( !doAreaFastjet_ && !doRhoFastjet_) {
     fjClusterSeq_ = ClusterSequencePtr( new fastjet::ClusterSequence( fjInputs_, *fjJetDefinition_ ) );
   } else if (voronoiRfact_ <= 0) {
@@ -455,6 +474,31 @@ void FastjetJetProducer::runAlgorithm( edm::Event & iEvent, edm::EventSetup cons
 
 }
 
+//______________________________________________________________________________
+void FastjetJetProducer::runTiledAntiKt()
+{
+  tiledAntiKt_->clear();
+  tiledAntiKt_->reserve(fjInputs_.size());
+  for ( auto const& input : fjInputs_ ) {
+    tiledAntiKt_->addParticle(input.px(), input.py(), input.pz(), input.E());
+  }
+  tiledAntiKt_->run();
+
+  // the jets are made of the inputs, so that constituents() gives them back with their user_index
+  fjJets_.clear();
+  std::vector<unsigned int> indices;
+  std::vector<fastjet::PseudoJet> pieces;
+  for ( auto ijet : tiledAntiKt_->inclusiveJets(jetPtMin_) ) {
+    tiledAntiKt_->constituents(ijet, indices);
+    pieces.clear();
+    for ( auto i : indices ) pieces.push_back(fjInputs_[i]);
+    fastjet::PseudoJet jet = fastjet::join(pieces);
+    // the four-momentum as recombined by the clustering
+    jet.reset_momentum(tiledAntiKt_->px(ijet), tiledAntiKt_->py(ijet), tiledAntiKt_->pz(ijet), tiledAntiKt_->e(ijet));
+    fjJets_.push_back(jet);
+  }
+}
+
 //______________________________________________________________________________
 void FastjetJetProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
 
@@ -484,6 +528,7 @@ void FastjetJetProducer::fillDescriptionsFromFastJetProducer(edm::ParameterSetDe
 	desc.add<bool>("useConstituentSubtraction", false);
 	desc.add<bool>("useSoftDrop",	false);
 	desc.add<bool>("correctShape",	false);
+	desc.add<bool>("useTiledAntiKt",	false);
 	desc.add<bool>("UseOnlyVertexTracks",	false);
 	desc.add<bool>("UseOnlyOnePV",	false);
 	desc.add<double>("muCut",	-1.0);
@@ -9,6 +9,7 @@
 #include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
 
 #include "RecoJets/JetProducers/plugins/VirtualJetProducer.h"
+#include "RecoJets/JetAlgorithms/interface/TiledAntiKtAlgorithm.h"
 
 #include <fastjet/tools/Transformer.hh>
 
@@ -67,6 +68,7 @@ protected:
 
   virtual void produceTrackJets( edm::Event & iEvent, const edm::EventSetup & iSetup );
   void runAlgorithm( edm::Event& iEvent, const edm::EventSetup& iSetup ) override;
+  void runTiledAntiKt();
 
  private:
 
@@ -115,6 +117,9 @@ protected:
   double dRMax_;              /// for CMSBoostedTauSeedingAlgorithm : max dR
   int    maxDepth_;           /// for CMSBoostedTauSeedingAlgorithm : max depth for descending into clustering sequence
 
+  bool useTiledAntiKt_;       /// cluster with TiledAntiKtAlgorithm instead of a fastjet::ClusterSequence
+  std::unique_ptr<TiledAntiKtAlgorithm> tiledAntiKt_;  /// kept between events to reuse its buffers
+
 
   // tokens for the data access
   edm::EDGetTokenT<edm::View<reco::RecoChargedRefCandidate> > input_chrefcand_token_;
@@ -2,6 +2,7 @@
 
 
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "fastjet/ClusterSequence.hh"
 
 NjettinessAdder::NjettinessAdder(const edm::ParameterSet& iConfig) :
   src_(iConfig.getParameter<edm::InputTag>("src")),
@@ -71,42 +72,66 @@ NjettinessAdder::NjettinessAdder(const edm::ParameterSet& iConfig) :
   };
 
   routine_ = std::auto_ptr<fastjet::contrib::Njettiness> ( new fastjet::contrib::Njettiness( *axesDef, *measureDef ) );
-      
+
+  // The exclusive kT and C/A axes (with or without one pass of minimization) of all the
+  // N values come from the same clustering of the jet constituents: it is run once per
+  // jet, and its exclusive jets are given as manual axes. The jet definitions are the
+  // ones of the corresponding axes definitions in Nsubjettiness.
+  fastjet::contrib::Manual_Axes         manual_axes;
+  fastjet::contrib::OnePass_Manual_Axes onepass_manual_axes;
+  switch ( axesDefinition_ ) {
+  case  KT_Axes : case  OnePass_KT_Axes :
+    seedDefinition_.reset( new fastjet::JetDefinition( fastjet::kt_algorithm, fastjet::JetDefinition::max_allowable_R, fastjet::E_scheme, fastjet::Best ) );
+    break;
+  case  CA_Axes : case  OnePass_CA_Axes :
+    seedDefinition_.reset( new fastjet::JetDefinition( fastjet::cambridge_algorithm, fastjet::JetDefinition::max_allowable_R, fastjet::E_scheme, fastjet::Best ) );
+    break;
+  default : break;
+  };
+  if ( seedDefinition_ ) {
+    if ( axesDefinition_ == OnePass_KT_Axes || axesDefinition_ == OnePass_CA_Axes )
+      manualRoutine_.reset( new fastjet::contrib::Njettiness( onepass_manual_axes, *measureDef ) );
+    else
+      manualRoutine_.reset( new fastjet::contrib::Njettiness( manual_axes, *measureDef ) );
+  }
 }
 
 void NjettinessAdder::produce(edm::Event & iEvent, const edm::EventSetup & iSetup) {
   // read input collection
   edm::Handle<edm::View<reco::Jet> > jets;
   iEvent.getByToken(src_token_, jets);
-  
-  for ( std::vector<unsigned>::const_iterator n = Njets_.begin(); n != Njets_.end(); ++n )
-    {
-      std::ostringstream tauN_str;
-      tauN_str << "tau" << *n;
 
-      // prepare room for output
-      std::vector<float> tauN;
-      tauN.reserve(jets->size());
+  // prepare room for output
+  std::vector<std::vector<float> > tauN(Njets_.size());
+  for ( auto & taus : tauN ) taus.reserve(jets->size());
 
-      for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
+  // all the N values of a jet are computed together, from the same constituents
+  std::vector<float> taus(Njets_.size());
+  for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
 
-	edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
+    edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
 
-	float t=getTau( *n, jetPtr );
+    getTaus( jetPtr, taus );
 
-	tauN.push_back(t);
-      }
+    for ( unsigned i = 0; i < Njets_.size(); ++i ) tauN[i].push_back(taus[i]);
+  }
+
+  for ( std::vector<unsigned>::const_iterator n = Njets_.begin(); n != Njets_.end(); ++n )
+    {
+      std::ostringstream tauN_str;
+      tauN_str << "tau" << *n;
 
       auto outT = std::make_unique<edm::ValueMap<float>>();
       edm::ValueMap<float>::Filler fillerT(*outT);
-      fillerT.insert(jets, tauN.begin(), tauN.end());
+      auto const & taus = tauN[n - Njets_.begin()];
+      fillerT.insert(jets, taus.begin(), taus.end());
       fillerT.fill();
 
       iEvent.put(std::move(outT),tauN_str.str());
     }
 }
 
-float NjettinessAdder::getTau(unsigned num, const edm::Ptr<reco::Jet> & object) const
+void NjettinessAdder::getTaus(const edm::Ptr<reco::Jet> & object, std::vector<float> & taus)
 {
   std::vector<fastjet::PseudoJet> FJparticles;
   for (unsigned k = 0; k < object->numberOfDaughters(); ++k)
@@ -118,7 +143,27 @@ float NjettinessAdder::getTau(unsigned num, const edm::Ptr<reco::Jet> & object)
 	edm::LogWarning("MissingJetConstituent") << "Jet constituent required for N-subjettiness computation is missing!";
     }
 
-  return routine_->getTau(num, FJparticles); 
+  // the clustering for the seed axes, if any N needs axes
+  std::unique_ptr<fastjet::ClusterSequence> seedSequence;
+  if ( seedDefinition_ ) {
+    for ( auto n : Njets_ ) {
+      if ( FJparticles.size() > n ) {
+        seedSequence.reset( new fastjet::ClusterSequence( FJparticles, *seedDefinition_ ) );
+        break;
+      }
+    }
+  }
+
+  for ( unsigned i = 0; i < Njets_.size(); ++i ) {
+    const unsigned num = Njets_[i];
+    // with at most num particles tau is 0, as computed by Njettiness
+    if ( seedSequence && FJparticles.size() > num ) {
+      manualRoutine_->setAxes( seedSequence->exclusive_jets_up_to(num) );
+      taus[i] = manualRoutine_->getTau(num, FJparticles);
+    } else {
+      taus[i] = routine_->getTau(num, FJparticles);
+    }
+  }
 }
 
 
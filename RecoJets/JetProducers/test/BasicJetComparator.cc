@@ -0,0 +1,99 @@
+// Compares two collections of reco::BasicJets made from the same inputs, for
+// instance by FastjetJetProducer with and without useTiledAntiKt: same number
+// of jets, in the same order, with the same four-momentum, area and
+// constituents.
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/JetReco/interface/BasicJetCollection.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <algorithm>
+#include <cmath>
+
+class BasicJetComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit BasicJetComparator(edm::ParameterSet const& params) :
+    referenceToken_(consumes<reco::BasicJetCollection>(params.getParameter<edm::InputTag>("reference"))),
+    testToken_(consumes<reco::BasicJetCollection>(params.getParameter<edm::InputTag>("test"))),
+    tolerance_(params.getParameter<double>("tolerance"))
+  {}
+
+  void analyze(edm::Event const& iEvent, edm::EventSetup const&) override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  bool close(double a, double b) const { return std::abs(a - b) <= tolerance_ * std::max(1., std::abs(a)); }
+
+  const edm::EDGetTokenT<reco::BasicJetCollection> referenceToken_;
+  const edm::EDGetTokenT<reco::BasicJetCollection> testToken_;
+  const double tolerance_;
+
+  unsigned long nEvents_ = 0;
+  unsigned long nEmptyEvents_ = 0;
+  unsigned long nJets_ = 0;
+};
+
+void BasicJetComparator::analyze(edm::Event const& iEvent, edm::EventSetup const&)
+{
+  edm::Handle<reco::BasicJetCollection> hReference, hTest;
+  iEvent.getByToken(referenceToken_, hReference);
+  iEvent.getByToken(testToken_, hTest);
+  auto const& reference = *hReference;
+  auto const& test = *hTest;
+  ++nEvents_;
+  if (reference.empty()) ++nEmptyEvents_;
+
+  if (test.size() != reference.size()) {
+    throw cms::Exception("BasicJetComparator") << "event " << iEvent.id() << ": " << test.size() << " jets instead of "
+                                               << reference.size();
+  }
+  for (unsigned int i = 0; i < reference.size(); ++i) {
+    auto const& r = reference[i];
+    auto const& t = test[i];
+    if (!close(r.px(), t.px()) || !close(r.py(), t.py()) || !close(r.pz(), t.pz()) || !close(r.energy(), t.energy()) ||
+        !close(r.jetArea(), t.jetArea())) {
+      throw cms::Exception("BasicJetComparator") << "event " << iEvent.id() << ", jet " << i << ": (" << t.px() << ", "
+                                                 << t.py() << ", " << t.pz() << ", " << t.energy() << ") area "
+                                                 << t.jetArea() << " instead of (" << r.px() << ", " << r.py() << ", "
+                                                 << r.pz() << ", " << r.energy() << ") area " << r.jetArea();
+    }
+    auto const referenceConstituents = r.getJetConstituents();
+    auto const testConstituents = t.getJetConstituents();
+    if (testConstituents != referenceConstituents) {
+      throw cms::Exception("BasicJetComparator") << "event " << iEvent.id() << ", jet " << i << ": "
+                                                 << testConstituents.size() << " constituents instead of "
+                                                 << referenceConstituents.size() << ", or different ones";
+    }
+  }
+  nJets_ += reference.size();
+}
+
+void BasicJetComparator::endJob()
+{
+  edm::LogSystem("BasicJetComparator") << nJets_ << " jets compared in " << nEvents_ << " events, "
+                                       << nEmptyEvents_ << " without jets";
+  if (nJets_ == 0 || nEmptyEvents_ == 0) {
+    throw cms::Exception("BasicJetComparator") << "The comparison needs events with jets and events without";
+  }
+}
+
+void BasicJetComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
+{
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("reference", edm::InputTag(""));
+  desc.add<edm::InputTag>("test", edm::InputTag(""));
+  desc.add<double>("tolerance", 1e-9)->setComment("relative, or absolute below 1");
+  descriptions.add("basicJetComparator", desc);
+}
+
+DEFINE_FWK_MODULE(BasicJetComparator);
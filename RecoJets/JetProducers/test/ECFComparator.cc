@@ -0,0 +1,125 @@
+// Recomputes the energy correlation functions of jets one N at a time, collecting
+// the constituents of the jet for each N, as ECFAdder used to do, and requires the
+// same values as the ones of ECFAdder, which collects them once for all the N
+// values. The parameters are the ones of the ECFAdder.
+
+#include "CommonTools/UtilAlgos/interface/StringCutObjectSelector.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include "fastjet/PseudoJet.hh"
+#include "fastjet/contrib/EnergyCorrelator.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ECFComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit ECFComparator(edm::ParameterSet const& params);
+
+  void analyze(edm::Event const& iEvent, edm::EventSetup const&) override;
+  void endJob() override;
+
+private:
+  std::unique_ptr<fastjet::FunctionOfPseudoJet<double> > makeRoutine(unsigned n) const;
+
+  const edm::EDGetTokenT<edm::View<reco::Jet> > jetsToken_;
+  const std::vector<unsigned> Njets_;
+  const std::string ecftype_;
+  const double alpha_;
+  const double beta_;
+  std::vector<edm::EDGetTokenT<edm::ValueMap<float> > > ecfTokens_;
+  std::vector<StringCutObjectSelector<reco::Jet> > selectors_;
+
+  unsigned long nJets_ = 0;
+  unsigned long nComputed_ = 0;
+};
+
+ECFComparator::ECFComparator(edm::ParameterSet const& params) :
+  jetsToken_(consumes<edm::View<reco::Jet> >(params.getParameter<edm::InputTag>("src"))),
+  Njets_(params.getParameter<std::vector<unsigned> >("Njets")),
+  ecftype_(params.getParameter<std::string>("ecftype")),
+  alpha_(params.getParameter<double>("alpha")),
+  beta_(params.getParameter<double>("beta"))
+{
+  const std::string ecfs = params.getParameter<std::string>("ecfs");
+  const auto cuts = params.getParameter<std::vector<std::string> >("cuts");
+  const std::string prefix = (ecftype_ == "ECF" || ecftype_.empty()) ? "ecf" : "ecf" + ecftype_;
+  for (unsigned i = 0; i < Njets_.size(); ++i) {
+    ecfTokens_.push_back(consumes<edm::ValueMap<float> >(edm::InputTag(ecfs, prefix + std::to_string(Njets_[i]))));
+    selectors_.emplace_back(cuts.at(i));
+  }
+}
+
+std::unique_ptr<fastjet::FunctionOfPseudoJet<double> > ECFComparator::makeRoutine(unsigned n) const
+{
+  typedef std::unique_ptr<fastjet::FunctionOfPseudoJet<double> > Routine;
+  const auto measure = fastjet::contrib::EnergyCorrelator::pt_R;
+  if (ecftype_ == "C") return Routine(new fastjet::contrib::EnergyCorrelatorCseries(n, beta_, measure));
+  if (ecftype_ == "D") return Routine(new fastjet::contrib::EnergyCorrelatorGeneralizedD2(alpha_, beta_, measure));
+  if (ecftype_ == "N") return Routine(new fastjet::contrib::EnergyCorrelatorNseries(n, beta_, measure));
+  if (ecftype_ == "M") return Routine(new fastjet::contrib::EnergyCorrelatorMseries(n, beta_, measure));
+  if (ecftype_ == "U") return Routine(new fastjet::contrib::EnergyCorrelatorUseries(n, beta_, measure));
+  return Routine(new fastjet::contrib::EnergyCorrelator(n, beta_, measure));
+}
+
+void ECFComparator::analyze(edm::Event const& iEvent, edm::EventSetup const&)
+{
+  edm::Handle<edm::View<reco::Jet> > jets;
+  iEvent.getByToken(jetsToken_, jets);
+
+  for (unsigned i = 0; i < Njets_.size(); ++i) {
+    edm::Handle<edm::ValueMap<float> > ecfs;
+    iEvent.getByToken(ecfTokens_[i], ecfs);
+    const auto routine = makeRoutine(Njets_[i]);
+    for (unsigned j = 0; j < jets->size(); ++j) {
+      const auto jet = jets->ptrAt(j);
+      float reference = -1.0;
+      if (selectors_[i](*jet)) {
+        // the constituents, or the ones of the subjets of a BasicJet
+        std::vector<fastjet::PseudoJet> particles;
+        for (unsigned k = 0; k < jet->numberOfDaughters(); ++k) {
+          const reco::CandidatePtr& dp = jet->daughterPtr(k);
+          if (dp->numberOfDaughters() == 0) {
+            particles.push_back(fastjet::PseudoJet(dp->px(), dp->py(), dp->pz(), dp->energy()));
+          } else {
+            for (unsigned l = 0; l < dp->numberOfDaughters(); ++l) {
+              const reco::Candidate* ddp = dp->daughter(l);
+              particles.push_back(fastjet::PseudoJet(ddp->px(), ddp->py(), ddp->pz(), ddp->energy()));
+            }
+          }
+        }
+        if (particles.size() > Njets_[i]) {
+          reference = routine->result(fastjet::join(particles));
+          ++nComputed_;
+        }
+      }
+      const float ecf = (*ecfs)[jet];
+      if (ecf != reference) {
+        throw cms::Exception("ECFComparator") << "event " << iEvent.id() << ", jet " << j << ": " << ecftype_
+                                              << " N = " << Njets_[i] << " is " << ecf << " instead of " << reference;
+      }
+    }
+  }
+  nJets_ += jets->size();
+}
+
+void ECFComparator::endJob()
+{
+  edm::LogSystem("ECFComparator") << nJets_ << " jets compared, " << nComputed_ << " values computed";
+  if (nComputed_ == 0) {
+    throw cms::Exception("ECFComparator") << "The comparison needs jets with more constituents than N";
+  }
+}
+
+DEFINE_FWK_MODULE(ECFComparator);
@@ -0,0 +1,120 @@
+// Recomputes the N-subjettiness of jets with fastjet::contrib::Nsubjettiness, one
+// N at a time and with its own axes, as NjettinessAdder used to do, and requires
+// the same values as the ones of NjettinessAdder, which takes the axes of all the
+// N values of a jet from the same clustering. The measure and axes parameters are
+// the ones of the NjettinessAdder.
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "RecoJets/JetProducers/interface/NjettinessAdder.h"
+
+#include "fastjet/PseudoJet.hh"
+#include "fastjet/contrib/Nsubjettiness.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class NjettinessComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit NjettinessComparator(edm::ParameterSet const& params);
+
+  void analyze(edm::Event const& iEvent, edm::EventSetup const&) override;
+  void endJob() override;
+
+private:
+  const edm::EDGetTokenT<edm::View<reco::Jet> > jetsToken_;
+  const std::vector<unsigned> Njets_;
+  std::vector<edm::EDGetTokenT<edm::ValueMap<float> > > tauTokens_;
+  std::unique_ptr<fastjet::contrib::MeasureDefinition> measure_;
+  std::unique_ptr<fastjet::contrib::AxesDefinition> axes_;
+
+  unsigned long nJets_ = 0;
+  unsigned long nNonZero_ = 0;
+};
+
+NjettinessComparator::NjettinessComparator(edm::ParameterSet const& params) :
+  jetsToken_(consumes<edm::View<reco::Jet> >(params.getParameter<edm::InputTag>("src"))),
+  Njets_(params.getParameter<std::vector<unsigned> >("Njets"))
+{
+  const std::string taus = params.getParameter<std::string>("taus");
+  for (auto n : Njets_) {
+    tauTokens_.push_back(consumes<edm::ValueMap<float> >(edm::InputTag(taus, "tau" + std::to_string(n))));
+  }
+
+  const double beta = params.getParameter<double>("beta");
+  const double R0 = params.getParameter<double>("R0");
+  const double Rcutoff = params.getParameter<double>("Rcutoff");
+  switch (params.getParameter<unsigned>("measureDefinition")) {
+  case NjettinessAdder::UnnormalizedMeasure : measure_.reset(new fastjet::contrib::UnnormalizedMeasure(beta)); break;
+  case NjettinessAdder::OriginalGeometricMeasure : measure_.reset(new fastjet::contrib::OriginalGeometricMeasure(beta)); break;
+  case NjettinessAdder::NormalizedCutoffMeasure : measure_.reset(new fastjet::contrib::NormalizedCutoffMeasure(beta, R0, Rcutoff)); break;
+  case NjettinessAdder::UnnormalizedCutoffMeasure : measure_.reset(new fastjet::contrib::UnnormalizedCutoffMeasure(beta, Rcutoff)); break;
+  case NjettinessAdder::NormalizedMeasure : default : measure_.reset(new fastjet::contrib::NormalizedMeasure(beta, R0)); break;
+  }
+
+  const double akAxesR0 = params.getParameter<double>("akAxesR0");
+  switch (params.getParameter<unsigned>("axesDefinition")) {
+  case NjettinessAdder::KT_Axes : default : axes_.reset(new fastjet::contrib::KT_Axes()); break;
+  case NjettinessAdder::CA_Axes : axes_.reset(new fastjet::contrib::CA_Axes()); break;
+  case NjettinessAdder::AntiKT_Axes : axes_.reset(new fastjet::contrib::AntiKT_Axes(akAxesR0)); break;
+  case NjettinessAdder::WTA_KT_Axes : axes_.reset(new fastjet::contrib::WTA_KT_Axes()); break;
+  case NjettinessAdder::WTA_CA_Axes : axes_.reset(new fastjet::contrib::WTA_CA_Axes()); break;
+  case NjettinessAdder::OnePass_KT_Axes : axes_.reset(new fastjet::contrib::OnePass_KT_Axes()); break;
+  case NjettinessAdder::OnePass_CA_Axes : axes_.reset(new fastjet::contrib::OnePass_CA_Axes()); break;
+  case NjettinessAdder::OnePass_AntiKT_Axes : axes_.reset(new fastjet::contrib::OnePass_AntiKT_Axes(akAxesR0)); break;
+  case NjettinessAdder::OnePass_WTA_KT_Axes : axes_.reset(new fastjet::contrib::OnePass_WTA_KT_Axes()); break;
+  case NjettinessAdder::OnePass_WTA_CA_Axes : axes_.reset(new fastjet::contrib::OnePass_WTA_CA_Axes()); break;
+  case NjettinessAdder::MultiPass_Axes :
+    // the multi-pass minimization starts from random axes, so two computations differ
+    throw cms::Exception("Configuration") << "NjettinessComparator cannot compare the random MultiPass_Axes";
+  }
+}
+
+void NjettinessComparator::analyze(edm::Event const& iEvent, edm::EventSetup const&)
+{
+  edm::Handle<edm::View<reco::Jet> > jets;
+  iEvent.getByToken(jetsToken_, jets);
+  std::vector<edm::Handle<edm::ValueMap<float> > > taus(tauTokens_.size());
+  for (unsigned i = 0; i < tauTokens_.size(); ++i) iEvent.getByToken(tauTokens_[i], taus[i]);
+
+  for (unsigned j = 0; j < jets->size(); ++j) {
+    const auto jet = jets->ptrAt(j);
+    std::vector<fastjet::PseudoJet> particles;
+    for (unsigned k = 0; k < jet->numberOfDaughters(); ++k) {
+      const reco::CandidatePtr& dp = jet->daughterPtr(k);
+      particles.push_back(fastjet::PseudoJet(dp->px(), dp->py(), dp->pz(), dp->energy()));
+    }
+    const fastjet::PseudoJet fjJet = fastjet::join(particles);
+    for (unsigned i = 0; i < Njets_.size(); ++i) {
+      const float reference = fastjet::contrib::Nsubjettiness(Njets_[i], *axes_, *measure_).result(fjJet);
+      const float tau = (*taus[i])[jet];
+      if (tau != reference) {
+        throw cms::Exception("NjettinessComparator") << "event " << iEvent.id() << ", jet " << j << " with "
+                                                     << particles.size() << " constituents: tau" << Njets_[i]
+                                                     << " = " << tau << " instead of " << reference;
+      }
+      if (reference > 0) ++nNonZero_;
+    }
+  }
+  nJets_ += jets->size();
+}
+
+void NjettinessComparator::endJob()
+{
+  edm::LogSystem("NjettinessComparator") << nJets_ << " jets compared, " << nNonZero_ << " non-zero taus";
+  if (nNonZero_ == 0) {
+    throw cms::Exception("NjettinessComparator") << "The comparison needs jets with non-zero taus";
+  }
+}
+
+DEFINE_FWK_MODULE(NjettinessComparator);
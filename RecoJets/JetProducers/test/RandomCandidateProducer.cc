@@ -0,0 +1,78 @@
+// Produces massless reco::LeafCandidates that depend only on the seed and the
+// event number, for the tests of the jet producers: showers of particles
+// around a few random axes, including axes close to phi = +-pi, and soft
+// particles over the whole acceptance. Some events have no particle at all.
+
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+class RandomCandidateProducer : public edm::global::EDProducer<> {
+public:
+  explicit RandomCandidateProducer(edm::ParameterSet const& params) :
+    seed_(params.getParameter<unsigned int>("seed")),
+    maxShowers_(params.getParameter<unsigned int>("maxShowers")),
+    maxSoftParticles_(params.getParameter<unsigned int>("maxSoftParticles")),
+    etaMax_(params.getParameter<double>("etaMax"))
+  {
+    produces<std::vector<reco::LeafCandidate> >();
+  }
+
+  void produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const override {
+    auto candidates = std::make_unique<std::vector<reco::LeafCandidate> >();
+
+    // one event out of five is empty
+    const unsigned long long event = iEvent.id().event();
+    if (event % 5 != 0) {
+      std::mt19937 engine(seed_ + event);
+      std::uniform_real_distribution<double> eta(-etaMax_, etaMax_), phi(-M_PI, M_PI), uniform(0., 1.);
+      std::normal_distribution<double> spread(0., 0.15);
+      auto add = [&](double pt, double particleEta, double particlePhi) {
+        candidates->emplace_back(0, reco::LeafCandidate::PolarLorentzVector(pt, particleEta, reco::reduceRange(particlePhi), 0.));
+      };
+
+      const unsigned int nShowers = std::uniform_int_distribution<unsigned int>(0, maxShowers_)(engine);
+      for (unsigned int s = 0; s < nShowers; ++s) {
+        // every other shower is next to phi = +-pi
+        const double axisEta = eta(engine), axisPhi = s % 2 ? M_PI - 0.05 + 0.1 * uniform(engine) : phi(engine);
+        const double showerPt = 20. + 400. * uniform(engine) * uniform(engine);
+        const unsigned int nParticles = std::uniform_int_distribution<unsigned int>(1, 40)(engine);
+        for (unsigned int p = 0; p < nParticles; ++p) {
+          add(showerPt / nParticles * 2. * uniform(engine), axisEta + spread(engine), axisPhi + spread(engine));
+        }
+      }
+      const unsigned int nSoft = std::uniform_int_distribution<unsigned int>(0, maxSoftParticles_)(engine);
+      for (unsigned int p = 0; p < nSoft; ++p) {
+        add(0.1 - 2. * std::log(1. - uniform(engine)), eta(engine), phi(engine));
+      }
+    }
+    iEvent.put(std::move(candidates));
+  }
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<unsigned int>("seed", 1)->setComment("the particles of an event depend on seed + event number only");
+    desc.add<unsigned int>("maxShowers", 8);
+    desc.add<unsigned int>("maxSoftParticles", 1000);
+    desc.add<double>("etaMax", 5.);
+    descriptions.add("randomCandidateProducer", desc);
+  }
+
+private:
+  const unsigned int seed_;
+  const unsigned int maxShowers_;
+  const unsigned int maxSoftParticles_;
+  const double etaMax_;
+};
+
+DEFINE_FWK_MODULE(RandomCandidateProducer);
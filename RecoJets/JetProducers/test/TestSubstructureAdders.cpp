@@ -0,0 +1,8 @@
+//------------------------------------------------------------
+//
+// Driver for shell scripts.
+//
+//------------------------------------------------------------
+
+#include "FWCore/Utilities/interface/TestHelper.h"
+RUNTEST()
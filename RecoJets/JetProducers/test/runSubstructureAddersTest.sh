@@ -0,0 +1,5 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testSubstructureAdders_cfg.py || die 'Failure using testSubstructureAdders_cfg.py' $?
@@ -0,0 +1,5 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testTiledAntiKt_cfg.py || die 'Failure using testTiledAntiKt_cfg.py' $?
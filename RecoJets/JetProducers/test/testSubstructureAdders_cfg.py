@@ -0,0 +1,78 @@
+# Checks that NjettinessAdder, which takes the axes of all the N values of a jet
+# from the same clustering, gives the same taus as Nsubjettiness computed one N at
+# a time, for each deterministic axes definition and for the cutoff and geometric
+# measures, and that ECFAdder gives the same values as computed one N at a time,
+# for each correlator type. MultiPass_Axes starts from random axes, so it cannot
+# be compared, and the manual axes need axes from outside.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 50
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(100))
+
+process.particles = cms.EDProducer("RandomCandidateProducer",
+    seed = cms.uint32(4242),
+    maxShowers = cms.uint32(6),
+    maxSoftParticles = cms.uint32(200),
+    etaMax = cms.double(3.)
+)
+
+process.ak8Jets = cms.EDProducer("FastjetJetProducer",
+    src = cms.InputTag("particles"),
+    jetType = cms.string("BasicJet"),
+    jetAlgorithm = cms.string("AntiKt"),
+    rParam = cms.double(0.8),
+    jetPtMin = cms.double(20.)
+)
+
+process.tasks = cms.Task(process.particles, process.ak8Jets)
+process.comparisons = cms.Sequence()
+
+from RecoJets.JetProducers.nJettinessAdder_cfi import Njettiness
+# KT, CA, AntiKT, WTA_KT, WTA_CA, and the same with one pass of minimization
+for axesDefinition in (0, 1, 2, 3, 4, 6, 7, 8, 9, 10):
+    for measureDefinition, label in ((0, ""), (2, "Geometric"), (3, "Cutoff")):
+        adder = Njettiness.clone(
+            src = "ak8Jets",
+            axesDefinition = cms.uint32(axesDefinition),
+            measureDefinition = cms.uint32(measureDefinition),
+            Rcutoff = cms.double(0.4 if measureDefinition == 3 else 999.),
+            akAxesR0 = cms.double(0.3)
+        )
+        name = "njettiness%d%s" % (axesDefinition, label)
+        comparator = cms.EDAnalyzer("NjettinessComparator",
+            adder.parameters_(),
+            taus = cms.string(name)
+        )
+        setattr(process, name, adder)
+        setattr(process, "compare" + name, comparator)
+        process.tasks.add(adder)
+        process.comparisons += comparator
+
+from RecoJets.JetProducers.ECF_cff import ecf
+for ecftype, Njets in (("ECF", (1, 2, 3)), ("C", (1, 2, 3)), ("D", (2,)), ("N", (2, 3)), ("M", (2, 3)), ("U", (1, 2, 3))):
+    adder = ecf.clone(
+        src = "ak8Jets",
+        Njets = cms.vuint32(*Njets),
+        # one cut per N, which selects some of the jets only
+        cuts = cms.vstring(*["pt > %d" % (20 * i) for i in range(len(Njets))]),
+        ecftype = cms.string(ecftype),
+        alpha = cms.double(1.0),
+        beta = cms.double(1.0)
+    )
+    name = "ecf" + ecftype
+    comparator = cms.EDAnalyzer("ECFComparator",
+        adder.parameters_(),
+        ecfs = cms.string(name)
+    )
+    setattr(process, name, adder)
+    setattr(process, "compare" + name, comparator)
+    process.tasks.add(adder)
+    process.comparisons += comparator
+
+process.p = cms.Path(process.comparisons, process.tasks)
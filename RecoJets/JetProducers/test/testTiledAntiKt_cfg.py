@@ -0,0 +1,45 @@
+# Checks that FastjetJetProducer gives the same jets with useTiledAntiKt as
+# with a fastjet::ClusterSequence, for several jet sizes and pt thresholds.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(200))
+
+process.particles = cms.EDProducer("RandomCandidateProducer",
+    seed = cms.uint32(12345),
+    maxShowers = cms.uint32(8),
+    maxSoftParticles = cms.uint32(1000),
+    etaMax = cms.double(5.)
+)
+
+process.tasks = cms.Task(process.particles)
+process.comparisons = cms.Sequence()
+for rParam, jetPtMin in ((0.4, 5.), (0.8, 20.), (0.2, 0.)):
+    label = "ak%dJets" % int(rParam * 10)
+    fastjet = cms.EDProducer("FastjetJetProducer",
+        src = cms.InputTag("particles"),
+        jetType = cms.string("BasicJet"),
+        jetAlgorithm = cms.string("AntiKt"),
+        rParam = cms.double(rParam),
+        jetPtMin = cms.double(jetPtMin),
+        doAreaDiskApprox = cms.bool(True)
+    )
+    tiled = fastjet.clone(useTiledAntiKt = cms.bool(True))
+    comparator = cms.EDAnalyzer("BasicJetComparator",
+        reference = cms.InputTag(label),
+        test = cms.InputTag(label + "Tiled"),
+        tolerance = cms.double(1e-7)
+    )
+    setattr(process, label, fastjet)
+    setattr(process, label + "Tiled", tiled)
+    setattr(process, "compare" + label, comparator)
+    process.tasks.add(fastjet, tiled)
+    process.comparisons += comparator
+
+process.p = cms.Path(process.comparisons, process.tasks)
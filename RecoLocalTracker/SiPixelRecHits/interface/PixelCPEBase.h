@@ -51,6 +51,7 @@
 
 class RectangularPixelTopology;
 class MagneticField;
+class SiPixelClustersSoA;
 class PixelCPEBase : public PixelClusterParameterEstimator
 {
 public:
@@ -190,6 +191,13 @@ public:
       return tuple;
    }
    
+   //--------------------------------------------------------------------------
+   // Position, error and quality word of all the clusters of the event
+   // in one call, angles from the position of the DetUnit.  The default
+   // calls getParameters() cluster by cluster; concrete CPEs may override
+   // it with loops over all the clusters.
+   //--------------------------------------------------------------------------
+   virtual void fillParameters(SiPixelClustersSoA & clusters) const;
    
    
 private:
@@ -203,6 +211,7 @@ private:
    
    void fillDetParams();
    
+protected:
    //-----------------------------------------------------------------------------
    //! A convenience method to fill a whole SiPixelRecHitQuality word in one shot.
    //! This way, we can keep the details of what is filled within the pixel
@@ -211,7 +220,7 @@ private:
    //-----------------------------------------------------------------------------
    SiPixelRecHitQuality::QualWordType rawQualityWord(ClusterParam & theClusterParam) const;
    
-protected:
+
    //--- All methods and data members are protected to facilitate (for now)
    //--- access from derived classes.
    
@@ -261,6 +270,9 @@ protected:
    //---------------------------------------------------------------------------
 protected:
    void computeAnglesFromDetPosition( DetParam const & theDetParam, ClusterParam & theClusterParam ) const;
+   // the same, with the cluster position (in the measurement frame) already known
+   void computeAnglesFromDetPosition( DetParam const & theDetParam, ClusterParam & theClusterParam,
+                                      MeasurementPoint const & clusterPosition ) const;
    
    void computeAnglesFromTrajectory ( DetParam const & theDetParam, ClusterParam & theClusterParam,
                                      const LocalTrajectoryParameters & ltp) const;
@@ -86,7 +86,10 @@ public:
    
    ~PixelCPEGeneric() override {;}
    
-   
+   //--- All the clusters of the event at once: the per-module and GenError
+   //--- lookups cluster by cluster, the position formula as a loop over
+   //--- flat arrays.  Same result as getParameters().
+   void fillParameters(SiPixelClustersSoA & clusters) const override;
    
 private:
    ClusterParam * createClusterParam(const SiPixelCluster & cl) const override;
@@ -114,6 +117,9 @@ private:
                             float size_cut           //!< Use edge when size == cuts
    ) const;
    
+   void
+   fillGenErrors(DetParam const & theDetParam, ClusterParamGeneric & theClusterParam, float qclus) const;
+   
    void
    collect_edge_charges(ClusterParam & theClusterParam,  //!< input, the cluster
                         int & Q_f_X,              //!< output, Q first  in X
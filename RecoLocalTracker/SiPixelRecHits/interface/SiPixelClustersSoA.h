@@ -0,0 +1,67 @@
+#ifndef RecoLocalTracker_SiPixelRecHits_SiPixelClustersSoA_h
+#define RecoLocalTracker_SiPixelRecHits_SiPixelClustersSoA_h
+
+//---------------------------------------------------------------------------
+//! \class SiPixelClustersSoA
+//!
+//! \brief Structure of arrays holding all the pixel clusters of an event
+//!
+//! Filled in a single flat pass over all the modules of the
+//! edmNew::DetSetVector<SiPixelCluster>: every cluster quantity the CPE
+//! needs (charge, charge weighted row/column sums, extent, edge charges)
+//! is a contiguous array indexed by the cluster number in the event,
+//! so that the CPE can loop over all the clusters at once instead of
+//! module by module and cluster by cluster.
+//!
+//! The CPE output (local position, errors and quality word) is stored in
+//! the same structure; SiPixelRecHitConverter turns it back into the
+//! legacy SiPixelRecHitCollection.
+//---------------------------------------------------------------------------
+
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHitQuality.h"
+
+#include <cstdint>
+#include <vector>
+
+class SiPixelClustersSoA {
+public:
+  void fill(const edmNew::DetSetVector<SiPixelCluster> & input);
+
+  unsigned int nModules() const { return detId.size(); }
+  unsigned int nClusters() const { return charge.size(); }
+
+  //! the clusters of module m are [moduleStart[m], moduleStart[m+1])
+  unsigned int begin(unsigned int m) const { return moduleStart[m]; }
+  unsigned int end(unsigned int m) const { return moduleStart[m+1]; }
+
+  //! measurement frame position, the same as SiPixelCluster::x() and y()
+  float x(unsigned int i) const { return xSum[i]/charge[i]; }
+  float y(unsigned int i) const { return ySum[i]/charge[i]; }
+
+  //--- Per module
+  std::vector<uint32_t> detId;
+  std::vector<uint32_t> moduleStart;   // nModules()+1 entries
+
+  //--- Per cluster
+  std::vector<const SiPixelCluster *> cluster;  // back-reference, for the rechit Ref
+  std::vector<uint32_t> moduleIndex;
+  std::vector<int32_t>  charge;
+  std::vector<float>    xSum;          // sum of adc*(row+0.5)
+  std::vector<float>    ySum;          // sum of adc*(col+0.5)
+  std::vector<int32_t>  minRow, maxRow, minCol, maxCol;
+  std::vector<int32_t>  sizeX, sizeY;
+  std::vector<int32_t>  qFirstX, qLastX, qFirstY, qLastY;  // charge of the edge rows/columns
+  std::vector<int32_t>  maxADC;        // to know if the pixel charge truncation matters
+
+  //--- CPE output, per cluster
+  std::vector<float> xLocal, yLocal;
+  std::vector<float> xErr2, yErr2;
+  std::vector<SiPixelRecHitQuality::QualWordType> qualWord;
+
+private:
+  void resize(unsigned int n);
+};
+
+#endif
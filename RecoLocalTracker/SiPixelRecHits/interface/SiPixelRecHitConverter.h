@@ -34,6 +34,7 @@
 //--- Base class for CPEs:
 
 #include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEBase.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/SiPixelClustersSoA.h"
 
 //--- Geometry + DataFormats
 #include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
@@ -96,6 +97,8 @@ namespace cms
     edm::InputTag src_;
     edm::EDGetTokenT<edmNew::DetSetVector<SiPixelCluster>> tPixelCluster;
     bool m_newCont; // save also in emdNew::DetSetVector
+    bool batchCPE_;  // run the CPE on all the clusters at once, through clustersSoA_
+    SiPixelClustersSoA clustersSoA_;
   };
 }
 
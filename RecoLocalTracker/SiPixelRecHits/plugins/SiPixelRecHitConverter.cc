@@ -43,7 +43,8 @@ namespace cms
     : 
     conf_(conf),
     src_( conf.getParameter<edm::InputTag>( "src" ) ),
-    tPixelCluster(consumes< edmNew::DetSetVector<SiPixelCluster> >( src_)) {
+    tPixelCluster(consumes< edmNew::DetSetVector<SiPixelCluster> >( src_)),
+    batchCPE_( conf.existsAs<bool>("batchCPE") ? conf.getParameter<bool>("batchCPE") : false ) {
     //--- Declare to the EDM what kind of collections we will be making.
     produces<SiPixelRecHitCollection>();
     
@@ -108,6 +109,25 @@ namespace cms
     
     const edmNew::DetSetVector<SiPixelCluster>& input = *inputhandle;
     
+    if ( batchCPE_ ) {
+      //--- one flat pass to fill the SoA, the CPE for all the clusters,
+      //--- then the legacy collection from the SoA
+      clustersSoA_.fill( input );
+      cpe_->fillParameters( clustersSoA_ );
+      for ( unsigned int m = 0; m != clustersSoA_.nModules(); ++m ) {
+	unsigned int detid = clustersSoA_.detId[m];
+	const GeomDetUnit * genericDet = geom->idToDetUnit( DetId(detid) );
+	SiPixelRecHitCollectionNew::FastFiller recHitsOnDetUnit(output,detid);
+	for ( unsigned int i = clustersSoA_.begin(m); i != clustersSoA_.end(m); ++i ) {
+	  LocalPoint lp( clustersSoA_.xLocal[i], clustersSoA_.yLocal[i] );
+	  LocalError le( clustersSoA_.xErr2[i], 0, clustersSoA_.yErr2[i] );
+	  edm::Ref< edmNew::DetSetVector<SiPixelCluster>, SiPixelCluster > cluster = edmNew::makeRefTo( inputhandle, clustersSoA_.cluster[i]);
+	  recHitsOnDetUnit.push_back( SiPixelRecHit( lp, le, clustersSoA_.qualWord[i], *genericDet, cluster) );
+	}
+      }
+      return;
+    }
+    
     edmNew::DetSetVector<SiPixelCluster>::const_iterator DSViter=input.begin();
     
     for ( ; DSViter != input.end() ; DSViter++) {
@@ -3,6 +3,8 @@ import FWCore.ParameterSet.Config as cms
 siPixelRecHits = cms.EDProducer("SiPixelRecHitConverter",
     src = cms.InputTag("siPixelClusters"),
     CPE = cms.string('PixelCPEGeneric'),
+    # compute all the hits of the event in one batch (same result)
+    batchCPE = cms.bool(False),
     VerboseLevel = cms.untracked.int32(0)
 )
 
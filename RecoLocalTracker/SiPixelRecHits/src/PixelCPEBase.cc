@@ -11,6 +11,7 @@
 #include "Geometry/TrackerGeometryBuilder/interface/ProxyPixelTopology.h"
 
 #include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEBase.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/SiPixelClustersSoA.h"
 
 #define CORRECT_FOR_BIG_PIXELS
 
@@ -308,9 +309,17 @@ computeAnglesFromTrajectory( DetParam const & theDetParam, ClusterParam & theClu
 // G. Giurgiu, 12/01/06 : implement the function
 void PixelCPEBase::
 computeAnglesFromDetPosition(DetParam const & theDetParam, ClusterParam & theClusterParam ) const
+{
+   computeAnglesFromDetPosition( theDetParam, theClusterParam,
+                                 MeasurementPoint(theClusterParam.theCluster->x(), theClusterParam.theCluster->y()) );
+}
+
+void PixelCPEBase::
+computeAnglesFromDetPosition(DetParam const & theDetParam, ClusterParam & theClusterParam,
+                             MeasurementPoint const & clusterPosition ) const
 {
    
-   LocalPoint lp = theDetParam.theTopol->localPosition( MeasurementPoint(theClusterParam.theCluster->x(), theClusterParam.theCluster->y()) );
+   LocalPoint lp = theDetParam.theTopol->localPosition( clusterPosition );
    auto gvx = lp.x()-theDetParam.theOrigin.x();
    auto gvy = lp.y()-theDetParam.theOrigin.y();
    auto gvz = -1.f/theDetParam.theOrigin.z();
@@ -500,3 +509,23 @@ PixelCPEBase::rawQualityWord(ClusterParam & theClusterParam) const
    
    return qualWord;
 }
+
+//-----------------------------------------------------------------------------
+//!  Default batch interface: one getParameters() call per cluster.
+//-----------------------------------------------------------------------------
+void
+PixelCPEBase::fillParameters(SiPixelClustersSoA & clusters) const
+{
+   for (unsigned int m = 0; m != clusters.nModules(); ++m) {
+      const GeomDetUnit & det = *geom_.idToDetUnit( DetId(clusters.detId[m]) );
+      for (unsigned int i = clusters.begin(m); i != clusters.end(m); ++i) {
+         auto tuple = getParameters( *clusters.cluster[i], det );
+         LocalError const & le = std::get<1>(tuple);
+         clusters.xLocal[i] = std::get<0>(tuple).x();
+         clusters.yLocal[i] = std::get<0>(tuple).y();
+         clusters.xErr2[i] = le.xx();
+         clusters.yErr2[i] = le.yy();
+         clusters.qualWord[i] = std::get<2>(tuple);
+      }
+   }
+}
@@ -1,4 +1,5 @@
 #include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGeneric.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/SiPixelClustersSoA.h"
 
 #include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
 #include "Geometry/TrackerGeometryBuilder/interface/RectangularPixelTopology.h"
@@ -20,6 +21,54 @@ using namespace std;
 namespace {
    constexpr float micronsToCm = 1.0e-4;
    const bool MYDEBUG = false;
+   
+   //--- Inputs of the generic position formula along one projection,
+   //--- one entry per cluster of the event (the det quantities are repeated).
+   struct ProjectionSoA {
+      std::vector<int>   size, qFirst, qLast;
+      std::vector<float> upperEdgeFirst, lowerEdgeLast;
+      std::vector<float> sumOfEdge;      // length of the first and last pixels, in pitches
+      std::vector<float> chargeWidth, thickness, cot, pitch, shift;
+      std::vector<float> bias;           // irradiation bias correction
+      
+      void resize(unsigned int n) {
+         size.resize(n); qFirst.resize(n); qLast.resize(n);
+         upperEdgeFirst.resize(n); lowerEdgeLast.resize(n);
+         sumOfEdge.resize(n);
+         chargeWidth.resize(n); thickness.resize(n); cot.resize(n); pitch.resize(n); shift.resize(n);
+         bias.resize(n);
+      }
+   };
+   
+   //--- generic_position_formula(), the Lorentz offset and the irradiation
+   //--- correction of localPosition(), without branches so that the compiler
+   //--- vectorizes the loop.  The operations are the same, in the same order.
+   void genericPositions(ProjectionSoA const & p, float * __restrict__ pos, unsigned int n,
+                         float eff_charge_cut_low, float eff_charge_cut_high, float size_cut,
+                         bool irradiationBiasCorrection)
+   {
+      for (unsigned int i = 0; i < n; ++i) {
+         float geom_center = 0.5f * ( p.upperEdgeFirst[i] + p.lowerEdgeLast[i] );
+         float W_inner = p.lowerEdgeLast[i] - p.upperEdgeFirst[i];
+         float W_pred = p.thickness[i] * p.cot[i] - p.chargeWidth[i];
+         float W_eff = std::abs( W_pred ) - W_inner;
+         bool useEdge = ( p.size[i] >= size_cut ) |
+                        ( W_eff/p.pitch[i] < eff_charge_cut_low ) |
+                        ( W_eff/p.pitch[i] > eff_charge_cut_high );
+         W_eff = useEdge ? p.pitch[i] * 0.5f * p.sumOfEdge[i] : W_eff;
+         float Qdiff = p.qLast[i] - p.qFirst[i];
+         float Qsum  = p.qLast[i] + p.qFirst[i];
+         Qsum = ( Qsum==0 ) ? 1.0f : Qsum;
+         float hit_pos = ( p.size[i]==1 ) ? geom_center : geom_center + 0.5f*(Qdiff/Qsum) * W_eff;
+         hit_pos = hit_pos + p.shift[i];
+         if ( irradiationBiasCorrection ) {
+            // for size 1 the Lorentz shift is already in the bias correction
+            hit_pos = ( p.size[i]==1 ) ? hit_pos - p.shift[i] : hit_pos;
+            hit_pos -= p.bias[i];
+         }
+         pos[i] = hit_pos;
+      }
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -175,71 +224,7 @@ PixelCPEGeneric::localPosition(DetParam const & theDetParam, ClusterParam & theC
    
    //cout<<" main la width "<<chargeWidthX<<" "<<chargeWidthY<<endl;
    
-   if ( UseErrorsFromTemplates_ ) {
-      
-      float qclus = theClusterParam.theCluster->charge();
-      float locBz = theDetParam.bz;
-      float locBx = theDetParam.bx;
-      //cout << "PixelCPEGeneric::localPosition(...) : locBz = " << locBz << endl;
-      
-      theClusterParam.pixmx  = -999.9; // max pixel charge for truncation of 2-D cluster
-      theClusterParam.sigmay = -999.9; // CPE Generic y-error for multi-pixel cluster
-      theClusterParam.deltay = -999.9; // CPE Generic y-bias for multi-pixel cluster
-      theClusterParam.sigmax = -999.9; // CPE Generic x-error for multi-pixel cluster
-      theClusterParam.deltax = -999.9; // CPE Generic x-bias for multi-pixel cluster
-      theClusterParam.sy1    = -999.9; // CPE Generic y-error for single single-pixel
-      theClusterParam.dy1    = -999.9; // CPE Generic y-bias for single single-pixel cluster
-      theClusterParam.sy2    = -999.9; // CPE Generic y-error for single double-pixel cluster
-      theClusterParam.dy2    = -999.9; // CPE Generic y-bias for single double-pixel cluster
-      theClusterParam.sx1    = -999.9; // CPE Generic x-error for single single-pixel cluster
-      theClusterParam.dx1    = -999.9; // CPE Generic x-bias for single single-pixel cluster
-      theClusterParam.sx2    = -999.9; // CPE Generic x-error for single double-pixel cluster
-      theClusterParam.dx2    = -999.9; // CPE Generic x-bias for single double-pixel cluster
-      
-      
-      SiPixelGenError gtempl(thePixelGenError_);
-      int gtemplID_ = theDetParam.detTemplateId;
-      
-      //int gtemplID0 = genErrorDBObject_->getGenErrorID(theDetParam.theDet->geographicalId().rawId());
-      //if(gtemplID0!=gtemplID_) cout<<" different id "<< gtemplID_<<" "<<gtemplID0<<endl;
-      
-      theClusterParam.qBin_ = gtempl.qbin( gtemplID_, theClusterParam.cotalpha, theClusterParam.cotbeta, locBz, locBx, qclus, IrradiationBiasCorrection_,
-                                          theClusterParam.pixmx, theClusterParam.sigmay, theClusterParam.deltay,
-                                          theClusterParam.sigmax, theClusterParam.deltax, theClusterParam.sy1,
-                                          theClusterParam.dy1, theClusterParam.sy2, theClusterParam.dy2, theClusterParam.sx1,
-                                          theClusterParam.dx1, theClusterParam.sx2, theClusterParam.dx2 );
-      
-      // now use the charge widths stored in the new generic template headers (change to the
-      // incorrect sign convention of the base class)
-      bool useLAWidthFromGenError = false;
-      if(useLAWidthFromGenError) {
-         chargeWidthX = (-micronsToCm*gtempl.lorxwidth());
-         chargeWidthY = (-micronsToCm*gtempl.lorywidth());
-         if(MYDEBUG) cout<< " redefine la width (gen-error) "<< chargeWidthX<<" "<< chargeWidthY <<endl;
-      }
-      if(MYDEBUG) cout<<" GenError: "<<gtemplID_<<endl;
-      
-      // These numbers come in microns from the qbin(...) call. Transform them to cm.
-      theClusterParam.deltax = theClusterParam.deltax * micronsToCm;
-      theClusterParam.dx1 = theClusterParam.dx1 * micronsToCm;
-      theClusterParam.dx2 = theClusterParam.dx2 * micronsToCm;
-      
-      theClusterParam.deltay = theClusterParam.deltay * micronsToCm;
-      theClusterParam.dy1 = theClusterParam.dy1 * micronsToCm;
-      theClusterParam.dy2 = theClusterParam.dy2 * micronsToCm;
-      
-      theClusterParam.sigmax = theClusterParam.sigmax * micronsToCm;
-      theClusterParam.sx1 = theClusterParam.sx1 * micronsToCm;
-      theClusterParam.sx2 = theClusterParam.sx2 * micronsToCm;
-      
-      theClusterParam.sigmay = theClusterParam.sigmay * micronsToCm;
-      theClusterParam.sy1 = theClusterParam.sy1 * micronsToCm;
-      theClusterParam.sy2 = theClusterParam.sy2 * micronsToCm;
-      
-   } // if ( UseErrorsFromTemplates_ )
-   else {
-     theClusterParam.qBin_ = 0;
-   }
+   fillGenErrors( theDetParam, theClusterParam, theClusterParam.theCluster->charge() );
    
    int Q_f_X;        //!< Q of the first  pixel  in X
    int Q_l_X;        //!< Q of the last   pixel  in X
@@ -389,6 +374,74 @@ PixelCPEGeneric::localPosition(DetParam const & theDetParam, ClusterParam & theC
 
 
 
+//-----------------------------------------------------------------------------
+//!  Errors and irradiation biases from the GenError object (with the qbin),
+//!  or qbin 0 if the errors from templates are not used.
+//-----------------------------------------------------------------------------
+void
+PixelCPEGeneric::fillGenErrors(DetParam const & theDetParam, ClusterParamGeneric & theClusterParam, float qclus) const
+{
+   if ( UseErrorsFromTemplates_ ) {
+      
+      float locBz = theDetParam.bz;
+      float locBx = theDetParam.bx;
+      //cout << "PixelCPEGeneric::localPosition(...) : locBz = " << locBz << endl;
+      
+      theClusterParam.pixmx  = -999.9; // max pixel charge for truncation of 2-D cluster
+      theClusterParam.sigmay = -999.9; // CPE Generic y-error for multi-pixel cluster
+      theClusterParam.deltay = -999.9; // CPE Generic y-bias for multi-pixel cluster
+      theClusterParam.sigmax = -999.9; // CPE Generic x-error for multi-pixel cluster
+      theClusterParam.deltax = -999.9; // CPE Generic x-bias for multi-pixel cluster
+      theClusterParam.sy1    = -999.9; // CPE Generic y-error for single single-pixel
+      theClusterParam.dy1    = -999.9; // CPE Generic y-bias for single single-pixel cluster
+      theClusterParam.sy2    = -999.9; // CPE Generic y-error for single double-pixel cluster
+      theClusterParam.dy2    = -999.9; // CPE Generic y-bias for single double-pixel cluster
+      theClusterParam.sx1    = -999.9; // CPE Generic x-error for single single-pixel cluster
+      theClusterParam.dx1    = -999.9; // CPE Generic x-bias for single single-pixel cluster
+      theClusterParam.sx2    = -999.9; // CPE Generic x-error for single double-pixel cluster
+      theClusterParam.dx2    = -999.9; // CPE Generic x-bias for single double-pixel cluster
+      
+      
+      SiPixelGenError gtempl(thePixelGenError_);
+      int gtemplID_ = theDetParam.detTemplateId;
+      
+      //int gtemplID0 = genErrorDBObject_->getGenErrorID(theDetParam.theDet->geographicalId().rawId());
+      //if(gtemplID0!=gtemplID_) cout<<" different id "<< gtemplID_<<" "<<gtemplID0<<endl;
+      
+      theClusterParam.qBin_ = gtempl.qbin( gtemplID_, theClusterParam.cotalpha, theClusterParam.cotbeta, locBz, locBx, qclus, IrradiationBiasCorrection_,
+                                          theClusterParam.pixmx, theClusterParam.sigmay, theClusterParam.deltay,
+                                          theClusterParam.sigmax, theClusterParam.deltax, theClusterParam.sy1,
+                                          theClusterParam.dy1, theClusterParam.sy2, theClusterParam.dy2, theClusterParam.sx1,
+                                          theClusterParam.dx1, theClusterParam.sx2, theClusterParam.dx2 );
+      
+      // the charge widths stored in the generic template headers (gtempl.lorxwidth(),
+      // gtempl.lorywidth(), with the opposite sign convention) are not used
+      if(MYDEBUG) cout<<" GenError: "<<gtemplID_<<endl;
+      
+      // These numbers come in microns from the qbin(...) call. Transform them to cm.
+      theClusterParam.deltax = theClusterParam.deltax * micronsToCm;
+      theClusterParam.dx1 = theClusterParam.dx1 * micronsToCm;
+      theClusterParam.dx2 = theClusterParam.dx2 * micronsToCm;
+      
+      theClusterParam.deltay = theClusterParam.deltay * micronsToCm;
+      theClusterParam.dy1 = theClusterParam.dy1 * micronsToCm;
+      theClusterParam.dy2 = theClusterParam.dy2 * micronsToCm;
+      
+      theClusterParam.sigmax = theClusterParam.sigmax * micronsToCm;
+      theClusterParam.sx1 = theClusterParam.sx1 * micronsToCm;
+      theClusterParam.sx2 = theClusterParam.sx2 * micronsToCm;
+      
+      theClusterParam.sigmay = theClusterParam.sigmay * micronsToCm;
+      theClusterParam.sy1 = theClusterParam.sy1 * micronsToCm;
+      theClusterParam.sy2 = theClusterParam.sy2 * micronsToCm;
+      
+   } // if ( UseErrorsFromTemplates_ )
+   else {
+     theClusterParam.qBin_ = 0;
+   }
+}
+
+
 //-----------------------------------------------------------------------------
 //!  A generic version of the position formula.  Since it works for both
 //!  X and Y, in the interest of the simplicity of the code, all parameters
@@ -728,7 +781,94 @@ PixelCPEGeneric::localError(DetParam const & theDetParam,  ClusterParam & theClu
 }
 
 
-
-
-
-
+//-----------------------------------------------------------------------------
+//!  Batch version of getParameters(cluster, det) for all the clusters of the
+//!  event.  The per-cluster lookups (topology, GenError qbin, errors) are done
+//!  first, without allocating any ClusterParam on the heap and with the charges
+//!  already collected in the SoA; then the positions are computed for all the
+//!  clusters in one vectorized loop per projection.
+//-----------------------------------------------------------------------------
+void
+PixelCPEGeneric::fillParameters(SiPixelClustersSoA & clusters) const
+{
+   unsigned int n = clusters.nClusters();
+   ProjectionSoA px, py;
+   px.resize(n);
+   py.resize(n);
+   
+   const bool truncate = UseErrorsFromTemplates_ && TruncatePixelCharge_;
+   
+   for (unsigned int m = 0; m != clusters.nModules(); ++m) {
+      DetParam const & theDetParam = detParam( *geom_.idToDetUnit( DetId(clusters.detId[m]) ) );
+      
+      float chargeWidthX = (theDetParam.lorentzShiftInCmX * theDetParam.widthLAFractionX);
+      float chargeWidthY = (theDetParam.lorentzShiftInCmY * theDetParam.widthLAFractionY);
+      float shiftX = 0.5f*theDetParam.lorentzShiftInCmX;
+      float shiftY = 0.5f*theDetParam.lorentzShiftInCmY;
+      
+      for (unsigned int i = clusters.begin(m); i != clusters.end(m); ++i) {
+         ClusterParamGeneric theClusterParam(*clusters.cluster[i]);
+         setTheClu( theDetParam, theClusterParam );
+         computeAnglesFromDetPosition( theDetParam, theClusterParam, MeasurementPoint(clusters.x(i), clusters.y(i)) );
+         fillGenErrors( theDetParam, theClusterParam, clusters.charge[i] );
+         
+         int minRow = clusters.minRow[i], maxRow = clusters.maxRow[i];
+         int minCol = clusters.minCol[i], maxCol = clusters.maxCol[i];
+         
+         // the edge charges in the SoA are not truncated: only redo them if it matters
+         if ( truncate && clusters.maxADC[i] > theClusterParam.pixmx ) {
+            collect_edge_charges( theClusterParam,
+                                  px.qFirst[i], px.qLast[i],
+                                  py.qFirst[i], py.qLast[i] );
+         } else {
+            px.qFirst[i] = clusters.qFirstX[i]; px.qLast[i] = clusters.qLastX[i];
+            py.qFirst[i] = clusters.qFirstY[i]; py.qLast[i] = clusters.qLastY[i];
+         }
+         
+         LocalPoint local_URcorn_LLpix = theDetParam.theTopol->localPosition( MeasurementPoint(minRow+1.0, minCol+1.0) );
+         LocalPoint local_LLcorn_URpix = theDetParam.theTopol->localPosition( MeasurementPoint(maxRow, maxCol) );
+         
+         bool firstIsBigX = theDetParam.theRecTopol->isItBigPixelInX( minRow );
+         bool lastIsBigX  = theDetParam.theRecTopol->isItBigPixelInX( maxRow );
+         bool firstIsBigY = theDetParam.theRecTopol->isItBigPixelInY( minCol );
+         bool lastIsBigY  = theDetParam.theRecTopol->isItBigPixelInY( maxCol );
+         
+         px.size[i] = clusters.sizeX[i];
+         px.upperEdgeFirst[i] = local_URcorn_LLpix.x();
+         px.lowerEdgeLast[i] = local_LLcorn_URpix.x();
+         px.sumOfEdge[i] = 2.0f + (firstIsBigX ? 1.0f : 0.0f) + (lastIsBigX ? 1.0f : 0.0f);
+         px.chargeWidth[i] = chargeWidthX;
+         px.thickness[i] = theDetParam.theThickness;
+         px.cot[i] = theClusterParam.cotalpha;
+         px.pitch[i] = theDetParam.thePitchX;
+         px.shift[i] = shiftX;
+         px.bias[i] = !IrradiationBiasCorrection_ ? 0.f :
+            ( px.size[i]==1 ) ? ( lastIsBigX ? theClusterParam.dx2 : theClusterParam.dx1 ) : theClusterParam.deltax;
+         
+         py.size[i] = clusters.sizeY[i];
+         py.upperEdgeFirst[i] = local_URcorn_LLpix.y();
+         py.lowerEdgeLast[i] = local_LLcorn_URpix.y();
+         py.sumOfEdge[i] = 2.0f + (firstIsBigY ? 1.0f : 0.0f) + (lastIsBigY ? 1.0f : 0.0f);
+         py.chargeWidth[i] = chargeWidthY;
+         py.thickness[i] = theDetParam.theThickness;
+         py.cot[i] = theClusterParam.cotbeta;
+         py.pitch[i] = theDetParam.thePitchY;
+         py.shift[i] = shiftY;
+         py.bias[i] = !IrradiationBiasCorrection_ ? 0.f :
+            ( py.size[i]==1 ) ? ( lastIsBigY ? theClusterParam.dy2 : theClusterParam.dy1 ) : theClusterParam.deltay;
+         
+         // the errors do not depend on the position
+         LocalError le = localError( theDetParam, theClusterParam );
+         clusters.xErr2[i] = le.xx();
+         clusters.yErr2[i] = le.yy();
+         clusters.qualWord[i] = rawQualityWord( theClusterParam );
+      }
+   }
+   
+   genericPositions( px, clusters.xLocal.data(), n,
+                     the_eff_charge_cut_lowX, the_eff_charge_cut_highX, the_size_cutX,
+                     IrradiationBiasCorrection_ );
+   genericPositions( py, clusters.yLocal.data(), n,
+                     the_eff_charge_cut_lowY, the_eff_charge_cut_highY, the_size_cutY,
+                     IrradiationBiasCorrection_ );
+}
@@ -0,0 +1,72 @@
+#include "RecoLocalTracker/SiPixelRecHits/interface/SiPixelClustersSoA.h"
+
+#include <algorithm>
+
+void SiPixelClustersSoA::resize(unsigned int n) {
+  cluster.resize(n);
+  moduleIndex.resize(n);
+  charge.resize(n);
+  xSum.resize(n); ySum.resize(n);
+  minRow.resize(n); maxRow.resize(n); minCol.resize(n); maxCol.resize(n);
+  sizeX.resize(n); sizeY.resize(n);
+  qFirstX.resize(n); qLastX.resize(n); qFirstY.resize(n); qLastY.resize(n);
+  maxADC.resize(n);
+  xLocal.resize(n); yLocal.resize(n);
+  xErr2.resize(n); yErr2.resize(n);
+  qualWord.resize(n);
+}
+
+//---------------------------------------------------------------------------
+//!  One pass over all the modules and all the pixels of each cluster:
+//!  the sums are accumulated in the same order as in SiPixelCluster,
+//!  so x() and y() are bit-wise identical to the cluster ones.
+//---------------------------------------------------------------------------
+void SiPixelClustersSoA::fill(const edmNew::DetSetVector<SiPixelCluster> & input) {
+  detId.clear();
+  moduleStart.clear();
+  detId.reserve(input.size());
+  moduleStart.reserve(input.size()+1);
+  resize(input.dataSize());
+
+  unsigned int i = 0;
+  for (auto const & detSet : input) {
+    unsigned int m = detId.size();
+    detId.push_back(detSet.detId());
+    moduleStart.push_back(i);
+    for (auto const & clus : detSet) {
+      int xmin = clus.minPixelRow();
+      int xmax = clus.maxPixelRow();
+      int ymin = clus.minPixelCol();
+      int ymax = clus.maxPixelCol();
+      int q = 0, qfx = 0, qlx = 0, qfy = 0, qly = 0, qmax = 0;
+      float sx = 0, sy = 0;
+      int isize = clus.size();
+      for (int j = 0; j != isize; ++j) {
+        auto const & pixel = clus.pixel(j);
+        int adc = pixel.adc;
+        q += adc;
+        sx += float(adc) * (pixel.x + 0.5f);
+        sy += float(adc) * (pixel.y + 0.5f);
+        qmax = std::max(qmax, adc);
+        if (pixel.x == xmin) qfx += adc;
+        if (pixel.x == xmax) qlx += adc;
+        if (pixel.y == ymin) qfy += adc;
+        if (pixel.y == ymax) qly += adc;
+      }
+      cluster[i] = &clus;
+      moduleIndex[i] = m;
+      charge[i] = q;
+      xSum[i] = sx; ySum[i] = sy;
+      minRow[i] = xmin; maxRow[i] = xmax;
+      minCol[i] = ymin; maxCol[i] = ymax;
+      sizeX[i] = clus.sizeX(); sizeY[i] = clus.sizeY();
+      qFirstX[i] = qfx; qLastX[i] = qlx;
+      qFirstY[i] = qfy; qLastY[i] = qly;
+      maxADC[i] = qmax;
+      ++i;
+    }
+  }
+  moduleStart.push_back(i);
+  // the data of a DetSetVector may be larger than the sum of its DetSets
+  resize(i);
+}
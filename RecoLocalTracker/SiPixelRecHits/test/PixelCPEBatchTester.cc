@@ -0,0 +1,197 @@
+// Compares PixelCPEBase::fillParameters(SiPixelClustersSoA &), as used by
+// SiPixelRecHitConverter with batchCPE=True, to getParameters() cluster by
+// cluster: same position, errors and quality word for every cluster.
+//
+// The clusters are the ones of the "src" collection, if given, and clusters
+// generated on every pixel module: single pixels in the corners of the module,
+// clusters over the big pixels between the ROCs, long clusters, and random
+// clusters, some with pixel charges above the truncation of the generic CPE.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "RecoLocalTracker/Records/interface/TkPixelCPERecord.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEBase.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/SiPixelClustersSoA.h"
+
+class PixelCPEBatchTester : public edm::one::EDAnalyzer<> {
+ public:
+  explicit PixelCPEBatchTester(const edm::ParameterSet& pset) :
+    cpeName_(pset.getParameter<std::string>("PixelCPE")),
+    src_(pset.getParameter<edm::InputTag>("src")),
+    nRandom_(pset.getParameter<unsigned int>("randomClustersPerModule")),
+    tolerance_(pset.getParameter<double>("tolerance")),
+    engine_(pset.getParameter<unsigned int>("seed"))
+  {
+    if ( !src_.label().empty() ) srcToken_ = consumes<edmNew::DetSetVector<SiPixelCluster> >(src_);
+  }
+
+  void analyze(const edm::Event& event, const edm::EventSetup& setup) override;
+  void endJob() override;
+
+ private:
+  typedef edmNew::DetSetVector<SiPixelCluster> Clusters;
+
+  // pixels given as (row, col, adc)
+  struct Pixel { int row, col, adc; };
+  static void addCluster(Clusters::FastFiller & filler, const std::vector<Pixel> & pixels);
+  void generate(const PixelGeomDetUnit & det, Clusters::FastFiller & filler);
+
+  const std::string cpeName_;
+  const edm::InputTag src_;
+  edm::EDGetTokenT<Clusters> srcToken_;
+  const unsigned int nRandom_;
+  const double tolerance_;
+  std::mt19937 engine_;
+
+  unsigned long nClusters_ = 0;
+  unsigned long nBigPixelClusters_ = 0;
+  unsigned long nEdgeClusters_ = 0;
+};
+
+void PixelCPEBatchTester::addCluster(Clusters::FastFiller & filler, const std::vector<Pixel> & pixels)
+{
+  std::vector<uint16_t> adc, row, col;
+  uint16_t rowMin = pixels.front().row, colMin = pixels.front().col;
+  for ( const Pixel & p : pixels ) {
+    adc.push_back(p.adc);
+    row.push_back(p.row);
+    col.push_back(p.col);
+    rowMin = std::min<uint16_t>(rowMin, p.row);
+    colMin = std::min<uint16_t>(colMin, p.col);
+  }
+  filler.push_back(SiPixelCluster(pixels.size(), &adc[0], &row[0], &col[0], rowMin, colMin));
+}
+
+void PixelCPEBatchTester::generate(const PixelGeomDetUnit & det, Clusters::FastFiller & filler)
+{
+  const int nRows = det.specificTopology().nrows();
+  const int nCols = det.specificTopology().ncolumns();
+
+  // single pixels and small clusters in the corners of the module
+  addCluster(filler, {{0, 0, 12000}});
+  addCluster(filler, {{nRows-1, nCols-1, 15000}});
+  addCluster(filler, {{0, nCols-2, 8000}, {0, nCols-1, 9000}, {1, nCols-1, 4000}});
+  addCluster(filler, {{nRows-2, 0, 7000}, {nRows-1, 0, 20000}, {nRows-1, 1, 5000}});
+
+  // over the big pixels between the first two ROCs in x and in y
+  if ( nRows > 81 ) addCluster(filler, {{78, 10, 9000}, {79, 10, 14000}, {80, 10, 13000}, {81, 10, 6000}});
+  if ( nCols > 53 ) addCluster(filler, {{20, 50, 6000}, {20, 51, 15000}, {20, 52, 16000}, {21, 53, 7000}});
+  if ( nRows > 80 && nCols > 52 ) addCluster(filler, {{79, 51, 20000}, {80, 52, 21000}});
+
+  // long clusters along the columns, with a saturated pixel in the middle
+  std::vector<Pixel> longCluster;
+  for ( int c = 0; c < std::min(nCols, 12); ++c ) longCluster.push_back({nRows/2, nCols/2-6+c, c == 5 ? 60000 : 9000+500*c});
+  addCluster(filler, longCluster);
+
+  // random clusters, including high pixel charges
+  std::uniform_int_distribution<int> sizeX(1, 4), sizeY(1, 8), adc(1500, 30000), hot(0, 9);
+  for ( unsigned int i = 0; i != nRandom_; ++i ) {
+    const int sx = std::min(sizeX(engine_), nRows), sy = std::min(sizeY(engine_), nCols);
+    const int row0 = std::uniform_int_distribution<int>(0, nRows-sx)(engine_);
+    const int col0 = std::uniform_int_distribution<int>(0, nCols-sy)(engine_);
+    std::vector<Pixel> pixels;
+    for ( int r = 0; r != sx; ++r )
+      for ( int c = 0; c != sy; ++c )
+        if ( (r == 0 && c == 0) || hot(engine_) < 8 ) pixels.push_back({row0+r, col0+c, hot(engine_) == 0 ? 50000 : adc(engine_)});
+    addCluster(filler, pixels);
+  }
+}
+
+void PixelCPEBatchTester::analyze(const edm::Event& event, const edm::EventSetup& setup)
+{
+  edm::ESHandle<TrackerGeometry> geom;
+  setup.get<TrackerDigiGeometryRecord>().get(geom);
+  edm::ESHandle<PixelClusterParameterEstimator> hCPE;
+  setup.get<TkPixelCPERecord>().get(cpeName_, hCPE);
+  const PixelCPEBase * cpe = dynamic_cast<const PixelCPEBase *>(&(*hCPE));
+  if ( cpe == nullptr ) throw cms::Exception("Configuration") << "The CPE " << cpeName_ << " is not a PixelCPEBase";
+
+  Clusters clusters;
+  if ( !src_.label().empty() ) {
+    edm::Handle<Clusters> input;
+    event.getByToken(srcToken_, input);
+    for ( const auto & detSet : *input ) {
+      Clusters::FastFiller filler(clusters, detSet.detId());
+      for ( const SiPixelCluster & cluster : detSet ) filler.push_back(cluster);
+    }
+  }
+  for ( const GeomDet * det : geom->detUnits() ) {
+    const PixelGeomDetUnit * pixelDet = dynamic_cast<const PixelGeomDetUnit *>(det);
+    if ( pixelDet == nullptr || clusters.exists(det->geographicalId().rawId()) ) continue;
+    Clusters::FastFiller filler(clusters, det->geographicalId().rawId());
+    generate(*pixelDet, filler);
+  }
+
+  SiPixelClustersSoA soa;
+  soa.fill(clusters);
+  cpe->fillParameters(soa);
+
+  std::ostringstream errors;
+  unsigned int nErrors = 0;
+  for ( unsigned int m = 0; m != soa.nModules(); ++m ) {
+    const PixelGeomDetUnit & det = *dynamic_cast<const PixelGeomDetUnit *>(geom->idToDetUnit(DetId(soa.detId[m])));
+    const PixelTopology & topology = det.specificTopology();
+    for ( unsigned int i = soa.begin(m); i != soa.end(m); ++i ) {
+      const SiPixelCluster & cluster = *soa.cluster[i];
+      ++nClusters_;
+      if ( topology.containsBigPixelInX(cluster.minPixelRow(), cluster.maxPixelRow()) ||
+           topology.containsBigPixelInY(cluster.minPixelCol(), cluster.maxPixelCol()) ) ++nBigPixelClusters_;
+      if ( topology.isItEdgePixelInX(cluster.minPixelRow()) || topology.isItEdgePixelInX(cluster.maxPixelRow()) ||
+           topology.isItEdgePixelInY(cluster.minPixelCol()) || topology.isItEdgePixelInY(cluster.maxPixelCol()) ) ++nEdgeClusters_;
+
+      auto reference = cpe->getParameters(cluster, det);
+      const LocalPoint & lp = std::get<0>(reference);
+      const LocalError & le = std::get<1>(reference);
+      const bool same =
+        std::abs(soa.xLocal[i] - lp.x()) <= tolerance_ &&
+        std::abs(soa.yLocal[i] - lp.y()) <= tolerance_ &&
+        std::abs(soa.xErr2[i] - le.xx()) <= tolerance_*le.xx() &&
+        std::abs(soa.yErr2[i] - le.yy()) <= tolerance_*le.yy() &&
+        soa.qualWord[i] == std::get<2>(reference);
+      if ( !same && nErrors++ < 20 ) {
+        errors << "module " << soa.detId[m] << " cluster rows " << cluster.minPixelRow() << "-" << cluster.maxPixelRow()
+               << " cols " << cluster.minPixelCol() << "-" << cluster.maxPixelCol() << " charge " << cluster.charge()
+               << ": batch (" << soa.xLocal[i] << ", " << soa.yLocal[i] << ") err2 (" << soa.xErr2[i] << ", " << soa.yErr2[i]
+               << ") qual " << soa.qualWord[i]
+               << ", getParameters (" << lp.x() << ", " << lp.y() << ") err2 (" << le.xx() << ", " << le.yy()
+               << ") qual " << std::get<2>(reference) << "\n";
+      }
+    }
+  }
+  if ( nErrors != 0 ) {
+    throw cms::Exception("PixelCPEBatchTester") << nErrors << " of " << soa.nClusters()
+                                                << " clusters differ between fillParameters() and getParameters():\n"
+                                                << errors.str();
+  }
+}
+
+void PixelCPEBatchTester::endJob()
+{
+  edm::LogSystem("PixelCPEBatchTester") << nClusters_ << " clusters compared, " << nBigPixelClusters_ << " with big pixels, "
+                                        << nEdgeClusters_ << " on the edges of the modules";
+  if ( nBigPixelClusters_ == 0 || nEdgeClusters_ == 0 ) {
+    throw cms::Exception("PixelCPEBatchTester") << "No cluster with big pixels or on the edges of the modules was tested";
+  }
+}
+
+DEFINE_FWK_MODULE(PixelCPEBatchTester);
@@ -0,0 +1,36 @@
+#
+# Compares the batched generic CPE (SiPixelRecHitConverter with batchCPE=True)
+# to the cluster by cluster one, on clusters generated on every pixel module.
+# To also compare on reconstructed clusters, use a PoolSource with clusters
+# and set process.cpeBatch.src = 'siPixelClusters'.
+#
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("PixelCPEBatchTest")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(3)
+)
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.source = cms.Source("EmptySource")
+
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+
+process.load("RecoLocalTracker.SiPixelRecHits.PixelCPEESProducers_cff")
+
+process.cpeBatch = cms.EDAnalyzer("PixelCPEBatchTester",
+    PixelCPE = cms.string('PixelCPEGeneric'),
+    src = cms.InputTag(''),
+    randomClustersPerModule = cms.uint32(20),
+    seed = cms.uint32(12345),
+    # in cm for the positions, relative for the errors
+    tolerance = cms.double(1e-5)
+)
+
+process.p = cms.Path(process.cpeBatch)
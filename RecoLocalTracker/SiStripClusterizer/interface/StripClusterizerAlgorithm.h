@@ -71,6 +71,11 @@ class StripClusterizerAlgorithm {
   virtual void stripByStripAdd(State & state, uint16_t strip, uint8_t adc, output_t::TSFastFiller & out)  const {}
   virtual void stripByStripEnd(State & state, output_t::TSFastFiller & out)  const {}
 
+  // block of n strips (e.g. one unpacked FED channel), in increasing strip order
+  virtual void addStrips(State & state, const uint16_t * strips, const uint8_t * adcs, unsigned int n, output_t::TSFastFiller & out) const {
+    for (unsigned int i=0; i!=n; ++i) stripByStripAdd(state, strips[i], adcs[i], out);
+  }
+
 
   struct InvalidChargeException : public cms::Exception { public: InvalidChargeException(const SiStripDigi&); };
 
@@ -42,6 +42,9 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
 
   void stripByStripEnd(State & state, output_t::TSFastFiller & out) const override { endCandidate(state,out);}
 
+  // same result as stripByStripAdd() strip by strip: the thresholds are applied to the whole block first
+  void addStrips(State & state, const uint16_t * strips, const uint8_t * adcs, unsigned int n, output_t::TSFastFiller & out) const override;
+
 
  private:
 
@@ -61,6 +64,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
     void clearCandidate(State & state) const { state.candidateLacksSeed = true;  state.noiseSquared = 0;  state.ADCs.clear();}
     void addToCandidate(State & state, const SiStripDigi& digi) const { addToCandidate(state, digi.strip(),digi.adc());}
     void addToCandidate(State & state, uint16_t strip, uint8_t adc) const;
+    void addAboveThreshold(State & state, uint16_t strip, uint8_t adc, float noise, bool lacksSeed) const;
     void appendBadNeighbors(State & state) const;
     void applyGains(State & state) const;
 
@@ -386,6 +386,56 @@ namespace {
     StripClusterizerAlgorithm::State& state_;
     StripClusterizerAlgorithm::output_t::TSFastFiller& record_;
   };
+
+  // the strips of one FED channel, unpacked into contiguous arrays
+  // and handed to the clusterizer in one go
+  class StripBlock {
+  public:
+    static constexpr unsigned int Size = 256;
+
+    class Inserter {
+    public:
+      typedef std::output_iterator_tag iterator_category;
+      typedef void value_type;
+      typedef void difference_type;
+      typedef void pointer;
+      typedef void reference;
+
+      explicit Inserter(StripBlock& block) : block_(block) {}
+      Inserter& operator= ( SiStripDigi digi ) { block_.push_back(digi); return *this; }
+      Inserter& operator*  ()    { return *this; }
+      Inserter& operator++ ()    { return *this; }
+      Inserter& operator++ (int) { return *this; }
+    private:
+      StripBlock& block_;
+    };
+
+    StripBlock(StripClusterizerAlgorithm& clusterizer,
+               StripClusterizerAlgorithm::State& state,
+               StripClusterizerAlgorithm::output_t::TSFastFiller& record)
+      : clusterizer_(clusterizer), state_(state), record_(record) {}
+
+    Inserter inserter() { return Inserter(*this); }
+
+    void push_back(SiStripDigi digi) {
+      strips_[n_] = digi.strip();
+      adcs_[n_] = digi.adc();  // same conversion as in stripByStripAdd
+      if (++n_ == Size) flush();
+    }
+
+    void flush() {
+      if (n_ != 0) clusterizer_.addStrips(state_, strips_, adcs_, n_, record_);
+      n_ = 0;
+    }
+
+  private:
+    StripClusterizerAlgorithm& clusterizer_;
+    StripClusterizerAlgorithm::State& state_;
+    StripClusterizerAlgorithm::output_t::TSFastFiller& record_;
+    uint16_t strips_[Size];
+    uint8_t adcs_[Size];
+    unsigned int n_ = 0;
+  };
 }
 
 void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::TSFastFiller & record) {
@@ -443,10 +493,12 @@ try { // edmNew::CapacityExaustedException
 
     if LIKELY( ( mode > sistrip::READOUT_MODE_VIRGIN_RAW ) && ( mode < sistrip::READOUT_MODE_SPY ) && ( mode != sistrip::READOUT_MODE_PROC_RAW ) ) {
       // ZS modes
+      StripBlock block(clusterizer, state, record);
       try {
         auto perStripAdder = StripByStripAdder(clusterizer, state, record);
         if LIKELY( ! hybridZeroSuppressed_ ) {
-          unpackZS(buffer->channel(fedCh), mode, ipair*256, perStripAdder);
+          unpackZS(buffer->channel(fedCh), mode, ipair*256, block.inserter());
+          block.flush();
         } else {
           const uint32_t id = conn->detId();
           edm::DetSet<SiStripDigi> unpDigis{id}; unpDigis.reserve(256);
@@ -460,6 +512,7 @@ try { // edmNew::CapacityExaustedException
       } catch (edmNew::CapacityExaustedException const&) {
         throw;
       } catch (const cms::Exception& e) {
+        block.flush(); // the strips unpacked before the error, as strip by strip
         if (edm::isDebugEnabled()) {
           edm::LogWarning(sistrip::mlRawToCluster_) << "Unordered clusters for channel " << fedCh << " on FED " << fedId << ": " << e.what();
         }
@@ -1,6 +1,7 @@
 #include "RecoLocalTracker/SiStripClusterizer/interface/ThreeThresholdAlgorithm.h"
 #include "DataFormats/SiStripDigi/interface/SiStripDigi.h"
 #include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -67,7 +68,13 @@ addToCandidate(State & state, uint16_t strip, uint8_t adc) const {
   if(  adc < static_cast<uint8_t>( Noise * ChannelThreshold) || state.det().bad(strip) )
     return;
 
-  if(state.candidateLacksSeed) state.candidateLacksSeed  =  adc < static_cast<uint8_t>( Noise * SeedThreshold);
+  addAboveThreshold(state, strip, adc, Noise, adc < static_cast<uint8_t>( Noise * SeedThreshold));
+}
+
+inline 
+void ThreeThresholdAlgorithm::
+addAboveThreshold(State & state, uint16_t strip, uint8_t adc, float Noise, bool lacksSeed) const { 
+  if(state.candidateLacksSeed) state.candidateLacksSeed = lacksSeed;
   if(state.ADCs.empty()) state.lastStrip = strip - 1; // begin candidate
   while( ++state.lastStrip < strip ) state.ADCs.push_back(0); // pad holes
 
@@ -143,3 +150,38 @@ void ThreeThresholdAlgorithm::
 stripByStripEnd(State & state, std::vector<SiStripCluster>& out) const { 
   endCandidate(state, out);
 }
+
+// A strip below the channel threshold (or bad) never enters a candidate. It can end
+// the current candidate, but the next strip above threshold would end it as well, with
+// the same result: such strips can be dropped before the sequential candidate building.
+void ThreeThresholdAlgorithm::
+addStrips(State & state, const uint16_t * strips, const uint8_t * adcs, unsigned int n, output_t::TSFastFiller & out) const {
+  constexpr unsigned int BlockSize = 256; // one FED channel
+  alignas(32) float noise[BlockSize];
+  alignas(32) uint8_t accepted[BlockSize];
+  alignas(32) uint8_t lacksSeed[BlockSize];
+
+  auto const & det = state.det();
+  bool noBadStrips = det.qualityRange.first == det.qualityRange.second;
+
+  for (unsigned int b=0; b<n; b+=BlockSize) {
+    unsigned int m = std::min(BlockSize, n-b);
+    const uint16_t * strip = strips+b;
+    const uint8_t * adc = adcs+b;
+
+    // gather the noise of the block, then apply the thresholds to all its strips at once
+    for (unsigned int i=0; i<m; ++i) noise[i] = det.noise(strip[i]);
+    for (unsigned int i=0; i<m; ++i) {
+      accepted[i] = adc[i] >= static_cast<uint8_t>( noise[i] * ChannelThreshold);
+      lacksSeed[i] = adc[i] < static_cast<uint8_t>( noise[i] * SeedThreshold);
+    }
+    if (!noBadStrips)
+      for (unsigned int i=0; i<m; ++i) accepted[i] &= !det.bad(strip[i]);
+
+    for (unsigned int i=0; i<m; ++i) {
+      if (!accepted[i]) continue;
+      if (candidateEnded(state, strip[i])) endCandidate(state, out);
+      addAboveThreshold(state, strip[i], adc[i], noise[i], lacksSeed[i]);
+    }
+  }
+}
@@ -50,6 +50,12 @@ runTheTest(const PSet& test) {
   try { 
     clusterizer->clusterize(digis, result); 
     assertIdentical(expected, result);
+    if(!digis.empty()) {
+      output_t blockResult;
+      blockResult.reserve(2*clusterset.size(),8*clusterset.size());
+      clusterizeAsBlock(digis, blockResult);
+      assertIdentical(expected, blockResult);
+    }
     if(test.getParameter<bool>("InvalidCharge")) throw cms::Exception("Failed") << "Charges are valid, contrary to expectation.\n";
   }
   catch(StripClusterizerAlgorithm::InvalidChargeException const&) {
@@ -60,6 +66,23 @@ runTheTest(const PSet& test) {
   }
 }
 
+// the path of the clusterizer from raw data: all the strips in one addStrips call
+void ClusterizerUnitTester::
+clusterizeAsBlock(const edmNew::DetSetVector<SiStripDigi>& digis, output_t& result) {
+  for(auto const & detSet : digis) {
+    auto const & det = clusterizer->stripByStripBegin(detSet.detId());
+    if(!det.valid()) continue;
+    StripClusterizerAlgorithm::State state(det);
+    std::vector<uint16_t> strips;
+    std::vector<uint8_t> adcs;
+    for(auto const & digi : detSet) { strips.push_back(digi.strip()); adcs.push_back(digi.adc()); }
+    output_t::TSFastFiller ff(result, detSet.detId());
+    clusterizer->addStrips(state, strips.data(), adcs.data(), strips.size(), ff);
+    clusterizer->stripByStripEnd(state, ff);
+    if(ff.empty()) ff.abort();
+  }
+}
+
 void ClusterizerUnitTester::
 constructDigis(const VPSet& stripset, edmNew::DetSetVector<SiStripDigi>& digis) {
   edmNew::DetSetVector<SiStripDigi>::TSFastFiller digisFF(digis, detId);
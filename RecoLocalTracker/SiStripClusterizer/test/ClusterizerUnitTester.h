@@ -32,6 +32,7 @@ class ClusterizerUnitTester : public edm::EDAnalyzer {
   
   void constructClusters(const VPSet&, output_t&);
   void constructDigis(const VPSet&, edmNew::DetSetVector<SiStripDigi>&);
+  void clusterizeAsBlock(const edmNew::DetSetVector<SiStripDigi>&, output_t&);
 
   static std::string printDigis(const VPSet&);
   static void assertIdentical(const output_t&, const output_t&);
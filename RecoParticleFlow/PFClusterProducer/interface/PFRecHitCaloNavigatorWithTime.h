@@ -4,6 +4,7 @@
 
 
 #include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitNavigatorBase.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitCaloNeighbourTable.h"
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloGeometry.h"
 
@@ -37,74 +38,11 @@ class PFRecHitCaloNavigatorWithTime : public PFRecHitNavigatorBase {
 
 
   void associateNeighbours(reco::PFRecHit& hit,std::unique_ptr<reco::PFRecHitCollection>& hits,edm::RefProd<reco::PFRecHitCollection>& refProd) override {
-      DetId detid( hit.detId() );
-      
-      CaloNavigator<D> navigator(detid, topology_.get());
-      
-      DetId N(0);
-      DetId E(0);
-      DetId S(0);
-      DetId W(0);
-      DetId NW(0);
-      DetId NE(0);
-      DetId SW(0);
-      DetId SE(0);
-
-
-      N=navigator.north();  
-      associateNeighbour(N,hit,hits,refProd,0,1);
-
-
-      if (N !=DetId(0)) {
-	NE=navigator.east();
+      const auto& neighbours = neighbourTable_.neighbours(DetId(hit.detId()));
+      const auto& offsets = PFRecHitCaloNeighbourTable<D,T>::offsets();
+      for( unsigned int i = 0; i < neighbours.size(); ++i ) {
+	associateNeighbour(neighbours[i],hit,hits,refProd,offsets[i].first,offsets[i].second);
       }
-      else 
-	{
-	  navigator.home();
-	  E=navigator.east();
-	  NE=navigator.north();
-	}
-      associateNeighbour(NE,hit,hits,refProd,1,1);
-      navigator.home();
-
-      S = navigator.south();
-      associateNeighbour(S,hit,hits,refProd,0,-1);
-      
-      if (S !=DetId(0)) {
-	SW = navigator.west();
-      } else {
-	navigator.home();
-	W=navigator.west();
-	SW=navigator.south();
-      }
-      associateNeighbour(SW,hit,hits,refProd,-1,-1);
-      navigator.home();
-
-      E = navigator.east();
-      associateNeighbour(E,hit,hits,refProd,1,0);
-      
-      if (E !=DetId(0)) {
-	SE = navigator.south();
-      } else {
-	navigator.home();
-	S=navigator.south();
-	SE=navigator.east();
-      }
-      associateNeighbour(SE,hit,hits,refProd,1,-1);
-      navigator.home();
-
-
-      W = navigator.west();
-      associateNeighbour(W,hit,hits,refProd,-1,0);
-
-      if (W !=DetId(0)) {
-	NW = navigator.north();
-      } else {
-	navigator.home();
-	N=navigator.north();
-	NW=navigator.west();
-      }
-      associateNeighbour(NW,hit,hits,refProd,-1,1);
   }
 
 
@@ -113,6 +51,8 @@ class PFRecHitCaloNavigatorWithTime : public PFRecHitNavigatorBase {
 
   double sigmaCut2_;
   std::unique_ptr<const T> topology_;
+  // to be reset by beginEvent when the topology changes
+  PFRecHitCaloNeighbourTable<D,T> neighbourTable_;
   std::unique_ptr<CaloRecHitResolutionProvider> _timeResolutionCalc;
 
 
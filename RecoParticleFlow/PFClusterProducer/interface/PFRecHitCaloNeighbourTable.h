@@ -0,0 +1,137 @@
+#ifndef RecoParticleFlow_PFClusterProducer_PFRecHitCaloNeighbourTable_h
+#define RecoParticleFlow_PFClusterProducer_PFRecHitCaloNeighbourTable_h
+
+#include "RecoCaloTools/Navigation/interface/CaloNavigator.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/ESDetId.h"
+#include "DataFormats/CaloTowers/interface/CaloTowerDetId.h"
+#include "Geometry/CaloTopology/interface/CaloTowerTopology.h"
+
+#include <array>
+#include <vector>
+
+// The eight neighbours of the cells of a calorimeter, found with CaloNavigator
+// on the topology and kept by dense index of the cell until the topology
+// changes, so that the navigation is done once per cell and IOV instead of
+// once per rechit and event.
+//
+// The neighbours are in the order in which the calo navigators associate
+// them, with the (eta,phi) offsets of offsets(); a missing neighbour is DetId(0).
+
+namespace pfrechitcalo {
+  // dense index of the cells: the one of the topology by default, the hashed
+  // index of the ECAL ids and the dense index of the calo towers
+  template<typename DET,typename TOPO> struct DenseIndex {
+    static unsigned int size(const TOPO& topo) { return topo.ncells(); }
+    static unsigned int index(const TOPO& topo, const DetId& id) { return topo.detId2denseId(id); }
+  };
+  template<typename DET,typename TOPO> struct HashedIndex {
+    static unsigned int size(const TOPO&) { return DET::kSizeForDenseIndexing; }
+    static unsigned int index(const TOPO&, const DetId& id) { return DET(id).hashedIndex(); }
+  };
+  template<typename TOPO> struct DenseIndex<EBDetId,TOPO> : public HashedIndex<EBDetId,TOPO> {};
+  template<typename TOPO> struct DenseIndex<EEDetId,TOPO> : public HashedIndex<EEDetId,TOPO> {};
+  template<typename TOPO> struct DenseIndex<ESDetId,TOPO> : public HashedIndex<ESDetId,TOPO> {};
+  template<> struct DenseIndex<CaloTowerDetId,CaloTowerTopology> {
+    static unsigned int size(const CaloTowerTopology& topo) { return topo.sizeForDenseIndexing(); }
+    static unsigned int index(const CaloTowerTopology& topo, const DetId& id) { return topo.denseIndex(id); }
+  };
+}
+
+template <typename DET,typename TOPO>
+class PFRecHitCaloNeighbourTable {
+ public:
+  typedef std::array<DetId,8> Neighbours;
+
+  // (eta,phi) offsets of the neighbours: N, NE, S, SW, E, SE, W, NW
+  static const std::array<std::pair<short,short>,8>& offsets() {
+    static const std::array<std::pair<short,short>,8> o = {{ {0,1}, {1,1}, {0,-1}, {-1,-1},
+							      {1,0}, {1,-1}, {-1,0}, {-1,1} }};
+    return o;
+  }
+
+  // forget the neighbours found with the previous topology
+  void reset(const TOPO* topology) {
+    topology_ = topology;
+    const unsigned int n = pfrechitcalo::DenseIndex<DET,TOPO>::size(*topology);
+    neighbours_.resize(n);
+    filled_.assign(n,false);
+  }
+
+  const Neighbours& neighbours(const DetId& id) {
+    const unsigned int i = pfrechitcalo::DenseIndex<DET,TOPO>::index(*topology_,id);
+    if( i >= filled_.size() ) {
+      // not a cell of the dense index: navigate each time
+      fill(id,outside_);
+      return outside_;
+    }
+    if( !filled_[i] ) {
+      fill(id,neighbours_[i]);
+      filled_[i] = true;
+    }
+    return neighbours_[i];
+  }
+
+ private:
+  void fill(const DetId& detid, Neighbours& result) const {
+    CaloNavigator<DET> navigator(detid, topology_);
+
+    DetId N(0);
+    DetId E(0);
+    DetId S(0);
+    DetId W(0);
+    DetId NW(0);
+    DetId NE(0);
+    DetId SW(0);
+    DetId SE(0);
+
+    N=navigator.north();
+    if (N !=DetId(0)) {
+      NE=navigator.east();
+    } else {
+      navigator.home();
+      E=navigator.east();
+      NE=navigator.north();
+    }
+    navigator.home();
+
+    S = navigator.south();
+    if (S !=DetId(0)) {
+      SW = navigator.west();
+    } else {
+      navigator.home();
+      W=navigator.west();
+      SW=navigator.south();
+    }
+    navigator.home();
+
+    E = navigator.east();
+    if (E !=DetId(0)) {
+      SE = navigator.south();
+    } else {
+      navigator.home();
+      S=navigator.south();
+      SE=navigator.east();
+    }
+    navigator.home();
+
+    W = navigator.west();
+    if (W !=DetId(0)) {
+      NW = navigator.north();
+    } else {
+      navigator.home();
+      N=navigator.north();
+      NW=navigator.west();
+    }
+
+    result = {{ N, NE, S, SW, E, SE, W, NW }};
+  }
+
+  const TOPO* topology_ = nullptr;
+  std::vector<Neighbours> neighbours_;
+  std::vector<bool> filled_;
+  Neighbours outside_;
+};
+
+#endif
@@ -104,7 +104,8 @@ buildClusters(const reco::PFClusterCollection& input,
     seedPFClustersFromTopo(topocluster,seedable,clustersInTopo);
     const unsigned tolScal = 
       std::pow(std::max(1.0,clustersInTopo.size()-1.0),2.0);
-    growPFClusters(topocluster,seedable,tolScal,0,tolScal,clustersInTopo);
+    fillTopoRecHits(topocluster,seedable,_topoHits);
+    growPFClusters(topocluster,_topoHits,tolScal,0,tolScal,clustersInTopo);
     // step added by Josh Bendavid, removes low-fraction clusters
     // did not impact position resolution with fraction cut of 1e-7
     // decreases the size of each pf cluster considerably
@@ -145,9 +146,53 @@ seedPFClustersFromTopo(const reco::PFCluster& topo,
   }
 }
 
+double Basic2DGenericPFlowClusterizer::
+recHitEnergyNorm(const reco::PFRecHit& hit) const {
+  int cell_layer = (int)hit.layer();
+  if( cell_layer == PFLayer::HCAL_BARREL2 && 
+      std::abs(hit.positionREP().eta()) > 0.34 ) {
+    cell_layer *= 100;
+  }  
+
+  double recHitEnergyNorm=0.;
+  auto const& recHitEnergyNormDepthPair = _recHitEnergyNorms.find(cell_layer)->second;
+
+  for (unsigned int j=0; j<recHitEnergyNormDepthPair.second.size(); ++j) {
+    int depth=recHitEnergyNormDepthPair.first[j];
+
+    if( ( cell_layer == PFLayer::HCAL_BARREL1 && hit.depth()== depth)
+	|| ( cell_layer == PFLayer::HCAL_ENDCAP && hit.depth()== depth)
+	|| ( cell_layer != PFLayer::HCAL_ENDCAP && cell_layer != PFLayer::HCAL_BARREL1)
+	) recHitEnergyNorm = recHitEnergyNormDepthPair.second[j];
+  }
+  return recHitEnergyNorm;
+}
+
+void Basic2DGenericPFlowClusterizer::
+fillTopoRecHits(const reco::PFCluster& topo,
+		const std::vector<bool>& seedable,
+		TopoRecHits& hits) const {
+  const auto& recHitFractions = topo.recHitFractions();
+  const unsigned n = recHitFractions.size();
+  hits.x.resize(n); hits.y.resize(n); hits.z.resize(n);
+  hits.energyNorm.resize(n);
+  hits.detId.resize(n);
+  hits.excluded.resize(n);
+  for( unsigned k = 0; k < n; ++k ) {
+    const reco::PFRecHitRef& refhit = recHitFractions[k].recHitRef();
+    const math::XYZPoint topocellpos_xyz(refhit->position());
+    hits.x[k] = topocellpos_xyz.x();
+    hits.y[k] = topocellpos_xyz.y();
+    hits.z[k] = topocellpos_xyz.z();
+    hits.energyNorm[k] = recHitEnergyNorm(*refhit);
+    hits.detId[k] = refhit->detId();
+    hits.excluded[k] = seedable[refhit.key()] && _excludeOtherSeeds;
+  }
+}
+
 void Basic2DGenericPFlowClusterizer::
 growPFClusters(const reco::PFCluster& topo,
-	       const std::vector<bool>& seedable,
+	       const TopoRecHits& hits,
 	       const unsigned toleranceScaling,
 	       const unsigned iter,
 	       double diff,
@@ -173,59 +218,57 @@ growPFClusters(const reco::PFCluster& topo,
     }
     cluster.resetHitsAndFractions();
   }
+  // the cluster positions, energies and seeds of this iteration as plain arrays,
+  // so that the distances and fractions to a rechit are computed in vectorizable loops
+  const unsigned nClusters = clusters.size();
+  std::vector<double> clus_x(nClusters), clus_y(nClusters), clus_z(nClusters);
+  std::vector<double> clus_energy(nClusters);
+  std::vector<uint32_t> clus_seed(nClusters);
+  for( unsigned i = 0; i < nClusters; ++i ) {
+    const math::XYZPoint& clusterpos_xyz = clusters[i].position();
+    clus_x[i] = clusterpos_xyz.x();
+    clus_y[i] = clusterpos_xyz.y();
+    clus_z[i] = clusterpos_xyz.z();
+    clus_energy[i] = clusters[i].energy();
+    clus_seed[i] = clusters[i].seed().rawId();
+  }
   // loop over topo cluster and grow current PFCluster hypothesis 
-  std::vector<double> dist2, frac;
+  std::vector<double> dist2(nClusters), frac(nClusters);
   double fractot = 0;
-  for( const reco::PFRecHitFraction& rhf : topo.recHitFractions() ) {
-    const reco::PFRecHitRef& refhit = rhf.recHitRef();
-    int cell_layer = (int)refhit->layer();
-    if( cell_layer == PFLayer::HCAL_BARREL2 && 
-	std::abs(refhit->positionREP().eta()) > 0.34 ) {
-      cell_layer *= 100;
-    }  
-
-    math::XYZPoint topocellpos_xyz(refhit->position());
-    dist2.clear(); frac.clear(); fractot = 0;
-
-    double recHitEnergyNorm=0.;
-    auto const& recHitEnergyNormDepthPair = _recHitEnergyNorms.find(cell_layer)->second;
-
-    for (unsigned int j=0; j<recHitEnergyNormDepthPair.second.size(); ++j) {
-      int depth=recHitEnergyNormDepthPair.first[j];
-
-      if( ( cell_layer == PFLayer::HCAL_BARREL1 && refhit->depth()== depth)
-	  || ( cell_layer == PFLayer::HCAL_ENDCAP && refhit->depth()== depth)
-	  || ( cell_layer != PFLayer::HCAL_ENDCAP && cell_layer != PFLayer::HCAL_BARREL1)
-	  ) recHitEnergyNorm = recHitEnergyNormDepthPair.second[j];
+  const auto& recHitFractions = topo.recHitFractions();
+  for( unsigned k = 0; k < recHitFractions.size(); ++k ) {
+    const reco::PFRecHitRef& refhit = recHitFractions[k].recHitRef();
+    const double hx = hits.x[k], hy = hits.y[k], hz = hits.z[k];
+    for( unsigned i = 0; i < nClusters; ++i ) {
+      const double dx = clus_x[i] - hx, dy = clus_y[i] - hy, dz = clus_z[i] - hz;
+      dist2[i] = (dx*dx + dy*dy + dz*dz)/_showerSigma2;
     }
-
-    // add rechits to clusters, calculating fraction based on distance
-    for( auto& cluster : clusters ) {      
-      const math::XYZPoint& clusterpos_xyz = cluster.position();
-      const math::XYZVector deltav = clusterpos_xyz - topocellpos_xyz;
-      const double d2 = deltav.Mag2()/_showerSigma2;
-      dist2.emplace_back( d2 );
-      if( d2 > 100 ) {
+    for( unsigned i = 0; i < nClusters; ++i ) {
+      if( dist2[i] > 100 ) {
 	LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
 	  << "Warning! :: pfcluster-topocell distance is too large! d= "
-	  << d2;
+	  << dist2[i];
       }
+    }
 
-      // fraction assignment logic
-      double fraction;
-      if( refhit->detId() == cluster.seed() && _excludeOtherSeeds ) {
-	fraction = 1.0;	
-      } else if ( seedable[refhit.key()] && _excludeOtherSeeds ) {
-	fraction = 0.0;
-      } else {
-	fraction = cluster.energy()/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
-      }      
-      fractot += fraction;
-      frac.emplace_back(fraction);
+    // fraction assignment logic: a seedable rechit only belongs to its own
+    // cluster when the other seeds are excluded, seeds being seedable
+    if( hits.excluded[k] ) {
+      for( unsigned i = 0; i < nClusters; ++i ) {
+	frac[i] = hits.detId[k] == clus_seed[i] ? 1.0 : 0.0;
+      }
+    } else {
+      const double recHitEnergyNorm = hits.energyNorm[k];
+      for( unsigned i = 0; i < nClusters; ++i ) {
+	frac[i] = clus_energy[i]/recHitEnergyNorm * vdt::fast_expf( -0.5*dist2[i] );
+      }
     }
-    for( unsigned i = 0; i < clusters.size(); ++i ) {      
+    fractot = 0;
+    for( unsigned i = 0; i < nClusters; ++i ) fractot += frac[i];
+
+    for( unsigned i = 0; i < nClusters; ++i ) {      
       if( fractot > _minFracTot || 
-	  ( refhit->detId() == clusters[i].seed() && fractot > 0.0 ) ) {
+	  ( hits.detId[k] == clus_seed[i] && fractot > 0.0 ) ) {
 	frac[i]/=fractot;
       } else {
 	continue;
@@ -264,7 +307,7 @@ growPFClusters(const reco::PFCluster& topo,
   }
   diff = std::sqrt(diff2);
   dist2.clear(); frac.clear(); clus_prev_pos.clear();// avoid badness
-  growPFClusters(topo,seedable,toleranceScaling,iter+1,diff,clusters);
+  growPFClusters(topo,hits,toleranceScaling,iter+1,diff,clusters);
 }
 
 void Basic2DGenericPFlowClusterizer::
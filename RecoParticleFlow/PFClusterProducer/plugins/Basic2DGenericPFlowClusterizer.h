@@ -36,13 +36,28 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
   std::unordered_map<int,std::pair<std::vector<int>,std::vector<double> > > _recHitEnergyNorms;
   std::unique_ptr<PFCPositionCalculatorBase> _allCellsPosCalc;
   std::unique_ptr<PFCPositionCalculatorBase> _convergencePosCalc;
+
+  // the rechits of a topo cluster as plain arrays, filled once per topo cluster
+  // and read at each iteration of the position fit
+  struct TopoRecHits {
+    std::vector<double> x, y, z;
+    std::vector<double> energyNorm;
+    std::vector<uint32_t> detId;
+    std::vector<bool> excluded; // seedable with _excludeOtherSeeds
+  };
+  TopoRecHits _topoHits;
+
+  double recHitEnergyNorm(const reco::PFRecHit&) const;
+  void fillTopoRecHits(const reco::PFCluster&,
+		       const std::vector<bool>&,
+		       TopoRecHits&) const;
   
   void seedPFClustersFromTopo(const reco::PFCluster&,
 			      const std::vector<bool>&,
 			      reco::PFClusterCollection&) const;
 
   void growPFClusters(const reco::PFCluster&,
-		      const std::vector<bool>&,
+		      const TopoRecHits&,
 		      const unsigned toleranceScaling,
 		      const unsigned iter,
 		      double dist,
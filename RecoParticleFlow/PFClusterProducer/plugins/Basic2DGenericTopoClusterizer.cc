@@ -20,6 +20,7 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
 	      reco::PFClusterCollection& output) {
   auto const & hits = *input;  
   std::vector<bool> used(hits.size(),false);
+  _aboveThresholds.assign(hits.size(),0);
   std::vector<unsigned int> seeds;
   
   // get the seeds and sort them descending in energy
@@ -41,13 +42,8 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
   }
 }
 
-void Basic2DGenericTopoClusterizer::
-buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
-		 const std::vector<bool>& rechitMask,
-		 unsigned int kcell,
-		 std::vector<bool>& used,		 
-		 reco::PFCluster& topocluster) {
-  auto const & cell = (*input)[kcell];
+bool Basic2DGenericTopoClusterizer::
+isAboveThresholds(const reco::PFRecHit& cell) {
   int cell_layer = (int)cell.layer();
   if( cell_layer == PFLayer::HCAL_BARREL2 && 
       std::abs(cell.positionREP().eta()) > 0.34 ) {
@@ -73,19 +69,48 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
     LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       << "RecHit " << cell.detId() << " with enegy "
       << cell.energy() << " GeV was rejected!." << std::endl;
-    return;
+    return false;
   }
+  return true;
+}
 
+// depth-first walk through the neighbours, adding the cells in the same order
+// as a recursion on the neighbours would, with an explicit stack of the cells
+// being visited
+void Basic2DGenericTopoClusterizer::
+buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
+		 const std::vector<bool>& rechitMask,
+		 unsigned int kcell,
+		 std::vector<bool>& used,		 
+		 reco::PFCluster& topocluster) {
+  auto const & hits = *input;
+  auto visit = [&](unsigned int k) {
+    if( _aboveThresholds[k] == 0 ) {
+      _aboveThresholds[k] = isAboveThresholds(hits[k]) ? 1 : -1;
+    }
+    if( _aboveThresholds[k] < 0 ) return;
 
-  auto k = kcell;
-  used[k] = true;
-  auto ref = makeRefhit(input,k);
-  topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
-  
-  auto const & neighbours = 
-    ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
-  
-  for( auto nb : neighbours ) {
+    used[k] = true;
+    auto ref = makeRefhit(input,k);
+    topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
+    auto const & neighbours = 
+      ( _useCornerCells ? hits[k].neighbours8() : hits[k].neighbours4() );
+    _visiting.emplace_back(k,neighbours.begin());
+  };
+
+  _visiting.clear();
+  visit(kcell);
+  while( !_visiting.empty() ) {
+    const unsigned int k = _visiting.back().first;
+    auto const & cell = hits[k];
+    auto const & neighbours = 
+      ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
+    auto& next = _visiting.back().second;
+    if( next == neighbours.end() ) {
+      _visiting.pop_back();
+      continue;
+    }
+    const unsigned int nb = *next++;
     if( used[nb] || !rechitMask[nb] ) {
       LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       	<< "  RecHit " << cell.detId() << "\'s" 
@@ -96,6 +121,6 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
 	<< !rechitMask[nb] << " (masked)." << std::endl;
       continue;
     }
-    buildTopoCluster(input,rechitMask,nb,used,topocluster);
+    visit(nb);
   }
 }
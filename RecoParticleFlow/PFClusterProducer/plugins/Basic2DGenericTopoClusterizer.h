@@ -22,6 +22,12 @@ class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   
  private:  
   const bool _useCornerCells;
+  // by rechit of the event: 0 not checked yet, 1 above and -1 below the thresholds
+  std::vector<signed char> _aboveThresholds;
+  // the cells being visited by buildTopoCluster, with the next neighbour to try
+  std::vector<std::pair<unsigned int,reco::PFRecHit::Neighbours::Pointer> > _visiting;
+
+  bool isAboveThresholds(const reco::PFRecHit&);
   void buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>&,
 			const std::vector<bool>&, // masked rechits
 			unsigned int, //present rechit
@@ -1,4 +1,5 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
 
 #include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitFakeNavigator.h"
 
@@ -18,10 +19,15 @@ class PFRecHitEcalBarrelNavigatorWithTime : public PFRecHitCaloNavigatorWithTime
     }
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !geometryWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalBarrelTopology(geoHandle) );
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geometryWatcher_;
 };
 
 class PFRecHitEcalEndcapNavigatorWithTime : public PFRecHitCaloNavigatorWithTime<EEDetId,EcalEndcapTopology> {
@@ -33,10 +39,15 @@ class PFRecHitEcalEndcapNavigatorWithTime : public PFRecHitCaloNavigatorWithTime
     }
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !geometryWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalEndcapTopology(geoHandle) );
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geometryWatcher_;
 };
 
 class PFRecHitEcalBarrelNavigator final : public PFRecHitCaloNavigator<EBDetId,EcalBarrelTopology> {
@@ -46,10 +57,15 @@ class PFRecHitEcalBarrelNavigator final : public PFRecHitCaloNavigator<EBDetId,E
   }
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !geometryWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalBarrelTopology(geoHandle) );
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geometryWatcher_;
 };
 
 class PFRecHitEcalEndcapNavigator final : public PFRecHitCaloNavigator<EEDetId,EcalEndcapTopology> {
@@ -59,10 +75,15 @@ class PFRecHitEcalEndcapNavigator final : public PFRecHitCaloNavigator<EEDetId,E
   }
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !geometryWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalEndcapTopology(geoHandle) );
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geometryWatcher_;
 };
 
 class PFRecHitPreshowerNavigator final : public PFRecHitCaloNavigator<ESDetId,EcalPreshowerTopology> {
@@ -73,10 +94,15 @@ class PFRecHitPreshowerNavigator final : public PFRecHitCaloNavigator<ESDetId,Ec
 
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !geometryWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalPreshowerTopology(geoHandle) );
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geometryWatcher_;
 };
 
 
@@ -88,11 +114,16 @@ class PFRecHitHCALNavigator final : public PFRecHitCaloNavigator<HcalDetId,HcalT
 
 
   void beginEvent(const edm::EventSetup& iSetup) override {    
+      if( !topologyWatcher_.check(iSetup) ) return;
       edm::ESHandle<HcalTopology> hcalTopology;
       iSetup.get<HcalRecNumberingRecord>().get( hcalTopology );
       topology_.release();
       topology_.reset(hcalTopology.product());
+      neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<HcalRecNumberingRecord> topologyWatcher_;
 };
 class PFRecHitHCALNavigatorWithTime : public PFRecHitCaloNavigatorWithTime<HcalDetId,HcalTopology,false> {
  public:
@@ -104,11 +135,16 @@ class PFRecHitHCALNavigatorWithTime : public PFRecHitCaloNavigatorWithTime<HcalD
 
 
   void beginEvent(const edm::EventSetup& iSetup) override {    
+      if( !topologyWatcher_.check(iSetup) ) return;
       edm::ESHandle<HcalTopology> hcalTopology;
       iSetup.get<HcalRecNumberingRecord>().get( hcalTopology );
       topology_.release();
       topology_.reset(hcalTopology.product());
+      neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<HcalRecNumberingRecord> topologyWatcher_;
 };
 
 
@@ -120,11 +156,16 @@ class PFRecHitCaloTowerNavigator : public PFRecHitCaloNavigator<CaloTowerDetId,C
 
 
   void beginEvent(const edm::EventSetup& iSetup) override {
+    if( !topologyWatcher_.check(iSetup) ) return;
     edm::ESHandle<CaloTowerTopology> caloTowerTopology;
     iSetup.get<HcalRecNumberingRecord>().get(caloTowerTopology);
     topology_.release();
     topology_.reset(caloTowerTopology.product());
+    neighbourTable_.reset(topology_.get());
   }
+
+ private:
+  edm::ESWatcher<HcalRecNumberingRecord> topologyWatcher_;
 };
 
 typedef PFRecHitDualNavigator<PFLayer::ECAL_BARREL,
@@ -0,0 +1,84 @@
+// Requires two PFCluster collections of the same rechits to be identical: the
+// same clusters in the same order, with the same seed, layer, energies,
+// position and time, and the same rechits with the same fractions. Meant to
+// compare the clusters of a reconstruction that must not change them, e.g. of
+// the release before and after a change of the navigation or of the fit.
+
+#include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
+#include "DataFormats/ParticleFlowReco/interface/PFClusterFwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+class PFClusterExactComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit PFClusterExactComparator(const edm::ParameterSet& iConfig) :
+    referenceToken_(consumes<reco::PFClusterCollection>(iConfig.getParameter<edm::InputTag>("PFClusters"))),
+    testToken_(consumes<reco::PFClusterCollection>(iConfig.getParameter<edm::InputTag>("PFClustersCompare")))
+  {}
+
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  const edm::EDGetTokenT<reco::PFClusterCollection> referenceToken_;
+  const edm::EDGetTokenT<reco::PFClusterCollection> testToken_;
+
+  unsigned long nClusters_ = 0;
+};
+
+void PFClusterExactComparator::analyze(const edm::Event& iEvent, const edm::EventSetup&) {
+  edm::Handle<reco::PFClusterCollection> hReference, hTest;
+  iEvent.getByToken(referenceToken_, hReference);
+  iEvent.getByToken(testToken_, hTest);
+  const auto& reference = *hReference;
+  const auto& test = *hTest;
+
+  if( test.size() != reference.size() ) {
+    throw cms::Exception("PFClusterExactComparator") << "event " << iEvent.id() << ": " << test.size()
+						     << " clusters instead of " << reference.size();
+  }
+  for( unsigned int i = 0; i < reference.size(); ++i ) {
+    const auto& ref = reference[i];
+    const auto& cluster = test[i];
+    const auto& refFractions = ref.recHitFractions();
+    const auto& fractions = cluster.recHitFractions();
+    bool same = cluster.seed() == ref.seed() && cluster.layer() == ref.layer() &&
+      cluster.energy() == ref.energy() && cluster.correctedEnergy() == ref.correctedEnergy() &&
+      cluster.position() == ref.position() && cluster.time() == ref.time() &&
+      fractions.size() == refFractions.size();
+    for( unsigned int h = 0; same && h < fractions.size(); ++h ) {
+      same = fractions[h].recHitRef()->detId() == refFractions[h].recHitRef()->detId() &&
+	fractions[h].fraction() == refFractions[h].fraction();
+    }
+    if( !same ) {
+      throw cms::Exception("PFClusterExactComparator") << "event " << iEvent.id() << ", cluster " << i << ":\n"
+						       << cluster << "\ninstead of\n" << ref;
+    }
+  }
+  nClusters_ += reference.size();
+}
+
+void PFClusterExactComparator::endJob() {
+  edm::LogSystem("PFClusterExactComparator") << nClusters_ << " identical clusters";
+  if( nClusters_ == 0 ) {
+    throw cms::Exception("PFClusterExactComparator") << "The comparison needs clusters";
+  }
+}
+
+void PFClusterExactComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("PFClusters", edm::InputTag(""));
+  desc.add<edm::InputTag>("PFClustersCompare", edm::InputTag(""));
+  descriptions.add("pfClusterExactComparator", desc);
+}
+
+DEFINE_FWK_MODULE(PFClusterExactComparator);
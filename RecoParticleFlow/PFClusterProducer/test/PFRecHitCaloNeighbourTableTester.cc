@@ -0,0 +1,177 @@
+// Checks the neighbours kept by PFRecHitCaloNeighbourTable against the ones
+// found by walking the topology with CaloNavigator for each cell, as the calo
+// navigators did for each rechit, for all the valid cells of the barrel, endcap
+// and preshower of ECAL and of HB, HE, HO and HF, so including the cells at the
+// edges and along the cracks (EB+/EB-, EB/EE, HB/HE, HE/HF).
+//
+// The tables are filled in one order, reset and filled again in the reverse
+// order: the neighbours of a cell must not depend on the cells seen before.
+
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+#include "Geometry/Records/interface/HcalRecNumberingRecord.h"
+#include "Geometry/CaloTopology/interface/EcalBarrelTopology.h"
+#include "Geometry/CaloTopology/interface/EcalEndcapTopology.h"
+#include "Geometry/CaloTopology/interface/EcalPreshowerTopology.h"
+#include "Geometry/CaloTopology/interface/HcalTopology.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitCaloNeighbourTable.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // the navigation of the calo navigators before the neighbour table, in the same order
+  template<typename DET,typename TOPO>
+  std::array<DetId,8> navigate(const DetId& detid, const TOPO& topology) {
+    CaloNavigator<DET> navigator(detid, &topology);
+
+    DetId N(0);
+    DetId E(0);
+    DetId S(0);
+    DetId W(0);
+    DetId NW(0);
+    DetId NE(0);
+    DetId SW(0);
+    DetId SE(0);
+
+    std::array<DetId,8> result;
+    N=navigator.north();
+    result[0] = N;
+    if (N !=DetId(0)) {
+      NE=navigator.east();
+    } else {
+      navigator.home();
+      E=navigator.east();
+      NE=navigator.north();
+    }
+    result[1] = NE;
+    navigator.home();
+
+    S = navigator.south();
+    result[2] = S;
+    if (S !=DetId(0)) {
+      SW = navigator.west();
+    } else {
+      navigator.home();
+      W=navigator.west();
+      SW=navigator.south();
+    }
+    result[3] = SW;
+    navigator.home();
+
+    E = navigator.east();
+    result[4] = E;
+    if (E !=DetId(0)) {
+      SE = navigator.south();
+    } else {
+      navigator.home();
+      S=navigator.south();
+      SE=navigator.east();
+    }
+    result[5] = SE;
+    navigator.home();
+
+    W = navigator.west();
+    result[6] = W;
+    if (W !=DetId(0)) {
+      NW = navigator.north();
+    } else {
+      navigator.home();
+      N=navigator.north();
+      NW=navigator.west();
+    }
+    result[7] = NW;
+    return result;
+  }
+}
+
+class PFRecHitCaloNeighbourTableTester : public edm::one::EDAnalyzer<> {
+public:
+  explicit PFRecHitCaloNeighbourTableTester(const edm::ParameterSet&) {}
+
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  template<typename DET,typename TOPO>
+  void compare(const std::string& name, const TOPO& topology, const std::vector<DetId>& ids);
+};
+
+template<typename DET,typename TOPO>
+void PFRecHitCaloNeighbourTableTester::compare(const std::string& name, const TOPO& topology, const std::vector<DetId>& ids) {
+  if( ids.empty() ) {
+    throw cms::Exception("PFRecHitCaloNeighbourTableTester") << "no valid cell in " << name;
+  }
+  PFRecHitCaloNeighbourTable<DET,TOPO> table;
+  unsigned int nAtEdge = 0;
+  for( unsigned int pass = 0; pass < 2; ++pass ) {
+    table.reset(&topology);
+    for( unsigned int i = 0; i < ids.size(); ++i ) {
+      const DetId& id = pass == 0 ? ids[i] : ids[ids.size()-1-i];
+      const auto expected = navigate<DET,TOPO>(id,topology);
+      // twice, to find the cell in the table the second time
+      for( unsigned int lookup = 0; lookup < 2; ++lookup ) {
+	const auto& neighbours = table.neighbours(id);
+	for( unsigned int n = 0; n < expected.size(); ++n ) {
+	  if( neighbours[n] != expected[n] ) {
+	    throw cms::Exception("PFRecHitCaloNeighbourTableTester")
+	      << name << " cell " << id.rawId() << ": neighbour " << n << " is " << neighbours[n].rawId()
+	      << " instead of " << expected[n].rawId();
+	  }
+	}
+      }
+      if( pass == 0 && std::find(expected.begin(),expected.end(),DetId(0)) != expected.end() ) ++nAtEdge;
+    }
+  }
+  // cells with a missing neighbour are the edges and cracks of the calorimeter
+  if( nAtEdge == 0 ) {
+    throw cms::Exception("PFRecHitCaloNeighbourTableTester") << "no cell at an edge in " << name;
+  }
+  edm::LogSystem("PFRecHitCaloNeighbourTableTester") << name << ": " << ids.size() << " cells, "
+						     << nAtEdge << " with a missing neighbour";
+}
+
+void PFRecHitCaloNeighbourTableTester::analyze(const edm::Event&, const edm::EventSetup& iSetup) {
+  edm::ESHandle<CaloGeometry> geoHandle;
+  iSetup.get<CaloGeometryRecord>().get(geoHandle);
+  edm::ESHandle<HcalTopology> hcalTopology;
+  iSetup.get<HcalRecNumberingRecord>().get(hcalTopology);
+
+  const EcalBarrelTopology barrel(geoHandle);
+  const EcalEndcapTopology endcap(geoHandle);
+  const EcalPreshowerTopology preshower(geoHandle);
+  compare<EBDetId>("EB", barrel, geoHandle->getValidDetIds(DetId::Ecal,EcalBarrel));
+  compare<EEDetId>("EE", endcap, geoHandle->getValidDetIds(DetId::Ecal,EcalEndcap));
+  compare<ESDetId>("ES", preshower, geoHandle->getValidDetIds(DetId::Ecal,EcalPreshower));
+
+  compare<HcalDetId>("HB", *hcalTopology, geoHandle->getValidDetIds(DetId::Hcal,HcalBarrel));
+  compare<HcalDetId>("HE", *hcalTopology, geoHandle->getValidDetIds(DetId::Hcal,HcalEndcap));
+  compare<HcalDetId>("HO", *hcalTopology, geoHandle->getValidDetIds(DetId::Hcal,HcalOuter));
+  compare<HcalDetId>("HF", *hcalTopology, geoHandle->getValidDetIds(DetId::Hcal,HcalForward));
+}
+
+void PFRecHitCaloNeighbourTableTester::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  descriptions.add("pfRecHitCaloNeighbourTableTester", desc);
+}
+
+DEFINE_FWK_MODULE(PFRecHitCaloNeighbourTableTester);
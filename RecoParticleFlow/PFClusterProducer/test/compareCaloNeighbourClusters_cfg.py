@@ -0,0 +1,76 @@
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+# Compares the PF rechits clustering of two releases, e.g. before and after the
+# neighbour table of the calo navigators and the flattened cluster fit, which
+# must give identical clusters:
+#   (reference release) cmsRun compareCaloNeighbourClusters_cfg.py step=reference
+#   (release to test)   cmsRun compareCaloNeighbourClusters_cfg.py step=compare
+# The reference step reruns the PF rechits and clusters on a RECO file and keeps
+# them in pfClustersReference.root; the compare step reruns them on this file and
+# requires the same clusters, in the same order, in each collection.
+
+options = VarParsing('analysis')
+options.register('step', 'compare', VarParsing.multiplicity.singleton, VarParsing.varType.string,
+                 'reference or compare')
+options.maxEvents = 50
+options.parseArguments()
+
+referenceFile = 'pfClustersReference.root'
+
+process = cms.Process("REFERENCE" if options.step == 'reference' else "COMPARE")
+
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 10
+
+if options.step == 'reference':
+    inputFiles = options.inputFiles if options.inputFiles else [
+        '/store/relval/CMSSW_10_0_0_pre2/RelValTTbar_13/GEN-SIM-RECO/100X_mc2017_realistic_v1-v1/20000/1CD8D6F0-AFDC-E711-B2BC-0CC47A78A478.root']
+else:
+    inputFiles = ['file:' + referenceFile]
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring(inputFiles))
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+process.load("RecoParticleFlow.PFClusterProducer.particleFlowCluster_cff")
+process.clustering = cms.Path(process.pfClusteringPS +
+                              process.pfClusteringECAL +
+                              process.pfClusteringHBHEHF +
+                              process.pfClusteringHO)
+
+clusters = ['particleFlowClusterPS',
+            'particleFlowClusterECALUncorrected',
+            'particleFlowClusterECAL',
+            'particleFlowClusterHBHE',
+            'particleFlowClusterHF',
+            'particleFlowClusterHCAL',
+            'particleFlowClusterHO']
+
+if options.step == 'reference':
+    process.out = cms.OutputModule("PoolOutputModule",
+        fileName = cms.untracked.string(referenceFile),
+        outputCommands = cms.untracked.vstring('drop *',
+                                               'keep *_ecalRecHit_*_*',
+                                               'keep *_ecalPreshowerRecHit_*_*',
+                                               'keep *_hbhereco_*_*',
+                                               'keep *_hfreco_*_*',
+                                               'keep *_horeco_*_*',
+                                               'keep recoPFRecHits_*_*_REFERENCE',
+                                               'keep recoPFClusters_*_*_REFERENCE')
+    )
+    process.outpath = cms.EndPath(process.out)
+else:
+    process.comparisons = cms.Sequence()
+    for label in clusters:
+        comparator = cms.EDAnalyzer("PFClusterExactComparator",
+            PFClusters = cms.InputTag(label, '', 'REFERENCE'),
+            PFClustersCompare = cms.InputTag(label, '', 'COMPARE')
+        )
+        setattr(process, label + 'Comparator', comparator)
+        process.comparisons += comparator
+    process.compare = cms.Path(process.comparisons)
+    process.schedule = cms.Schedule(process.clustering, process.compare)
@@ -0,0 +1,5 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testPFRecHitCaloNeighbourTable_cfg.py || die 'Failure using testPFRecHitCaloNeighbourTable_cfg.py' $?
@@ -0,0 +1,18 @@
+import FWCore.ParameterSet.Config as cms
+
+# compares the neighbours of PFRecHitCaloNeighbourTable with CaloNavigator for
+# all the ECAL and HCAL cells of the ideal 2017 geometry
+
+process = cms.Process("NEIGHBOURS")
+
+process.load("Configuration.Geometry.GeometryExtended2017Reco_cff")
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.neighbourTableTester = cms.EDAnalyzer("PFRecHitCaloNeighbourTableTester")
+
+process.p = cms.Path(process.neighbourTableTester)
@@ -64,6 +64,9 @@ class PFAlgo {
   void setPFMuonAlgo(PFMuonAlgo* algo) {pfmu_ =algo;}
   void setMuonHandle(const edm::Handle<reco::MuonCollection>&);
   void setDebug( bool debug ) {debug_ = debug; connector_.setDebug(debug_); if (pfegamma_) pfegamma_->setDebug(debug); }
+  /// process the blocks concurrently; the candidates are the same as with the serial
+  /// processing, which is used anyway with the legacy electron and photon algorithms
+  void setParallelBlocks( bool parallel ) {parallelBlocks_ = parallel;}
 
   void setParameters(double nSigmaECAL,
                      double nSigmaHCAL, 
@@ -243,16 +246,19 @@ class PFAlgo {
   
  protected:
 
-  /// process one block. can be reimplemented in more sophisticated 
-  /// algorithms
+  /// process one block, adding its candidates to pfCandidates. can be 
+  /// reimplemented in more sophisticated algorithms. Blocks may be processed
+  /// concurrently (see setParallelBlocks), each into its own collection
   virtual void processBlock( const reco::PFBlockRef& blockref,
                              std::list<reco::PFBlockRef>& hcalBlockRefs, 
-                             std::list<reco::PFBlockRef>& ecalBlockRefs ); 
+                             std::list<reco::PFBlockRef>& ecalBlockRefs,
+                             reco::PFCandidateCollection& pfCandidates ); 
   
   /// Reconstruct a charged particle from a track
-  /// Returns the index of the newly created candidate in pfCandidates_
+  /// Returns the index of the newly created candidate in pfCandidates
   /// Michalis added a flag here to treat muons inside jets
-  unsigned reconstructTrack( const reco::PFBlockElement& elt,bool allowLoose= false);
+  unsigned reconstructTrack( reco::PFCandidateCollection& pfCandidates,
+                             const reco::PFBlockElement& elt,bool allowLoose= false);
 
   /// Reconstruct a neutral particle from a cluster. 
   /// If chargedEnergy is specified, the neutral 
@@ -260,7 +266,8 @@ class PFAlgo {
   /// larger than the chargedEnergy. In this case, the energy of the 
   /// neutral particle is cluster energy - chargedEnergy
 
-  unsigned reconstructCluster( const reco::PFCluster& cluster,
+  unsigned reconstructCluster( reco::PFCandidateCollection& pfCandidates,
+                               const reco::PFCluster& cluster,
                                double particleEnergy,
 			       bool useDirection = false,
 			       double particleX=0.,
@@ -339,6 +346,7 @@ class PFAlgo {
   bool               useHO_;
   int                algo_;
   bool               debug_;
+  bool               parallelBlocks_;
 
   /// Variables for PFElectrons
   std::string mvaWeightFileEleID_;
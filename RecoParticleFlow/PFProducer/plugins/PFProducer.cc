@@ -405,6 +405,11 @@ PFProducer::PFProducer(const edm::ParameterSet& iConfig) {
 
   pfAlgo_->setDebug( debug_ );
 
+  // Process the PF blocks concurrently
+  if( iConfig.existsAs<bool>("parallelBlocks") ) {
+    pfAlgo_->setParallelBlocks( iConfig.getParameter<bool>("parallelBlocks") );
+  }
+
 }
 
 
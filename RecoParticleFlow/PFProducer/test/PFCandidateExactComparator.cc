@@ -0,0 +1,95 @@
+// Requires two PFCandidate collections made from the same blocks to be
+// identical: the same candidates in the same order, with the same type,
+// charge, momentum, vertex, calorimeter energies, references and elements in
+// blocks. Meant to compare two configurations of PFProducer that must not
+// change the candidates, e.g. with and without the concurrent processing of the
+// blocks.
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+namespace {
+  bool sameElements(const reco::PFCandidate::ElementsInBlocks& a, const reco::PFCandidate::ElementsInBlocks& b) {
+    if( a.size() != b.size() ) return false;
+    for( unsigned int i = 0; i < a.size(); ++i ) {
+      if( a[i].first != b[i].first || a[i].second != b[i].second ) return false;
+    }
+    return true;
+  }
+}
+
+class PFCandidateExactComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit PFCandidateExactComparator(const edm::ParameterSet& iConfig) :
+    referenceToken_(consumes<reco::PFCandidateCollection>(iConfig.getParameter<edm::InputTag>("reference"))),
+    testToken_(consumes<reco::PFCandidateCollection>(iConfig.getParameter<edm::InputTag>("test"))),
+    requireCandidates_(iConfig.getParameter<bool>("requireCandidates"))
+  {}
+
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  const edm::EDGetTokenT<reco::PFCandidateCollection> referenceToken_;
+  const edm::EDGetTokenT<reco::PFCandidateCollection> testToken_;
+  const bool requireCandidates_;
+
+  unsigned long nCandidates_ = 0;
+};
+
+void PFCandidateExactComparator::analyze(const edm::Event& iEvent, const edm::EventSetup&) {
+  edm::Handle<reco::PFCandidateCollection> hReference, hTest;
+  iEvent.getByToken(referenceToken_, hReference);
+  iEvent.getByToken(testToken_, hTest);
+  const auto& reference = *hReference;
+  const auto& test = *hTest;
+
+  if( test.size() != reference.size() ) {
+    throw cms::Exception("PFCandidateExactComparator") << "event " << iEvent.id() << ": " << test.size()
+						       << " candidates instead of " << reference.size();
+  }
+  for( unsigned int i = 0; i < reference.size(); ++i ) {
+    const auto& ref = reference[i];
+    const auto& cand = test[i];
+    const bool same = cand.particleId() == ref.particleId() && cand.charge() == ref.charge() &&
+      cand.p4() == ref.p4() && cand.vertex() == ref.vertex() &&
+      cand.rawEcalEnergy() == ref.rawEcalEnergy() && cand.ecalEnergy() == ref.ecalEnergy() &&
+      cand.rawHcalEnergy() == ref.rawHcalEnergy() && cand.hcalEnergy() == ref.hcalEnergy() &&
+      cand.hoEnergy() == ref.hoEnergy() && cand.mva_e_pi() == ref.mva_e_pi() &&
+      cand.trackRef() == ref.trackRef() && cand.muonRef() == ref.muonRef() &&
+      sameElements(cand.elementsInBlocks(), ref.elementsInBlocks());
+    if( !same ) {
+      throw cms::Exception("PFCandidateExactComparator") << "event " << iEvent.id() << ", candidate " << i << ":\n"
+							 << cand << "\ninstead of\n" << ref;
+    }
+  }
+  nCandidates_ += reference.size();
+}
+
+void PFCandidateExactComparator::endJob() {
+  edm::LogSystem("PFCandidateExactComparator") << nCandidates_ << " identical candidates";
+  if( requireCandidates_ && nCandidates_ == 0 ) {
+    throw cms::Exception("PFCandidateExactComparator") << "The comparison needs candidates";
+  }
+}
+
+void PFCandidateExactComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("reference", edm::InputTag(""));
+  desc.add<edm::InputTag>("test", edm::InputTag(""));
+  desc.add<bool>("requireCandidates", true)->setComment("fail if no candidate was compared");
+  descriptions.add("pfCandidateExactComparator", desc);
+}
+
+DEFINE_FWK_MODULE(PFCandidateExactComparator);
@@ -0,0 +1,66 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Runs the reconstruction, then PFProducer again with the blocks processed
+# concurrently (parallelBlocks) and requires the same candidates, in the same
+# order, as the serial particleFlowTmp in each output collection, for
+# runPFProducerParallelBlocksTest.sh. One stream, so that the threads only
+# process the blocks of an event concurrently.
+
+options = VarParsing.VarParsing()
+options.register('nThreads',
+                 4, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of threads.")
+options.parseArguments()
+
+from Configuration.StandardSequences.Eras import eras
+process = cms.Process('PFTEST', eras.Run2_2017)
+
+process.load('Configuration.StandardSequences.Services_cff')
+process.load('FWCore.MessageService.MessageLogger_cfi')
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_cff')
+process.load('Configuration.StandardSequences.RawToDigi_cff')
+process.load('Configuration.StandardSequences.Reconstruction_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.nThreads),
+    numberOfStreams = cms.untracked.uint32(1)
+)
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:pfProducerParallelBlocksInput.root')
+)
+
+process.particleFlowTmp.parallelBlocks = False
+process.particleFlowTmpParallel = process.particleFlowTmp.clone(
+    parallelBlocks = True
+)
+
+process.comparisons = cms.Sequence()
+for instance in ['',
+                 'CleanedHF',
+                 'CleanedCosmicsMuons',
+                 'CleanedTrackerAndGlobalMuons',
+                 'CleanedFakeMuons',
+                 'CleanedPunchThroughMuons',
+                 'CleanedPunchThroughNeutralHadrons',
+                 'AddedMuonsAndHadrons']:
+    comparator = cms.EDAnalyzer("PFCandidateExactComparator",
+        reference = cms.InputTag('particleFlowTmp', instance),
+        test = cms.InputTag('particleFlowTmpParallel', instance),
+        # the cleaned collections are often empty
+        requireCandidates = cms.bool(instance == '')
+    )
+    setattr(process, 'compare' + (instance if instance else 'Candidates'), comparator)
+    process.comparisons += comparator
+
+process.p = cms.Path(process.RawToDigi *
+                     process.reconstruction *
+                     process.particleFlowTmpParallel *
+                     process.comparisons)
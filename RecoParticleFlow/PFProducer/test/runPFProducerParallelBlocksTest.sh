@@ -0,0 +1,10 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsDriver.py TTbar_13TeV_TuneCUETP8M1_cfi --conditions auto:phase1_2017_realistic --era Run2_2017 -n 5 -s GEN,SIM,DIGI:pdigi_valid,L1,DIGI2RAW --eventcontent FEVTDEBUG --datatier GEN-SIM-DIGI-RAW --beamspot NominalCollision2015 --fileout pfProducerParallelBlocksInput.root || die 'Failure running cmsDriver' $?
+
+# the concurrent processing of the blocks must give the candidates of the serial one
+cmsRun ${LOCAL_TEST_DIR}/pfProducerParallelBlocks_cfg.py nThreads=1 || die 'Failure using pfProducerParallelBlocks_cfg.py with 1 thread' $?
+cmsRun ${LOCAL_TEST_DIR}/pfProducerParallelBlocks_cfg.py nThreads=4 || die 'Failure using pfProducerParallelBlocks_cfg.py with 4 threads' $?
+cmsRun ${LOCAL_TEST_DIR}/pfProducerParallelBlocks_cfg.py nThreads=8 || die 'Failure using pfProducerParallelBlocks_cfg.py with 8 threads' $?
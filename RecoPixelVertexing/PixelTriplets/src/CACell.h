@@ -3,6 +3,8 @@
 
 #include <array>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include "DataFormats/Math/interface/deltaPhi.h"
 #include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
@@ -41,6 +43,11 @@ public:
   using CAStatusColl = std::vector<CACellStatus>;
   
   
+  // (inner cell, outer cell) pair of aligned cells
+  using CAConnection = std::pair<unsigned int, unsigned int>;
+  
+  CACell() : theDoublets(nullptr), theDoubletId(0), theInnerR(0), theInnerZ(0) {}
+  
   CACell(const HitDoublets* doublets, int doubletId, const int innerHitId, const int outerHitId) :
     theDoublets(doublets), theDoubletId(doubletId)
     ,theInnerR(doublets->rv(doubletId, HitDoublets::inner)) 
@@ -98,14 +105,16 @@ public:
     return theDoublets->phi(theDoubletId, HitDoublets::outer);
   }
   
-  void evolve(unsigned int me, CAStatusColl& allStatus) {
+  // the outer neighbors of the cell are [outerNeighbors, outerNeighborsEnd)
+  void evolve(unsigned int me, CAStatusColl& allStatus,
+	      const unsigned int* outerNeighbors, const unsigned int* outerNeighborsEnd) const {
     
     allStatus[me].hasSameStateNeighbors = 0;
     auto mystate = allStatus[me].theCAState;
     
-    for (auto oc : theOuterNeighbors ) {
+    for (auto oc = outerNeighbors; oc != outerNeighborsEnd; ++oc) {
       
-      if (allStatus[oc].getCAState() == mystate) {
+      if (allStatus[*oc].getCAState() == mystate) {
 	
 	allStatus[me].hasSameStateNeighbors = 1;
 	
@@ -116,10 +125,11 @@ public:
   }
   
 
-  void checkAlignmentAndAct(CAColl& allCells, CAntuple & innerCells, const float ptmin, const float region_origin_x,
-			    const float region_origin_y, const float region_origin_radius, const float thetaCut,
-			    const float phiCut, const float hardPtCut, std::vector<CACell::CAntuplet> * foundTriplets) {
-    int ncells = innerCells.size();
+  // calls act(innerCell, thisCell) for each of the innerCells aligned with this cell, in order
+  template<typename Act>
+  void checkAlignmentAndAct(const CAColl& allCells, const unsigned int* innerCells, int ncells, const float ptmin,
+			    const float region_origin_x, const float region_origin_y, const float region_origin_radius,
+			    const float thetaCut, const float phiCut, const float hardPtCut, Act && act) const {
     int constexpr VSIZE = 16;
     int ok[VSIZE];
     float r1[VSIZE];
@@ -141,10 +151,7 @@ public:
 	auto & oc =  allCells[koc]; 
 	if (ok[j]&&haveSimilarCurvature(oc,ptmin, region_origin_x, region_origin_y,
 					region_origin_radius, phiCut, hardPtCut)) {
-	  if (foundTriplets) foundTriplets->emplace_back(CACell::CAntuplet{koc,cellId});
-	  else {
-	    oc.tagAsOuterNeighbor(cellId);
-	  }
+	  act(koc, cellId);
 	}
       }
     };
@@ -154,19 +161,23 @@ public:
     
   }
   
-  void checkAlignmentAndTag(CAColl& allCells, CAntuple & innerCells, const float ptmin, const float region_origin_x,
+  // only reads the cells, so that all the cells can be checked at the same time
+  void checkAlignmentAndTag(const CAColl& allCells, const unsigned int* innerCells, int ncells,
+			    std::vector<CAConnection>& connections, const float ptmin, const float region_origin_x,
 			    const float region_origin_y, const float region_origin_radius, const float thetaCut,
-			    const float phiCut, const float hardPtCut) {
-    checkAlignmentAndAct(allCells, innerCells, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut,
-			 phiCut, hardPtCut, nullptr);
+			    const float phiCut, const float hardPtCut) const {
+    checkAlignmentAndAct(allCells, innerCells, ncells, ptmin, region_origin_x, region_origin_y, region_origin_radius,
+			 thetaCut, phiCut, hardPtCut,
+			 [&](unsigned int inner, unsigned int outer) { connections.emplace_back(inner, outer); });
     
   }
-  void checkAlignmentAndPushTriplet(CAColl& allCells, CAntuple & innerCells, std::vector<CACell::CAntuplet>& foundTriplets,
+  void checkAlignmentAndPushTriplet(const CAColl& allCells, const CAntuple & innerCells, std::vector<CACell::CAntuplet>& foundTriplets,
 				    const float ptmin, const float region_origin_x, const float region_origin_y,
 				    const float region_origin_radius, const float thetaCut, const float phiCut,
-				    const float hardPtCut) {
-    checkAlignmentAndAct(allCells, innerCells, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut,
-			 phiCut, hardPtCut, &foundTriplets);
+				    const float hardPtCut) const {
+    checkAlignmentAndAct(allCells, innerCells.data(), innerCells.size(), ptmin, region_origin_x, region_origin_y,
+			 region_origin_radius, thetaCut, phiCut, hardPtCut,
+			 [&](unsigned int inner, unsigned int outer) { foundTriplets.emplace_back(CACell::CAntuplet{inner,outer}); });
   }
   
   
@@ -182,12 +193,6 @@ public:
   }
   
   
-  void tagAsOuterNeighbor(unsigned int otherCell)
-  {
-    theOuterNeighbors.push_back(otherCell);
-  }
-  
-  
   bool haveSimilarCurvature(const CACell & otherCell, const float ptmin,
 			    const float region_origin_x, const float region_origin_y, const float region_origin_radius, const float phiCut, const float hardPtCut) const
   {
@@ -257,42 +262,14 @@ public:
   }
   
   
-  // trying to free the track building process from hardcoded layers, leaving the visit of the graph
-  // based on the neighborhood connections between cells.
-  
-  void findNtuplets(CAColl& allCells, std::vector<CAntuplet>& foundNtuplets, CAntuplet& tmpNtuplet, const unsigned int minHitsPerNtuplet) const {
-    
-    // the building process for a track ends if:
-    // it has no outer neighbor
-    // it has no compatible neighbor
-    // the ntuplets is then saved if the number of hits it contains is greater than a threshold
-    
-    if (tmpNtuplet.size() == minHitsPerNtuplet - 1)
-      {
-	foundNtuplets.push_back(tmpNtuplet);
-      }
-    else
-      {
-	unsigned int numberOfOuterNeighbors = theOuterNeighbors.size();
-	for (unsigned int i = 0; i < numberOfOuterNeighbors; ++i) {
-	  tmpNtuplet.push_back((theOuterNeighbors[i]));
-	  allCells[theOuterNeighbors[i]].findNtuplets(allCells,foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
-	  tmpNtuplet.pop_back();
-	}
-      }
-    
-  }
-  
-  
 private:
   
-  CAntuple theOuterNeighbors;
-  
+  // the outer neighbors are stored by the CellularAutomaton, in a flat array
   const HitDoublets* theDoublets;  
-  const int theDoubletId;
+  int theDoubletId;
   
-  const float theInnerR;
-  const float theInnerZ;
+  float theInnerR;
+  float theInnerZ;
   
 };
 
@@ -1,30 +1,37 @@
+#include <algorithm>
+#include <iterator>
 #include <queue>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "CellularAutomaton.h"
 
-void CellularAutomaton::createAndConnectCells(
-    const std::vector<const HitDoublets *> & hitDoublets,
-    const TrackingRegion & region,
-    const float thetaCut,
-    const float phiCut,
-    const float hardPtCut)
-{
-  int tsize = 0;
-  for (auto hd : hitDoublets) {
-    tsize += hd->size();
-  }
-  allCells.reserve(tsize);
-  unsigned int cellId = 0;
-  float ptmin = region.ptMin();
-  float region_origin_x = region.origin().x();
-  float region_origin_y = region.origin().y();
-  float region_origin_radius = region.originRBound();
+namespace {
+  // the cells are created, connected and evolved in chunks of consecutive cells of a layer pair;
+  // the chunks do not depend on the number of threads, so neither does the result
+  constexpr unsigned int cellChunkSize = 256;
+  // the ntuplets are searched in chunks of root cells, merged in order
+  constexpr unsigned int rootCellChunkSize = 64;
 
-  std::vector<bool> alreadyVisitedLayerPairs;
-  alreadyVisitedLayerPairs.resize(theLayerGraph.theLayerPairs.size());
-  for (auto visited : alreadyVisitedLayerPairs) {
-    visited = false;
-  }
+  struct CellChunk {
+    int layerPair;
+    unsigned int begin;
+    unsigned int end;
+  };
+
+  // flat list of the cells having their outer hit on each hit of a layer:
+  // the cells on hit h are cells[start[h]..start[h+1])
+  struct CellsOnOuterHit {
+    std::vector<unsigned int> start;
+    std::vector<unsigned int> cells;
+  };
+}
+
+std::vector<int> CellularAutomaton::visitLayerPairs() const
+{
+  std::vector<int> visitOrder;
+  std::vector<bool> alreadyVisitedLayerPairs(theLayerGraph.theLayerPairs.size(), false);
   for (int rootVertex : theLayerGraph.theRootLayers) {
     std::queue<int> LayerPairsToVisit;
 
@@ -32,8 +39,6 @@ void CellularAutomaton::createAndConnectCells(
       LayerPairsToVisit.push(LayerPair);
     }
 
-    unsigned int numberOfLayerPairsToVisitAtThisDepth = LayerPairsToVisit.size();
-
     while (not LayerPairsToVisit.empty()) {
       auto currentLayerPair = LayerPairsToVisit.front();
       auto & currentLayerPairRef  = theLayerGraph.theLayerPairs[currentLayerPair];
@@ -46,25 +51,7 @@ void CellularAutomaton::createAndConnectCells(
       }
 
       if (alreadyVisitedLayerPairs[currentLayerPair] == false and allInnerLayerPairsAlreadyVisited) {
-        const HitDoublets *doubletLayerPairId = hitDoublets[currentLayerPair];
-        auto numberOfDoublets = doubletLayerPairId->size();
-        currentLayerPairRef.theFoundCells[0] = cellId;
-        currentLayerPairRef.theFoundCells[1] = cellId + numberOfDoublets;
-        for (unsigned int i = 0; i < numberOfDoublets; ++i) {
-          allCells.emplace_back(doubletLayerPairId, i,
-                                doubletLayerPairId->innerHitId(i),
-                                doubletLayerPairId->outerHitId(i));
-
-          currentOuterLayerRef.isOuterHitOfCell[doubletLayerPairId->outerHitId(i)].push_back(cellId);
-
-          cellId++;
-
-          auto & neigCells = currentInnerLayerRef.isOuterHitOfCell[doubletLayerPairId->innerHitId(i)];
-          allCells.back().checkAlignmentAndTag(
-              allCells, neigCells, ptmin, region_origin_x, region_origin_y,
-              region_origin_radius, thetaCut, phiCut, hardPtCut);
-        }
-        assert(cellId == currentLayerPairRef.theFoundCells[1]);
+        visitOrder.push_back(currentLayerPair);
         for (auto outerLayerPair : currentOuterLayerRef.theOuterLayerPairs) {
           LayerPairsToVisit.push(outerLayerPair);
         }
@@ -72,32 +59,132 @@ void CellularAutomaton::createAndConnectCells(
         alreadyVisitedLayerPairs[currentLayerPair] = true;
       }
       LayerPairsToVisit.pop();
-      numberOfLayerPairsToVisitAtThisDepth--;
-      if (numberOfLayerPairsToVisitAtThisDepth == 0) {
-        numberOfLayerPairsToVisitAtThisDepth = LayerPairsToVisit.size();
-      }
     }
   }
+  return visitOrder;
+}
+
+// The cells are numbered in the order of the visit of the layer pairs, as in a serial
+// creation, so that the inner cells of every cell are known as soon as all the cells exist:
+// the cells are then created, and checked against their inner cells, all at the same time.
+// The connections are stored in a flat array of outer neighbors, sorted by inner cell and then
+// by outer cell, the same order in which a serial creation would have tagged them.
+void CellularAutomaton::createAndConnectCells(
+    const std::vector<const HitDoublets *> & hitDoublets,
+    const TrackingRegion & region,
+    const float thetaCut,
+    const float phiCut,
+    const float hardPtCut)
+{
+  float ptmin = region.ptMin();
+  float region_origin_x = region.origin().x();
+  float region_origin_y = region.origin().y();
+  float region_origin_radius = region.originRBound();
+
+  auto const visitOrder = visitLayerPairs();
+
+  unsigned int cellId = 0;
+  std::vector<CellChunk> chunks;
+  for (int layerPair : visitOrder) {
+    auto & foundCells = theLayerGraph.theLayerPairs[layerPair].theFoundCells;
+    foundCells[0] = cellId;
+    cellId += hitDoublets[layerPair]->size();
+    foundCells[1] = cellId;
+    for (auto begin = foundCells[0]; begin < foundCells[1]; begin += cellChunkSize) {
+      chunks.push_back(CellChunk{layerPair, begin, std::min(begin + cellChunkSize, foundCells[1])});
+    }
+  }
+  const unsigned int numberOfCells = cellId;
+  const unsigned int numberOfChunks = chunks.size();
+
+  allCells.resize(numberOfCells);
+  tbb::parallel_for(0U, numberOfChunks, 1U, [&](unsigned int ic) {
+    auto const & chunk = chunks[ic];
+    const HitDoublets *doublets = hitDoublets[chunk.layerPair];
+    auto firstCell = theLayerGraph.theLayerPairs[chunk.layerPair].theFoundCells[0];
+    for (auto i = chunk.begin; i < chunk.end; ++i) {
+      auto id = i - firstCell;
+      allCells[i] = CACell(doublets, id, doublets->innerHitId(id), doublets->outerHitId(id));
+    }
+  });
+
+  // the cells ending on each hit, in increasing cell order
+  const unsigned int numberOfLayers = theLayerGraph.theLayers.size();
+  std::vector<CellsOnOuterHit> cellsOnOuterHit(numberOfLayers);
+  tbb::parallel_for(0U, numberOfLayers, 1U, [&](unsigned int il) {
+    auto & start = cellsOnOuterHit[il].start;
+    auto & cells = cellsOnOuterHit[il].cells;
+    const unsigned int numberOfHits = theLayerGraph.theLayers[il].isOuterHitOfCell.size();
+    start.assign(numberOfHits + 1, 0);
+    for (int layerPair : visitOrder) {
+      if (theLayerGraph.theLayerPairs[layerPair].theLayers[1] != int(il)) continue;
+      auto doublets = hitDoublets[layerPair];
+      for (unsigned int i = 0; i < doublets->size(); ++i) ++start[doublets->outerHitId(i) + 1];
+    }
+    for (unsigned int h = 0; h < numberOfHits; ++h) start[h + 1] += start[h];
+    cells.resize(start[numberOfHits]);
+    std::vector<unsigned int> next(start.begin(), start.end() - 1);
+    for (int layerPair : visitOrder) {
+      auto const & layerPairRef = theLayerGraph.theLayerPairs[layerPair];
+      if (layerPairRef.theLayers[1] != int(il)) continue;
+      auto doublets = hitDoublets[layerPair];
+      for (unsigned int i = 0; i < doublets->size(); ++i) cells[next[doublets->outerHitId(i)]++] = layerPairRef.theFoundCells[0] + i;
+    }
+  });
+
+  std::vector<std::vector<CACell::CAConnection>> connections(numberOfChunks);
+  tbb::parallel_for(0U, numberOfChunks, 1U, [&](unsigned int ic) {
+    auto const & chunk = chunks[ic];
+    auto const & layerPairRef = theLayerGraph.theLayerPairs[chunk.layerPair];
+    const HitDoublets *doublets = hitDoublets[chunk.layerPair];
+    auto const & innerLayer = cellsOnOuterHit[layerPairRef.theLayers[0]];
+    for (auto i = chunk.begin; i < chunk.end; ++i) {
+      auto hit = doublets->innerHitId(i - layerPairRef.theFoundCells[0]);
+      auto first = innerLayer.start[hit];
+      allCells[i].checkAlignmentAndTag(
+          allCells, innerLayer.cells.data() + first, innerLayer.start[hit + 1] - first, connections[ic],
+          ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut, phiCut, hardPtCut);
+    }
+  });
+
+  // the connections come by increasing outer cell: sort them by inner cell, keeping this order
+  theOuterNeighborsStart.assign(numberOfCells + 1, 0);
+  for (auto const & chunkConnections : connections) {
+    for (auto const & connection : chunkConnections) ++theOuterNeighborsStart[connection.first + 1];
+  }
+  for (unsigned int i = 0; i < numberOfCells; ++i) theOuterNeighborsStart[i + 1] += theOuterNeighborsStart[i];
+  theOuterNeighbors.resize(theOuterNeighborsStart[numberOfCells]);
+  std::vector<unsigned int> next(theOuterNeighborsStart.begin(), theOuterNeighborsStart.end() - 1);
+  for (auto const & chunkConnections : connections) {
+    for (auto const & connection : chunkConnections) theOuterNeighbors[next[connection.first]++] = connection.second;
+  }
 }
 
 void CellularAutomaton::evolve(const unsigned int minHitsPerNtuplet)
 {
-  allStatus.resize(allCells.size());
+  const unsigned int numberOfCells = allCells.size();
+  allStatus.resize(numberOfCells);
 
+  auto const * neighbors = theOuterNeighbors.data();
+  auto const & start = theOuterNeighborsStart;
   unsigned int numberOfIterations = minHitsPerNtuplet - 2;
   // keeping the last iteration for later
+  // a cell only writes its own status, and reads the state of its neighbors, which is
+  // updated only once all the cells have evolved: the cells can evolve at the same time
   for (unsigned int iteration = 0; iteration < numberOfIterations - 1; ++iteration) {
-    for (auto & layerPair : theLayerGraph.theLayerPairs) {
-      for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i) {
-        allCells[i].evolve(i, allStatus);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, numberOfCells, cellChunkSize),
+                      [&](const tbb::blocked_range<unsigned int> & range) {
+      for (auto i = range.begin(); i < range.end(); ++i) {
+        allCells[i].evolve(i, allStatus, neighbors + start[i], neighbors + start[i + 1]);
       }
-    }
+    });
 
-    for (auto & layerPair : theLayerGraph.theLayerPairs) {
-      for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i) {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, numberOfCells, cellChunkSize),
+                      [&](const tbb::blocked_range<unsigned int> & range) {
+      for (auto i = range.begin(); i < range.end(); ++i) {
         allStatus[i].updateState();
       }
-    }
+    });
   }
 
   // last iteration
@@ -107,7 +194,7 @@ void CellularAutomaton::evolve(const unsigned int minHitsPerNtuplet)
       auto foundCells = theLayerGraph.theLayerPairs[rootLayerPair].theFoundCells;
       for (auto i = foundCells[0]; i < foundCells[1]; ++i) {
         auto & cell = allStatus[i];
-        allCells[i].evolve(i, allStatus);
+        allCells[i].evolve(i, allStatus, neighbors + start[i], neighbors + start[i + 1]);
         cell.updateState();
         if (cell.isRootCell(minHitsPerNtuplet - 2)) {
           theRootCells.push_back(i);
@@ -119,14 +206,44 @@ void CellularAutomaton::evolve(const unsigned int minHitsPerNtuplet)
 
 void CellularAutomaton::findNtuplets(std::vector<CACell::CAntuplet> & foundNtuplets, const unsigned int minHitsPerNtuplet)
 {
-  CACell::CAntuple tmpNtuplet;
-  tmpNtuplet.reserve(minHitsPerNtuplet);
-
-  for (auto root_cell : theRootCells)
-  {
-    tmpNtuplet.clear();
-    tmpNtuplet.push_back(root_cell);
-    allCells[root_cell].findNtuplets(allCells, foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+  const unsigned int numberOfRootCells = theRootCells.size();
+  const unsigned int numberOfChunks = (numberOfRootCells + rootCellChunkSize - 1) / rootCellChunkSize;
+  std::vector<std::vector<CACell::CAntuplet>> chunkNtuplets(numberOfChunks);
+  tbb::parallel_for(0U, numberOfChunks, 1U, [&](unsigned int ic) {
+    CACell::CAntuple tmpNtuplet;
+    tmpNtuplet.reserve(minHitsPerNtuplet);
+    for (auto ir = ic * rootCellChunkSize, er = std::min(ir + rootCellChunkSize, numberOfRootCells); ir < er; ++ir) {
+      auto root_cell = theRootCells[ir];
+      tmpNtuplet.clear();
+      tmpNtuplet.push_back(root_cell);
+      findNtuplets(root_cell, chunkNtuplets[ic], tmpNtuplet, minHitsPerNtuplet);
+    }
+  });
+
+  for (auto & ntuplets : chunkNtuplets) {
+    std::move(ntuplets.begin(), ntuplets.end(), std::back_inserter(foundNtuplets));
+  }
+}
+
+// trying to free the track building process from hardcoded layers, leaving the visit of the graph
+// based on the neighborhood connections between cells.
+void CellularAutomaton::findNtuplets(unsigned int cell, std::vector<CACell::CAntuplet> & foundNtuplets,
+                                     CACell::CAntuplet & tmpNtuplet, const unsigned int minHitsPerNtuplet) const
+{
+  // the building process for a track ends if:
+  // it has no outer neighbor
+  // it has no compatible neighbor
+  // the ntuplets is then saved if the number of hits it contains is greater than a threshold
+
+  if (tmpNtuplet.size() == minHitsPerNtuplet - 1) {
+    foundNtuplets.push_back(tmpNtuplet);
+  }
+  else {
+    for (auto i = theOuterNeighborsStart[cell]; i < theOuterNeighborsStart[cell + 1]; ++i) {
+      tmpNtuplet.push_back(theOuterNeighbors[i]);
+      findNtuplets(theOuterNeighbors[i], foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+      tmpNtuplet.pop_back();
+    }
   }
 }
 
@@ -149,62 +266,29 @@ void CellularAutomaton::findTriplets(
   float region_origin_y = region.origin().y();
   float region_origin_radius = region.originRBound();
 
-  std::vector<bool> alreadyVisitedLayerPairs;
-  alreadyVisitedLayerPairs.resize(theLayerGraph.theLayerPairs.size());
-  for (auto visited : alreadyVisitedLayerPairs) {
-    visited = false;
-  }
-  for (int rootVertex : theLayerGraph.theRootLayers) {
-    std::queue<int> LayerPairsToVisit;
+  for (int currentLayerPair : visitLayerPairs()) {
+    auto & currentLayerPairRef  = theLayerGraph.theLayerPairs[currentLayerPair];
+    auto & currentInnerLayerRef = theLayerGraph.theLayers[currentLayerPairRef.theLayers[0]];
+    auto & currentOuterLayerRef = theLayerGraph.theLayers[currentLayerPairRef.theLayers[1]];
 
-    for (int LayerPair : theLayerGraph.theLayers[rootVertex].theOuterLayerPairs) {
-      LayerPairsToVisit.push(LayerPair);
-    }
-
-    unsigned int numberOfLayerPairsToVisitAtThisDepth = LayerPairsToVisit.size();
+    const HitDoublets *doubletLayerPairId = hitDoublets[currentLayerPair];
+    auto numberOfDoublets = doubletLayerPairId->size();
+    currentLayerPairRef.theFoundCells[0] = cellId;
+    currentLayerPairRef.theFoundCells[1] = cellId + numberOfDoublets;
+    for (unsigned int i = 0; i < numberOfDoublets; ++i) {
+      allCells.emplace_back(doubletLayerPairId, i,
+                            doubletLayerPairId->innerHitId(i),
+                            doubletLayerPairId->outerHitId(i));
 
-    while (not LayerPairsToVisit.empty()) {
-      auto currentLayerPair = LayerPairsToVisit.front();
-      auto & currentLayerPairRef  = theLayerGraph.theLayerPairs[currentLayerPair];
-      auto & currentInnerLayerRef = theLayerGraph.theLayers[currentLayerPairRef.theLayers[0]];
-      auto & currentOuterLayerRef = theLayerGraph.theLayers[currentLayerPairRef.theLayers[1]];
-      bool allInnerLayerPairsAlreadyVisited{true};
-
-      for (auto innerLayerPair : currentInnerLayerRef.theInnerLayerPairs) {
-        allInnerLayerPairsAlreadyVisited &= alreadyVisitedLayerPairs[innerLayerPair];
-      }
+      currentOuterLayerRef.isOuterHitOfCell[doubletLayerPairId->outerHitId(i)].push_back(cellId);
 
-      if (alreadyVisitedLayerPairs[currentLayerPair] == false and allInnerLayerPairsAlreadyVisited) {
-        const HitDoublets *doubletLayerPairId = hitDoublets[currentLayerPair];
-        auto numberOfDoublets = doubletLayerPairId->size();
-        currentLayerPairRef.theFoundCells[0] = cellId;
-        currentLayerPairRef.theFoundCells[1] = cellId + numberOfDoublets;
-        for (unsigned int i = 0; i < numberOfDoublets; ++i) {
-          allCells.emplace_back(doubletLayerPairId, i,
-                                doubletLayerPairId->innerHitId(i),
-                                doubletLayerPairId->outerHitId(i));
-
-          currentOuterLayerRef.isOuterHitOfCell[doubletLayerPairId->outerHitId(i)].push_back(cellId);
-
-          cellId++;
-
-          auto & neigCells = currentInnerLayerRef.isOuterHitOfCell[doubletLayerPairId->innerHitId(i)];
-          allCells.back().checkAlignmentAndPushTriplet(
-              allCells, neigCells, foundTriplets, ptmin, region_origin_x, region_origin_y,
-              region_origin_radius, thetaCut, phiCut, hardPtCut);
-        }
-        assert(cellId == currentLayerPairRef.theFoundCells[1]);
-        for (auto outerLayerPair : currentOuterLayerRef.theOuterLayerPairs) {
-          LayerPairsToVisit.push(outerLayerPair);
-        }
+      cellId++;
 
-        alreadyVisitedLayerPairs[currentLayerPair] = true;
-      }
-      LayerPairsToVisit.pop();
-      numberOfLayerPairsToVisitAtThisDepth--;
-      if (numberOfLayerPairsToVisitAtThisDepth == 0) {
-        numberOfLayerPairsToVisitAtThisDepth = LayerPairsToVisit.size();
-      }
+      auto & neigCells = currentInnerLayerRef.isOuterHitOfCell[doubletLayerPairId->innerHitId(i)];
+      allCells.back().checkAlignmentAndPushTriplet(
+          allCells, neigCells, foundTriplets, ptmin, region_origin_x, region_origin_y,
+          region_origin_radius, thetaCut, phiCut, hardPtCut);
     }
+    assert(cellId == currentLayerPairRef.theFoundCells[1]);
   }
 }
@@ -27,11 +27,22 @@ public:
 		    const float thetaCut, const float phiCut, const float hardPtCut);
   
 private:
+  // the layer pairs in the order of the breadth-first visit from the root layers:
+  // a layer pair comes after all the layer pairs ending on its inner layer
+  std::vector<int> visitLayerPairs() const;
+
+  void findNtuplets(unsigned int cell, std::vector<CACell::CAntuplet>& foundNtuplets, CACell::CAntuplet& tmpNtuplet,
+		    const unsigned int minHitsPerNtuplet) const;
+
   CAGraph & theLayerGraph;
 
   std::vector<CACell> allCells;
   std::vector<CACellStatus> allStatus;
 
+  // the outer neighbors of cell i are theOuterNeighbors[theOuterNeighborsStart[i]..theOuterNeighborsStart[i+1])
+  std::vector<unsigned int> theOuterNeighborsStart;
+  std::vector<unsigned int> theOuterNeighbors;
+
   std::vector<unsigned int> theRootCells;
   std::vector<std::vector<CACell*> > theNtuplets;
   
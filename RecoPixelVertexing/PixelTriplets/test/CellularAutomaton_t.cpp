@@ -0,0 +1,252 @@
+// Checks that the parallel creation, connection and evolution of the cells of
+// CellularAutomaton, and its search of the ntuplets in chunks of root cells,
+// give the same quadruplets, in the same order, as the serial algorithm.
+//
+// The serial reference is the algorithm before the parallel steps: the cells
+// are connected in the order of their creation, each cell keeps its outer
+// neighbors in the order they were tagged, the cells are evolved one by one
+// and the ntuplets are searched recursively from each root cell in turn. The
+// aligned (inner, outer) cells are taken from findTriplets, which creates the
+// cells serially with the same numbering and the same cuts.
+//
+// The hits are helices from the beam line crossing four barrel layers, and
+// random hits; the graph has layer pairs skipping a layer, so that some layers
+// are reached by several layer pairs.
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "RecoPixelVertexing/PixelTriplets/src/CellularAutomaton.h"
+#include "RecoTracker/TkTrackingRegions/interface/GlobalTrackingRegion.h"
+#include "TrackingTools/DetLayers/interface/DetLayer.h"
+
+#include "tbb/task_arena.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // RecHitsSortedInPhi needs a layer only to know if it is a barrel one
+  class FakeBarrelLayer final : public DetLayer {
+  public:
+    FakeBarrelLayer() : DetLayer(false, true) {}
+    SubDetector subDetector() const override { return GeomDetEnumerators::PixelBarrel; }
+    Location location() const override { return GeomDetEnumerators::barrel; }
+    const BoundSurface& surface() const override { std::abort(); }
+    const std::vector<const GeometricSearchDet*>& components() const override { return theComponents; }
+    const std::vector<const GeomDet*>& basicComponents() const override { return theBasicComponents; }
+    std::pair<bool, TrajectoryStateOnSurface> compatible(const TrajectoryStateOnSurface&, const Propagator&,
+                                                         const MeasurementEstimator&) const override {
+      return std::make_pair(false, TrajectoryStateOnSurface());
+    }
+  private:
+    std::vector<const GeometricSearchDet*> theComponents;
+    std::vector<const GeomDet*> theBasicComponents;
+  };
+
+  struct Point { float x, y, z; };
+
+  const float radii[] = {2.9f, 6.8f, 10.9f, 16.0f};
+  constexpr unsigned int nLayers = 4;
+  // inner and outer layer of each layer pair
+  const int layerPairs[][2] = {{0, 1}, {1, 2}, {2, 3}, {0, 2}, {1, 3}};
+  constexpr unsigned int nLayerPairs = 5;
+
+  constexpr unsigned int minHitsPerNtuplet = 4;
+  constexpr float thetaCut = 0.002f;
+  constexpr float phiCut = 0.2f;
+  constexpr float hardPtCut = 0.f;
+
+  std::vector<std::vector<Point>> generateHits(std::mt19937& engine, unsigned int nTracks, unsigned int nNoise) {
+    std::vector<std::vector<Point>> hits(nLayers);
+    std::uniform_real_distribution<float> phi(-M_PI, M_PI), z0(-8.f, 8.f), cotTheta(-2.f, 2.f), invPt(-2.f, 2.f);
+    std::normal_distribution<float> smear(0.f, 0.002f);
+    for (unsigned int t = 0; t < nTracks; ++t) {
+      const float phi0 = phi(engine), z = z0(engine), cot = cotTheta(engine);
+      const float rho = 87.f / std::max(std::abs(invPt(engine)), 0.1f);  // cm, for pt in GeV in 3.8 T
+      const float charge = (t % 2) ? 1.f : -1.f;
+      for (unsigned int l = 0; l < nLayers; ++l) {
+        const float R = radii[l];
+        if (R > 2 * rho) break;
+        const float alpha = std::asin(R / (2 * rho));
+        const float hitPhi = phi0 + charge * alpha;
+        hits[l].push_back({R * std::cos(hitPhi) + smear(engine), R * std::sin(hitPhi) + smear(engine),
+                           z + cot * 2 * rho * alpha + smear(engine)});
+      }
+    }
+    std::uniform_real_distribution<float> noiseZ(-25.f, 25.f);
+    for (unsigned int l = 0; l < nLayers; ++l) {
+      for (unsigned int n = 0; n < nNoise; ++n) {
+        const float hitPhi = phi(engine);
+        hits[l].push_back({radii[l] * std::cos(hitPhi), radii[l] * std::sin(hitPhi), noiseZ(engine)});
+      }
+    }
+    return hits;
+  }
+
+  std::unique_ptr<RecHitsSortedInPhi> makeLayerHits(const std::vector<Point>& points, const DetLayer& layer) {
+    auto layerHits = std::make_unique<RecHitsSortedInPhi>(std::vector<RecHitsSortedInPhi::Hit>(), GlobalPoint(0, 0, 0), &layer);
+    for (const Point& p : points) {
+      const float r = std::sqrt(p.x * p.x + p.y * p.y);
+      layerHits->theHits.emplace_back(nullptr, std::atan2(p.y, p.x));
+      layerHits->x.push_back(p.x);
+      layerHits->y.push_back(p.y);
+      layerHits->z.push_back(p.z);
+      layerHits->u.push_back(r);
+      layerHits->v.push_back(p.z);
+      layerHits->lphi.push_back(std::atan2(p.y, p.x));
+    }
+    return layerHits;
+  }
+
+  CAGraph makeGraph(const std::vector<std::vector<Point>>& hits) {
+    CAGraph graph;
+    for (unsigned int l = 0; l < nLayers; ++l) {
+      graph.theLayers.emplace_back("layer" + std::to_string(l), hits[l].size());
+    }
+    for (unsigned int p = 0; p < nLayerPairs; ++p) {
+      const int inner = layerPairs[p][0], outer = layerPairs[p][1];
+      graph.theLayerPairs.emplace_back(inner, outer);
+      graph.theLayers[inner].theOuterLayerPairs.push_back(p);
+      graph.theLayers[inner].theOuterLayers.push_back(outer);
+      graph.theLayers[outer].theInnerLayerPairs.push_back(p);
+      graph.theLayers[outer].theInnerLayers.push_back(inner);
+    }
+    graph.theRootLayers.push_back(0);
+    return graph;
+  }
+
+  // the serial algorithm, given the aligned (inner, outer) cells in the order of their tagging
+  std::vector<CACell::CAntuplet> serialQuadruplets(const CAGraph& graph, unsigned int nCells,
+                                                   const std::vector<CACell::CAntuplet>& connections) {
+    std::vector<std::vector<unsigned int>> outerNeighbors(nCells);
+    for (const auto& c : connections) outerNeighbors[c[0]].push_back(c[1]);
+
+    std::vector<CACellStatus> status(nCells);
+    auto evolve = [&](unsigned int i) {
+      status[i].hasSameStateNeighbors = 0;
+      for (auto o : outerNeighbors[i]) {
+        if (status[o].getCAState() == status[i].getCAState()) {
+          status[i].hasSameStateNeighbors = 1;
+          break;
+        }
+      }
+    };
+    for (unsigned int iteration = 0; iteration < minHitsPerNtuplet - 3; ++iteration) {
+      for (unsigned int i = 0; i < nCells; ++i) evolve(i);
+      for (unsigned int i = 0; i < nCells; ++i) status[i].updateState();
+    }
+    std::vector<unsigned int> rootCells;
+    for (int rootLayer : graph.theRootLayers) {
+      for (int rootLayerPair : graph.theLayers[rootLayer].theOuterLayerPairs) {
+        const auto& foundCells = graph.theLayerPairs[rootLayerPair].theFoundCells;
+        for (auto i = foundCells[0]; i < foundCells[1]; ++i) {
+          evolve(i);
+          status[i].updateState();
+          if (status[i].isRootCell(minHitsPerNtuplet - 2)) rootCells.push_back(i);
+        }
+      }
+    }
+
+    std::vector<CACell::CAntuplet> quadruplets;
+    CACell::CAntuplet tmp;
+    std::function<void(unsigned int)> find = [&](unsigned int cell) {
+      if (tmp.size() == minHitsPerNtuplet - 1) {
+        quadruplets.push_back(tmp);
+        return;
+      }
+      for (auto o : outerNeighbors[cell]) {
+        tmp.push_back(o);
+        find(o);
+        tmp.pop_back();
+      }
+    };
+    for (auto root : rootCells) {
+      tmp.assign(1, root);
+      find(root);
+    }
+    return quadruplets;
+  }
+
+  void print(const char* what, const std::vector<CACell::CAntuplet>& ntuplets) {
+    std::cout << what << ": " << ntuplets.size() << " ntuplets" << std::endl;
+  }
+}
+
+int main() {
+  std::mt19937 engine(42);
+  GlobalTrackingRegion region(0.5f, GlobalPoint(0, 0, 0), 0.2f, 15.f, true);
+  std::vector<FakeBarrelLayer> detLayers(nLayers);
+
+  int failures = 0;
+  for (unsigned int event = 0; event < 5; ++event) {
+    // the last event has no hit at all
+    const unsigned int nTracks = event == 4 ? 0 : 300 * (event + 1);
+    const unsigned int nNoise = event == 4 ? 0 : 200 * event;
+    const auto points = generateHits(engine, nTracks, nNoise);
+
+    std::vector<std::unique_ptr<RecHitsSortedInPhi>> layerHits;
+    for (unsigned int l = 0; l < nLayers; ++l) layerHits.push_back(makeLayerHits(points[l], detLayers[l]));
+
+    std::vector<std::unique_ptr<HitDoublets>> doublets;
+    std::vector<const HitDoublets*> doubletPointers;
+    for (unsigned int p = 0; p < nLayerPairs; ++p) {
+      const int inner = layerPairs[p][0], outer = layerPairs[p][1];
+      doublets.push_back(std::make_unique<HitDoublets>(*layerHits[inner], *layerHits[outer]));
+      for (unsigned int i = 0; i < points[inner].size(); ++i) {
+        for (unsigned int o = 0; o < points[outer].size(); ++o) {
+          const float dphi = reco::deltaPhi(layerHits[inner]->phi(i), layerHits[outer]->phi(o));
+          if (std::abs(dphi) < 0.1f && std::abs(points[outer][o].z - points[inner][i].z) < 30.f) {
+            doublets.back()->add(i, o);
+          }
+        }
+      }
+      doubletPointers.push_back(doublets.back().get());
+    }
+    unsigned int nCells = 0;
+    for (auto d : doubletPointers) nCells += d->size();
+
+    // serial reference
+    CAGraph serialGraph = makeGraph(points);
+    std::vector<CACell::CAntuplet> connections;
+    {
+      CellularAutomaton ca(serialGraph);
+      ca.findTriplets(doubletPointers, connections, region, thetaCut, phiCut, hardPtCut);
+    }
+    const auto reference = serialQuadruplets(serialGraph, nCells, connections);
+    std::cout << "event " << event << ": " << nCells << " cells, " << connections.size() << " connections, ";
+    print("serial", reference);
+    if (event < 4 && reference.empty()) {
+      std::cout << "  no quadruplet found by the serial algorithm" << std::endl;
+      ++failures;
+    }
+
+    for (int nThreads : {1, 2, 4, 8}) {
+      tbb::task_arena arena(nThreads);
+      std::vector<CACell::CAntuplet> quadruplets;
+      arena.execute([&] {
+        CAGraph graph = makeGraph(points);
+        CellularAutomaton ca(graph);
+        ca.createAndConnectCells(doubletPointers, region, thetaCut, phiCut, hardPtCut);
+        ca.evolve(minHitsPerNtuplet);
+        ca.findNtuplets(quadruplets, minHitsPerNtuplet);
+      });
+      if (quadruplets != reference) {
+        std::cout << "  " << nThreads << " threads: ";
+        print("different from the serial algorithm", quadruplets);
+        ++failures;
+      }
+    }
+  }
+
+  if (failures) {
+    std::cout << failures << " failures" << std::endl;
+    return 1;
+  }
+  return 0;
+}
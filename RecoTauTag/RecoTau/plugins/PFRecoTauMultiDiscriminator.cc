@@ -0,0 +1,240 @@
+/*
+ * PFRecoTauMultiDiscriminator
+ *
+ * Evaluates a list of tau discriminants (RecoTauDiscriminantPlugins) in one
+ * pass over the taus, and stores them, together with working points cut on
+ * them, in one PFTauDiscriminatorContainer.
+ *
+ * Each output is configured by a PSet of the "discriminants" VPSet:
+ *   name          : name of the output (the raw value of the discriminant)
+ *   plugin        : name of the plugin, by default discPluginName(name)
+ *   pluginParameters : optional PSet given to the plugin
+ *   index         : optional, element of the values of the plugin (default 0)
+ *   default       : optional, value if the plugin has no such element (default 0)
+ *   workingPoints : optional VPSet of { name, minValue, maxValue }: outputs that
+ *                   are 1 if the raw value is above minValue and below maxValue
+ *                   (each optional), 0 otherwise
+ *
+ * A plugin is built and evaluated once per tau, whatever the number of outputs
+ * that use it: the outputs with the same plugin and parameters (e.g. different
+ * indices of a vector discriminant) share the values.  The prediscriminants are
+ * checked once per tau for all the outputs, and the taus that fail them get
+ * prediscriminantFailValue in all the outputs without evaluating the plugins.
+ *
+ * If produceCompatibilityViews is set, each output is also put in the event
+ * as a PFTauDiscriminator with the name of the output as instance label, for
+ * the modules that read one PFTauDiscriminator per discriminator.
+ *
+ */
+
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminatorContainer.h"
+#include "RecoTauTag/RecoTau/interface/RecoTauDiscriminantPlugins.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+class PFRecoTauMultiDiscriminator : public edm::stream::EDProducer<> {
+ public:
+  explicit PFRecoTauMultiDiscriminator(const edm::ParameterSet&);
+  ~PFRecoTauMultiDiscriminator() override {}
+
+  void produce(edm::Event&, const edm::EventSetup&) override;
+
+ private:
+  struct PluginInfo {
+    std::string key;
+    std::unique_ptr<reco::tau::RecoTauDiscriminantPlugin> plugin;
+  };
+  struct WorkingPoint {
+    unsigned int column;
+    double minValue;
+    double maxValue;
+  };
+  struct Output {
+    unsigned int plugin;
+    unsigned int index;
+    double defaultValue;
+    unsigned int column;
+    std::vector<WorkingPoint> workingPoints;
+  };
+  struct Prediscriminant {
+    edm::InputTag label;
+    edm::EDGetTokenT<reco::PFTauDiscriminator> token;
+    double cut;
+  };
+
+  unsigned int addColumn(const std::string& name);
+
+  edm::InputTag tauSource_;
+  edm::EDGetTokenT<reco::PFTauCollection> tauToken_;
+  std::vector<Prediscriminant> prediscriminants_;
+  bool andPrediscriminants_;
+  double prediscriminantFailValue_;
+  bool produceCompatibilityViews_;
+
+  std::vector<PluginInfo> plugins_;
+  std::vector<Output> outputs_;
+  std::vector<std::string> columns_;
+
+  // values of the plugins for the current tau
+  std::vector<std::vector<double> > pluginValues_;
+};
+
+PFRecoTauMultiDiscriminator::PFRecoTauMultiDiscriminator(const edm::ParameterSet& cfg)
+{
+  typedef std::vector<edm::ParameterSet> VPSet;
+
+  tauSource_ = cfg.getParameter<edm::InputTag>("PFTauProducer");
+  tauToken_ = consumes<reco::PFTauCollection>(tauSource_);
+
+  // same configuration of the prediscriminants as in TauDiscriminationProducerBase
+  const edm::ParameterSet& prediscriminantConfig = cfg.getParameter<edm::ParameterSet>("Prediscriminants");
+  std::string pdBoolOperator = prediscriminantConfig.getParameter<std::string>("BooleanOperator");
+  std::transform(pdBoolOperator.begin(), pdBoolOperator.end(), pdBoolOperator.begin(), ::tolower);
+  if ( pdBoolOperator == "and" ) {
+    andPrediscriminants_ = true;
+  } else if ( pdBoolOperator == "or" ) {
+    andPrediscriminants_ = false;
+  } else {
+    throw cms::Exception("PFRecoTauMultiDiscriminator") << "PrediscriminantBooleanOperator defined incorrectly, options are: AND,OR";
+  }
+  for ( const std::string& name : prediscriminantConfig.getParameterNamesForType<edm::ParameterSet>() ) {
+    const edm::ParameterSet& pset = prediscriminantConfig.getParameter<edm::ParameterSet>(name);
+    Prediscriminant prediscriminant;
+    prediscriminant.label = pset.getParameter<edm::InputTag>("Producer");
+    prediscriminant.token = consumes<reco::PFTauDiscriminator>(prediscriminant.label);
+    prediscriminant.cut = pset.getParameter<double>("cut");
+    prediscriminants_.push_back(prediscriminant);
+  }
+  prediscriminantFailValue_ = cfg.existsAs<double>("prediscriminantFailValue") ?
+    cfg.getParameter<double>("prediscriminantFailValue") : 0.;
+  produceCompatibilityViews_ = cfg.getParameter<bool>("produceCompatibilityViews");
+
+  for ( const edm::ParameterSet& pset : cfg.getParameter<VPSet>("discriminants") ) {
+    const std::string name = pset.getParameter<std::string>("name");
+    const std::string pluginName = pset.existsAs<std::string>("plugin") ?
+      pset.getParameter<std::string>("plugin") : reco::tau::discPluginName(name);
+    edm::ParameterSet pluginPSet = pset.existsAs<edm::ParameterSet>("pluginParameters") ?
+      pset.getParameter<edm::ParameterSet>("pluginParameters") : edm::ParameterSet();
+    pluginPSet.addParameter<std::string>("name", pluginName);
+
+    // one instance of each plugin and configuration
+    const std::string key = pluginPSet.toString();
+    auto plugin = std::find_if(plugins_.begin(), plugins_.end(), [&key](const PluginInfo& info) { return info.key == key; });
+    if ( plugin == plugins_.end() ) {
+      PluginInfo info;
+      info.key = key;
+      info.plugin.reset(RecoTauDiscriminantPluginFactory::get()->create(pluginName, pluginPSet));
+      plugins_.push_back(std::move(info));
+      plugin = plugins_.end()-1;
+    }
+
+    Output output;
+    output.plugin = plugin-plugins_.begin();
+    output.index = pset.existsAs<unsigned int>("index") ? pset.getParameter<unsigned int>("index") : 0;
+    output.defaultValue = pset.existsAs<double>("default") ? pset.getParameter<double>("default") : 0.;
+    output.column = addColumn(name);
+    if ( pset.existsAs<VPSet>("workingPoints") ) {
+      for ( const edm::ParameterSet& wpPSet : pset.getParameter<VPSet>("workingPoints") ) {
+        WorkingPoint wp;
+        wp.column = addColumn(wpPSet.getParameter<std::string>("name"));
+        wp.minValue = wpPSet.existsAs<double>("minValue") ?
+          wpPSet.getParameter<double>("minValue") : -std::numeric_limits<double>::max();
+        wp.maxValue = wpPSet.existsAs<double>("maxValue") ?
+          wpPSet.getParameter<double>("maxValue") : std::numeric_limits<double>::max();
+        output.workingPoints.push_back(wp);
+      }
+    }
+    outputs_.push_back(output);
+  }
+  pluginValues_.resize(plugins_.size());
+
+  produces<reco::PFTauDiscriminatorContainer>();
+  if ( produceCompatibilityViews_ ) {
+    for ( const std::string& column : columns_ ) produces<reco::PFTauDiscriminator>(column);
+  }
+}
+
+unsigned int PFRecoTauMultiDiscriminator::addColumn(const std::string& name)
+{
+  if ( std::find(columns_.begin(), columns_.end(), name) != columns_.end() ) {
+    throw cms::Exception("PFRecoTauMultiDiscriminator") << "The output name " << name << " is used twice.";
+  }
+  columns_.push_back(name);
+  return columns_.size()-1;
+}
+
+void PFRecoTauMultiDiscriminator::produce(edm::Event& evt, const edm::EventSetup& es)
+{
+  edm::Handle<reco::PFTauCollection> taus;
+  evt.getByToken(tauToken_, taus);
+  const unsigned int nTaus = taus->size();
+
+  std::vector<edm::Handle<reco::PFTauDiscriminator> > prediscriminants(prediscriminants_.size());
+  for ( size_t iDisc = 0; iDisc < prediscriminants_.size(); ++iDisc ) {
+    evt.getByToken(prediscriminants_[iDisc].token, prediscriminants[iDisc]);
+    if ( prediscriminants[iDisc]->keyProduct().id() != taus.id() ) {
+      throw cms::Exception("MisconfiguredPrediscriminant")
+        << "The tau collection with input tag " << tauSource_
+        << " has product ID: " << taus.id()
+        << " but the pre-discriminator with input tag "
+        << prediscriminants_[iDisc].label
+        << " is keyed with product ID: " << prediscriminants[iDisc]->keyProduct().id() << std::endl;
+    }
+  }
+
+  for ( PluginInfo& plugin : plugins_ ) plugin.plugin->setup(evt, es);
+
+  auto container = std::make_unique<reco::PFTauDiscriminatorContainer>(reco::PFTauRefProd(taus), nTaus, columns_);
+  for ( unsigned int iTau = 0; iTau < nTaus; ++iTau ) {
+    reco::PFTauRef tauRef(taus, iTau);
+
+    bool passesPrediscriminants = andPrediscriminants_;
+    for ( size_t iDisc = 0; iDisc < prediscriminants.size(); ++iDisc ) {
+      bool passes = (*prediscriminants[iDisc])[tauRef] > prediscriminants_[iDisc].cut;
+      if ( passes != andPrediscriminants_ ) {
+        passesPrediscriminants = passes;
+        break;
+      }
+    }
+    if ( !passesPrediscriminants ) {
+      for ( unsigned int iColumn = 0; iColumn < columns_.size(); ++iColumn ) {
+        container->setValue(iColumn, iTau, prediscriminantFailValue_);
+      }
+      continue;
+    }
+
+    for ( size_t iPlugin = 0; iPlugin < plugins_.size(); ++iPlugin ) {
+      pluginValues_[iPlugin] = (*plugins_[iPlugin].plugin)(tauRef);
+    }
+    for ( const Output& output : outputs_ ) {
+      const std::vector<double>& values = pluginValues_[output.plugin];
+      const double value = output.index < values.size() ? values[output.index] : output.defaultValue;
+      container->setValue(output.column, iTau, value);
+      for ( const WorkingPoint& wp : output.workingPoints ) {
+        container->setValue(wp.column, iTau, value > wp.minValue && value < wp.maxValue ? 1. : 0.);
+      }
+    }
+  }
+
+  if ( produceCompatibilityViews_ ) {
+    for ( unsigned int iColumn = 0; iColumn < columns_.size(); ++iColumn ) {
+      evt.put(std::make_unique<reco::PFTauDiscriminator>(container->discriminator(iColumn)), columns_[iColumn]);
+    }
+  }
+  evt.put(std::move(container));
+}
+
+DEFINE_FWK_MODULE(PFRecoTauMultiDiscriminator);
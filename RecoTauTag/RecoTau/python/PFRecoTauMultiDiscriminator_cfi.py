@@ -0,0 +1,46 @@
+'''
+
+Evaluate several tau discriminants in one pass over the taus and store them,
+and working points cut on them, in one PFTauDiscriminatorContainer.
+The discriminants are the RecoTauDiscriminantPlugins named "RecoTauDiscrimination" + name
+(or "plugin" when given); the entries using the same plugin share its evaluation.
+With produceCompatibilityViews, each output is also a PFTauDiscriminator
+with the name of the output as instance label.
+
+'''
+
+import FWCore.ParameterSet.Config as cms
+
+from RecoTauTag.RecoTau.TauDiscriminatorTools import requireLeadTrack
+
+pfRecoTauMultiDiscriminator = cms.EDProducer("PFRecoTauMultiDiscriminator",
+    PFTauProducer = cms.InputTag('hpsPFTauProducer'),
+    Prediscriminants = requireLeadTrack,
+    prediscriminantFailValue = cms.double(0.),
+    produceCompatibilityViews = cms.bool(False),
+    discriminants = cms.VPSet(
+        cms.PSet(
+            name = cms.string('IsolationChargedSumHard'),
+            workingPoints = cms.VPSet(
+                cms.PSet(name = cms.string('ByLooseChargedSumHard'), maxValue = cms.double(2.0)),
+                cms.PSet(name = cms.string('ByTightChargedSumHard'), maxValue = cms.double(1.0))
+            )
+        ),
+        cms.PSet(
+            name = cms.string('IsolationECALSumHard')
+        ),
+        # the pt of the two leading tracks, from one evaluation of TrackPt per tau
+        cms.PSet(
+            name = cms.string('TrackPt0'),
+            plugin = cms.string('RecoTauDiscriminationTrackPt'),
+            index = cms.uint32(0),
+            default = cms.double(-1.)
+        ),
+        cms.PSet(
+            name = cms.string('TrackPt1'),
+            plugin = cms.string('RecoTauDiscriminationTrackPt'),
+            index = cms.uint32(1),
+            default = cms.double(-1.)
+        )
+    )
+)
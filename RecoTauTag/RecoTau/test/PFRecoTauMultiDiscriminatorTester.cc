@@ -0,0 +1,158 @@
+/*
+ * PFRecoTauMultiDiscriminatorTester
+ *
+ * Checks the products of a PFRecoTauMultiDiscriminator with compatibility
+ * views, given its "discriminants" and "prediscriminantFailValue":
+ *  - the container has one column per output and working point, in the order
+ *    of the configuration, and one value per tau;
+ *  - each compatibility view has the values of its column;
+ *  - the taus that fail the prediscriminant have the fail value everywhere;
+ *  - each working point is 1 if the raw value is in (minValue, maxValue), 0 otherwise.
+ *
+ * Throws in endJob if no working point was seen both passed and failed.
+ *
+ */
+
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminatorContainer.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+class PFRecoTauMultiDiscriminatorTester : public edm::one::EDAnalyzer<> {
+ public:
+  explicit PFRecoTauMultiDiscriminatorTester(const edm::ParameterSet&);
+
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+  void endJob() override;
+
+ private:
+  struct WorkingPoint {
+    unsigned int column;
+    unsigned int rawColumn;
+    double minValue;
+    double maxValue;
+  };
+
+  edm::EDGetTokenT<reco::PFTauCollection> tauToken_;
+  edm::EDGetTokenT<reco::PFTauDiscriminator> prediscriminantToken_;
+  edm::EDGetTokenT<reco::PFTauDiscriminatorContainer> containerToken_;
+  std::vector<edm::EDGetTokenT<reco::PFTauDiscriminator> > viewTokens_;
+  double prediscriminantFailValue_;
+  std::vector<std::string> columns_;
+  std::vector<WorkingPoint> workingPoints_;
+
+  unsigned long nTaus_ = 0;
+  unsigned long nFailedPrediscriminant_ = 0;
+  unsigned long nPassedWorkingPoints_ = 0;
+  unsigned long nFailedWorkingPoints_ = 0;
+};
+
+PFRecoTauMultiDiscriminatorTester::PFRecoTauMultiDiscriminatorTester(const edm::ParameterSet& cfg) :
+  tauToken_(consumes<reco::PFTauCollection>(cfg.getParameter<edm::InputTag>("PFTauProducer"))),
+  prediscriminantToken_(consumes<reco::PFTauDiscriminator>(cfg.getParameter<edm::InputTag>("prediscriminant"))),
+  prediscriminantFailValue_(cfg.getParameter<double>("prediscriminantFailValue"))
+{
+  const std::string label = cfg.getParameter<std::string>("discriminator");
+  containerToken_ = consumes<reco::PFTauDiscriminatorContainer>(edm::InputTag(label));
+  for ( const edm::ParameterSet& pset : cfg.getParameter<std::vector<edm::ParameterSet> >("discriminants") ) {
+    const unsigned int rawColumn = columns_.size();
+    columns_.push_back(pset.getParameter<std::string>("name"));
+    if ( pset.existsAs<std::vector<edm::ParameterSet> >("workingPoints") ) {
+      for ( const edm::ParameterSet& wpPSet : pset.getParameter<std::vector<edm::ParameterSet> >("workingPoints") ) {
+        WorkingPoint wp;
+        wp.column = columns_.size();
+        wp.rawColumn = rawColumn;
+        wp.minValue = wpPSet.existsAs<double>("minValue") ?
+          wpPSet.getParameter<double>("minValue") : -std::numeric_limits<double>::max();
+        wp.maxValue = wpPSet.existsAs<double>("maxValue") ?
+          wpPSet.getParameter<double>("maxValue") : std::numeric_limits<double>::max();
+        workingPoints_.push_back(wp);
+        columns_.push_back(wpPSet.getParameter<std::string>("name"));
+      }
+    }
+  }
+  for ( const std::string& column : columns_ ) {
+    viewTokens_.push_back(consumes<reco::PFTauDiscriminator>(edm::InputTag(label, column)));
+  }
+}
+
+void PFRecoTauMultiDiscriminatorTester::analyze(const edm::Event& evt, const edm::EventSetup&)
+{
+  edm::Handle<reco::PFTauCollection> taus;
+  evt.getByToken(tauToken_, taus);
+  edm::Handle<reco::PFTauDiscriminator> prediscriminant;
+  evt.getByToken(prediscriminantToken_, prediscriminant);
+  edm::Handle<reco::PFTauDiscriminatorContainer> container;
+  evt.getByToken(containerToken_, container);
+
+  if ( container->keyProduct().id() != taus.id() || container->size() != taus->size() ) {
+    throw cms::Exception("PFRecoTauMultiDiscriminatorTester") << "The container is not keyed to the taus";
+  }
+  if ( container->names() != columns_ ) {
+    throw cms::Exception("PFRecoTauMultiDiscriminatorTester") << "The columns of the container are not the configured outputs";
+  }
+
+  for ( unsigned int iColumn = 0; iColumn < columns_.size(); ++iColumn ) {
+    edm::Handle<reco::PFTauDiscriminator> view;
+    evt.getByToken(viewTokens_[iColumn], view);
+    if ( view->keyProduct().id() != taus.id() || view->size() != taus->size() ) {
+      throw cms::Exception("PFRecoTauMultiDiscriminatorTester") << "The view " << columns_[iColumn] << " is not keyed to the taus";
+    }
+    for ( unsigned int iTau = 0; iTau < taus->size(); ++iTau ) {
+      reco::PFTauRef tau(taus, iTau);
+      if ( (*view)[tau] != container->value(iColumn, iTau) || container->value(iColumn, tau) != container->value(iColumn, iTau) ) {
+        throw cms::Exception("PFRecoTauMultiDiscriminatorTester")
+          << "Tau " << iTau << ": the view " << columns_[iColumn] << " has " << (*view)[tau]
+          << ", the container " << container->value(iColumn, iTau);
+      }
+    }
+  }
+
+  for ( unsigned int iTau = 0; iTau < taus->size(); ++iTau ) {
+    ++nTaus_;
+    if ( !((*prediscriminant)[reco::PFTauRef(taus, iTau)] > 0.5) ) {
+      ++nFailedPrediscriminant_;
+      for ( unsigned int iColumn = 0; iColumn < columns_.size(); ++iColumn ) {
+        if ( container->value(iColumn, iTau) != prediscriminantFailValue_ ) {
+          throw cms::Exception("PFRecoTauMultiDiscriminatorTester")
+            << "Tau " << iTau << " fails the prediscriminant but has " << container->value(iColumn, iTau) << " for " << columns_[iColumn];
+        }
+      }
+      continue;
+    }
+    for ( const WorkingPoint& wp : workingPoints_ ) {
+      const double raw = container->value(wp.rawColumn, iTau);
+      const float expected = raw > wp.minValue && raw < wp.maxValue ? 1. : 0.;
+      if ( container->value(wp.column, iTau) != expected ) {
+        throw cms::Exception("PFRecoTauMultiDiscriminatorTester")
+          << "Tau " << iTau << ": " << columns_[wp.column] << " is " << container->value(wp.column, iTau)
+          << " for " << columns_[wp.rawColumn] << " = " << raw;
+      }
+      if ( expected > 0.5 ) ++nPassedWorkingPoints_; else ++nFailedWorkingPoints_;
+    }
+  }
+}
+
+void PFRecoTauMultiDiscriminatorTester::endJob()
+{
+  edm::LogSystem("PFRecoTauMultiDiscriminatorTester")
+    << nTaus_ << " taus, " << nFailedPrediscriminant_ << " failing the prediscriminant, working points passed "
+    << nPassedWorkingPoints_ << " and failed " << nFailedWorkingPoints_ << " times";
+  if ( nFailedPrediscriminant_ == 0 || nPassedWorkingPoints_ == 0 || nFailedWorkingPoints_ == 0 ) {
+    throw cms::Exception("PFRecoTauMultiDiscriminatorTester") << "The taus do not test all the cases";
+  }
+}
+
+DEFINE_FWK_MODULE(PFRecoTauMultiDiscriminatorTester);
@@ -0,0 +1,115 @@
+/*
+ * PFTauTestProducer
+ *
+ * Produces PFTaus made of random PFCandidates, that depend only on the event
+ * number, for the tests of the tau discriminators: one or three signal charged
+ * hadrons and random isolation charged hadrons and photons.  Some events have
+ * no tau.
+ *
+ * Also produces a PFTauDiscriminator ("leadTrack"), to be used as
+ * prediscriminant, that is 0 for one tau out of four and 1 for the others.
+ *
+ */
+
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/OrphanHandle.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+class PFTauTestProducer : public edm::global::EDProducer<> {
+ public:
+  explicit PFTauTestProducer(const edm::ParameterSet& cfg) :
+    seed_(cfg.getParameter<unsigned int>("seed")),
+    maxTaus_(cfg.getParameter<unsigned int>("maxTaus"))
+  {
+    produces<reco::PFCandidateCollection>();
+    produces<reco::PFTauCollection>();
+    produces<reco::PFTauDiscriminator>("leadTrack");
+  }
+
+  void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const override;
+
+ private:
+  const unsigned int seed_;
+  const unsigned int maxTaus_;
+};
+
+void PFTauTestProducer::produce(edm::StreamID, edm::Event& evt, const edm::EventSetup&) const
+{
+  std::mt19937 engine(seed_ + evt.id().event());
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  const unsigned int nTaus = std::uniform_int_distribution<unsigned int>(0, maxTaus_)(engine);
+
+  auto candidate = [&](int charge, double pt, double eta, double phi, reco::PFCandidate::ParticleType type) {
+    reco::Candidate::PolarLorentzVector p4(pt, eta, phi, type == reco::PFCandidate::h ? 0.13957 : 0.);
+    return reco::PFCandidate(charge, reco::Candidate::LorentzVector(p4), type);
+  };
+
+  // the candidates of each tau: signal charged hadrons, isolation charged hadrons, isolation photons
+  auto candidates = std::make_unique<reco::PFCandidateCollection>();
+  std::vector<std::vector<unsigned int> > signalCharged(nTaus), isolationCharged(nTaus), isolationGammas(nTaus);
+  std::vector<double> tauEta(nTaus), tauPhi(nTaus);
+  for ( unsigned int iTau = 0; iTau < nTaus; ++iTau ) {
+    tauEta[iTau] = -2.3 + 4.6*uniform(engine);
+    tauPhi[iTau] = M_PI*(2.*uniform(engine)-1.);
+    const unsigned int nSignal = engine() % 2 ? 3 : 1;
+    for ( unsigned int i = 0; i < nSignal; ++i ) {
+      signalCharged[iTau].push_back(candidates->size());
+      candidates->push_back(candidate(i == 1 ? -1 : 1, 5.+30.*uniform(engine), tauEta[iTau]+0.05*(uniform(engine)-0.5),
+                                      tauPhi[iTau]+0.05*(uniform(engine)-0.5), reco::PFCandidate::h));
+    }
+    for ( unsigned int i = 0, n = engine() % 6; i < n; ++i ) {
+      isolationCharged[iTau].push_back(candidates->size());
+      candidates->push_back(candidate(engine() % 2 ? 1 : -1, 0.2+3.*uniform(engine), tauEta[iTau]+0.4*(uniform(engine)-0.5),
+                                      tauPhi[iTau]+0.4*(uniform(engine)-0.5), reco::PFCandidate::h));
+    }
+    for ( unsigned int i = 0, n = engine() % 6; i < n; ++i ) {
+      isolationGammas[iTau].push_back(candidates->size());
+      candidates->push_back(candidate(0, 0.5+3.*uniform(engine), tauEta[iTau]+0.4*(uniform(engine)-0.5),
+                                      tauPhi[iTau]+0.4*(uniform(engine)-0.5), reco::PFCandidate::gamma));
+    }
+  }
+  edm::OrphanHandle<reco::PFCandidateCollection> hCandidates = evt.put(std::move(candidates));
+
+  auto taus = std::make_unique<reco::PFTauCollection>();
+  for ( unsigned int iTau = 0; iTau < nTaus; ++iTau ) {
+    auto ptrs = [&hCandidates](const std::vector<unsigned int>& indices) {
+      std::vector<reco::PFCandidatePtr> output;
+      for ( unsigned int i : indices ) output.push_back(reco::PFCandidatePtr(hCandidates, i));
+      return output;
+    };
+    std::vector<reco::PFCandidatePtr> signal = ptrs(signalCharged[iTau]);
+    reco::Candidate::LorentzVector p4;
+    int charge = 0;
+    for ( const auto& cand : signal ) {
+      p4 += cand->p4();
+      charge += cand->charge();
+    }
+    reco::PFTau tau(charge, p4);
+    tau.setsignalPFChargedHadrCands(signal);
+    tau.setleadPFChargedHadrCand(signal.front());
+    tau.setisolationPFChargedHadrCands(ptrs(isolationCharged[iTau]));
+    tau.setisolationPFGammaCands(ptrs(isolationGammas[iTau]));
+    taus->push_back(tau);
+  }
+  edm::OrphanHandle<reco::PFTauCollection> hTaus = evt.put(std::move(taus));
+
+  auto leadTrack = std::make_unique<reco::PFTauDiscriminator>(reco::PFTauRefProd(hTaus));
+  for ( unsigned int iTau = 0; iTau < nTaus; ++iTau ) {
+    leadTrack->setValue(iTau, iTau % 4 == 3 ? 0. : 1.);
+  }
+  evt.put(std::move(leadTrack), "leadTrack");
+}
+
+DEFINE_FWK_MODULE(PFTauTestProducer);
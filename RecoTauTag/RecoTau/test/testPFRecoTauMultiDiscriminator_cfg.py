@@ -0,0 +1,42 @@
+# Runs pfRecoTauMultiDiscriminator with compatibility views on random taus and
+# checks its outputs with PFRecoTauMultiDiscriminatorTester.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load("RecoTauTag.RecoTau.PFRecoTauMultiDiscriminator_cfi")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(100))
+
+process.taus = cms.EDProducer("PFTauTestProducer",
+    seed = cms.uint32(1234),
+    maxTaus = cms.uint32(6)
+)
+
+process.pfRecoTauMultiDiscriminator.PFTauProducer = "taus"
+process.pfRecoTauMultiDiscriminator.Prediscriminants = cms.PSet(
+    BooleanOperator = cms.string("and"),
+    leadTrack = cms.PSet(
+        Producer = cms.InputTag("taus", "leadTrack"),
+        cut = cms.double(0.5)
+    )
+)
+process.pfRecoTauMultiDiscriminator.prediscriminantFailValue = -1.
+process.pfRecoTauMultiDiscriminator.produceCompatibilityViews = True
+# a working point with both cuts, on a discriminant with a default value
+process.pfRecoTauMultiDiscriminator.discriminants[2].workingPoints = cms.VPSet(
+    cms.PSet(name = cms.string('TrackPt0Between2And20'), minValue = cms.double(2.), maxValue = cms.double(20.))
+)
+
+process.tester = cms.EDAnalyzer("PFRecoTauMultiDiscriminatorTester",
+    PFTauProducer = cms.InputTag("taus"),
+    prediscriminant = cms.InputTag("taus", "leadTrack"),
+    discriminator = cms.string("pfRecoTauMultiDiscriminator"),
+    prediscriminantFailValue = process.pfRecoTauMultiDiscriminator.prediscriminantFailValue,
+    discriminants = process.pfRecoTauMultiDiscriminator.discriminants
+)
+
+process.p = cms.Path(process.taus + process.pfRecoTauMultiDiscriminator + process.tester)
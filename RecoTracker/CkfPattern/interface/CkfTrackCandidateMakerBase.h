@@ -27,6 +27,7 @@
 #include "RecoTracker/MeasurementDet/interface/MeasurementTrackerEvent.h"
 
 #include <memory>
+#include <vector>
 
 class TransientInitialStateEstimator;
 
@@ -55,6 +56,8 @@ namespace cms
     unsigned int theMaxNSeeds;
 
     std::unique_ptr<BaseCkfTrajectoryBuilder> theTrajectoryBuilder;
+    /// additional builders used to process seed chunks concurrently
+    std::vector<std::unique_ptr<BaseCkfTrajectoryBuilder>> theChunkTrajectoryBuilders;
 
     std::string theTrajectoryCleanerName;
     const TrajectoryCleaner*               theTrajectoryCleaner;
@@ -69,8 +72,13 @@ namespace cms
     const NavigationSchool*       theNavigationSchool;
     
     RedundantSeedCleaner*  theSeedCleaner;
+    int  theNumHitsForSeedCleaner;
+    bool theOnlyPixelHitsForSeedCleaner;
 
     unsigned int maxSeedsBeforeCleaning_;
+
+    /// if not 0, the seeds are processed concurrently in chunks of this size
+    unsigned int theSeedChunkSize;
     
     edm::EDGetTokenT<edm::View<TrajectorySeed> >  theSeedLabel;
     edm::EDGetTokenT<MeasurementTrackerEvent>     theMTELabel;
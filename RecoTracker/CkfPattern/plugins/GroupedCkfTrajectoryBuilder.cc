@@ -138,6 +138,8 @@ GroupedCkfTrajectoryBuilder::GroupedCkfTrajectoryBuilder(const edm::ParameterSet
   theAlwaysUseInvalid         = conf.getParameter<bool>("alwaysUseInvalidHits");
   theLockHits                 = conf.getParameter<bool>("lockHits");
   theBestHitOnly              = conf.getParameter<bool>("bestHitOnly");
+  theBatchedKalmanUpdate      = conf.existsAs<bool>("batchedKalmanUpdate") ?
+    conf.getParameter<bool>("batchedKalmanUpdate") : false;
   theMinNrOf2dHitsForRebuild  = 2;
   theRequireSeedHitsInRebuild = conf.getParameter<bool>("requireSeedHitsInRebuild");
   theKeepOriginalIfRebuildFails = conf.getParameter<bool>("keepOriginalIfRebuildFails");
@@ -575,7 +577,8 @@ GroupedCkfTrajectoryBuilder::advanceOneLayer (const TrajectorySeed& seed,
     TrajectorySegmentBuilder layerBuilder(&layerMeasurements,
 					  **il,*propagator,
 					  *theUpdator,*theEstimator,
-					  theLockHits,theBestHitOnly,theMaxCand);
+					  theLockHits,theBestHitOnly,theMaxCand,
+					  theBatchedKalmanUpdate);
 
 #ifdef EDM_ML_DEBUG
     LogDebug("CkfPattern")<<whatIsTheStateToUse(stateAndLayers.first,stateToUse,*il);
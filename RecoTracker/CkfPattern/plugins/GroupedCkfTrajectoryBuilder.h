@@ -187,6 +187,8 @@ private:
 
   bool theLockHits;             /**< Lock hits when building segments in a layer */
   bool theBestHitOnly;          /**< Use only best hit / group when building segments */
+  bool theBatchedKalmanUpdate;  /**< Update the candidates with the 2D hits of a layer 
+				     in SIMD batches (KFUpdator only) */
 
   bool theRequireSeedHitsInRebuild; 
                                /**< Only accept rebuilt trajectories if they contain the seed hits. */
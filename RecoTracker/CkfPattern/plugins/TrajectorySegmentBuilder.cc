@@ -7,6 +7,7 @@
 
 #include "DataFormats/TrajectorySeed/interface/TrajectorySeed.h"
 #include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
 #include "TrackingTools/DetLayers/interface/MeasurementEstimator.h"
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
 #include "TrackingTools/PatternTools/interface/TrajectoryMeasurement.h"
@@ -319,6 +320,10 @@ TrajectorySegmentBuilder::updateCandidates (TempTrajectory const & traj,
 					    const vector<TM>& measurements,
 					    TempTrajectoryContainer& candidates)
 {
+  if ( theBatchedUpdate ) {
+    updateCandidatesBatched(traj,measurements,candidates);
+    return;
+  }
   //
   // generate updated candidates with all valid hits
   //
@@ -332,6 +337,44 @@ TrajectorySegmentBuilder::updateCandidates (TempTrajectory const & traj,
   }
 }
 
+void
+TrajectorySegmentBuilder::updateCandidatesBatched (TempTrajectory const & traj,
+						   const vector<TM>& measurements,
+						   TempTrajectoryContainer& candidates)
+{
+  //
+  // the candidates are created in the same order as in updateCandidates;
+  // those with a 2D hit get their updated state when their batch is full
+  //
+  KFBatchUpdator batch;
+  const TM * batchedMeas[KFBatchUpdator::Width];
+  size_t batchedCand[KFBatchUpdator::Width];
+  auto flush = [&]() {
+    batch.update();
+    for ( unsigned int l=0; l!=batch.size(); ++l ) {
+      const TM & tm = *batchedMeas[l];
+      candidates[batchedCand[l]].emplace(tm.predictedState(), batch.updatedState(l),
+					 tm.recHit(), tm.estimate(), tm.layer());
+    }
+    batch.clear();
+  };
+
+  for ( auto const & tm : measurements ) {
+    if ( !tm.recHit()->isValid() )  continue;
+    candidates.push_back(traj);
+    if ( KFBatchUpdator::accepts(tm.recHitR()) ) {
+      unsigned int l = batch.add(tm.predictedState(),tm.recHitR());
+      batchedMeas[l] = &tm;
+      batchedCand[l] = candidates.size()-1;
+      if ( batch.full() )  flush();
+    } else {
+      updateTrajectory(candidates.back(),tm);
+    }
+    if ( theLockHits )  lockMeasurement(tm);
+  }
+  if ( batch.size()!=0 )  flush();
+}
+
 void
 TrajectorySegmentBuilder::updateCandidatesWithBestHit (TempTrajectory const& traj,
 						       TM measurement,
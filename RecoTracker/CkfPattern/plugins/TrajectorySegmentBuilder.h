@@ -10,6 +10,7 @@
 #include "RecoTracker/MeasurementDet/interface/MeasurementTracker.h"
 #include "RecoTracker/MeasurementDet/interface/MeasurementTrackerEvent.h"
 #include "TrackingTools/MeasurementDet/interface/LayerMeasurements.h"
+#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
 #include <vector>                                        
 
 #include "FWCore/Utilities/interface/Visibility.h"
@@ -50,7 +51,8 @@ public:
 			    const Propagator& propagator,
 			    const TrajectoryStateUpdator& updator,
 			    const MeasurementEstimator& estimator,
-			    bool lockHits, bool bestHitOnly, int maxCand) :
+			    bool lockHits, bool bestHitOnly, int maxCand,
+			    bool batchedUpdate=false) :
     theLayerMeasurements(theInputLayerMeasurements),
     theLayer(layer),
     theFullPropagator(propagator),
@@ -58,7 +60,8 @@ public:
     theEstimator(estimator),
     theGeomPropagator(propagator),
 //     theGeomPropagator(propagator.propagationDirection()),
-      theLockHits(lockHits),theBestHitOnly(bestHitOnly),theMaxCand(maxCand)
+      theLockHits(lockHits),theBestHitOnly(bestHitOnly),theMaxCand(maxCand),
+      theBatchedUpdate(batchedUpdate && dynamic_cast<const KFUpdator*>(&updator)!=nullptr)
   {}
 
   /// destructor
@@ -76,6 +79,10 @@ private:
   void updateCandidates (TempTrajectory const& traj, const std::vector<TM>& measurements,
 			 TempTrajectoryContainer& candidates);
 
+  /// same as updateCandidates, with the Kalman updates of the 2D hits done in batches
+  void updateCandidatesBatched (TempTrajectory const& traj, const std::vector<TM>& measurements,
+				TempTrajectoryContainer& candidates);
+
   /// creation of a new candidate from a segment and the best hit out of a collection
   void updateCandidatesWithBestHit (TempTrajectory const& traj, TM measurements,
 				    TempTrajectoryContainer& candidates);
@@ -116,6 +123,7 @@ private:
   bool theLockHits;
   bool theBestHitOnly;
   int  theMaxCand;
+  bool theBatchedUpdate;
   ConstRecHitContainer theLockedHits;
 
   bool theDbgFlg;
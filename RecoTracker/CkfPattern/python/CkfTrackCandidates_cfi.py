@@ -17,6 +17,14 @@ ckfTrackCandidates = cms.EDProducer("CkfTrackCandidateMaker",
 #    SeedLabel = cms.string(''),
     maxNSeeds = cms.uint32(500000),
     maxSeedsBeforeCleaning = cms.uint32(5000),
+# If not 0, build from the seeds of an event concurrently, in chunks of this
+# many seeds; the result does not depend on the number of threads. Without seed
+# cleaning it is the same as with 0; with seed cleaning a few candidates can
+# differ, as the seeds are cleaned within their chunk before the chunks are
+# merged (see test/runCkfSeedChunksTest.sh)
+    seedChunkSize = cms.uint32(0),
+# Number of seed chunks processed at the same time (one trajectory builder each)
+    maxConcurrentSeedChunks = cms.uint32(4),
 # SeedProducer:SeedLabel descoped to src
     src = cms.InputTag('globalMixedSeeds'),                                  
     SimpleMagneticField = cms.string(''),                                    
@@ -25,6 +25,9 @@ GroupedCkfTrajectoryBuilder = cms.PSet(
     foundHitBonus = cms.double(10.0),
     MeasurementTrackerName = cms.string(''),
     lockHits = cms.bool(True),
+    # If true, the candidates created from the 2D hits of a layer are
+    # updated together by KFBatchUpdator (only used with the KFUpdator)
+    batchedKalmanUpdate = cms.bool(False),
     TTRHBuilder = cms.string('WithTrackAngle'),
     updator = cms.string('KFUpdator'),
     # If true, track building will allow for possibility of no hit
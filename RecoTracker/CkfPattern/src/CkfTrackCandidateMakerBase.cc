@@ -41,9 +41,7 @@
 // #define VI_TBB
 
 #include <thread>
-#ifdef VI_TBB
 #include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
 
@@ -73,7 +71,10 @@ namespace cms{
     theNavigationSchoolName(conf.getParameter<std::string>("NavigationSchool")),
     theNavigationSchool(nullptr),
     theSeedCleaner(nullptr),
+    theNumHitsForSeedCleaner(4),
+    theOnlyPixelHitsForSeedCleaner(false),
     maxSeedsBeforeCleaning_(0),
+    theSeedChunkSize(conf.existsAs<unsigned int>("seedChunkSize") ? conf.getParameter<unsigned int>("seedChunkSize") : 0),
     theMTELabel(iC.consumes<MeasurementTrackerEvent>(conf.getParameter<edm::InputTag>("MeasurementTrackerEvent"))),
     skipClusters_(false),
     phase2skipClusters_(false)
@@ -97,11 +98,11 @@ namespace cms{
 #ifndef VI_REPRODUCIBLE
     std::string cleaner = conf.getParameter<std::string>("RedundantSeedCleaner");
     if (cleaner == "CachingSeedCleanerBySharedInput") {
-      int numHitsForSeedCleaner = conf.existsAs<int>("numHitsForSeedCleaner") ?
+      theNumHitsForSeedCleaner = conf.existsAs<int>("numHitsForSeedCleaner") ?
 	conf.getParameter<int>("numHitsForSeedCleaner") : 4;
-      int onlyPixelHits = conf.existsAs<bool>("onlyPixelHitsForSeedCleaner") ?
+      theOnlyPixelHitsForSeedCleaner = conf.existsAs<bool>("onlyPixelHitsForSeedCleaner") ?
 	conf.getParameter<bool>("onlyPixelHitsForSeedCleaner") : false;
-      theSeedCleaner = new CachingSeedCleanerBySharedInput(numHitsForSeedCleaner,onlyPixelHits);
+      theSeedCleaner = new CachingSeedCleanerBySharedInput(theNumHitsForSeedCleaner,theOnlyPixelHitsForSeedCleaner);
     } else if (cleaner == "none") {
         theSeedCleaner = nullptr;
     } else {
@@ -109,6 +110,14 @@ namespace cms{
     }
 #endif
 
+    // one builder per seed chunk processed concurrently, the first one being theTrajectoryBuilder
+    if (theSeedChunkSize > 0) {
+      unsigned int nBuilders = conf.existsAs<unsigned int>("maxConcurrentSeedChunks") ?
+        conf.getParameter<unsigned int>("maxConcurrentSeedChunks") : 4;
+      for (unsigned int i = 1; i < nBuilders; ++i)
+        theChunkTrajectoryBuilders.emplace_back(createBaseCkfTrajectoryBuilder(conf.getParameter<edm::ParameterSet>("TrajectoryBuilderPSet"), iC));
+    }
+
 #ifdef VI_REPRODUCIBLE
    std::cout << "CkfTrackCandidateMaker in reproducible setting" << std::endl;
    assert(nullptr==theSeedCleaner);
@@ -144,6 +153,7 @@ namespace cms{
     es.get<NavigationSchoolRecord>().get(theNavigationSchoolName, navigationSchoolH);
     theNavigationSchool = navigationSchoolH.product();
     theTrajectoryBuilder->setNavigationSchool(theNavigationSchool);
+    for (auto & builder : theChunkTrajectoryBuilders) builder->setNavigationSchool(theNavigationSchool);
   }
 
   // Functions that gets called by framework every event
@@ -168,6 +178,7 @@ namespace cms{
     e.getByToken(theMTELabel, data);
 
     std::unique_ptr<MeasurementTrackerEvent> dataWithMasks;
+    const MeasurementTrackerEvent * mte = &*data;
     if (skipClusters_) {
         edm::Handle<PixelClusterMask> pixelMask;
         e.getByToken(maskPixels_, pixelMask);
@@ -175,7 +186,7 @@ namespace cms{
         e.getByToken(maskStrips_, stripMask);
         dataWithMasks = std::make_unique<MeasurementTrackerEvent>(*data, *stripMask, *pixelMask);
         //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created with masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*dataWithMasks);
+        mte = &*dataWithMasks;
     } else if (phase2skipClusters_) {
         //FIXME:just temporary solution for phase2!
         edm::Handle<PixelClusterMask> pixelMask;
@@ -184,11 +195,10 @@ namespace cms{
         e.getByToken(maskPhase2OTs_, phase2OTMask);
         dataWithMasks = std::make_unique<MeasurementTrackerEvent>(*data, *pixelMask, *phase2OTMask);
         //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created with phase2 masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*dataWithMasks);
-    } else {
-        //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created without masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*data);
+        mte = &*dataWithMasks;
     }
+    theTrajectoryBuilder->setEvent(e, es, mte);
+    for (auto & builder : theChunkTrajectoryBuilders) builder->setEvent(e, es, mte);
     // TISE ES must be set here due to dependence on theTrajectoryBuilder
     theInitialState->setEventSetup( es, static_cast<TkTransientTrackingRecHitBuilder const *>(theTrajectoryBuilder->hitBuilder())->cloner() );
 
@@ -267,7 +277,9 @@ namespace cms{
 #endif
 
       std::atomic<unsigned int> ntseed(0);
-      auto theLoop = [&](size_t ii) {
+      // build from seed indeces[ii] with the given builder, storing the trajectories in result
+      auto theLoop = [&](size_t ii, BaseCkfTrajectoryBuilder & builder, RedundantSeedCleaner * seedCleaner,
+                         std::vector<Trajectory> & result, unsigned int & lastCleanResult) {
         auto j = indeces[ii];
 
         ntseed++;
@@ -280,7 +292,7 @@ namespace cms{
 
         { Lock lock(theMutex);
 	// Check if seed hits already used by another track
-	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
+	if (seedCleaner && !seedCleaner->good( &((*collseed)[j])) ) {
           LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
           (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
           return;  // from the lambda!
@@ -290,7 +302,7 @@ namespace cms{
 	// Build trajectory from seed outwards
         theTmpTrajectories.clear();
         unsigned int nCandPerSeed = 0;
-        auto const & startTraj = theTrajectoryBuilder->buildTrajectories( (*collseed)[j], theTmpTrajectories, nCandPerSeed, nullptr );
+        auto const & startTraj = builder.buildTrajectories( (*collseed)[j], theTmpTrajectories, nCandPerSeed, nullptr );
         {
           Lock lock(theMutex);
           (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
@@ -319,7 +331,7 @@ namespace cms{
 	// seed and if possible further inwards.
 
 	if (doSeedingRegionRebuilding) {
-	  theTrajectoryBuilder->rebuildTrajectories(startTraj,(*collseed)[j],theTmpTrajectories);
+	  builder.rebuildTrajectories(startTraj,(*collseed)[j],theTmpTrajectories);
 
   	  LogDebug("CkfPattern") << "======== Out-in trajectory building found " << theTmpTrajectories.size()
   			              << " valid/invalid trajectories from seed " << j << " ========\n"
@@ -346,25 +358,25 @@ namespace cms{
 	    it->setSeedRef(collseed->refAt(j));
             (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NOT_STOPPED);
 	    // Store trajectory
-	    rawResult.push_back(std::move(*it));
+	    result.push_back(std::move(*it));
   	    // Tell seed cleaner which hits this trajectory used.
             //TO BE FIXED: this cut should be configurable via cfi file
-            if (theSeedCleaner && rawResult.back().foundHits()>3) theSeedCleaner->add( &rawResult.back() );
+            if (seedCleaner && result.back().foundHits()>3) seedCleaner->add( &result.back() );
             //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
 	  }
 	}}
 
         theTmpTrajectories.clear();
 
-	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
+	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << result.size();
 
         { Lock lock(theMutex);
-	if ( maxSeedsBeforeCleaning_ >0 && rawResult.size() > maxSeedsBeforeCleaning_+lastCleanResult) {
-          theTrajectoryCleaner->clean(rawResult);
-          rawResult.erase(std::remove_if(rawResult.begin()+lastCleanResult,rawResult.end(),
+	if ( maxSeedsBeforeCleaning_ >0 && result.size() > maxSeedsBeforeCleaning_+lastCleanResult) {
+          theTrajectoryCleaner->clean(result);
+          result.erase(std::remove_if(result.begin()+lastCleanResult,result.end(),
 					 std::not1(std::mem_fun_ref(&Trajectory::isValid))),
-			  rawResult.end());
-          lastCleanResult=rawResult.size();
+			  result.end());
+          lastCleanResult=result.size();
         }
         }
 
@@ -372,16 +384,61 @@ namespace cms{
       // end of loop over seeds
 
 
+      if (theSeedChunkSize > 0 && collseed_size > theSeedChunkSize) {
+        // The seeds are processed in chunks of theSeedChunkSize, each chunk by one builder
+        // with its own seed cleaner. The chunks do not depend on the number of threads
+        // and are merged in order, so the result is reproducible.
+        std::vector<BaseCkfTrajectoryBuilder*> builders(1, theTrajectoryBuilder.get());
+        for (auto & builder : theChunkTrajectoryBuilders) builders.push_back(builder.get());
+        const size_t nChunks = (collseed_size + theSeedChunkSize - 1) / theSeedChunkSize;
+        std::vector<std::vector<Trajectory>> chunkResults(nChunks);
+        std::atomic<size_t> nextChunk(0);
+        tbb::parallel_for(size_t(0), builders.size(), size_t(1), [&](size_t ib) {
+          std::unique_ptr<RedundantSeedCleaner> chunkSeedCleaner;
+          if (theSeedCleaner)
+            chunkSeedCleaner = std::make_unique<CachingSeedCleanerBySharedInput>(theNumHitsForSeedCleaner,theOnlyPixelHitsForSeedCleaner);
+          for (size_t ic = nextChunk++; ic < nChunks; ic = nextChunk++) {
+            auto & chunkResult = chunkResults[ic];
+            unsigned int chunkLastCleanResult = 0;
+            if (chunkSeedCleaner) chunkSeedCleaner->init(&chunkResult);
+            for (size_t ii = ic*theSeedChunkSize, ie = std::min(ii+theSeedChunkSize, collseed_size); ii < ie; ++ii)
+              theLoop(ii, *builders[ib], chunkSeedCleaner.get(), chunkResult, chunkLastCleanResult);
+            if (chunkSeedCleaner) chunkSeedCleaner->done();
+          }
+        });
+
+        // Drop the trajectories of the seeds which share their hits with a trajectory of a
+        // previous chunk, as the seed cleaner would have done in the serial loop.
+        for (auto & chunkResult : chunkResults) {
+          const size_t firstOfChunk = rawResult.size();
+          bool keep = true;
+          size_t lastSeed = collseed_size;
+          for (auto & traj : chunkResult) {
+            const size_t seedIndex = traj.seedRef().key();
+            if (seedIndex != lastSeed) { // the trajectories of a seed are contiguous
+              lastSeed = seedIndex;
+              keep = !theSeedCleaner || theSeedCleaner->good( &((*collseed)[seedIndex]) );
+              if (!keep) (*outputSeedStopInfos)[seedIndex].setStopReason(SeedStopReason::SEED_CLEANING);
+            }
+            if (keep) rawResult.push_back(std::move(traj));
+          }
+          if (theSeedCleaner) {
+            for (size_t i = firstOfChunk; i < rawResult.size(); ++i)
+              if (rawResult[i].foundHits()>3) theSeedCleaner->add( &rawResult[i] );
+          }
+        }
+      } else {
 #ifdef VI_TBB
-     tbb::parallel_for(0UL,collseed_size,1UL,theLoop);
+     tbb::parallel_for(0UL,collseed_size,1UL,[&](size_t j){ theLoop(j, *theTrajectoryBuilder, theSeedCleaner, rawResult, lastCleanResult); });
 #else
 #ifdef VI_OMP
 #pragma omp parallel for schedule(dynamic,4)
 #endif
       for (size_t j = 0; j < collseed_size; j++){
-       theLoop(j);
+       theLoop(j, *theTrajectoryBuilder, theSeedCleaner, rawResult, lastCleanResult);
       }
 #endif
+      }
       assert(ntseed==collseed_size);
       if (theSeedCleaner) theSeedCleaner->done();
 
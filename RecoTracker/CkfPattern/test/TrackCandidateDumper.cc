@@ -0,0 +1,72 @@
+// Writes the track candidates of several collections to a text file, one line
+// per candidate, with enough digits to compare jobs: seed index, stop reason,
+// number of loops, state on the first hit, and detector id and local position
+// of each hit.
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/TrackCandidate/interface/TrackCandidateCollection.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+class TrackCandidateDumper : public edm::one::EDAnalyzer<> {
+public:
+  explicit TrackCandidateDumper(const edm::ParameterSet& conf);
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void analyze(const edm::Event& event, const edm::EventSetup&) override;
+
+  std::vector<std::string> theLabels;
+  std::vector<edm::EDGetTokenT<TrackCandidateCollection>> theTokens;
+  std::ofstream theFile;
+};
+
+TrackCandidateDumper::TrackCandidateDumper(const edm::ParameterSet& conf)
+    : theFile(conf.getParameter<std::string>("fileName")) {
+  for (const auto& tag : conf.getParameter<std::vector<edm::InputTag>>("src")) {
+    theLabels.push_back(tag.label());
+    theTokens.push_back(consumes<TrackCandidateCollection>(tag));
+  }
+  theFile << std::setprecision(9);
+}
+
+void TrackCandidateDumper::analyze(const edm::Event& event, const edm::EventSetup&) {
+  for (unsigned int i = 0; i < theTokens.size(); ++i) {
+    edm::Handle<TrackCandidateCollection> candidates;
+    event.getByToken(theTokens[i], candidates);
+    for (const auto& cand : *candidates) {
+      theFile << event.id().event() << ' ' << theLabels[i] << ' ' << cand.seedRef().key() << ' '
+              << int(cand.stopReason()) << ' ' << int(cand.nLoops());
+      const auto& state = cand.trajectoryStateOnDet();
+      theFile << ' ' << state.detId();
+      const auto& parameters = state.parameters().vector();
+      for (unsigned int j = 0; j < 5; ++j)
+        theFile << ' ' << parameters[j];
+      for (auto hit = cand.recHits().first; hit != cand.recHits().second; ++hit) {
+        theFile << ' ' << hit->geographicalId().rawId();
+        if (hit->isValid())
+          theFile << ':' << hit->localPosition().x() << ':' << hit->localPosition().y();
+      }
+      theFile << '\n';
+    }
+  }
+}
+
+void TrackCandidateDumper::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<std::vector<edm::InputTag>>("src", {});
+  desc.add<std::string>("fileName", "trackCandidates.txt");
+  descriptions.add("trackCandidateDumper", desc);
+}
+
+DEFINE_FWK_MODULE(TrackCandidateDumper);
@@ -0,0 +1,74 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Builds the initial step track candidates with and without seed chunks, with
+# and without seed cleaning, and writes all of them with TrackCandidateDumper,
+# for runCkfSeedChunksTest.sh. One stream, so that the threads only build the
+# seed chunks of an event concurrently.
+
+options = VarParsing.VarParsing()
+options.register('nThreads',
+                 1, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of threads.")
+options.register('seedChunkSize',
+                 20, # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Seed chunk size of the chunked collections.")
+options.register('dumpFile',
+                 'ckfSeedChunks.txt', # default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Output of TrackCandidateDumper.")
+options.parseArguments()
+
+from Configuration.StandardSequences.Eras import eras
+process = cms.Process('CKFTEST', eras.Run2_2017)
+
+process.load('Configuration.StandardSequences.Services_cff')
+process.load('FWCore.MessageService.MessageLogger_cfi')
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_cff')
+process.load('Configuration.StandardSequences.RawToDigi_cff')
+process.load('Configuration.StandardSequences.Reconstruction_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.nThreads),
+    numberOfStreams = cms.untracked.uint32(1)
+)
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:ckfSeedChunksInput.root')
+)
+
+# seedChunkSize 0 against > 0: identical without seed cleaning, close with it
+process.initialStepTrackCandidatesChunks = process.initialStepTrackCandidates.clone(
+    seedChunkSize = cms.uint32(options.seedChunkSize)
+)
+process.initialStepTrackCandidatesNoCleaning = process.initialStepTrackCandidates.clone(
+    RedundantSeedCleaner = cms.string('none'),
+    maxSeedsBeforeCleaning = cms.uint32(0)
+)
+process.initialStepTrackCandidatesNoCleaningChunks = process.initialStepTrackCandidatesNoCleaning.clone(
+    seedChunkSize = cms.uint32(options.seedChunkSize)
+)
+
+process.dumper = cms.EDAnalyzer("TrackCandidateDumper",
+    src = cms.VInputTag("initialStepTrackCandidates",
+                        "initialStepTrackCandidatesChunks",
+                        "initialStepTrackCandidatesNoCleaning",
+                        "initialStepTrackCandidatesNoCleaningChunks"),
+    fileName = cms.string(options.dumpFile)
+)
+
+process.p = cms.Path(process.RawToDigi *
+                     process.reconstruction_trackingOnly *
+                     process.initialStepTrackCandidatesChunks *
+                     process.initialStepTrackCandidatesNoCleaning *
+                     process.initialStepTrackCandidatesNoCleaningChunks *
+                     process.dumper)
@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+# Compares, event by event, the track candidates written by ckfSeedChunks_cfg.py
+# with seedChunkSize 0 and > 0.
+#
+# Without seed cleaning (RedundantSeedCleaner 'none', maxSeedsBeforeCleaning 0)
+# the seeds are independent, and the chunks are merged in seed order: the
+# candidates must be the same, in the same order.
+#
+# With seed cleaning they can differ a little: a seed can be dropped in its
+# chunk because of the trajectory of an earlier seed of the chunk, which is
+# itself dropped when the chunks are merged (the serial loop would have built
+# it), and the cleaning after maxSeedsBeforeCleaning seeds is done per chunk.
+# Most candidates must be common.
+# Usage: compareCkfSeedChunks.py <dump file>
+from __future__ import print_function
+import sys
+from collections import Counter, defaultdict
+
+minCommonFraction = 0.9
+
+candidates = defaultdict(list)
+for line in open(sys.argv[1]):
+    fields = line.split()
+    candidates[(fields[0], fields[1])].append(" ".join(fields[2:]))
+events = sorted(set(event for event, label in candidates), key=int)
+
+errors = []
+def compare(reference, chunked, identical):
+    nRef = nChunked = nCommon = 0
+    for event in events:
+        ref = candidates[(event, reference)]
+        new = candidates[(event, chunked)]
+        if identical and ref != new:
+            errors.append("event %s: %s and %s differ" % (event, reference, chunked))
+        nRef += len(ref)
+        nChunked += len(new)
+        nCommon += sum((Counter(ref) & Counter(new)).values())
+    print("%s: %d candidates, %s: %d, %d in common" % (reference, nRef, chunked, nChunked, nCommon))
+    if nRef == 0:
+        errors.append("no candidate in %s" % reference)
+    elif nCommon < minCommonFraction * max(nRef, nChunked):
+        errors.append("only %d candidates in common between %s and %s" % (nCommon, reference, chunked))
+
+compare("initialStepTrackCandidatesNoCleaning", "initialStepTrackCandidatesNoCleaningChunks", True)
+compare("initialStepTrackCandidates", "initialStepTrackCandidatesChunks", False)
+for e in errors:
+    print(e)
+sys.exit(1 if errors else 0)
@@ -0,0 +1,15 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsDriver.py TTbar_13TeV_TuneCUETP8M1_cfi --conditions auto:phase1_2017_realistic --era Run2_2017 -n 3 -s GEN,SIM,DIGI:pdigi_valid,L1,DIGI2RAW --eventcontent FEVTDEBUG --datatier GEN-SIM-DIGI-RAW --beamspot NominalCollision2015 --fileout ckfSeedChunksInput.root || die 'Failure running cmsDriver' $?
+
+# the chunked collections must not depend on the number of threads
+cmsRun ${LOCAL_TEST_DIR}/ckfSeedChunks_cfg.py nThreads=1 dumpFile=ckfSeedChunks_1.txt || die 'Failure using ckfSeedChunks_cfg.py with 1 thread' $?
+cmsRun ${LOCAL_TEST_DIR}/ckfSeedChunks_cfg.py nThreads=4 dumpFile=ckfSeedChunks_4.txt || die 'Failure using ckfSeedChunks_cfg.py with 4 threads' $?
+cmp ckfSeedChunks_1.txt ckfSeedChunks_4.txt || die 'Different track candidates with 1 and 4 threads' $?
+cmsRun ${LOCAL_TEST_DIR}/ckfSeedChunks_cfg.py nThreads=4 seedChunkSize=1 dumpFile=ckfSeedChunks_4_size1.txt || die 'Failure using ckfSeedChunks_cfg.py with chunks of one seed' $?
+
+# seedChunkSize 0 against > 0
+python ${LOCAL_TEST_DIR}/compareCkfSeedChunks.py ckfSeedChunks_4.txt || die 'Failure comparing seedChunkSize 0 and 20' $?
+python ${LOCAL_TEST_DIR}/compareCkfSeedChunks.py ckfSeedChunks_4_size1.txt || die 'Failure comparing seedChunkSize 0 and 1' $?
@@ -0,0 +1,42 @@
+#ifndef RecoTracker_FinalTrackSelectors_BatchGBRForest_h
+#define RecoTracker_FinalTrackSelectors_BatchGBRForest_h
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+
+#include <vector>
+
+/** A GBRForest flattened in a few contiguous arrays, all the trees one
+ *  after the other, evaluated for many rows of features at once:
+ *  each tree is walked for a block of rows in lock step before moving
+ *  to the next one, so that a tree stays in cache for the whole block.
+ *
+ *  The responses of the trees are summed in the same order as in
+ *  GBRForest, so the result is the same as GBRForest::GetClassifier,
+ *  up to the rounding of the final exp when it is vectorized.
+ */
+class BatchGBRForest {
+public:
+  BatchGBRForest() {}
+  explicit BatchGBRForest(const GBRForest & forest) { set(forest); }
+
+  void set(const GBRForest & forest);
+  bool empty() const { return theRoots.empty(); }
+
+  /// GBRForest::GetClassifier of each of the nRows rows of nVars features,
+  /// the rows being stored one after the other in features
+  void classify(const float * features, unsigned int nRows, unsigned int nVars, float * result) const;
+
+private:
+  static constexpr unsigned int BlockSize = 32;
+
+  double theInitialResponse = 0;
+  std::vector<int> theRoots;                  // first node of each tree
+  // the children of a node are the index of a node if >=0, or -(index of a leaf)-1
+  std::vector<unsigned char> theCutIndices;
+  std::vector<float> theCutVals;
+  std::vector<int> theLeftIndices;
+  std::vector<int> theRightIndices;
+  std::vector<float> theResponses;
+};
+
+#endif
@@ -2,12 +2,15 @@
 
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
 #include "CondFormats/DataRecord/interface/GBRWrapperRcd.h"
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include <limits>
 
+#include "RecoTracker/FinalTrackSelectors/interface/BatchGBRForest.h"
+
 #include "getBestVertex.h"
 
 #include "TFile.h"
@@ -16,16 +19,20 @@ namespace {
   
 template<bool PROMPT>
 struct mva {
+  static constexpr unsigned int nVars = PROMPT ? 16 : 12;
+
   mva(const edm::ParameterSet &cfg):
     forestLabel_    ( cfg.getParameter<std::string>("GBRForestLabel") ),
     dbFileName_     ( cfg.getParameter<std::string>("GBRForestFileName") ),
-    useForestFromDB_( (!forestLabel_.empty()) & dbFileName_.empty())
+    useForestFromDB_( (!forestLabel_.empty()) & dbFileName_.empty()),
+    batchEvaluation_( cfg.getParameter<bool>("batchEvaluation") )
   {}
 
   void beginStream() {
     if(!dbFileName_.empty()){
       TFile gbrfile(dbFileName_.c_str());
       forestFromFile_.reset((GBRForest*)gbrfile.Get(forestLabel_.c_str()));
+      if (batchEvaluation_) batchForest_.set(*forestFromFile_);
     }
   }
 
@@ -35,12 +42,40 @@ struct mva {
       edm::ESHandle<GBRForest> forestHandle;
       es.get<GBRWrapperRcd>().get(forestLabel_,forestHandle);
       forest_ = forestHandle.product();
+      // flatten the forest again only when it changes
+      if (batchEvaluation_ && forestWatcher_.check(es)) batchForest_.set(*forest_);
     }
   }
 
   float operator()(reco::Track const & trk,
 		   reco::BeamSpot const & beamSpot,
 		   reco::VertexCollection const & vertices) const {
+    float gbrVals_[nVars];
+    fillVariables(trk,beamSpot,vertices,gbrVals_);
+    return forest_->GetClassifier(gbrVals_);
+  }
+
+  // all the tracks at once: the variables of all the tracks are gathered
+  // in one matrix, a row per track, and given to the flattened forest
+  void operator()(reco::TrackCollection const & tracks,
+		  reco::BeamSpot const & beamSpot,
+		  reco::VertexCollection const & vertices,
+		  std::vector<float> & mvas) const {
+    if (!batchEvaluation_) {
+      size_t current = 0;
+      for (auto const & trk : tracks) mvas[current++] = (*this)(trk,beamSpot,vertices);
+      return;
+    }
+    const unsigned int nTracks = tracks.size();
+    variables_.resize(nTracks*nVars);
+    for (unsigned int i=0; i<nTracks; ++i) fillVariables(tracks[i],beamSpot,vertices,&variables_[i*nVars]);
+    batchForest_.classify(variables_.data(),nTracks,nVars,mvas.data());
+  }
+
+  void fillVariables(reco::Track const & trk,
+		     reco::BeamSpot const & beamSpot,
+		     reco::VertexCollection const & vertices,
+		     float * gbrVals_) const {
 
     auto tmva_pt_ = trk.pt();
     auto tmva_ndof_ = trk.ndof();
@@ -72,7 +107,6 @@ struct mva {
     auto tmva_minlost_ = std::min(lostIn,lostOut);
     auto tmva_lostmidfrac_ = static_cast<float>(trk.numberOfLostHits()) / static_cast<float>(trk.numberOfValidHits() + trk.numberOfLostHits());
    
-    float gbrVals_[PROMPT ? 16 : 12];
     gbrVals_[0] = tmva_pt_;
     gbrVals_[1] = tmva_lostmidfrac_;
     gbrVals_[2] = tmva_minlost_;
@@ -98,11 +132,6 @@ struct mva {
       gbrVals_[14] = tmva_absdz_;
       gbrVals_[15] = tmva_absd0_;
     }
-
- 
-
-    return forest_->GetClassifier(gbrVals_);
-    
   }
 
   static const char * name();
@@ -110,6 +139,7 @@ struct mva {
   static void fillDescriptions(edm::ParameterSetDescription & desc) {
     desc.add<std::string>("GBRForestLabel",std::string());
     desc.add<std::string>("GBRForestFileName",std::string());
+    desc.add<bool>("batchEvaluation",true);
   }
   
   std::unique_ptr<GBRForest> forestFromFile_;
@@ -117,6 +147,11 @@ struct mva {
   const std::string forestLabel_;
   const std::string dbFileName_;
   const bool useForestFromDB_;
+  const bool batchEvaluation_;
+
+  BatchGBRForest batchForest_;
+  edm::ESWatcher<GBRWrapperRcd> forestWatcher_;
+  mutable std::vector<float> variables_;  // a stream module: not shared between threads
 };
 
   using TrackMVAClassifierDetached = TrackMVAClassifier<mva<false>>;
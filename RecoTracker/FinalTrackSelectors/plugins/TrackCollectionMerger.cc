@@ -18,6 +18,7 @@
 #include "DataFormats/TrackReco/interface/TrackExtra.h"
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
 #include "TrackingTools/PatternTools/interface/TrajTrackAssociation.h"
+#include "TrackingTools/TrajectoryCleaning/interface/SharedHitIndex.h"
 
 #include "RecoTracker/FinalTrackSelectors/interface/TrackAlgoPriorityOrder.h"
 #include "RecoTracker/Record/interface/CkfComponentsRecord.h"
@@ -79,9 +80,6 @@ namespace {
     using MVACollection = std::vector<float>;
     using QualityMaskCollection = std::vector<unsigned char>;
     
-    using IHit = std::pair<unsigned int, TrackingRecHit const *>;
-    using IHitV = std::vector<IHit>;
-    
     std::vector<edm::EDGetTokenT<MVACollection>> srcMVAs;
     std::vector<edm::EDGetTokenT<QualityMaskCollection>> srcQuals;
 	
@@ -98,7 +96,7 @@ namespace {
     void produce(edm::StreamID, edm::Event& evt, const edm::EventSetup&) const override;
     
 
-    bool areDuplicate(IHitV const& rh1, IHitV const& rh2) const;
+    bool areDuplicate(SharedHitIndex const& hitIndex, unsigned int t1, unsigned int t2) const;
       
 
   };
@@ -172,7 +170,7 @@ namespace {
       // load momentum, hits and score
       declareDynArray(reco::TrackBase::Vector,ntotTk,mom);
       declareDynArray(float,ntotTk,score);
-      declareDynArray(IHitV, ntotTk, rh1);
+      SharedHitIndex hitIndex;
       
       k=0U;
       for (auto i=0U; i< collsSize; ++i) {
@@ -188,21 +186,19 @@ namespace {
 	  auto lostHits=track.numberOfLostHits();
 	  score[k] = m_foundHitBonus*validPixelHits+m_foundHitBonus*validHits - m_lostHitPenalty*lostHits - track.chi2();
 	  
-	  auto & rhv =  rh1[k];
-	  rhv.reserve(validHits) ;
-	  auto compById = [](IHit const &  h1, IHit const & h2) {return h1.first < h2.first;};
+	  hitIndex.newTrack();
 	  for (auto it = track.recHitsBegin();  it != track.recHitsEnd(); ++it) {
 	    auto const & hit = *(*it);
 	    auto id = hit.rawId() ;
-	    if LIKELY(hit.isValid()) { rhv.emplace_back(id,&hit); std::push_heap(rhv.begin(),rhv.end(),compById); }
+	    if LIKELY(hit.isValid()) hitIndex.addHit(id,&hit);
 	  }
-	  std::sort_heap(rhv.begin(),rhv.end(),compById);
 	  
 	  
 	  ++k;
 	}
       }
       assert(ntotTk==k);
+      hitIndex.build();
       
       auto seti = [&](unsigned int ii, unsigned int jj) {
 	selected[jj]=false;
@@ -216,6 +212,7 @@ namespace {
 
 
 
+      std::vector<unsigned int> sharing;
       auto iStart2=0U;
       for (auto i=0U; i<collsSize-1; ++i) {
 	auto iStart1=iStart2;
@@ -223,11 +220,14 @@ namespace {
 	for (auto t1=iStart1; t1<iStart2; ++t1) {
 	  if (!selected[t1]) continue;
 	  auto score1 = score[t1];
-	  for (auto t2=iStart2; t2 <ntotTk; ++t2) {
+	  // the tracks without any hit on the same module cannot be duplicates
+	  hitIndex.sharingTracks(t1, sharing);
+	  for (auto t2 : sharing) {
+	    if (t2<iStart2) continue;
 	    if (!selected[t1]) break;
 	    if (!selected[t2]) continue;
             if (mom[t1].Dot(mom[t2])<0) continue; // do not bother if in opposite hemespheres...
-	    if (!areDuplicate(rh1[t1],rh1[t2])) continue;
+	    if (!areDuplicate(hitIndex,t1,t2)) continue;
 	    auto score2 = score[t2];
 
 	    constexpr float almostSame = 0.01f; // difference rather than ratio due to possible negative values for score
@@ -308,9 +308,11 @@ namespace {
 
 
 
-  bool TrackCollectionMerger::areDuplicate(IHitV const& rh1, IHitV const& rh2) const {
-    auto nh1=rh1.size();
-    auto nh2=rh2.size();
+  bool TrackCollectionMerger::areDuplicate(SharedHitIndex const& hitIndex, unsigned int t1, unsigned int t2) const {
+    auto nh1=hitIndex.nHits(t1);
+    auto nh2=hitIndex.nHits(t2);
+    auto const * rh1 = hitIndex.hits(t1);
+    auto const * rh2 = hitIndex.hits(t2);
 
     auto share =
       [](const TrackingRecHit*  it,const TrackingRecHit*  jt)->bool { return it->sharesInput(jt,TrackingRecHit::some); };
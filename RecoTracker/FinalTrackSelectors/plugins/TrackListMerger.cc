@@ -27,6 +27,7 @@
 #include "RecoTracker/Record/interface/CkfComponentsRecord.h"
 #include "TrackingTools/PatternTools/interface/TrajTrackAssociation.h"
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
+#include "TrackingTools/TrajectoryCleaning/interface/SharedHitIndex.h"
 
 class dso_hidden TrackListMerger : public edm::stream::EDProducer<>
   {
@@ -431,8 +432,8 @@ TrackListMerger::~TrackListMerger() { }
     statCount.pre(ngood);
 
     //cache the id and rechits of valid hits
-    typedef std::pair<unsigned int, const TrackingRecHit*> IHit;
-    std::vector<std::vector<IHit>> rh1(ngood);  // "not an array" of vectors!
+    SharedHitIndex hitIndex;
+    int goodTracks[ngood];
     //const TrackingRecHit*  fh1[ngood];  // first hit...
     reco::TrackBase::TrackAlgorithm algo[ngood];
     float score[ngood];
@@ -442,6 +443,7 @@ TrackListMerger::~TrackListMerger() { }
       if (selected[j]==0) continue;
       int i = indexG[j];
       assert(i>=0);
+      goodTracks[i]=j;
       unsigned int collNum=trackCollNum[j];
       unsigned int trackNum=j-trackCollFirsts[collNum];
       const reco::Track *track=&((trackColls[collNum])->at(trackNum));
@@ -453,16 +455,14 @@ TrackListMerger::~TrackListMerger() { }
       score[i] = foundHitBonus_*validPixelHits+foundHitBonus_*validHits - lostHitPenalty_*lostHits - track->chi2();
 
 
-      rh1[i].reserve(validHits) ;
-      auto compById = [](IHit const &  h1, IHit const & h2) {return h1.first < h2.first;};
+      auto k = hitIndex.newTrack();
+      assert(int(k)==i);
       for (trackingRecHit_iterator it = track->recHitsBegin();  it != track->recHitsEnd(); ++it) {
 	const TrackingRecHit* hit = (*it);
-	unsigned int id = hit->rawId() ;
-	if(hit->geographicalId().subdetId()>2)  id &= (~3); // mask mono/stereo in strips...
-	if LIKELY(hit->isValid()) { rh1[i].emplace_back(id,hit); std::push_heap(rh1[i].begin(),rh1[i].end(),compById); }
+	if LIKELY(hit->isValid()) hitIndex.addHit(SharedHitIndex::gluedId(*hit), hit); // mask mono/stereo in strips...
       }
-      std::sort_heap(rh1[i].begin(),rh1[i].end(),compById);
     }
+    hitIndex.build();
 
     //DL here
     if LIKELY(ngood>1 && collsSize>1)
@@ -474,6 +474,7 @@ TrackListMerger::~TrackListMerger() { }
 
       for ( unsigned int i=0; i<rSize; i++) saveSelected[i]=selected[i];
 
+      std::vector<unsigned int> sharing;
       //DL protect against 0 tracks?
       for ( unsigned int i=0; i<rSize-1; i++) {
 	if (selected[i]==0) continue;
@@ -483,21 +484,23 @@ TrackListMerger::~TrackListMerger() { }
 	if (notActive[collNum]) continue;
 
 	int k1 = indexG[i];
-	unsigned int nh1=rh1[k1].size();
+	unsigned int nh1=hitIndex.nHits(k1);
 	int qualityMaskT1 = trackQuals[i];
 
 	int nhit1 = nh1; // validHits[k1];
 	float score1 = score[k1];
 
-	// start at next collection
-	for ( unsigned int j=i+1; j<rSize; j++) {
+	// only the tracks with at least a hit on the same module can be duplicates:
+	// the others are not even looked at
+	hitIndex.sharingTracks(k1, sharing);
+	for ( int k2 : sharing) {
+	  unsigned int j = goodTracks[k2];
 	  if (selected[j]==0) continue;
 	  unsigned int collNum2=trackCollNum[j];
 	  if ( (collNum == collNum2) && indivShareFrac_[collNum] > 0.99) continue;
 	  //check that this track is in one of the lists for this iteration
 	  if (notActive[collNum2]) continue;
 
-	  int k2 = indexG[j];
 
 	  int newQualityMask = -9; //avoid resetting quality mask if not desired 10+ -9 =1
 	  if (promoteQuality_[ltm]) {
@@ -505,7 +508,7 @@ TrackListMerger::~TrackListMerger() { }
 	    int maskT2= saveSelected[j]>1? saveSelected[j]-10 : trackQuals[j];
 	    newQualityMask =(maskT1 | maskT2); // take OR of trackQuality
 	  }
-	  unsigned int nh2=rh1[k2].size();
+	  unsigned int nh2=hitIndex.nHits(k2);
 	  int nhit2 = nh2;
 
 
@@ -519,41 +522,19 @@ TrackListMerger::~TrackListMerger() { }
 	  statCount.start();
 
 	  //loop over rechits
-	  int noverlap=0;
 	  int firstoverlap=0;
 	  // check first hit  (should use REAL first hit?)
-	  if UNLIKELY(allowFirstHitShare_ && rh1[k1][0].first==rh1[k2][0].first ) {
-	      const TrackingRecHit*  it = rh1[k1][0].second;
-	      const TrackingRecHit*  jt = rh1[k2][0].second;
+	  auto const * rh1 = hitIndex.hits(k1);
+	  auto const * rh2 = hitIndex.hits(k2);
+	  if UNLIKELY(allowFirstHitShare_ && rh1[0].first==rh2[0].first ) {
+	      const TrackingRecHit*  it = rh1[0].second;
+	      const TrackingRecHit*  jt = rh2[0].second;
 	      if (share(it,jt,epsilon_)) firstoverlap=1;
 	    }
 
 
-	  // exploit sorting
-	  unsigned int jh=0;
-	  unsigned int ih=0;
-	  while (ih!=nh1 && jh!=nh2) {
-	    // break if not enough to go...
-	    // if ( nprecut-noverlap+firstoverlap > int(nh1-ih)) break;
-	    // if ( nprecut-noverlap+firstoverlap > int(nh2-jh)) break;
-	    auto const id1 = rh1[k1][ih].first;
-	    auto const id2 = rh1[k2][jh].first;
-	    if (id1<id2) ++ih;
-	    else if (id2<id1) ++jh;
-	    else {
-	      // in case of split-hit do full conbinatorics
-	      auto li=ih; while( (++li)!=nh1 && id1 == rh1[k1][li].first);
-	      auto lj=jh; while( (++lj)!=nh2 && id2 == rh1[k2][lj].first);
-	      for (auto ii=ih; ii!=li; ++ii)
-		for (auto jj=jh; jj!=lj; ++jj) {
-		  const TrackingRecHit*  it = rh1[k1][ii].second;
-		  const TrackingRecHit*  jt = rh1[k2][jj].second;
-		  if (share(it,jt,epsilon_))  noverlap++;
-		}
-	      jh=lj; ih=li;
-	    } // equal ids
-
-	  } //loop over ih & jh
+	  // exploit sorting, in case of split-hit do full conbinatorics
+	  int noverlap = hitIndex.sharedHits(k1, k2, [&](const TrackingRecHit* it, const TrackingRecHit* jt) { return share(it,jt,epsilon_); });
 
 	  bool dupfound = (collNum != collNum2) ? (noverlap-firstoverlap) > (std::min(nhit1,nhit2)-firstoverlap)*shareFrac_ :
 	    (noverlap-firstoverlap) > (std::min(nhit1,nhit2)-firstoverlap)*indivShareFrac_[collNum];
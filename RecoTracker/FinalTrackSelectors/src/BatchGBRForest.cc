@@ -0,0 +1,52 @@
+#include "RecoTracker/FinalTrackSelectors/interface/BatchGBRForest.h"
+
+#include <algorithm>
+#include <cmath>
+
+void BatchGBRForest::set(const GBRForest & forest) {
+  theInitialResponse = forest.InitialResponse();
+  theRoots.clear();
+  theCutIndices.clear(); theCutVals.clear();
+  theLeftIndices.clear(); theRightIndices.clear();
+  theResponses.clear();
+
+  for (auto const & tree : forest.Trees()) {
+    const int firstNode = theCutIndices.size();
+    const int firstLeaf = theResponses.size();
+    // in GBRTree a child >0 is a node, and a child <=0 the leaf -child
+    auto child = [&](int c) { return c>0 ? firstNode+c : -(firstLeaf-c)-1; };
+    theRoots.push_back(firstNode);
+    theCutIndices.insert(theCutIndices.end(), tree.CutIndices().begin(), tree.CutIndices().end());
+    theCutVals.insert(theCutVals.end(), tree.CutVals().begin(), tree.CutVals().end());
+    for (auto c : tree.LeftIndices()) theLeftIndices.push_back(child(c));
+    for (auto c : tree.RightIndices()) theRightIndices.push_back(child(c));
+    theResponses.insert(theResponses.end(), tree.Responses().begin(), tree.Responses().end());
+  }
+}
+
+void BatchGBRForest::classify(const float * features, unsigned int nRows, unsigned int nVars, float * result) const {
+  double response[BlockSize];
+  int node[BlockSize];
+  for (unsigned int first=0; first<nRows; first+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, nRows-first);
+    const float * rows = features + first*nVars;
+    for (unsigned int l=0; l<n; ++l) response[l] = theInitialResponse;
+    for (auto root : theRoots) {
+      for (unsigned int l=0; l<n; ++l) node[l] = root;
+      // the root is never a leaf: walk down all the rows until they have all reached a leaf
+      bool active = true;
+      while (active) {
+        active = false;
+        for (unsigned int l=0; l<n; ++l) {
+          const int k = node[l];
+          if (k<0) continue;
+          const int next = rows[l*nVars+theCutIndices[k]] > theCutVals[k] ? theRightIndices[k] : theLeftIndices[k];
+          node[l] = next;
+          active |= next>=0;
+        }
+      }
+      for (unsigned int l=0; l<n; ++l) response[l] += theResponses[-node[l]-1];
+    }
+    for (unsigned int l=0; l<n; ++l) result[first+l] = 2.0/(1.0+std::exp(-2.0*response[l]))-1;
+  }
+}
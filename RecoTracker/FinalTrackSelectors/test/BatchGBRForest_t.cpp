@@ -0,0 +1,62 @@
+#include "RecoTracker/FinalTrackSelectors/interface/BatchGBRForest.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// compare the flattened forest with GBRForest::GetClassifier on random trees
+
+namespace {
+  std::mt19937 rng(1234);
+
+  // a random tree of depth up to maxDepth, with the GBRTree conventions:
+  // a child >0 is a node, and a child <=0 the leaf -child
+  int addNode(GBRTree & tree, unsigned int nVars, int depth, int maxDepth) {
+    std::uniform_real_distribution<float> val(-1.f,1.f);
+    if (depth==maxDepth || (depth>0 && rng()%4==0)) {
+      tree.Responses().push_back(val(rng));
+      return 1-int(tree.Responses().size());
+    }
+    int k = tree.CutIndices().size();
+    tree.CutIndices().push_back(rng()%nVars);
+    tree.CutVals().push_back(val(rng));
+    tree.LeftIndices().push_back(0);
+    tree.RightIndices().push_back(0);
+    int left = addNode(tree, nVars, depth+1, maxDepth);
+    tree.LeftIndices()[k] = left;
+    int right = addNode(tree, nVars, depth+1, maxDepth);
+    tree.RightIndices()[k] = right;
+    return k;
+  }
+}
+
+int main() {
+  constexpr unsigned int nVars = 16;
+  GBRForest forest;
+  forest.SetInitialResponse(0.1);
+  for (int t=0; t!=200; ++t) {
+    forest.Trees().emplace_back();
+    addNode(forest.Trees().back(), nVars, 0, 1+t%8);
+  }
+
+  constexpr unsigned int nRows = 1000;  // not a multiple of the block size
+  std::uniform_real_distribution<float> val(-1.2f,1.2f);
+  std::vector<float> features(nRows*nVars);
+  for (auto & f : features) f = val(rng);
+
+  BatchGBRForest batch(forest);
+  std::vector<float> result(nRows);
+  batch.classify(features.data(), nRows, nVars, result.data());
+
+  int failures = 0;
+  for (unsigned int i=0; i!=nRows; ++i) {
+    float expected = forest.GetClassifier(&features[i*nVars]);
+    if (std::abs(result[i]-expected) > 1.e-6f) {
+      ++failures;
+      std::cout << "row " << i << ": " << result[i] << " instead of " << expected << std::endl;
+    }
+  }
+  std::cout << nRows << " rows compared, " << failures << " failures" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
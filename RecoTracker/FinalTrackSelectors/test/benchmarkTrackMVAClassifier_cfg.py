@@ -0,0 +1,44 @@
+# Timing of the track MVA classifiers, one track at a time or in batch,
+# on the tracks stored in a RECO file:
+#   cmsRun benchmarkTrackMVAClassifier_cfg.py inputFiles=file:reco.root
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing('analysis')
+options.register('globalTag', 'auto:run2_mc', VarParsing.multiplicity.singleton, VarParsing.varType.string, "global tag")
+options.register('repeat', 10, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of copies of each classifier")
+options.parseArguments()
+
+process = cms.Process("BENCH")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring(options.inputFiles))
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+process.Timing = cms.Service("Timing", summaryOnly = cms.untracked.bool(True))
+
+from RecoTracker.FinalTrackSelectors.TrackMVAClassifierPrompt_cfi import TrackMVAClassifierPrompt
+from RecoTracker.FinalTrackSelectors.TrackMVAClassifierDetached_cfi import TrackMVAClassifierDetached
+
+process.benchmark = cms.Sequence()
+for batch in (False, True):
+    mode = "Batch" if batch else "Single"
+    for i in range(options.repeat):
+        prompt = TrackMVAClassifierPrompt.clone(src = 'generalTracks')
+        prompt.mva.GBRForestLabel = 'MVASelectorIter0_13TeV'
+        prompt.mva.batchEvaluation = batch
+        detached = TrackMVAClassifierDetached.clone(src = 'generalTracks')
+        detached.mva.GBRForestLabel = 'MVASelectorIter3_13TeV'
+        detached.mva.batchEvaluation = batch
+        setattr(process, "prompt%s%d" % (mode, i), prompt)
+        setattr(process, "detached%s%d" % (mode, i), detached)
+        process.benchmark += prompt + detached
+
+process.p = cms.Path(process.benchmark)
@@ -27,9 +27,10 @@ public:
                            const std::vector<bool> & pixelClustersToSkip,
                            const std::vector<bool> & phase2OTClustersToSkip):
          theTracker(&tracker), theStripData(strips), thePixelData(pixels), thePhase2OTData(phase2OT), theOwner(true),
-         theStripClustersToSkip(stripClustersToSkip), thePixelClustersToSkip(pixelClustersToSkip), thePhase2OTClustersToSkip(phase2OTClustersToSkip) {}
+         theOwnStripClustersToSkip(stripClustersToSkip), theOwnPixelClustersToSkip(pixelClustersToSkip), theOwnPhase2OTClustersToSkip(phase2OTClustersToSkip) {}
 
-   /// Real constructor 2: with new cluster skips (checked)
+   /// Real constructor 2: with new cluster skips (checked).
+   /// The skips are not copied: the masks must live as long as this object, as the products of the same event do
    MeasurementTrackerEvent(const MeasurementTrackerEvent &trackerEvent,
                            const edm::ContainerMask<edmNew::DetSetVector<SiStripCluster> > & stripClustersToSkip,
                            const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > & pixelClustersToSkip) ;
@@ -49,9 +50,9 @@ public:
    const StMeasurementDetSet & stripData() const { return * theStripData; }
    const PxMeasurementDetSet & pixelData() const { return * thePixelData; }
    const Phase2OTMeasurementDetSet & phase2OTData() const { return * thePhase2OTData; }
-   const std::vector<bool> & stripClustersToSkip() const { return theStripClustersToSkip; }
-   const std::vector<bool> & pixelClustersToSkip() const { return thePixelClustersToSkip; }
-   const std::vector<bool> & phase2OTClustersToSkip() const { return thePhase2OTClustersToSkip; }
+   const std::vector<bool> & stripClustersToSkip() const { return *theStripClustersToSkip; }
+   const std::vector<bool> & pixelClustersToSkip() const { return *thePixelClustersToSkip; }
+   const std::vector<bool> & phase2OTClustersToSkip() const { return *thePhase2OTClustersToSkip; }
 
    // forwarded calls
    const TrackingGeometry* geomTracker() const { return measurementTracker().geomTracker(); }
@@ -66,10 +67,16 @@ private:
    const PxMeasurementDetSet *thePixelData=nullptr;
    const Phase2OTMeasurementDetSet *thePhase2OTData=nullptr;
    bool  theOwner=false; // do I own the tree above?
-   // these  could be const pointers as well, but ContainerMask doesn't expose the vector
-   std::vector<bool> theStripClustersToSkip;
-   std::vector<bool> thePixelClustersToSkip;
-   std::vector<bool> thePhase2OTClustersToSkip;
+   // the skips in use: either the ones below, or the vectors of the ContainerMasks of a masked event,
+   // so that all the iterations share the same tracker data and no one copies the masks
+   const std::vector<bool> * theStripClustersToSkip=&theOwnStripClustersToSkip;
+   const std::vector<bool> * thePixelClustersToSkip=&theOwnPixelClustersToSkip;
+   const std::vector<bool> * thePhase2OTClustersToSkip=&theOwnPhase2OTClustersToSkip;
+   std::vector<bool> theOwnStripClustersToSkip;
+   std::vector<bool> theOwnPixelClustersToSkip;
+   std::vector<bool> theOwnPhase2OTClustersToSkip;
+
+   void moveSkipsFrom(MeasurementTrackerEvent & other);
 };
 
 #endif // MeasurementTrackerEvent_H
@@ -17,8 +17,7 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(MeasurementTrackerEvent && othe
   thePhase2OTData = std::move(other.thePhase2OTData);
   theOwner = other.theOwner;
   other.theOwner = false; // make sure to fully transfer the ownership
-  theStripClustersToSkip = std::move(other.theStripClustersToSkip);
-  thePixelClustersToSkip = std::move(other.thePixelClustersToSkip);
+  moveSkipsFrom(other);
 }
 MeasurementTrackerEvent& MeasurementTrackerEvent::operator=(MeasurementTrackerEvent && other) {
   theTracker = std::move(other.theTracker);
@@ -27,11 +26,23 @@ MeasurementTrackerEvent& MeasurementTrackerEvent::operator=(MeasurementTrackerEv
   thePhase2OTData = std::move(other.thePhase2OTData);
   theOwner = other.theOwner;
   other.theOwner = false; // make sure to fully transfer the ownership
-  theStripClustersToSkip = std::move(other.theStripClustersToSkip);
-  thePixelClustersToSkip = std::move(other.thePixelClustersToSkip);
+  moveSkipsFrom(other);
   return *this;
 }
 
+void MeasurementTrackerEvent::moveSkipsFrom(MeasurementTrackerEvent & other) {
+  // a skip pointing to the own vector of other has to point to ours after the move
+  auto move = [](const std::vector<bool> * & skip, std::vector<bool> & own,
+                 const std::vector<bool> * & otherSkip, std::vector<bool> & otherOwn) {
+    skip = (otherSkip == &otherOwn) ? &own : otherSkip;
+    own = std::move(otherOwn);
+    otherSkip = &otherOwn;
+  };
+  move(theStripClustersToSkip, theOwnStripClustersToSkip, other.theStripClustersToSkip, other.theOwnStripClustersToSkip);
+  move(thePixelClustersToSkip, theOwnPixelClustersToSkip, other.thePixelClustersToSkip, other.theOwnPixelClustersToSkip);
+  move(thePhase2OTClustersToSkip, theOwnPhase2OTClustersToSkip, other.thePhase2OTClustersToSkip, other.theOwnPhase2OTClustersToSkip);
+}
+
 MeasurementTrackerEvent::MeasurementTrackerEvent(const MeasurementTrackerEvent &trackerEvent,
                            const edm::ContainerMask<edmNew::DetSetVector<SiStripCluster> > & stripClustersToSkip,
                            const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > & pixelClustersToSkip) :
@@ -52,11 +63,8 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(const MeasurementTrackerEvent &
         throw cms::Exception("Configuration")<<"The pixel masking does not point to the proper collection of clusters: "<<pixelClustersToSkip.refProd().id()<<"!="<<thePixelData->handle().id()<<"\n";
     }
 
-    theStripClustersToSkip.resize(stripClustersToSkip.size());
-    stripClustersToSkip.copyMaskTo(theStripClustersToSkip);
-
-    thePixelClustersToSkip.resize(pixelClustersToSkip.size());
-    pixelClustersToSkip.copyMaskTo(thePixelClustersToSkip);
+    theStripClustersToSkip = &stripClustersToSkip.maskVector();
+    thePixelClustersToSkip = &pixelClustersToSkip.maskVector();
 }
 
 //FIXME:just temporary solution for phase2!
@@ -80,9 +88,6 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(const MeasurementTrackerEvent &
         throw cms::Exception("Configuration")<<"The pixel masking does not point to the proper collection of clusters: "<<pixelClustersToSkip.refProd().id()<<"!="<<thePixelData->handle().id()<<"\n";
     }
 
-    thePixelClustersToSkip.resize(pixelClustersToSkip.size());
-    pixelClustersToSkip.copyMaskTo(thePixelClustersToSkip);
-
-    thePhase2OTClustersToSkip.resize(phase2OTClustersToSkip.size());
-    phase2OTClustersToSkip.copyMaskTo(thePhase2OTClustersToSkip);
+    thePixelClustersToSkip = &pixelClustersToSkip.maskVector();
+    thePhase2OTClustersToSkip = &phase2OTClustersToSkip.maskVector();
 }
@@ -0,0 +1,234 @@
+// Checks the cluster skips of chained masked MeasurementTrackerEvents, which point
+// to the vectors of the ContainerMasks, against the copies that each masked event
+// used to make of its masks, for the strip and pixel masks and for the phase-2
+// pixel and outer tracker masks, after moving the events, and after a mask of the
+// wrong clusters.
+//
+// The masks are cumulative, as the cluster removers make them: each iteration ORs
+// the clusters it removes onto the mask of the previous iteration.
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/Provenance.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "RecoTracker/MeasurementDet/interface/MeasurementTrackerEvent.h"
+#include "RecoTracker/MeasurementDet/src/TkMeasurementDetSet.h"
+#include "TrackingTools/MeasurementDet/interface/MeasurementDetWithData.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // the events only keep a reference to the tracker, and take the conditions from it
+  class FakeMeasurementTracker final : public MeasurementTracker {
+  public:
+    FakeMeasurementTracker() : MeasurementTracker(nullptr, nullptr),
+      theStripConditions(nullptr, nullptr), thePixelConditions(nullptr), thePhase2OTConditions(nullptr) {}
+    MeasurementDetWithData idToDet(const DetId&, const MeasurementTrackerEvent&) const override { std::abort(); }
+    const StMeasurementConditionSet & stripDetConditions() const override { return theStripConditions; }
+    const PxMeasurementConditionSet & pixelDetConditions() const override { return thePixelConditions; }
+    const Phase2OTMeasurementConditionSet & phase2DetConditions() const override { return thePhase2OTConditions; }
+  private:
+    StMeasurementConditionSet theStripConditions;
+    PxMeasurementConditionSet thePixelConditions;
+    Phase2OTMeasurementConditionSet thePhase2OTConditions;
+  };
+
+  // the clusters of an event, with the handle the measurement data keep
+  template<typename T>
+  struct Clusters {
+    typedef edmNew::DetSetVector<T> Collection;
+    Clusters(unsigned int nDets, unsigned int nPerDet, unsigned short productIndex) :
+      provenance(std::make_shared<edm::BranchDescription const>(), edm::ProductID(1, productIndex)) {
+      for (unsigned int det = 0; det < nDets; ++det) {
+        typename Collection::FastFiller filler(clusters, det+1);
+        for (unsigned int i = 0; i < nPerDet; ++i) filler.push_back(T());
+      }
+      handle = edm::Handle<Collection>(&clusters, &provenance);
+    }
+    Clusters(const Clusters&) = delete;
+    Clusters& operator=(const Clusters&) = delete;
+
+    Collection clusters;
+    edm::Provenance provenance;
+    edm::Handle<Collection> handle;
+  };
+
+  template<typename T>
+  using Mask = edm::ContainerMask<edmNew::DetSetVector<T> >;
+
+  template<typename T>
+  std::vector<bool> randomSkips(const Clusters<T>& c, std::mt19937& engine) {
+    std::bernoulli_distribution skip(0.2);
+    std::vector<bool> skips(c.clusters.dataSize());
+    for (unsigned int i = 0; i < skips.size(); ++i) skips[i] = skip(engine);
+    return skips;
+  }
+
+  template<typename T>
+  std::vector<Mask<T> > makeMasks(const Clusters<T>& c, unsigned int nIterations, std::mt19937& engine) {
+    std::vector<Mask<T> > masks;
+    masks.reserve(nIterations);  // the events point to the masks, which must not move
+    for (unsigned int it = 0; it < nIterations; ++it) {
+      auto removed = randomSkips(c, engine);
+      if (!masks.empty()) masks.back().applyOrTo(removed);
+      masks.emplace_back(edm::RefProd<edmNew::DetSetVector<T> >(c.handle), removed);
+    }
+    return masks;
+  }
+
+  // what a masked event used to keep: its own copy of the mask
+  template<typename T>
+  std::vector<bool> oldCopy(const Mask<T>& mask) {
+    std::vector<bool> skips(mask.size());
+    for (unsigned int i = 0; i < skips.size(); ++i) skips[i] = mask.mask(i);
+    return skips;
+  }
+
+  int failures = 0;
+
+  void check(bool ok, const std::string& what) {
+    if (!ok) {
+      std::cout << "failed: " << what << std::endl;
+      ++failures;
+    }
+  }
+
+  const unsigned int nIterations = 8;
+
+  void testStripsAndPixels(std::mt19937& engine) {
+    FakeMeasurementTracker tracker;
+    Clusters<SiStripCluster> strips(50, 7, 1);
+    Clusters<SiPixelCluster> pixels(20, 5, 2);
+    const auto stripMasks = makeMasks(strips, nIterations, engine);
+    const auto pixelMasks = makeMasks(pixels, nIterations, engine);
+
+    auto stripData = new StMeasurementDetSet(tracker.stripDetConditions());
+    stripData->handle() = strips.handle;
+    auto pixelData = new PxMeasurementDetSet(tracker.pixelDetConditions());
+    pixelData->handle() = pixels.handle;
+    const auto stripSkips = randomSkips(strips, engine);
+    const auto pixelSkips = randomSkips(pixels, engine);
+    MeasurementTrackerEvent full(tracker, stripData, pixelData, nullptr, stripSkips, pixelSkips, std::vector<bool>());
+    check(full.stripClustersToSkip() == stripSkips && full.pixelClustersToSkip() == pixelSkips, "skips of the full event");
+
+    // each iteration masks the event of the previous one
+    std::vector<std::unique_ptr<MeasurementTrackerEvent> > chain;
+    const MeasurementTrackerEvent* previous = &full;
+    for (unsigned int it = 0; it < nIterations; ++it) {
+      chain.push_back(std::make_unique<MeasurementTrackerEvent>(*previous, stripMasks[it], pixelMasks[it]));
+      previous = chain.back().get();
+    }
+    for (unsigned int it = 0; it < nIterations; ++it) {
+      const std::string iteration = " of iteration " + std::to_string(it);
+      const auto& event = *chain[it];
+      check(event.stripClustersToSkip() == oldCopy(stripMasks[it]), "strip skips" + iteration);
+      check(event.pixelClustersToSkip() == oldCopy(pixelMasks[it]), "pixel skips" + iteration);
+      check(event.phase2OTClustersToSkip().empty(), "outer tracker skips" + iteration);
+      check(&event.stripClustersToSkip() == &stripMasks[it].maskVector() &&
+            &event.pixelClustersToSkip() == &pixelMasks[it].maskVector(), "skips" + iteration + " are not the masks");
+      check(&event.stripData() == stripData && &event.pixelData() == pixelData &&
+            &event.measurementTracker() == &tracker, "data" + iteration + " are not the ones of the full event");
+    }
+    std::vector<bool> copy;
+    stripMasks.back().copyMaskTo(copy);
+    check(copy == oldCopy(stripMasks.back()), "copyMaskTo");
+
+    // a masked event keeps pointing to the masks once moved
+    MeasurementTrackerEvent moved(std::move(*chain.back()));
+    check(&moved.stripClustersToSkip() == &stripMasks.back().maskVector() &&
+          &moved.pixelClustersToSkip() == &pixelMasks.back().maskVector(), "skips of a moved masked event");
+    MeasurementTrackerEvent assigned;
+    assigned = std::move(moved);
+    check(&assigned.stripClustersToSkip() == &stripMasks.back().maskVector() &&
+          &assigned.pixelClustersToSkip() == &pixelMasks.back().maskVector(), "skips of a move-assigned masked event");
+
+    // the full event moves its own skips along, and so does its data
+    MeasurementTrackerEvent movedFull(std::move(full));
+    check(movedFull.stripClustersToSkip() == stripSkips && movedFull.pixelClustersToSkip() == pixelSkips,
+          "skips of the moved full event");
+    check(full.stripClustersToSkip().empty() && full.pixelClustersToSkip().empty(),
+          "skips left in the moved-from full event");
+    MeasurementTrackerEvent assignedFull;
+    assignedFull = std::move(movedFull);
+    check(assignedFull.stripClustersToSkip() == stripSkips && assignedFull.pixelClustersToSkip() == pixelSkips,
+          "skips of the move-assigned full event");
+    check(&assignedFull.stripData() == stripData, "data of the move-assigned full event");
+    check(&assignedFull.stripClustersToSkip() != &movedFull.stripClustersToSkip(),
+          "skips of the move-assigned full event point to the moved-from one");
+    MeasurementTrackerEvent masked(assignedFull, stripMasks[0], pixelMasks[0]);
+    check(masked.stripClustersToSkip() == oldCopy(stripMasks[0]), "skips of an event masking a moved full event");
+
+    // a mask of other clusters is refused
+    Clusters<SiStripCluster> otherStrips(50, 7, 3);
+    const auto otherMasks = makeMasks(otherStrips, 1, engine);
+    bool thrown = false;
+    try {
+      MeasurementTrackerEvent wrong(assignedFull, otherMasks[0], pixelMasks[0]);
+    } catch (cms::Exception&) {
+      thrown = true;
+    }
+    check(thrown, "mask of other strip clusters");
+  }
+
+  void testPhase2(std::mt19937& engine) {
+    FakeMeasurementTracker tracker;
+    Clusters<SiPixelCluster> pixels(30, 5, 4);
+    Clusters<Phase2TrackerCluster1D> outer(60, 6, 5);
+    const auto pixelMasks = makeMasks(pixels, nIterations, engine);
+    const auto outerMasks = makeMasks(outer, nIterations, engine);
+
+    auto pixelData = new PxMeasurementDetSet(tracker.pixelDetConditions());
+    pixelData->handle() = pixels.handle;
+    auto outerData = new Phase2OTMeasurementDetSet(tracker.phase2DetConditions());
+    outerData->handle() = outer.handle;
+    const auto pixelSkips = randomSkips(pixels, engine);
+    const auto outerSkips = randomSkips(outer, engine);
+    MeasurementTrackerEvent full(tracker, nullptr, pixelData, outerData, std::vector<bool>(), pixelSkips, outerSkips);
+
+    std::vector<std::unique_ptr<MeasurementTrackerEvent> > chain;
+    const MeasurementTrackerEvent* previous = &full;
+    for (unsigned int it = 0; it < nIterations; ++it) {
+      chain.push_back(std::make_unique<MeasurementTrackerEvent>(*previous, pixelMasks[it], outerMasks[it]));
+      previous = chain.back().get();
+    }
+    for (unsigned int it = 0; it < nIterations; ++it) {
+      const std::string iteration = " of phase-2 iteration " + std::to_string(it);
+      const auto& event = *chain[it];
+      check(event.pixelClustersToSkip() == oldCopy(pixelMasks[it]), "pixel skips" + iteration);
+      check(event.phase2OTClustersToSkip() == oldCopy(outerMasks[it]), "outer tracker skips" + iteration);
+      check(event.stripClustersToSkip().empty(), "strip skips" + iteration);
+      check(&event.pixelData() == pixelData && &event.phase2OTData() == outerData,
+            "data" + iteration + " are not the ones of the full event");
+    }
+
+    // the outer tracker skips were dropped by the moves
+    MeasurementTrackerEvent moved(std::move(*chain.back()));
+    check(moved.phase2OTClustersToSkip() == oldCopy(outerMasks.back()), "outer tracker skips of a moved masked event");
+    MeasurementTrackerEvent movedFull(std::move(full));
+    check(movedFull.pixelClustersToSkip() == pixelSkips && movedFull.phase2OTClustersToSkip() == outerSkips,
+          "skips of the moved phase-2 full event");
+    MeasurementTrackerEvent assignedFull;
+    assignedFull = std::move(movedFull);
+    check(assignedFull.phase2OTClustersToSkip() == outerSkips, "outer tracker skips of the move-assigned phase-2 full event");
+    check(movedFull.phase2OTClustersToSkip().empty(), "outer tracker skips left in the moved-from phase-2 full event");
+  }
+}
+
+int main() {
+  std::mt19937 engine(4321);
+  for (unsigned int event = 0; event < 10; ++event) {
+    testStripsAndPixels(engine);
+    testPhase2(engine);
+  }
+  if (failures) {
+    std::cout << failures << " failures" << std::endl;
+    return 1;
+  }
+  return 0;
+}
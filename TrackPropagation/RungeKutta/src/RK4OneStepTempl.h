@@ -13,8 +13,9 @@ class dso_internal RK4OneStepTempl {
     typedef RKSmallVector<T,N>                  Vector;
 
   
+    template <typename Deriv>
     Vector operator()( Scalar startPar, const Vector& startState,
-		       const RKDerivative<T,N>& deriv, Scalar step) const {
+		       const Deriv& deriv, Scalar step) const {
 
  	// cout << "RK4OneStepTempl: starting from " << startPar << startState << endl;
 
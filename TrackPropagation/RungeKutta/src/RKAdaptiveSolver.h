@@ -20,7 +20,18 @@ public:
     Vector operator()( Scalar startPar, const Vector& startState,
 			       Scalar step, const RKDerivative<T,N>& deriv,
 			       const RKDistance<T,N>& dist,
-			       float eps) override;
+			       float eps) override {
+      return solve( startPar, startState, step, deriv, dist, eps);
+    }
+
+    /// Same as operator(), specialized at compile time for the derivative and
+    /// distance types: with final classes all the calls of the integration loop
+    /// are direct and can be inlined
+    template <typename Deriv, typename Dist>
+    Vector solve( Scalar startPar, const Vector& startState,
+		  Scalar step, const Deriv& deriv,
+		  const Dist& dist,
+		  float eps);
 
 };
 
@@ -2,9 +2,9 @@
 #define RKLocalFieldProvider_H
 
 #include "FWCore/Utilities/interface/Visibility.h"
+#include "FWCore/Utilities/interface/Likely.h"
 #include "DataFormats/GeometrySurface/interface/GloballyPositioned.h"
-
-class MagVolume;
+#include "MagneticField/VolumeGeometry/interface/MagVolume.h"
 
 class dso_internal RKLocalFieldProvider {
 public:
@@ -24,8 +24,15 @@ public:
     /// Local field access to the MagVolume field, transformed to the "frame" frame
     RKLocalFieldProvider( const MagVolume& vol, const Frame& frame);
 
-    /// the argument lp is in the local frame specified in the constructor
-    Vector inTesla( const LocalPoint& lp) const;
+    /// the argument lp is in the local frame specified in the constructor;
+    /// inline, since it is called at each stage of each Runge-Kutta step
+    Vector inTesla( const LocalPoint& lp) const {
+      if UNLIKELY(transform_) {
+	  LocalPoint vlp( theVolume.toLocal( theFrame.toGlobal( lp)));
+	  return theFrame.toLocal( theVolume.toGlobal( theVolume.fieldInTesla( vlp))).basicVector();
+	}
+      return theVolume.fieldInTesla( lp).basicVector();
+    }
 
     Vector inTesla( double x, double y, double z) const {
 	return inTesla( LocalPoint(x,y,z));
@@ -14,10 +14,11 @@ public:
   typedef T                                   Scalar;
   typedef RKSmallVector<T,N>                  Vector;
 
+  template <typename Deriv, typename Dist>
   std::pair< Vector, T> 
   operator()( Scalar startPar, const Vector& startState,
-	      const RKDerivative<T,N>& deriv,
-	      const RKDistance<T,N>& dist, Scalar step) {
+	      const Deriv& deriv,
+	      const Dist& dist, Scalar step) {
     const Scalar huge = 1.e5;  // ad hoc protection against infinities, must be done better!
     const Scalar hugediff = 100.;
 
@@ -16,10 +16,13 @@ public:
   typedef T                                   Scalar;
   typedef RKSmallVector<T,N>                  Vector;
 
+  /// Deriv and Dist are RKDerivative<T,N> and RKDistance<T,N> or, to avoid
+  /// the virtual calls in the six stages, their concrete (final) types
+  template <typename Deriv, typename Dist>
   std::pair< Vector, T> 
   operator()( Scalar startPar, const Vector& startState,
-	      const RKDerivative<T,N>& deriv,
-	      const RKDistance<T,N>& dist, Scalar step);
+	      const Deriv& deriv,
+	      const Dist& dist, Scalar step);
   
 
 };
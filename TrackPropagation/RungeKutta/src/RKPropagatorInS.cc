@@ -165,7 +165,7 @@ RKPropagatorInS::propagateParametersOnPlane( const FreeTrajectoryState& ts,
     LogDebug("RKPropagatorInS")  << "RKPropagatorInS: Solving for " << sstep 
 	      << " current distance to plane is " << startZ ;
 
-    RKVector rkresult = solver( 0, start, sstep, deriv, dist, eps);
+    RKVector rkresult = solver.solve( 0, start, sstep, deriv, dist, eps);
     stot += sstep;
     CartesianStateAdaptor cur( rkresult);
     double remainingZ = plane.localZ( globalPosition(cur.position()));
@@ -298,7 +298,7 @@ RKPropagatorInS::propagateParametersOnCylinder( const FreeTrajectoryState& ts,
     LogDebug("RKPropagatorInS")  << "RKPropagatorInS: Solving for " << sstep 
 				 << " current distance to cylinder is " << startR ;
     
-    RKVector rkresult = solver( 0, start, sstep, deriv, dist, eps);
+    RKVector rkresult = solver.solve( 0, start, sstep, deriv, dist, eps);
     stot += sstep;
     CartesianStateAdaptor cur( rkresult);
     double remainingR = cyl.radius() - cur.position().perp();
@@ -2,6 +2,7 @@
 #define DistanceBetweenComponents_H
 
 #include "TrackingTools/GsfTools/interface/SingleGaussianState.h"
+#include "TrackingTools/GsfTools/interface/MultiGaussianStateSoA.h"
 
 /** Base class (abstract) of calculation of distance between
  *  two Gaussian components.
@@ -16,6 +17,15 @@ public:
   virtual double operator() (const SingleState&, 
 			     const SingleState&) const = 0;
 
+  /** Distances of component i of a mixture to all its components
+   *  (result[j] for component j). The default calls operator() for each pair.
+   */
+  virtual void distances(const MultiGaussianStateSoA<N>& mixture, unsigned int i,
+			 double * result) const {
+    for (unsigned int j=0; j<mixture.size(); ++j)
+      result[j] = (*this)(mixture.state(i),mixture.state(j));
+  }
+
   virtual DistanceBetweenComponents<N>* clone() const = 0;
 
   virtual ~DistanceBetweenComponents() {}
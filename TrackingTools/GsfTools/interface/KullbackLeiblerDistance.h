@@ -15,6 +15,10 @@ public:
  double operator() (const SingleGaussianState<N>&, 
 			     const SingleGaussianState<N>&) const override;
 
+  /** The same as operator(), with the same arithmetic, for all the components at once.
+   */
+  void distances(const MultiGaussianStateSoA<N>&, unsigned int i, double * result) const override;
+
   KullbackLeiblerDistance<N>* clone() const override
   {  
     return new KullbackLeiblerDistance<N>(*this);
@@ -0,0 +1,67 @@
+#ifndef MultiGaussianStateSoA_H
+#define MultiGaussianStateSoA_H
+
+#include "TrackingTools/GsfTools/interface/SingleGaussianState.h"
+
+#include <memory>
+#include <vector>
+
+/** The components of a Gaussian mixture as a structure of arrays:
+ *  the same element (of the mean, or of the lower triangle of the
+ *  covariance and weight matrices, in the storage order of MatRepSym)
+ *  of all the components is contiguous, so that a quantity can be
+ *  computed for one component against all the others in a single
+ *  vectorizable loop. The original states are kept for reference.
+ */
+
+template <unsigned int N>
+class MultiGaussianStateSoA {
+public:
+  using SingleState = SingleGaussianState<N>;
+  using SingleStatePtr = std::shared_ptr<SingleState>;
+  static constexpr unsigned int NSym = N*(N+1)/2;
+
+  /// index of element (i,j) in the storage of a symmetric matrix
+  static constexpr unsigned int symIndex(unsigned int i, unsigned int j) {
+    return i>=j ? i*(i+1)/2+j : j*(j+1)/2+i;
+  }
+
+  MultiGaussianStateSoA() {}
+  explicit MultiGaussianStateSoA(const std::vector<SingleStatePtr> & states) { fill(states); }
+
+  /// (re)fill from the states; computes their weight matrix if not yet done
+  void fill(const std::vector<SingleStatePtr> & states) {
+    const unsigned int n = states.size();
+    theStates.resize(n);
+    theMeans.resize(N*n);
+    theCovariances.resize(NSym*n);
+    theWeightMatrices.resize(NSym*n);
+    for (unsigned int i=0; i<n; ++i) {
+      auto const & s = *states[i];
+      theStates[i] = &s;
+      for (unsigned int k=0; k<N; ++k) theMeans[k*n+i] = s.mean()[k];
+      auto const * v = s.covariance().Array();
+      auto const * g = s.weightMatrix().Array();
+      for (unsigned int k=0; k<NSym; ++k) {
+        theCovariances[k*n+i] = v[k];
+        theWeightMatrices[k*n+i] = g[k];
+      }
+    }
+  }
+
+  unsigned int size() const { return theStates.size(); }
+  const SingleState & state(unsigned int i) const { return *theStates[i]; }
+
+  /// element k of the means (covariances, weight matrices) of all the components
+  const double * mean(unsigned int k) const { return theMeans.data()+k*size(); }
+  const double * covariance(unsigned int k) const { return theCovariances.data()+k*size(); }
+  const double * weightMatrix(unsigned int k) const { return theWeightMatrices.data()+k*size(); }
+
+private:
+  std::vector<const SingleState*> theStates;
+  std::vector<double> theMeans;
+  std::vector<double> theCovariances;
+  std::vector<double> theWeightMatrices;
+};
+
+#endif // MultiGaussianStateSoA_H
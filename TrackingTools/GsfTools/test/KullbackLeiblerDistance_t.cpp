@@ -15,6 +15,10 @@
 #include "FWCore/Utilities/interface/HRRealTime.h"
 #include<iostream>
 #include<vector>
+#include<memory>
+#include<cmath>
+#include<cassert>
+#include<algorithm>
 
 bool isAligned(const void* data, long alignment)
 {
@@ -141,6 +145,24 @@ int main(int argc, char * argv[]) {
  
   std:: cout << res << std::endl;
 
+  // all the distances of a mixture at once
+  std::vector<std::shared_ptr<GS>> mix;
+  for (int i=0; i<72; ++i)
+    mix.push_back(std::make_shared<GS>(Vector(1.+0.01*i, 1.,1., 0.1*(i%7),0.2*(i%5)),buildCovariance(0.5+0.05*i)));
+  MultiGaussianStateSoA<5> soa(mix);
+  std::vector<double> dists(mix.size());
+  int nbad=0;
+  s= edm::hrRealTime();
+  for (unsigned int i=0; i<mix.size(); ++i) {
+    d.distances(soa,i,dists.data());
+    for (unsigned int j=0; j<mix.size(); ++j) {
+      double ref = d(*mix[i],*mix[j]);
+      if (std::abs(dists[j]-ref)>1.e-12*std::max(1.,std::abs(ref))) ++nbad;
+    }
+  }
+  e = edm::hrRealTime();
+  std::cout << e-s << " " << nbad << " distances differ" << std::endl;
+  assert(nbad==0);
 
   return 0;
 
@@ -0,0 +1,68 @@
+#ifndef TrackingTools_KalmanUpdators_KFBatchUpdator_h
+#define TrackingTools_KalmanUpdators_KFBatchUpdator_h
+
+/** \class KFBatchUpdator
+ * Kalman update of up to Width independent (predicted state, 2D hit) pairs
+ * in one go. <BR>
+ *
+ * The inputs are stored "matriplex" style: every element of the state
+ * vector, of the 5x5 covariance matrix and of the intermediate matrices
+ * is an array over the lanes, so that the whole update is a sequence of
+ * loops over lanes, with no dependency between the lanes, which the compiler
+ * can vectorize. test/KFBatchUpdator_t.cpp prints the time per update of
+ * both updators. <BR>
+ *
+ * The result is the same as KFUpdator (Joseph form), up to rounding,
+ * and the chi2 of each pair is computed on the way.
+ * Only hits of dimension 2 can be batched; the others must go
+ * through KFUpdator. <BR>
+ *
+ * Usage: add() the pairs, update(), then read updatedState() and chi2()
+ * of each lane; clear() before reusing the batch.
+ */
+
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHit.h"
+
+class KFBatchUpdator {
+
+public:
+
+  static constexpr unsigned int Width = 8;
+
+  KFBatchUpdator() : theSize(0) {}
+
+  static bool accepts(const TrackingRecHit& hit) { return hit.dimension()==2; }
+
+  /// add a pair in the next free lane and return the lane; the batch must not be full
+  unsigned int add(const TrajectoryStateOnSurface& tsos, const TrackingRecHit& hit);
+
+  unsigned int size() const { return theSize; }
+  bool full() const { return theSize==Width; }
+  void clear() { theSize=0; }
+
+  /// update all the lanes in use
+  void update();
+
+  /// invalid if the covariance matrix of the residuals could not be inverted
+  TrajectoryStateOnSurface updatedState(unsigned int lane) const;
+
+  double chi2(unsigned int lane) const { return theChi2[lane]; }
+
+private:
+
+  // index of element (i,j), i>=j, of a packed symmetric matrix
+  static constexpr unsigned int sym(unsigned int i, unsigned int j) { return i*(i+1)/2+j; }
+
+  alignas(64) double theX[5][Width];      // predicted local parameters, then filtered ones
+  alignas(64) double theC[15][Width];     // predicted local covariance, then filtered one
+  alignas(64) double theCHt[5][2][Width]; // C * H^T
+  alignas(64) double theR[3][Width];      // covariance of the residuals, V + H C H^T
+  alignas(64) double theRes[2][Width];    // residuals, m - H x
+  alignas(64) double theChi2[Width];
+  bool theOk[Width];
+  TrajectoryStateOnSurface theStates[Width];
+  unsigned int theSize;
+};
+
+#endif
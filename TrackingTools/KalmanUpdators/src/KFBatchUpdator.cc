@@ -0,0 +1,109 @@
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
+#include "DataFormats/TrackingRecHit/interface/KfComponentsHolder.h"
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <cassert>
+
+unsigned int KFBatchUpdator::add(const TrajectoryStateOnSurface& tsos,
+                                 const TrackingRecHit& aRecHit) {
+  assert(theSize<Width);
+  assert(accepts(aRecHit));
+  using ROOT::Math::SMatrixNoInit;
+
+  auto && x = tsos.localParameters().vector();
+  auto && C = tsos.localError().matrix();
+
+  ProjectMatrix<double,5,2> pf;
+  AlgebraicVector2 r, rMeas;
+  AlgebraicSymMatrix22 V(SMatrixNoInit{}), VMeas(SMatrixNoInit{});
+
+  KfComponentsHolder holder;
+  holder.setup<2>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+  aRecHit.getKfComponents(holder);
+
+  unsigned int l = theSize++;
+  for (unsigned int i=0; i<5; ++i) {
+    theX[i][l] = x[i];
+    for (unsigned int j=0; j<=i; ++j) theC[sym(i,j)][l] = C(i,j);
+    theCHt[i][0][l] = C(i,pf.index[0]);
+    theCHt[i][1][l] = C(i,pf.index[1]);
+  }
+  theR[sym(0,0)][l] = V(0,0)+VMeas(0,0);
+  theR[sym(1,0)][l] = V(1,0)+VMeas(1,0);
+  theR[sym(1,1)][l] = V(1,1)+VMeas(1,1);
+  theRes[0][l] = r[0]-rMeas[0];
+  theRes[1][l] = r[1]-rMeas[1];
+  theStates[l] = tsos;
+  return l;
+}
+
+void KFBatchUpdator::update() {
+  const unsigned int n = theSize;
+
+  // inverse of the covariance of the residuals, and chi2
+  alignas(64) double Ri[3][Width];
+  for (unsigned int l=0; l<n; ++l) {
+    double det = theR[0][l]*theR[2][l] - theR[1][l]*theR[1][l];
+    theOk[l] = (theR[0][l]>0) & (det>0);
+    double idet = theOk[l] ? 1./det : 0.;
+    Ri[0][l] =  theR[2][l]*idet;
+    Ri[1][l] = -theR[1][l]*idet;
+    Ri[2][l] =  theR[0][l]*idet;
+    theChi2[l] = theRes[0][l]*theRes[0][l]*Ri[0][l]
+               + 2.*theRes[0][l]*theRes[1][l]*Ri[1][l]
+               + theRes[1][l]*theRes[1][l]*Ri[2][l];
+  }
+
+  // Kalman gain K = C H^T R^-1, and K R
+  alignas(64) double K[5][2][Width];
+  alignas(64) double KR[5][2][Width];
+  for (unsigned int i=0; i<5; ++i) {
+    for (unsigned int l=0; l<n; ++l) {
+      K[i][0][l] = theCHt[i][0][l]*Ri[0][l] + theCHt[i][1][l]*Ri[1][l];
+      K[i][1][l] = theCHt[i][0][l]*Ri[1][l] + theCHt[i][1][l]*Ri[2][l];
+      KR[i][0][l] = K[i][0][l]*theR[0][l] + K[i][1][l]*theR[1][l];
+      KR[i][1][l] = K[i][0][l]*theR[1][l] + K[i][1][l]*theR[2][l];
+    }
+  }
+
+  // filtered state
+  for (unsigned int i=0; i<5; ++i) {
+    for (unsigned int l=0; l<n; ++l) {
+      theX[i][l] += K[i][0][l]*theRes[0][l] + K[i][1][l]*theRes[1][l];
+    }
+  }
+
+  // filtered covariance in Joseph form, (1-KH) C (1-KH)^T + K V K^T,
+  // expanded as C - K H C - C H^T K^T + K (H C H^T + V) K^T
+  for (unsigned int i=0; i<5; ++i) {
+    for (unsigned int j=0; j<=i; ++j) {
+      double * __restrict__ c = theC[sym(i,j)];
+      for (unsigned int l=0; l<n; ++l) {
+        c[l] += - K[i][0][l]*theCHt[j][0][l] - K[i][1][l]*theCHt[j][1][l]
+                - theCHt[i][0][l]*K[j][0][l] - theCHt[i][1][l]*K[j][1][l]
+                + KR[i][0][l]*K[j][0][l] + KR[i][1][l]*K[j][1][l];
+      }
+    }
+  }
+}
+
+TrajectoryStateOnSurface KFBatchUpdator::updatedState(unsigned int l) const {
+  assert(l<theSize);
+  auto const & tsos = theStates[l];
+  if (!theOk[l]) {
+    edm::LogError("KFBatchUpdator")<<" could not invert martix:\n"
+                                   << theR[0][l] << ' ' << theR[1][l] << '\n'
+                                   << theR[1][l] << ' ' << theR[2][l];
+    return TrajectoryStateOnSurface();
+  }
+  AlgebraicVector5 fsv;
+  AlgebraicSymMatrix55 fse;
+  for (unsigned int i=0; i<5; ++i) {
+    fsv[i] = theX[i][l];
+    for (unsigned int j=0; j<=i; ++j) fse(i,j) = theC[sym(i,j)][l];
+  }
+  return TrajectoryStateOnSurface( LocalTrajectoryParameters(fsv, tsos.localParameters().pzSign()),
+                                   LocalTrajectoryError(fse), tsos.surface(),
+                                   &(tsos.globalParameters().magneticField()), tsos.surfaceSide() );
+}
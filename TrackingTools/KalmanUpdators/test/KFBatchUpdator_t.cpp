@@ -0,0 +1,192 @@
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimator.h"
+
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+#include "DataFormats/GeometrySurface/interface/BoundPlane.h"
+#include <Geometry/CommonDetUnit/interface/GeomDet.h>
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// compare the batched update with KFUpdator and Chi2MeasurementEstimator, state
+// by state (parameters, errors and chi2), for more pairs than fit in one batch:
+// regular ones, then random ones with correlated errors; then time both
+
+class ConstMagneticField : public MagneticField {
+public:
+
+  virtual GlobalVector inTesla ( const GlobalPoint& ) const {
+    return GlobalVector(0,0,4);
+  }
+
+};
+
+class MyDet : public GeomDet {
+ public:
+  MyDet(BoundPlane * bp, DetId id) :
+    GeomDet(bp){setDetId(id);}
+
+  virtual std::vector< const GeomDet*> components() const {
+    return std::vector< const GeomDet*>();
+  }
+
+  virtual SubDetector subDetector() const {return GeomDetEnumerators::DT;}
+
+};
+
+namespace {
+  bool close(double a, double b, double scale) {
+    return std::abs(a-b) <= 1.e-9*std::max(scale,1.e-12);
+  }
+}
+
+namespace {
+  typedef std::vector<TrajectoryStateOnSurface> States;
+  typedef std::vector<std::unique_ptr<TrackingRecHit>> Hits;
+
+  // number of pairs for which the two differ
+  int compare(const States& states, const Hits& hits) {
+    KFUpdator kfu;
+    Chi2MeasurementEstimator chi2(1.e10);
+
+    int failures = 0;
+    KFBatchUpdator batch;
+    std::vector<unsigned int> inBatch;
+    auto check = [&]() {
+      batch.update();
+      for (unsigned int l=0; l!=batch.size(); ++l) {
+        unsigned int i = inBatch[l];
+        TrajectoryStateOnSurface ref = kfu.update(states[i], *hits[i]);
+        TrajectoryStateOnSurface upd = batch.updatedState(l);
+        double refChi2 = chi2.estimate(states[i], *hits[i]).second;
+        bool ok = close(batch.chi2(l), refChi2, refChi2);
+        auto && rv = ref.localParameters().vector();
+        auto && uv = upd.localParameters().vector();
+        auto && re = ref.localError().matrix();
+        auto && ue = upd.localError().matrix();
+        for (unsigned int j=0; j<5; ++j) {
+          ok &= close(uv[j], rv[j], std::sqrt(re(j,j)));
+          for (unsigned int k=0; k<=j; ++k) ok &= close(ue(j,k), re(j,k), std::sqrt(re(j,j)*re(k,k)));
+        }
+        ok &= upd.localParameters().pzSign() == ref.localParameters().pzSign();
+        ok &= &upd.surface() == &ref.surface();
+        if (!ok) {
+          ++failures;
+          std::cout << "mismatch for pair " << i << "\n"
+                    << rv << '\n' << uv << '\n' << re << '\n' << ue << '\n'
+                    << refChi2 << ' ' << batch.chi2(l) << std::endl;
+        }
+      }
+      batch.clear();
+      inBatch.clear();
+    };
+
+    for (unsigned int i=0; i!=states.size(); ++i) {
+      if (!KFBatchUpdator::accepts(*hits[i])) {
+        std::cout << "hit " << i << " not accepted" << std::endl;
+        return 1;
+      }
+      batch.add(states[i], *hits[i]);
+      inBatch.push_back(i);
+      if (batch.full()) check();
+    }
+    if (batch.size()!=0) check();
+
+    std::cout << states.size() << " updates compared, " << failures << " mismatches" << std::endl;
+    return failures;
+  }
+
+  // time per update, in ns, of KFUpdator and of KFBatchUpdator with full batches
+  void timeUpdates(const States& states, const Hits& hits) {
+    constexpr unsigned int repeat = 1000;
+    KFUpdator kfu;
+    double sum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned int r=0; r!=repeat; ++r) {
+      for (unsigned int i=0; i!=states.size(); ++i) sum += kfu.update(states[i], *hits[i]).localParameters().vector()[0];
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    double single = std::chrono::duration<double, std::nano>(stop-start).count()/(repeat*states.size());
+
+    KFBatchUpdator batch;
+    start = std::chrono::high_resolution_clock::now();
+    for (unsigned int r=0; r!=repeat; ++r) {
+      for (unsigned int i=0; i!=states.size(); ++i) {
+        batch.add(states[i], *hits[i]);
+        if (batch.full() || i+1==states.size()) {
+          batch.update();
+          for (unsigned int l=0; l!=batch.size(); ++l) sum -= batch.updatedState(l).localParameters().vector()[0];
+          batch.clear();
+        }
+      }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    double batched = std::chrono::duration<double, std::nano>(stop-start).count()/(repeat*states.size());
+
+    std::cout << "time per update: KFUpdator " << single << " ns, KFBatchUpdator " << batched
+              << " ns (Width " << KFBatchUpdator::Width << "), sum of differences " << sum << std::endl;
+  }
+}
+
+int main() {
+
+  MagneticField * field = new ConstMagneticField;
+  GlobalPoint gp(0,0,0);
+  BoundPlane* plane = new BoundPlane( gp, Surface::RotationType());
+  GeomDet *  det =  new MyDet(plane,41);
+
+  OmniClusterRef cref;
+  SiPixelRecHit::ClusterRef pref;
+
+  auto addHit = [&](Hits& hits, unsigned int i, const LocalPoint& m, const LocalError& e) {
+    if (i%2) hits.emplace_back(new SiPixelRecHit(m,e,1.,*det,pref));
+    else hits.emplace_back(new SiStripRecHit2D(m,e,*det,cref));
+  };
+
+  // regular pairs, with diagonal errors
+  States states;
+  Hits hits;
+  constexpr unsigned int N = 3*KFBatchUpdator::Width+3;
+  for (unsigned int i=0; i!=N; ++i) {
+    float f = 0.1f*i;
+    LocalTrajectoryParameters ltp(LocalPoint(0.01f*i,-0.02f*i,0), LocalVector(1.f,1.f-f,1.f+f), i%2 ? 1 : -1);
+    LocalTrajectoryError ler(0.1+0.01*i, 0.1, 0.01+0.001*i, 0.05, 0.1+0.02*i);
+    states.emplace_back(ltp,ler,*plane,field);
+    addHit(hits, i, LocalPoint(0.1f-f,0.1f+0.5f*f,0), LocalError(0.2+0.01*i,-0.05,0.1));
+  }
+  int failures = compare(states, hits);
+
+  // random pairs, with correlated errors: C = A^T A + d, for random A and d
+  std::mt19937 engine(1234);
+  std::uniform_real_distribution<double> u(-1., 1.), positive(0.01, 1.);
+  States rstates;
+  Hits rhits;
+  constexpr unsigned int NR = 40*KFBatchUpdator::Width+5;
+  for (unsigned int i=0; i!=NR; ++i) {
+    LocalTrajectoryParameters ltp(LocalPoint(u(engine),u(engine),0), LocalVector(u(engine),u(engine),1.f+positive(engine)),
+                                  i%3 ? 1 : -1);
+    AlgebraicMatrix55 A;
+    for (unsigned int j=0; j<5; ++j) for (unsigned int k=0; k<5; ++k) A(j,k) = 0.3*u(engine);
+    AlgebraicSymMatrix55 C = ROOT::Math::SimilarityT(A, AlgebraicSymMatrix55(ROOT::Math::SMatrixIdentity()));
+    for (unsigned int j=0; j<5; ++j) C(j,j) += 0.01*positive(engine);
+    rstates.emplace_back(ltp,LocalTrajectoryError(C),*plane,field);
+    double xx = positive(engine), yy = positive(engine);
+    addHit(rhits, i, LocalPoint(u(engine),u(engine),0), LocalError(xx, 0.9*u(engine)*std::sqrt(xx*yy), yy));
+  }
+  failures += compare(rstates, rhits);
+
+  timeUpdates(rstates, rhits);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#ifndef TrajectoryCleaning_SharedHitIndex_h
+#define TrajectoryCleaning_SharedHitIndex_h
+
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHit.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/** Index of the valid hits of a set of tracks (or trajectories), to find
+ *  the tracks sharing hits without comparing all the pairs.
+ *  Each hit is identified by a compact id, usually its DetId: two hits
+ *  can share input only if they have the same id.
+ *  The hits of each track are kept sorted by id, and an inverted index
+ *  gives all the (track, hit) on a given id, so that the tracks having
+ *  at least one id in common with a given one are found in a time
+ *  proportional to the number of such hits, not to the number of tracks.
+ *
+ *  Usage: clear(), then newTrack() and addHit() of its valid hits for each
+ *  track, then build(); the tracks are numbered in the order they are added.
+ *  An index is meant to be reused: clear() keeps the memory.
+ */
+
+class SharedHitIndex {
+public:
+  typedef const TrackingRecHit * Hit;
+  typedef std::pair<unsigned int, Hit> IHit;
+
+  /// the raw DetId, with the mono/stereo bits of the strip modules masked
+  /// so that a matched hit and its components have the same id
+  static unsigned int gluedId(const TrackingRecHit & hit) {
+    unsigned int id = hit.rawId();
+    if (hit.geographicalId().subdetId()>2) id &= (~3);
+    return id;
+  }
+
+  SharedHitIndex() : theTrackStart(1,0) {}
+
+  void clear();
+
+  /// start a new track, and return its number
+  unsigned int newTrack() {
+    theTrackStart.push_back(theTrackStart.back());
+    return theTrackStart.size()-2;
+  }
+
+  /// add a hit to the last track
+  void addHit(unsigned int id, Hit hit) {
+    theHits.emplace_back(id,hit);
+    ++theTrackStart.back();
+  }
+
+  /// sort the hits of each track by id and fill the inverted index
+  void build();
+
+  unsigned int size() const { return theTrackStart.size()-1; }
+
+  /// the hits of track t, sorted by id
+  unsigned int nHits(unsigned int t) const { return theTrackStart[t+1]-theTrackStart[t]; }
+  const IHit * hits(unsigned int t) const { return theHits.data()+theTrackStart[t]; }
+
+  /// the tracks after t having at least one id in common with t, in increasing order
+  void sharingTracks(unsigned int t, std::vector<unsigned int> & result);
+
+  /// call f(track, hit) for all the hits on id, by increasing track and in the order they were added
+  template<typename F>
+  void forEachHit(unsigned int id, F && f) const {
+    auto range = std::equal_range(theEntries.begin(), theEntries.end(), Entry{id,0,nullptr}, lessById);
+    for (auto e=range.first; e!=range.second; ++e) f(e->track, e->hit);
+  }
+
+  /// number of pairs of hits of t1 and t2 with the same id for which share(hit1, hit2) is true;
+  /// when a track has several hits on an id all the combinations are checked
+  template<typename Share>
+  int sharedHits(unsigned int t1, unsigned int t2, Share && share) const {
+    auto const * h1 = hits(t1); auto const * h2 = hits(t2);
+    unsigned int nh1 = nHits(t1), nh2 = nHits(t2);
+    int noverlap = 0;
+    unsigned int ih=0, jh=0;
+    while (ih!=nh1 && jh!=nh2) {
+      auto const id1 = h1[ih].first;
+      auto const id2 = h2[jh].first;
+      if (id1<id2) ++ih;
+      else if (id2<id1) ++jh;
+      else {
+        auto li=ih; while ((++li)!=nh1 && id1==h1[li].first);
+        auto lj=jh; while ((++lj)!=nh2 && id2==h2[lj].first);
+        for (auto ii=ih; ii!=li; ++ii)
+          for (auto jj=jh; jj!=lj; ++jj)
+            if (share(h1[ii].second, h2[jj].second)) ++noverlap;
+        ih=li; jh=lj;
+      }
+    }
+    return noverlap;
+  }
+
+private:
+  struct Entry {
+    unsigned int id;
+    unsigned int track;
+    Hit hit;
+  };
+  static bool lessById(const Entry & a, const Entry & b) { return a.id < b.id; }
+
+  std::vector<unsigned int> theTrackStart;  // the hits of track t are [theTrackStart[t], theTrackStart[t+1])
+  std::vector<IHit> theHits;
+  std::vector<Entry> theEntries;            // the inverted index, sorted by id and then by track
+  std::vector<unsigned int> theLastSeen;    // per track, to remove duplicates in sharingTracks
+  unsigned int theSearch = 0;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "TrackingTools/TrajectoryCleaning/interface/SharedHitIndex.h"
+
+void SharedHitIndex::clear() {
+  theTrackStart.assign(1,0);
+  theHits.clear();
+  theEntries.clear();
+}
+
+void SharedHitIndex::build() {
+  auto compById = [](IHit const & h1, IHit const & h2) { return h1.first < h2.first; };
+  const unsigned int nTracks = size();
+  theEntries.clear();
+  theEntries.reserve(theHits.size());
+  for (unsigned int t=0; t!=nTracks; ++t) {
+    auto b = theHits.begin()+theTrackStart[t];
+    auto e = theHits.begin()+theTrackStart[t+1];
+    for (auto h=b; h!=e; ++h) theEntries.push_back(Entry{h->first,t,h->second});
+    // heap sort, as the hits have always been sorted: same order for the hits with the same id
+    for (auto h=b; h!=e; ++h) std::push_heap(b,h+1,compById);
+    std::sort_heap(b,e,compById);
+  }
+  // the entries are filled by track: a stable sort keeps this order for the same id
+  std::stable_sort(theEntries.begin(), theEntries.end(), lessById);
+  theLastSeen.assign(nTracks,0);
+  theSearch = 0;
+}
+
+void SharedHitIndex::sharingTracks(unsigned int t, std::vector<unsigned int> & result) {
+  result.clear();
+  ++theSearch;
+  auto const * h = hits(t);
+  const unsigned int nh = nHits(t);
+  for (unsigned int ih=0; ih!=nh; ++ih) {
+    if (ih>0 && h[ih].first==h[ih-1].first) continue;
+    auto range = std::equal_range(theEntries.begin(), theEntries.end(), Entry{h[ih].first,0,nullptr}, lessById);
+    // the entries on an id are sorted by track
+    auto first = std::upper_bound(range.first, range.second, t,
+                                  [](unsigned int track, const Entry & e) { return track < e.track; });
+    for (auto e=first; e!=range.second; ++e) {
+      if (theLastSeen[e->track]==theSearch) continue;
+      theLastSeen[e->track] = theSearch;
+      result.push_back(e->track);
+    }
+  }
+  std::sort(result.begin(), result.end());
+}
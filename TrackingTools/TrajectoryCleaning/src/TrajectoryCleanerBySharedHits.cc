@@ -2,6 +2,7 @@
 #include "TrackingTools/TransientTrackingRecHit/interface/TransientTrackingRecHit.h"
 #include "TrackingTools/TransientTrackingRecHit/interface/RecHitComparatorByPosition.h"
 
+#include "TrackingTools/TrajectoryCleaning/interface/SharedHitIndex.h"
 #include "TrackingTools/TrajectoryCleaning/src/OtherHashMaps.h"
 
 
@@ -16,20 +17,11 @@ struct EqualsBySharesInput {
         return (h1 == h2) || ((h1->geographicalId() == h2->geographicalId()) && (h1->hit()->sharesInput(h2->hit(), TrackingRecHit::some)));
     }
 };
-// Define a hash, i.e. a number that must be equal if hits are equal, and should be different if they're not
-struct HashByDetId : std::unary_function<const TransientTrackingRecHit *, std::size_t> {
-    std::size_t operator()(const TransientTrackingRecHit *hit) const { 
-        boost::hash<uint32_t> hasher; 
-        return hasher(hit->geographicalId().rawId());
-    }
-};
 
-using RecHitMap = cmsutil::SimpleAllocHashMultiMap<const TransientTrackingRecHit*, Trajectory *, HashByDetId, EqualsBySharesInput>;
 using TrajMap = cmsutil::UnsortedDumbVectorMap<Trajectory*, int>;
 
 struct Maps {
-  Maps() : theRecHitMap(128,256,1024){} // allocate 128 buckets, one row for 256 keys and one row for 512 values
-  RecHitMap theRecHitMap;
+  SharedHitIndex theHitIndex;
   TrajMap theTrajMap;
 };
 
@@ -42,26 +34,27 @@ void TrajectoryCleanerBySharedHits::clean( TrajectoryPointerContainer & tc) cons
 {
   if (tc.size() <= 1) return; // nothing to clean
 
-  auto & theRecHitMap = theMaps.theRecHitMap;
-
-  theRecHitMap.clear(10*tc.size());           // set 10*tc.size() active buckets
-                                              // numbers are not optimized
+  // the hits are indexed by DetId: only the hits on the same module can share input
+  auto & theHitIndex = theMaps.theHitIndex;
+  theHitIndex.clear();
 
-  DEBUG_PRINT(std::cout << "Filling RecHit map" << std::endl);
+  DEBUG_PRINT(std::cout << "Filling hit index" << std::endl);
   for (auto const & it : tc) {
     DEBUG_PRINT(std::cout << "  Processing trajectory " << it << " (" << it->foundHits() << " valid hits)" << std::endl);
+    theHitIndex.newTrack();
     auto const & pd = it->measurements();
     for (auto const & im : pd) {
       auto theRecHit = &(*im.recHit());
       if (theRecHit->isValid()) {
         DEBUG_PRINT(std::cout << "    Added hit " << theRecHit << " for trajectory " << it << std::endl);
-        theRecHitMap.insert(theRecHit, it);
+        theHitIndex.addHit(theRecHit->geographicalId().rawId(), theRecHit);
       }
     }
   }
-  DEBUG_PRINT(theRecHitMap.dump());
+  theHitIndex.build();
 
-  DEBUG_PRINT(std::cout << "Using RecHit map" << std::endl);
+  DEBUG_PRINT(std::cout << "Using hit index" << std::endl);
+  EqualsBySharesInput equals;
   // for each trajectory fill theTrajMap
   auto & theTrajMap = theMaps.theTrajMap; 
   for (auto const & itt : tc) {
@@ -73,14 +66,12 @@ void TrajectoryCleanerBySharedHits::clean( TrajectoryPointerContainer & tc) cons
 	auto theRecHit = &(*im.recHit());
         if (theRecHit->isValid()) {
           DEBUG_PRINT(std::cout << "    Searching for overlaps on hit " << theRecHit << " for trajectory " << itt << std::endl);
-          for (RecHitMap::value_iterator ivec = theRecHitMap.values(theRecHit);
-                ivec.good(); ++ivec) {
-              if (*ivec != itt){
-                if ((*ivec)->isValid()){
-                    theTrajMap[*ivec]++;
-                }
+          theHitIndex.forEachHit(theRecHit->geographicalId().rawId(), [&](unsigned int t, const TrackingRecHit * hit) {
+              auto other = tc[t];
+              if (other != itt && other->isValid() && equals(theRecHit, hit)) {
+                theTrajMap[other]++;
               }
-          }
+          });
 	}
       }
       //end filling theTrajMap
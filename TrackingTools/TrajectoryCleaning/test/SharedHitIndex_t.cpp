@@ -0,0 +1,74 @@
+#include "TrackingTools/TrajectoryCleaning/interface/SharedHitIndex.h"
+#include "DataFormats/TrackingRecHit/interface/InvalidTrackingRecHit.h"
+
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+// compare the index with a plain comparison of all the pairs of tracks
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<unsigned int> nHits(0,12), module(0,200), hit(0,2999);
+  std::vector<InvalidTrackingRecHit> hits(3000);  // only their address is used
+
+  constexpr unsigned int N = 500;
+  std::vector<std::vector<SharedHitIndex::IHit>> tracks(N);
+  SharedHitIndex index;
+  for (int pass=0; pass!=2; ++pass) {  // the second pass checks that the index can be reused
+    index.clear();
+    for (auto & track : tracks) {
+      track.clear();
+      index.newTrack();
+      for (unsigned int n=nHits(rng); n!=0; --n) {
+        track.emplace_back(module(rng), &hits[hit(rng)]);
+        index.addHit(track.back().first, track.back().second);
+      }
+    }
+  }
+  index.build();
+
+  auto share = [](const TrackingRecHit * h1, const TrackingRecHit * h2) { return h1==h2; };
+  int failures = 0;
+  std::vector<unsigned int> sharing;
+  for (unsigned int t1=0; t1!=N; ++t1) {
+    if (index.nHits(t1)!=tracks[t1].size()) ++failures;
+    for (unsigned int i=1; i<index.nHits(t1); ++i)
+      if (index.hits(t1)[i].first < index.hits(t1)[i-1].first) ++failures;
+
+    std::vector<unsigned int> expected;
+    for (unsigned int t2=t1+1; t2!=N; ++t2) {
+      int nShared = 0;
+      bool sameModule = false;
+      for (auto const & h1 : tracks[t1])
+        for (auto const & h2 : tracks[t2])
+          if (h1.first==h2.first) { sameModule = true; if (share(h1.second,h2.second)) ++nShared; }
+      if (sameModule) expected.push_back(t2);
+      if (index.sharedHits(t1,t2,share)!=nShared) {
+        ++failures;
+        std::cout << "tracks " << t1 << ' ' << t2 << ": " << index.sharedHits(t1,t2,share)
+                  << " shared hits instead of " << nShared << std::endl;
+      }
+    }
+    index.sharingTracks(t1, sharing);
+    if (sharing!=expected) {
+      ++failures;
+      std::cout << "track " << t1 << ": " << sharing.size() << " sharing tracks instead of " << expected.size() << std::endl;
+    }
+  }
+
+  // the inverted index gives the hits by increasing track
+  for (unsigned int m=0; m!=201; ++m) {
+    std::multiset<unsigned int> expected;
+    for (unsigned int t=0; t!=N; ++t)
+      for (auto const & h : tracks[t]) if (h.first==m) expected.insert(t);
+    std::multiset<unsigned int> found;
+    unsigned int last = 0;
+    index.forEachHit(m, [&](unsigned int t, const TrackingRecHit *) { if (t<last) ++failures; last = t; found.insert(t); });
+    if (found!=expected) ++failures;
+  }
+
+  std::cout << N << " tracks compared, " << failures << " failures" << std::endl;
+  return failures == 0 ? 0 : 1;
+}